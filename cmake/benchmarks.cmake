@@ -0,0 +1,91 @@
+#################################################################################
+#
+# Inviwo - Interactive Visualization Workshop
+#
+# Copyright (c) 2021 Inviwo Foundation
+# All rights reserved.
+# 
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions are met: 
+# 
+# 1. Redistributions of source code must retain the above copyright notice, this
+# list of conditions and the following disclaimer. 
+# 2. Redistributions in binary form must reproduce the above copyright notice,
+# this list of conditions and the following disclaimer in the documentation
+# and/or other materials provided with the distribution. 
+# 
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+# ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+# WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+# DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+# ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+# (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+# LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+# ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+# (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+# SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+# 
+#################################################################################
+
+ ### Generate benchmarks for modules. ###
+
+#--------------------------------------------------------------------
+# Options for benchmarks, IVW_TEST_BENCHMARKS is defined in ext/CMakeLists.txt
+set(IVW_TEST_BENCHMARKS_OUTPUT_DIR "${CMAKE_BINARY_DIR}/benchmarks" CACHE PATH 
+    "Output directory for the json results written by the run-benchmarks targets")
+
+#--------------------------------------------------------------------
+# Add a benchmark application 'bm-<name>' and a target 'run-bm-<name>' that runs it and
+# writes the results in json format to IVW_TEST_BENCHMARKS_OUTPUT_DIR/bm-<name>.json.
+# All run targets are collected in the 'run-benchmarks' target. Two json files can be
+# compared using the tools/compare.py script of google benchmark.
+# Usage:
+# ivw_add_benchmark(<name> SOURCES <source files> LINK <libraries>)
+function(ivw_add_benchmark name)
+    set(options "")
+    set(oneValueArgs "")
+    set(multiValueArgs SOURCES LINK)
+    cmake_parse_arguments(ARG "${options}" "${oneValueArgs}" "${multiValueArgs}" ${ARGN})
+
+    find_package(benchmark CONFIG REQUIRED)
+
+    set(bm_name "bm-${name}")
+    ivw_group("Source Files" ${ARG_SOURCES})
+
+    # Create application
+    add_executable(${bm_name} ${ARG_SOURCES})
+    target_link_libraries(${bm_name} 
+        PUBLIC 
+            benchmark::benchmark
+            ${ARG_LINK}
+    )
+    set_target_properties(${bm_name} PROPERTIES FOLDER benchmarks)
+
+    if(MSVC)
+        set_property(TARGET ${bm_name} APPEND_STRING PROPERTY LINK_FLAGS 
+            " /SUBSYSTEM:CONSOLE /ENTRY:mainCRTStartup")
+    endif()
+
+    # Define defintions and properties
+    ivw_define_standard_properties(${bm_name})
+    ivw_define_standard_definitions(${bm_name} ${bm_name})
+
+    # Add run command
+    add_custom_target(run-${bm_name}
+        COMMAND ${CMAKE_COMMAND} -E make_directory "${IVW_TEST_BENCHMARKS_OUTPUT_DIR}"
+        COMMAND ${bm_name} 
+            "--benchmark_out=${IVW_TEST_BENCHMARKS_OUTPUT_DIR}/${bm_name}.json"
+            --benchmark_out_format=json
+        DEPENDS ${bm_name}
+        COMMENT "Running benchmark: ${bm_name}"
+        USES_TERMINAL
+        VERBATIM
+    )
+    set_target_properties(run-${bm_name} PROPERTIES FOLDER benchmarks/run)
+
+    if(NOT TARGET run-benchmarks)
+        add_custom_target(run-benchmarks COMMENT "Running all benchmarks")
+        set_target_properties(run-benchmarks PROPERTIES FOLDER benchmarks/run)
+    endif()
+    add_dependencies(run-benchmarks run-${bm_name})
+endfunction()
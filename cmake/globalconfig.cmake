@@ -173,6 +173,9 @@ option(IVW_CFG_PROFILING "Enable profiling" OFF)
 # Build unittest for all modules
 include(${CMAKE_CURRENT_LIST_DIR}/unittests.cmake)
 
+# Build benchmarks for all modules
+include(${CMAKE_CURRENT_LIST_DIR}/benchmarks.cmake)
+
 # Use Visual Studio memory leak test
 include(${CMAKE_CURRENT_LIST_DIR}/memleak.cmake)
 
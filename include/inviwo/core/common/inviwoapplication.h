@@ -214,9 +214,22 @@ public:
 
     virtual std::locale getUILocale() const;
 
+    /**
+     * Enqueue a functor to be run in the thread pool
+     * @returns a future with the result of the functor.
+     */
     template <class F, class... Args>
     auto dispatchPool(F&& f, Args&&... args) -> std::future<std::invoke_result_t<F, Args...>>;
 
+    /**
+     * Enqueue a functor to be run in the thread pool with the given priority. Queued tasks with a
+     * higher priority are started before queued tasks with a lower one.
+     * @returns a future with the result of the functor.
+     */
+    template <class F, class... Args>
+    auto dispatchPool(ThreadPool::Priority priority, F&& f, Args&&... args)
+        -> std::future<std::invoke_result_t<F, Args...>>;
+
     /**
      * Enqueue a functor to be run in the GUI thread
      * @returns a future with the result of the functor.
@@ -519,6 +532,13 @@ auto dispatchPool(F&& f, Args&&... args) -> std::future<std::invoke_result_t<F,
                                                      std::forward<Args>(args)...);
 }
 
+template <class F, class... Args>
+auto dispatchPool(ThreadPool::Priority priority, F&& f, Args&&... args)
+    -> std::future<std::invoke_result_t<F, Args...>> {
+    return InviwoApplication::getPtr()->dispatchPool(priority, std::forward<F>(f),
+                                                     std::forward<Args>(args)...);
+}
+
 template <class T>
 T* InviwoApplication::getSettingsByType() {
     return getTypeFromVector<T>(getModuleSettings());
@@ -540,6 +560,12 @@ auto InviwoApplication::dispatchPool(F&& f, Args&&... args)
     return pool_.enqueue(std::forward<F>(f), std::forward<Args>(args)...);
 }
 
+template <class F, class... Args>
+auto InviwoApplication::dispatchPool(ThreadPool::Priority priority, F&& f, Args&&... args)
+    -> std::future<std::invoke_result_t<F, Args...>> {
+    return pool_.enqueue(priority, std::forward<F>(f), std::forward<Args>(args)...);
+}
+
 template <class F, class... Args>
 auto InviwoApplication::dispatchFront(F&& f, Args&&... args)
     -> std::future<std::invoke_result_t<F, Args...>> {
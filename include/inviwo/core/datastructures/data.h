@@ -33,11 +33,14 @@
 #include <inviwo/core/datastructures/representationfactory.h>
 #include <inviwo/core/datastructures/representationconverterfactory.h>
 #include <inviwo/core/datastructures/representationfactorymanager.h>
+#include <inviwo/core/util/detected.h>
+#include <inviwo/core/util/evaluationtrace.h>
 
 #include <typeindex>
 #include <mutex>
 #include <unordered_map>
 #include <memory>
+#include <utility>
 
 namespace inviwo {
 
@@ -125,6 +128,13 @@ public:
     template <typename T>
     bool hasRepresentation() const;
 
+    /**
+     * Check if a representation of type T exists and is valid, i.e. getRepresentation<T>() will
+     * return it without any conversion.
+     */
+    template <typename T>
+    bool hasValidRepresentation() const;
+
     /**
      * Check if the Data object has any representation.
      * @return true if any representation exist, false otherwise.
@@ -182,6 +192,28 @@ protected:
     mutable std::shared_ptr<Repr> lastValidRepresentation_;
 };
 
+namespace detail {
+
+template <typename T>
+using HasDimensions = decltype(std::declval<const T&>().getDimensions());
+
+/**
+ * Size in bytes of a volume, layer, or buffer representation, used to trace conversions
+ */
+template <typename Repr>
+size_t representationBytes(const Repr& repr) {
+    size_t count = 1;
+    if constexpr (util::is_detected_v<HasDimensions, Repr>) {
+        const auto dims = repr.getDimensions();
+        for (int i = 0; i < static_cast<int>(dims.length()); ++i) count *= dims[i];
+    } else {
+        count = repr.getSize();
+    }
+    return count * repr.getDataFormat()->getSize();
+}
+
+}  // namespace detail
+
 template <typename Self, typename Repr>
 Data<Self, Repr>::Data(const Data<Self, Repr>& rhs) : lastValidRepresentation_{nullptr} {
     rhs.copyRepresentationsTo(this);
@@ -231,10 +263,12 @@ const T* Data<Self, Repr>::getValidRepresentation() const {
                 converter->update(lastValidRepresentation_, it->second);
                 lastValidRepresentation_ = it->second;
                 lastValidRepresentation_->setValid(true);
+                EvaluationTrace::countConversion(0);
             } else {  // No representation found, create it
                 auto result = converter->createFrom(lastValidRepresentation_);
                 if (!result) throw ConverterException("Converter failed to create", IVW_CONTEXT);
                 lastValidRepresentation_ = addRepresentationInternal(result);
+                EvaluationTrace::countConversion(detail::representationBytes(*result));
             }
         }
         return dynamic_cast<const T*>(lastValidRepresentation_.get());
@@ -258,6 +292,14 @@ bool Data<Self, Repr>::hasRepresentation() const {
     return util::has_key(representations_, std::type_index(typeid(T)));
 }
 
+template <typename Self, typename Repr>
+template <typename T>
+bool Data<Self, Repr>::hasValidRepresentation() const {
+    std::unique_lock<std::mutex> lock(mutex_);
+    auto it = representations_.find(std::type_index(typeid(T)));
+    return it != representations_.end() && it->second->isValid();
+}
+
 template <typename Self, typename Repr>
 void Data<Self, Repr>::invalidateAllOther(const Repr* repr) {
     bool found = false;
@@ -31,8 +31,14 @@
 
 #include <inviwo/core/common/inviwocoredefine.h>
 #include <inviwo/core/util/glm.h>
+#include <inviwo/core/util/formats.h>
+#include <inviwo/core/util/assertion.h>
 
+#include <algorithm>
+#include <cstdint>
 #include <iterator>
+#include <limits>
+#include <type_traits>
 #include <vector>
 #include <bitset>
 
@@ -80,6 +86,7 @@ protected:
 class IVW_CORE_API HistogramContainer {
 public:
     HistogramContainer() = default;
+    explicit HistogramContainer(std::vector<NormalizedHistogram> histograms);
     template <typename FirstIter, typename LastIter>
     HistogramContainer(dvec2 range, size_t bins, FirstIter begin, LastIter end);
 
@@ -98,66 +105,124 @@ private:
     std::vector<NormalizedHistogram> histograms_;
 };
 
-template <typename FirstIter, typename LastIter>
-HistogramContainer::HistogramContainer(dvec2 dataRange, size_t bins, FirstIter begin,
-                                       LastIter end) {
-    using T = typename std::iterator_traits<FirstIter>::value_type;
-
-    // a double type with the same extent as T
-    using D = typename util::same_extent<T, double>::type;
-    // a size_t type with same extent as T
-    using I = typename util::same_extent<T, size_t>::type;
-
-    constexpr size_t extent = util::rank<T>::value > 0 ? util::extent<T>::value : 1;
-
-    // check whether number of bins exceeds the data range only if it is an integral type
-    if constexpr (!util::is_floating_point<typename util::value_type<T>::type>::value) {
-        bins = std::min(bins, static_cast<std::size_t>(dataRange.y - dataRange.x + 1));
-    }
-
-    std::array<std::vector<double>, extent> histData;
-    for (size_t i = 0; i < extent; ++i) {
-        histData[i].resize(bins, 0.0);
-    }
-
-    D min(std::numeric_limits<double>::max());
-    D max(std::numeric_limits<double>::lowest());
-    D sum(0);
-    D sum2(0);
-    size_t count(0);
-
-    const D rangeMin(dataRange.x);
-    const D rangeScaleFactor(static_cast<double>(bins - 1) / (dataRange.y - dataRange.x));
-
-    for (; begin != end; ++begin) {
-
-        const auto val = static_cast<D>(*begin);
+/**
+ * \brief Bin counts and statistics accumulated over a part of a data set
+ *
+ * Partial histograms of different parts of the same data set can be computed independently, for
+ * example in parallel, and merged. Data with 8 or 16 bit integer components is counted per value
+ * instead of per bin, which avoids a floating point conversion per value and makes it possible to
+ * rebin() such a histogram for a new data range without going through the data again.
+ */
+class IVW_CORE_API PartialHistogram {
+public:
+    PartialHistogram() = default;
+    /**
+     * @param dataRange  data range covered by the bins
+     * @param bins       number of bins, limited to the size of the data range for integer formats
+     * @param format     data format of the values, determines the number of channels
+     */
+    PartialHistogram(dvec2 dataRange, size_t bins, const DataFormatBase* format);
+
+    /**
+     * Add the values in [begin, end), the value type has to match the data format.
+     */
+    template <typename FirstIter, typename LastIter>
+    void add(FirstIter begin, LastIter end);
+
+    /**
+     * Add the counts of \p other, which has to have the same data range, bins, and format.
+     */
+    void merge(const PartialHistogram& other);
+
+    /**
+     * True if the values are counted individually and the histogram can be rebinned.
+     */
+    bool hasValueCounts() const;
+
+    /**
+     * Use a new data range and number of bins. Requires hasValueCounts().
+     */
+    void rebin(dvec2 dataRange, size_t bins);
+
+    dvec2 getDataRange() const;
+    size_t getBins() const;
+    /**
+     * The number of values added so far
+     */
+    size_t getCount() const;
+
+    /**
+     * Create one normalized histogram per channel from the current counts
+     */
+    HistogramContainer getHistograms() const;
 
-        min = glm::min(min, val);
-        max = glm::max(max, val);
-        sum += val;
-        sum2 += val * val;
-        count++;
+private:
+    struct Channel {
+        std::vector<std::uint64_t> bins;
+        std::vector<std::uint64_t> values;
+        double min = std::numeric_limits<double>::max();
+        double max = std::numeric_limits<double>::lowest();
+        double sum = 0.0;
+        double sum2 = 0.0;
+    };
 
-        const auto ind = static_cast<I>((val - rangeMin) * rangeScaleFactor);
+    dvec2 dataRange_{0.0, 0.0};
+    size_t bins_ = 0;
+    bool integral_ = false;
+    double valueOffset_ = 0.0;
+    size_t count_ = 0;
+    std::vector<Channel> channels_;
+};
 
-        for (size_t i = 0; i < extent; ++i) {
-            const auto v = util::glmcomp(ind, i);
-            if (v < bins) {
-                histData[i][v]++;
+template <typename FirstIter, typename LastIter>
+void PartialHistogram::add(FirstIter begin, LastIter end) {
+    using T = typename std::iterator_traits<FirstIter>::value_type;
+    using C = typename util::value_type<T>::type;
+    constexpr size_t extent = util::flat_extent<T>::value;
+    IVW_ASSERT(channels_.size() == extent, "Format does not match the histogram");
+
+    if constexpr (std::is_integral_v<C> && sizeof(C) <= 2) {
+        IVW_ASSERT(hasValueCounts(), "Format does not match the histogram");
+        constexpr auto offset = static_cast<std::int32_t>(std::numeric_limits<C>::lowest());
+        for (; begin != end; ++begin) {
+            for (size_t i = 0; i < extent; ++i) {
+                const auto v = static_cast<std::int32_t>(util::glmcomp(*begin, i));
+                ++channels_[i].values[static_cast<size_t>(v - offset)];
+            }
+            ++count_;
+        }
+    } else {
+        const double rangeMin = dataRange_.x;
+        const double rangeScaleFactor =
+            static_cast<double>(bins_ - 1) / (dataRange_.y - dataRange_.x);
+        const auto binsd = static_cast<double>(bins_);
+
+        for (; begin != end; ++begin) {
+            for (size_t i = 0; i < extent; ++i) {
+                const auto val = static_cast<double>(util::glmcomp(*begin, i));
+                auto& channel = channels_[i];
+                channel.min = std::min(channel.min, val);
+                channel.max = std::max(channel.max, val);
+                channel.sum += val;
+                channel.sum2 += val * val;
+
+                const double ind = (val - rangeMin) * rangeScaleFactor;
+                if (ind >= 0.0 && ind < binsd) {
+                    ++channel.bins[static_cast<size_t>(ind)];
+                }
             }
+            ++count_;
         }
     }
+}
 
-    const auto dcount = static_cast<double>(count);
-    const auto mean = sum / dcount;
-    const auto stddev = glm::sqrt((dcount * sum2 - sum * sum) / (dcount * (dcount - D{1})));
-
-    for (size_t i = 0; i < extent; ++i) {
-        histograms_.emplace_back(dataRange, std::move(histData[i]), util::glmcomp(min, i),
-                                 util::glmcomp(max, i), util::glmcomp(mean, i),
-                                 util::glmcomp(stddev, i));
-    }
+template <typename FirstIter, typename LastIter>
+HistogramContainer::HistogramContainer(dvec2 dataRange, size_t bins, FirstIter begin,
+                                       LastIter end) {
+    using T = typename std::iterator_traits<FirstIter>::value_type;
+    PartialHistogram histogram(dataRange, bins, DataFormat<T>::get());
+    histogram.add(begin, end);
+    *this = histogram.getHistograms();
 }
 
 }  // namespace inviwo
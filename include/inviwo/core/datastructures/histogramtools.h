@@ -56,15 +56,32 @@ public:
 
     void whenDone(std::function<void(const HistogramContainer&)> callback);
 
+    /**
+     * Register a callback for approximate histograms of the part of the data processed so far.
+     * These are published for large volumes while the calculation is running, the callback is
+     * invoked on the main thread with the histograms and the fraction of the data they cover.
+     */
+    void whenUpdated(std::function<void(const HistogramContainer&, double)> callback);
+
     size_t getBins() const { return bins_; }
     dvec2 getDataRange() const { return dataRange_; }
+    /**
+     * Fraction of the data processed so far, 1.0 when done.
+     */
+    double getProgress() const { return progress_; }
 
 private:
     std::weak_ptr<HistogramContainer> container_;
     Dispatcher<void(const HistogramContainer&)> callbacks_;
     std::vector<std::shared_ptr<std::function<void(const HistogramContainer&)>>> callbackHandles_;
+    Dispatcher<void(const HistogramContainer&, double)> updateCallbacks_;
+    std::vector<std::shared_ptr<std::function<void(const HistogramContainer&, double)>>>
+        updateCallbackHandles_;
     std::shared_ptr<std::atomic<bool>> stop_;
     bool done = false;
+    double progress_ = 0.0;
+    // value counts of the finished calculation, used to rebin integer data for a new data range
+    std::shared_ptr<const PartialHistogram> result_;
 
     size_t bins_;
     dvec2 dataRange_;
@@ -95,7 +112,10 @@ protected:
 
 private:
     static void done(std::shared_ptr<HistogramCalculationState> state,
-                     HistogramContainer histograms);
+                     HistogramContainer histograms,
+                     std::shared_ptr<const PartialHistogram> result = nullptr);
+    static void update(std::shared_ptr<HistogramCalculationState> state,
+                       const HistogramContainer& histograms, double progress);
 
     mutable std::shared_ptr<HistogramCalculationState> calculation_;
     mutable std::shared_ptr<HistogramContainer> histograms_;
@@ -55,7 +55,7 @@ public:
     LayerRAMPrecision(const LayerRAMPrecision<T>& rhs);
     LayerRAMPrecision<T>& operator=(const LayerRAMPrecision<T>& that);
     virtual LayerRAMPrecision<T>* clone() const override;
-    virtual ~LayerRAMPrecision() = default;
+    virtual ~LayerRAMPrecision();
 
     T* getDataTyped();
     const T* getDataTyped() const;
@@ -64,6 +64,12 @@ public:
     virtual const void* getData() const override;
     virtual void setData(void* data, size2_t dimensions) override;
 
+    /**
+     * The data pointer will not be deleted by this representation, used when the memory is owned
+     * by someone else, e.g. a NumPy array. The ownership is regained by setData and setDimensions.
+     */
+    void removeDataOwnership();
+
     /**
      * Resize the representation to dimension. This is destructive, the data will not be
      * preserved. Use copyRepresentationsTo to update the data.
@@ -102,6 +108,7 @@ public:
 
 private:
     size2_t dimensions_;
+    bool ownsDataPtr_;
     std::unique_ptr<T[]> data_;
     SwizzleMask swizzleMask_;
     InterpolationType interpolation_;
@@ -132,6 +139,7 @@ LayerRAMPrecision<T>::LayerRAMPrecision(size2_t dimensions, LayerType type,
                                         InterpolationType interpolation, const Wrapping2D& wrapping)
     : LayerRAM(type, DataFormat<T>::get())
     , dimensions_(dimensions)
+    , ownsDataPtr_(true)
     , data_(new T[dimensions_.x * dimensions_.y]())
     , swizzleMask_(swizzleMask)
     , interpolation_{interpolation}
@@ -146,6 +154,7 @@ LayerRAMPrecision<T>::LayerRAMPrecision(T* data, size2_t dimensions, LayerType t
                                         InterpolationType interpolation, const Wrapping2D& wrapping)
     : LayerRAM(type, DataFormat<T>::get())
     , dimensions_(dimensions)
+    , ownsDataPtr_(true)
     , data_(data ? data : new T[dimensions_.x * dimensions_.y]())
     , swizzleMask_(swizzleMask)
     , interpolation_{interpolation}
@@ -160,6 +169,7 @@ template <typename T>
 LayerRAMPrecision<T>::LayerRAMPrecision(const LayerRAMPrecision<T>& rhs)
     : LayerRAM(rhs)
     , dimensions_(rhs.dimensions_)
+    , ownsDataPtr_(true)
     , data_(new T[dimensions_.x * dimensions_.y])
     , swizzleMask_(rhs.swizzleMask_)
     , interpolation_{rhs.interpolation_}
@@ -176,6 +186,8 @@ LayerRAMPrecision<T>& LayerRAMPrecision<T>::operator=(const LayerRAMPrecision<T>
         auto data = std::make_unique<T[]>(dim.x * dim.y);
         std::memcpy(data.get(), that.data_.get(), dim.x * dim.y * sizeof(T));
         data_.swap(data);
+        if (!ownsDataPtr_) data.release();
+        ownsDataPtr_ = true;
 
         dimensions_ = that.dimensions_;
         swizzleMask_ = that.swizzleMask_;
@@ -185,6 +197,11 @@ LayerRAMPrecision<T>& LayerRAMPrecision<T>::operator=(const LayerRAMPrecision<T>
     return *this;
 }
 
+template <typename T>
+LayerRAMPrecision<T>::~LayerRAMPrecision() {
+    if (!ownsDataPtr_) data_.release();
+}
+
 template <typename T>
 LayerRAMPrecision<T>* LayerRAMPrecision<T>::clone() const {
     return new LayerRAMPrecision<T>(*this);
@@ -214,6 +231,14 @@ void inviwo::LayerRAMPrecision<T>::setData(void* d, size2_t dimensions) {
     std::unique_ptr<T[]> data(static_cast<T*>(d));
     data_.swap(data);
     std::swap(dimensions_, dimensions);
+
+    if (!ownsDataPtr_) data.release();
+    ownsDataPtr_ = true;
+}
+
+template <typename T>
+void LayerRAMPrecision<T>::removeDataOwnership() {
+    ownsDataPtr_ = false;
 }
 
 template <typename T>
@@ -222,6 +247,8 @@ void LayerRAMPrecision<T>::setDimensions(size2_t dimensions) {
         auto data = std::make_unique<T[]>(dimensions.x * dimensions.y);
         data_.swap(data);
         std::swap(dimensions, dimensions_);
+        if (!ownsDataPtr_) data.release();
+        ownsDataPtr_ = true;
     }
 }
 
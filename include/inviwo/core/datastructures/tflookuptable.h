@@ -0,0 +1,89 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2021 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#pragma once
+
+#include <inviwo/core/common/inviwocoredefine.h>
+#include <inviwo/core/util/glmvec.h>
+
+#include <tcb/span.hpp>
+
+#include <vector>
+
+namespace inviwo {
+
+class TransferFunction;
+
+/**
+ * \ingroup datastructures
+ * \brief A lookup table of a TransferFunction for fast sampling on the CPU
+ *
+ * TransferFunction::sample searches the primitives for every value, which is slow when many
+ * values are mapped. The lookup table stores the colors at equidistant positions in [0,1],
+ * including the mask of the transfer function, and interpolates linearly between them. With the
+ * default size the table is the same as the texture used for rendering, larger tables reduce the
+ * difference to TransferFunction::sample. The table is a copy and stays valid if the transfer
+ * function changes, it can be sampled concurrently from several threads.
+ */
+class IVW_CORE_API TFLookupTable {
+public:
+    /**
+     * Create a lookup table of the given size, if size is 0 the texture size of the transfer
+     * function is used and its already computed colors are copied.
+     */
+    explicit TFLookupTable(const TransferFunction& tf, size_t size = 0);
+
+    /**
+     * Sample the table at position v with linear interpolation. The range of the table is [0,1],
+     * positions outside are clamped.
+     */
+    vec4 sample(double v) const {
+        // The comparisons are written such that NaN is mapped to 0
+        const double x = (v > 0.0 ? (v < 1.0 ? v : 1.0) : 0.0) * last_;
+        const auto i = static_cast<size_t>(x);
+        const auto j = i + (i < table_.size() - 1 ? 1 : 0);
+        return table_[i] + static_cast<float>(x - static_cast<double>(i)) * (table_[j] - table_[i]);
+    }
+    vec4 sample(float v) const { return sample(static_cast<double>(v)); }
+
+    /**
+     * Sample the table at all positions, colors has to be at least as large as positions.
+     */
+    void sample(util::span<const double> positions, util::span<vec4> colors) const;
+    void sample(util::span<const float> positions, util::span<vec4> colors) const;
+
+    size_t size() const { return table_.size(); }
+    const std::vector<vec4>& getTable() const { return table_; }
+
+private:
+    std::vector<vec4> table_;
+    double last_;  // Index of the last table entry
+};
+
+}  // namespace inviwo
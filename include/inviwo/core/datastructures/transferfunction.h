@@ -35,6 +35,8 @@
 #include <inviwo/core/datastructures/tfprimitiveset.h>
 #include <inviwo/core/util/fileextension.h>
 
+#include <tcb/span.hpp>
+
 namespace inviwo {
 
 class Layer;
@@ -93,6 +95,13 @@ public:
      */
     vec4 sample(float v) const;
 
+    /**
+     * Evaluate the transfer function at equidistant positions in [0,1], from 0 in the first to
+     * 1 in the last element of data, with zero opacity outside of the mask. This is how the
+     * texture of getData() is computed. Use a TFLookupTable to sample many values.
+     */
+    void interpolateAndStoreMaskedColors(util::span<vec4> data) const;
+
     friend bool operator==(const TransferFunction& lhs, const TransferFunction& rhs);
 
     virtual std::vector<FileExtension> getSupportedExtensions() const override;
@@ -0,0 +1,121 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2021 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#pragma once
+
+#include <inviwo/core/common/inviwocoredefine.h>
+
+#include <cstddef>
+#include <functional>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+
+namespace inviwo {
+
+class VolumeRAM;
+
+/**
+ * \ingroup datastructures
+ * \brief A thread safe least recently used cache of volume bricks with a memory budget.
+ *
+ * Bricks are identified by an owner id and a brick index, see VolumeBrickedRAM. When the total
+ * size of the cached bricks exceeds the budget the least recently used bricks are evicted. The
+ * most recently requested brick is always kept, even if it alone is larger than the budget.
+ * Evicted bricks stay alive as long as someone holds on to them.
+ */
+class IVW_CORE_API VolumeBrickCache {
+public:
+    using Loader = std::function<std::shared_ptr<const VolumeRAM>()>;
+
+    static constexpr size_t defaultMemoryBudget = size_t{1} << 30;
+
+    explicit VolumeBrickCache(size_t memoryBudget = defaultMemoryBudget);
+    VolumeBrickCache(const VolumeBrickCache&) = delete;
+    VolumeBrickCache& operator=(const VolumeBrickCache&) = delete;
+    ~VolumeBrickCache();
+
+    /**
+     * Get the brick `brick` of `owner`. If the brick is not in the cache `loader` is called to
+     * load it. The cache is not locked while loading, so several bricks can be loaded
+     * concurrently.
+     */
+    std::shared_ptr<const VolumeRAM> get(size_t owner, size_t brick, const Loader& loader);
+
+    /**
+     * Remove all bricks of `owner` from the cache
+     */
+    void erase(size_t owner);
+    void clear();
+
+    /**
+     * Set the memory budget in bytes, evicts bricks until the cache fits the new budget
+     */
+    void setMemoryBudget(size_t bytes);
+    size_t getMemoryBudget() const;
+    /**
+     * The number of bytes used by the cached bricks
+     */
+    size_t getMemoryUsage() const;
+    /**
+     * The number of cached bricks
+     */
+    size_t size() const;
+
+    /**
+     * A cache shared by all bricked volumes that do not specify a cache of their own
+     */
+    static std::shared_ptr<VolumeBrickCache> getShared();
+
+private:
+    struct Key {
+        size_t owner;
+        size_t brick;
+        bool operator==(const Key& rhs) const { return owner == rhs.owner && brick == rhs.brick; }
+    };
+    struct KeyHash {
+        size_t operator()(const Key& key) const;
+    };
+    struct Entry {
+        Key key;
+        std::shared_ptr<const VolumeRAM> brick;
+        size_t bytes;
+    };
+
+    void evict();
+
+    mutable std::mutex mutex_;
+    size_t memoryBudget_;
+    size_t memoryUsage_;
+    std::list<Entry> entries_;  // Ordered from most to least recently used
+    std::unordered_map<Key, std::list<Entry>::iterator, KeyHash> index_;
+};
+
+}  // namespace inviwo
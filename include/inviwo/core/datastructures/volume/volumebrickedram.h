@@ -0,0 +1,174 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2021 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#pragma once
+
+#include <inviwo/core/common/inviwocoredefine.h>
+#include <inviwo/core/datastructures/volume/volumerepresentation.h>
+#include <inviwo/core/datastructures/volume/volumebrickcache.h>
+#include <inviwo/core/util/glm.h>
+
+#include <memory>
+
+namespace inviwo {
+
+class VolumeRAM;
+class VolumeBrickedRAM;
+
+/**
+ * \ingroup datastructures
+ * \brief Loads the bricks of a VolumeBrickedRAM on demand
+ */
+class IVW_CORE_API VolumeBrickLoader {
+public:
+    virtual ~VolumeBrickLoader() = default;
+    /**
+     * Load brick `brick` of `volume`. The returned VolumeRAM should have the dimensions
+     * `volume.getBrickExtent(brick)` and the data format of `volume`.
+     */
+    virtual std::shared_ptr<VolumeRAM> loadBrick(const VolumeBrickedRAM& volume,
+                                                 size3_t brick) const = 0;
+};
+
+/**
+ * \ingroup datastructures
+ * \brief A brick loader that copies the bricks from a VolumeRAM.
+ * Used when converting a VolumeRAM into a VolumeBrickedRAM.
+ */
+class IVW_CORE_API VolumeRAMBrickLoader : public VolumeBrickLoader {
+public:
+    VolumeRAMBrickLoader(std::shared_ptr<const VolumeRAM> source);
+    virtual std::shared_ptr<VolumeRAM> loadBrick(const VolumeBrickedRAM& volume,
+                                                 size3_t brick) const override;
+
+private:
+    std::shared_ptr<const VolumeRAM> source_;
+};
+
+/**
+ * \ingroup datastructures
+ * \brief A read only volume representation split into bricks that are loaded on demand.
+ *
+ * The volume is divided into bricks of `getBrickSize()` voxels, the bricks along the upper
+ * borders are clipped to the volume dimensions. Bricks are loaded by a VolumeBrickLoader and kept
+ * in a VolumeBrickCache, which evicts the least recently used bricks when its memory budget is
+ * exceeded. That makes it possible to work on subregions of volumes larger than the available
+ * memory, as long as one only asks for the bricks or regions that are needed.
+ *
+ * Converting to a VolumeRAM will load the whole volume.
+ * @see VolumeBrickLoader, VolumeBrickCache, util::BrickIterator
+ */
+class IVW_CORE_API VolumeBrickedRAM : public VolumeRepresentation {
+public:
+    static constexpr size3_t defaultBrickSize{64, 64, 64};
+
+    VolumeBrickedRAM(std::shared_ptr<const VolumeBrickLoader> loader, size3_t dimensions,
+                     size3_t brickSize = defaultBrickSize,
+                     const DataFormatBase* format = DataUInt8::get(),
+                     const SwizzleMask& swizzleMask = swizzlemasks::rgba,
+                     InterpolationType interpolation = InterpolationType::Linear,
+                     const Wrapping3D& wrapping = wrapping3d::clampAll,
+                     std::shared_ptr<VolumeBrickCache> cache = VolumeBrickCache::getShared());
+    VolumeBrickedRAM(const VolumeBrickedRAM& rhs);
+    VolumeBrickedRAM& operator=(const VolumeBrickedRAM& that);
+    virtual VolumeBrickedRAM* clone() const override;
+    virtual ~VolumeBrickedRAM();
+
+    virtual std::type_index getTypeIndex() const override final;
+
+    /**
+     * Change the dimensions, drops all cached bricks of this volume. The loader has to be able to
+     * provide the bricks for the new dimensions.
+     */
+    virtual void setDimensions(size3_t dimensions) override;
+    virtual const size3_t& getDimensions() const override;
+
+    /**
+     * \brief update the swizzle mask of the color channels when sampling the volume
+     *
+     * @param mask new swizzle mask
+     */
+    virtual void setSwizzleMask(const SwizzleMask& mask) override;
+    virtual SwizzleMask getSwizzleMask() const override;
+
+    virtual void setInterpolation(InterpolationType interpolation) override;
+    virtual InterpolationType getInterpolation() const override;
+
+    virtual void setWrapping(const Wrapping3D& wrapping) override;
+    virtual Wrapping3D getWrapping() const override;
+
+    const size3_t& getBrickSize() const;
+    /**
+     * The number of bricks along each axis
+     */
+    size3_t getNumberOfBricks() const;
+    /**
+     * The voxel position of the lower corner of `brick`
+     */
+    size3_t getBrickOffset(size3_t brick) const;
+    /**
+     * The dimensions of `brick`, equal to the brick size except for bricks along the upper
+     * borders
+     */
+    size3_t getBrickExtent(size3_t brick) const;
+
+    /**
+     * Get a brick from the cache, loading it if needed
+     */
+    std::shared_ptr<const VolumeRAM> getBrick(size3_t brick) const;
+
+    /**
+     * Assemble the region [offset, offset + extent) into a new VolumeRAM, only the bricks
+     * overlapping the region are loaded.
+     * @throw Exception if the region is not inside the volume
+     */
+    std::shared_ptr<VolumeRAM> getRegion(size3_t offset, size3_t extent) const;
+
+    const std::shared_ptr<const VolumeBrickLoader>& getLoader() const;
+    /**
+     * Replace the loader, drops all cached bricks of this volume
+     */
+    void setLoader(std::shared_ptr<const VolumeBrickLoader> loader);
+
+    const std::shared_ptr<VolumeBrickCache>& getCache() const;
+
+private:
+    static size_t newId();
+
+    size_t id_;
+    std::shared_ptr<const VolumeBrickLoader> loader_;
+    std::shared_ptr<VolumeBrickCache> cache_;
+    size3_t dimensions_;
+    size3_t brickSize_;
+    SwizzleMask swizzleMask_;
+    InterpolationType interpolation_;
+    Wrapping3D wrapping_;
+};
+
+}  // namespace inviwo
@@ -34,6 +34,7 @@
 #include <inviwo/core/datastructures/volume/volumeram.h>
 #include <inviwo/core/datastructures/volume/volumedisk.h>
 #include <inviwo/core/datastructures/volume/volumeramprecision.h>
+#include <inviwo/core/datastructures/volume/volumebrickedram.h>
 
 namespace inviwo {
 
@@ -46,4 +47,28 @@ public:
                         std::shared_ptr<VolumeRAM> destination) const override;
 };
 
+/**
+ * Loads all the bricks of the VolumeBrickedRAM into a single VolumeRAM
+ */
+class IVW_CORE_API VolumeBrickedRAM2RAMConverter
+    : public RepresentationConverterType<VolumeRepresentation, VolumeBrickedRAM, VolumeRAM> {
+public:
+    virtual std::shared_ptr<VolumeRAM> createFrom(
+        std::shared_ptr<const VolumeBrickedRAM> source) const override;
+    virtual void update(std::shared_ptr<const VolumeBrickedRAM> source,
+                        std::shared_ptr<VolumeRAM> destination) const override;
+};
+
+/**
+ * Creates a VolumeBrickedRAM that copies its bricks from the VolumeRAM on demand
+ */
+class IVW_CORE_API VolumeRAM2BrickedRAMConverter
+    : public RepresentationConverterType<VolumeRepresentation, VolumeRAM, VolumeBrickedRAM> {
+public:
+    virtual std::shared_ptr<VolumeBrickedRAM> createFrom(
+        std::shared_ptr<const VolumeRAM> source) const override;
+    virtual void update(std::shared_ptr<const VolumeRAM> source,
+                        std::shared_ptr<VolumeBrickedRAM> destination) const override;
+};
+
 }  // namespace inviwo
@@ -33,6 +33,11 @@
 #include <inviwo/core/util/glm.h>
 #include <inviwo/core/util/stdextensions.h>
 
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include <mutex>
+
 namespace inviwo {
 
 /**
@@ -51,6 +56,18 @@ public:
                        const SwizzleMask& swizzleMask = swizzlemasks::rgba,
                        InterpolationType interpolation = InterpolationType::Linear,
                        const Wrapping3D& wrapping = wrapping3d::clampAll);
+    /**
+     * Create a volume using read only data kept alive by \p owner, for example a memory mapped
+     * file. The data is copied into an owned buffer the first time it is accessed through any of
+     * the non const functions returning or modifying the data. The copy is made once even if
+     * several threads edit the volume concurrently, and the owner is kept alive until the data is
+     * replaced, such that pointers from the const functions stay valid. Copies of the volume share
+     * the data as well.
+     */
+    VolumeRAMPrecision(const T* data, std::shared_ptr<const void> owner, size3_t dimensions,
+                       const SwizzleMask& swizzleMask = swizzlemasks::rgba,
+                       InterpolationType interpolation = InterpolationType::Linear,
+                       const Wrapping3D& wrapping = wrapping3d::clampAll);
     VolumeRAMPrecision(const VolumeRAMPrecision<T>& rhs);
     VolumeRAMPrecision<T>& operator=(const VolumeRAMPrecision<T>& that);
     virtual VolumeRAMPrecision<T>* clone() const override;
@@ -69,6 +86,16 @@ public:
 
     virtual void removeDataOwnership() override;
 
+    /**
+     * Replace the data with read only data kept alive by \p owner, see the constructor taking an
+     * owner.
+     */
+    void setSharedData(const T* data, std::shared_ptr<const void> owner, size3_t dimensions);
+    /**
+     * True if the data is read only data kept alive by an owner and has not been copied yet
+     */
+    bool hasSharedData() const;
+
     virtual const size3_t& getDimensions() const override;
     virtual void setDimensions(size3_t dimensions) override;
 
@@ -109,9 +136,17 @@ public:
     virtual size_t getNumberOfBytes() const override;
 
 private:
+    /**
+     * Copy shared data into an owned buffer before it gets modified, thread safe
+     */
+    void detach();
+
     size3_t dimensions_;
     bool ownsDataPtr_;
     std::unique_ptr<T[]> data_;
+    std::shared_ptr<const void> sharedOwner_;
+    std::atomic<bool> shared_;  // data_ points to the data of sharedOwner_
+    mutable std::mutex detachMutex_;
     SwizzleMask swizzleMask_;
     InterpolationType interpolation_;
     Wrapping3D wrapping_;
@@ -143,6 +178,7 @@ VolumeRAMPrecision<T>::VolumeRAMPrecision(size3_t dimensions, const SwizzleMask&
     , dimensions_(dimensions)
     , ownsDataPtr_(true)
     , data_(new T[dimensions_.x * dimensions_.y * dimensions_.z]())
+    , shared_{false}
     , swizzleMask_(swizzleMask)
     , interpolation_{interpolation}
     , wrapping_{wrapping} {}
@@ -156,6 +192,22 @@ VolumeRAMPrecision<T>::VolumeRAMPrecision(T* data, size3_t dimensions,
     , dimensions_(dimensions)
     , ownsDataPtr_(true)
     , data_(data ? data : new T[dimensions_.x * dimensions_.y * dimensions_.z]())
+    , shared_{false}
+    , swizzleMask_(swizzleMask)
+    , interpolation_{interpolation}
+    , wrapping_{wrapping} {}
+
+template <typename T>
+VolumeRAMPrecision<T>::VolumeRAMPrecision(const T* data, std::shared_ptr<const void> owner,
+                                          size3_t dimensions, const SwizzleMask& swizzleMask,
+                                          InterpolationType interpolation,
+                                          const Wrapping3D& wrapping)
+    : VolumeRAM(DataFormat<T>::get())
+    , dimensions_(dimensions)
+    , ownsDataPtr_(false)
+    , data_(const_cast<T*>(data))
+    , sharedOwner_(std::move(owner))
+    , shared_{true}
     , swizzleMask_(swizzleMask)
     , interpolation_{interpolation}
     , wrapping_{wrapping} {}
@@ -165,24 +217,46 @@ VolumeRAMPrecision<T>::VolumeRAMPrecision(const VolumeRAMPrecision<T>& rhs)
     : VolumeRAM(rhs)
     , dimensions_(rhs.dimensions_)
     , ownsDataPtr_(true)
-    , data_(new T[dimensions_.x * dimensions_.y * dimensions_.z])
+    , data_()
+    , sharedOwner_()
+    , shared_{false}
     , swizzleMask_(rhs.swizzleMask_)
     , interpolation_{rhs.interpolation_}
     , wrapping_{rhs.wrapping_} {
-    std::memcpy(data_.get(), rhs.data_.get(),
-                dimensions_.x * dimensions_.y * dimensions_.z * sizeof(T));
+    std::scoped_lock lock{rhs.detachMutex_};
+    if (rhs.shared_) {
+        ownsDataPtr_ = false;
+        data_.reset(rhs.data_.get());
+        sharedOwner_ = rhs.sharedOwner_;
+        shared_ = true;
+    } else {
+        data_.reset(new T[dimensions_.x * dimensions_.y * dimensions_.z]);
+        std::memcpy(data_.get(), rhs.data_.get(),
+                    dimensions_.x * dimensions_.y * dimensions_.z * sizeof(T));
+    }
 }
 
 template <typename T>
 VolumeRAMPrecision<T>& VolumeRAMPrecision<T>::operator=(const VolumeRAMPrecision<T>& that) {
     if (this != &that) {
         VolumeRAM::operator=(that);
+        std::unique_lock lock{that.detachMutex_};
         auto dim = that.dimensions_;
-        auto data = std::make_unique<T[]>(dim.x * dim.y * dim.z);
-        std::memcpy(data.get(), that.data_.get(), dim.x * dim.y * dim.z * sizeof(T));
-        data_.swap(data);
-        std::swap(dim, dimensions_);
-        ownsDataPtr_ = true;
+        if (that.shared_) {
+            auto owner = that.sharedOwner_;
+            const T* data = that.data_.get();
+            lock.unlock();
+            setSharedData(data, std::move(owner), dim);
+        } else {
+            auto data = std::make_unique<T[]>(dim.x * dim.y * dim.z);
+            std::memcpy(data.get(), that.data_.get(), dim.x * dim.y * dim.z * sizeof(T));
+            data_.swap(data);
+            std::swap(dim, dimensions_);
+            if (!ownsDataPtr_) data.release();
+            ownsDataPtr_ = true;
+            sharedOwner_.reset();
+            shared_ = false;
+        }
         swizzleMask_ = that.swizzleMask_;
         interpolation_ = that.interpolation_;
         wrapping_ = that.wrapping_;
@@ -207,11 +281,13 @@ const T* inviwo::VolumeRAMPrecision<T>::getDataTyped() const {
 
 template <typename T>
 T* inviwo::VolumeRAMPrecision<T>::getDataTyped() {
+    detach();
     return data_.get();
 }
 
 template <typename T>
 void* VolumeRAMPrecision<T>::getData() {
+    detach();
     return data_.get();
 }
 template <typename T>
@@ -221,6 +297,7 @@ const void* VolumeRAMPrecision<T>::getData() const {
 
 template <typename T>
 void* VolumeRAMPrecision<T>::getData(size_t pos) {
+    detach();
     return data_.get() + pos;
 }
 
@@ -237,13 +314,49 @@ void VolumeRAMPrecision<T>::setData(void* d, size3_t dimensions) {
 
     if (!ownsDataPtr_) data.release();
     ownsDataPtr_ = true;
+    sharedOwner_.reset();
+    shared_ = false;
 }
 
 template <typename T>
 void VolumeRAMPrecision<T>::removeDataOwnership() {
+    detach();
     ownsDataPtr_ = false;
 }
 
+template <typename T>
+void VolumeRAMPrecision<T>::setSharedData(const T* data, std::shared_ptr<const void> owner,
+                                          size3_t dimensions) {
+    std::unique_ptr<T[]> old(const_cast<T*>(data));
+    data_.swap(old);
+    if (!ownsDataPtr_ || old.get() == data_.get()) old.release();
+    dimensions_ = dimensions;
+    ownsDataPtr_ = false;
+    sharedOwner_ = std::move(owner);
+    shared_ = true;
+}
+
+template <typename T>
+bool VolumeRAMPrecision<T>::hasSharedData() const {
+    return shared_;
+}
+
+template <typename T>
+void VolumeRAMPrecision<T>::detach() {
+    if (!shared_.load(std::memory_order_acquire)) return;
+
+    std::scoped_lock lock{detachMutex_};
+    if (!shared_.load(std::memory_order_relaxed)) return;
+    const auto size = dimensions_.x * dimensions_.y * dimensions_.z;
+    auto data = std::make_unique<T[]>(size);
+    std::copy(data_.get(), data_.get() + size, data.get());
+    data_.release();
+    data_ = std::move(data);
+    ownsDataPtr_ = true;
+    // Keep the owner, other threads may still read through pointers to the shared data
+    shared_.store(false, std::memory_order_release);
+}
+
 template <typename T>
 const size3_t& VolumeRAMPrecision<T>::getDimensions() const {
     return dimensions_;
@@ -262,6 +375,8 @@ void VolumeRAMPrecision<T>::setDimensions(size3_t dimensions) {
         dimensions_ = dimensions;
         if (!ownsDataPtr_) data.release();
         ownsDataPtr_ = true;
+        sharedOwner_.reset();
+        shared_ = false;
     }
 }
 
@@ -317,21 +432,25 @@ dvec4 VolumeRAMPrecision<T>::getAsDVec4(const size3_t& pos) const {
 
 template <typename T>
 void VolumeRAMPrecision<T>::setFromDouble(const size3_t& pos, double val) {
+    detach();
     data_[posToIndex(pos, dimensions_)] = util::glm_convert<T>(val);
 }
 
 template <typename T>
 void VolumeRAMPrecision<T>::setFromDVec2(const size3_t& pos, dvec2 val) {
+    detach();
     data_[posToIndex(pos, dimensions_)] = util::glm_convert<T>(val);
 }
 
 template <typename T>
 void VolumeRAMPrecision<T>::setFromDVec3(const size3_t& pos, dvec3 val) {
+    detach();
     data_[posToIndex(pos, dimensions_)] = util::glm_convert<T>(val);
 }
 
 template <typename T>
 void VolumeRAMPrecision<T>::setFromDVec4(const size3_t& pos, dvec4 val) {
+    detach();
     data_[posToIndex(pos, dimensions_)] = util::glm_convert<T>(val);
 }
 
@@ -357,21 +476,25 @@ dvec4 VolumeRAMPrecision<T>::getAsNormalizedDVec4(const size3_t& pos) const {
 
 template <typename T>
 void VolumeRAMPrecision<T>::setFromNormalizedDouble(const size3_t& pos, double val) {
+    detach();
     data_[posToIndex(pos, dimensions_)] = util::glm_convert_normalized<T>(val);
 }
 
 template <typename T>
 void VolumeRAMPrecision<T>::setFromNormalizedDVec2(const size3_t& pos, dvec2 val) {
+    detach();
     data_[posToIndex(pos, dimensions_)] = util::glm_convert_normalized<T>(val);
 }
 
 template <typename T>
 void VolumeRAMPrecision<T>::setFromNormalizedDVec3(const size3_t& pos, dvec3 val) {
+    detach();
     data_[posToIndex(pos, dimensions_)] = util::glm_convert_normalized<T>(val);
 }
 
 template <typename T>
 void VolumeRAMPrecision<T>::setFromNormalizedDVec4(const size3_t& pos, dvec4 val) {
+    detach();
     data_[posToIndex(pos, dimensions_)] = util::glm_convert_normalized<T>(val);
 }
 
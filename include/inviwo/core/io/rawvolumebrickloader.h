@@ -0,0 +1,72 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2021 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#pragma once
+
+#include <inviwo/core/common/inviwocoredefine.h>
+#include <inviwo/core/datastructures/volume/volumebrickedram.h>
+
+#include <string>
+
+namespace inviwo {
+
+/**
+ * \class RawVolumeBrickLoader
+ * \brief Loads the bricks of a VolumeBrickedRAM from a bricked raw file.
+ *
+ * In a bricked raw file the bricks are stored one after another, ordered by x, then y, then z
+ * brick index. Each brick is stored as a contiguous block of its own, linearized in x, then y,
+ * then z. The bricks along the upper borders are clipped to the volume dimensions, i.e. the file
+ * contains no padding and has the same size as an unbricked raw file.
+ * @see util::brickedRawOffset, IvfVolumeReader
+ */
+class IVW_CORE_API RawVolumeBrickLoader : public VolumeBrickLoader {
+public:
+    RawVolumeBrickLoader(const std::string& rawFile, size_t offset, bool littleEndian);
+    virtual std::shared_ptr<VolumeRAM> loadBrick(const VolumeBrickedRAM& volume,
+                                                 size3_t brick) const override;
+
+private:
+    std::string rawFile_;
+    size_t offset_;
+    bool littleEndian_;
+};
+
+namespace util {
+
+/**
+ * The position, in number of voxels from the start of the data, of `brick` in a bricked raw file
+ * with volume dimensions `dims` and brick size `brickSize`.
+ * @see RawVolumeBrickLoader
+ */
+IVW_CORE_API size_t brickedRawOffset(size3_t dims, size3_t brickSize, size3_t brick);
+
+}  // namespace util
+
+}  // namespace inviwo
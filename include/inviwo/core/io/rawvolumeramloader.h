@@ -40,15 +40,27 @@
 
 namespace inviwo {
 
+class VolumeRAM;
+
+namespace util {
+class MemoryMappedFile;
+}
+
 /**
  * \class RawVolumeRAMLoader
  * \brief A loader of raw files. Used to create VolumeRAM representations.
  * This class us used by the DatVolumeSequenceReader, IvfVolumeReader and RawVolumeReader.
+ *
+ * Little endian files are memory mapped read only by default instead of being read into memory.
+ * The data is then loaded on demand and shared between processes. The VolumeRAM copies the data
+ * into memory the first time it is edited, the file is never changed. Falls back to reading the
+ * file if it can not be mapped.
  */
 
 class IVW_CORE_API RawVolumeRAMLoader : public DiskRepresentationLoader<VolumeRepresentation> {
 public:
-    RawVolumeRAMLoader(const std::string& rawFile, size_t offset, bool littleEndian);
+    RawVolumeRAMLoader(const std::string& rawFile, size_t offset, bool littleEndian,
+                       bool useMemoryMapping = true);
     virtual RawVolumeRAMLoader* clone() const override;
     virtual std::shared_ptr<VolumeRepresentation> createRepresentation(
         const VolumeRepresentation& src) const override;
@@ -56,9 +68,17 @@ public:
                                       const VolumeRepresentation& src) const override;
 
 private:
+    /**
+     * Map the data of the file read only, returns nullptr if the data can not be used as is or
+     * the file can not be mapped
+     */
+    std::shared_ptr<const util::MemoryMappedFile> map(const VolumeRepresentation& src,
+                                                      size_t size) const;
+
     std::string rawFile_;
     size_t offset_;
     bool littleEndian_;
+    bool useMemoryMapping_;
 };
 
 }  // namespace inviwo
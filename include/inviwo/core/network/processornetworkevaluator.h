@@ -34,12 +34,26 @@
 #include <inviwo/core/processors/processorobserver.h>
 #include <inviwo/core/network/processornetworkevaluationobserver.h>
 #include <inviwo/core/network/evaluationerrorhandler.h>
+#include <inviwo/core/util/dynamictopologicalorder.h>
+
+#include <exception>
+#include <memory>
 
 namespace inviwo {
 
+class EvaluationTrace;
 class Processor;
 class ProcessorNetwork;
 
+/**
+ * Sequential: all processors are evaluated one at a time in topological order on the main thread.
+ * Parallel: processors tagged with Tag::Concurrent, and without Tag::GL, are processed on the
+ * thread pool as soon as all their predecessors are done. Processors of independent branches can
+ * hence be processed concurrently. All other processors, as well as the preparation before and
+ * the notifications after processing, stay on the main thread.
+ */
+enum class EvaluationMode { Sequential, Parallel };
+
 class IVW_CORE_API ProcessorNetworkEvaluator : public ProcessorNetworkObserver,
                                                public ProcessorObserver,
                                                public ProcessorNetworkEvaluationObservable {
@@ -50,6 +64,22 @@ public:
     virtual ~ProcessorNetworkEvaluator() = default;
     void setExceptionHandler(EvaluationErrorHandler handler);
 
+    /**
+     * Set the evaluation mode, the default is EvaluationMode::Sequential. The parallel mode falls
+     * back to sequential evaluation when the thread pool has no threads.
+     * @see EvaluationMode
+     */
+    void setEvaluationMode(EvaluationMode mode);
+    EvaluationMode getEvaluationMode() const;
+
+    /**
+     * The trace of the time spent in the evaluations of the network, in initializeResources,
+     * inport onChange, and process of each processor, and in background jobs of PoolProcessors.
+     * Tracing is disabled by default.
+     * @see EvaluationTrace
+     */
+    std::shared_ptr<EvaluationTrace> getTrace() const;
+
 private:
     // ProcessorNetworkObserver overrides
     virtual void onProcessorNetworkEvaluateRequest() override;
@@ -65,12 +95,36 @@ private:
 
     void requestEvaluate();
     void evaluate();
+    /**
+     * Update processorsSorted_ from the topological order of all processors, keeping the
+     * processors that lead to a sink through active connections.
+     */
+    void updateSorted();
+    void evaluateSequential();
+    void evaluateParallel();
+
+    /**
+     * Initialize resources, call inport onChange callbacks, and notify observers. Calls
+     * doIfNotReady if the processor is not ready.
+     * @return true if the processor should be processed.
+     */
+    bool prepareProcess(Processor* processor);
+    /**
+     * Set the processor valid if processing succeeded and notify observers.
+     * @param error an exception thrown by Processor::process if any.
+     */
+    void finishProcess(Processor* processor, std::exception_ptr error);
 
     ProcessorNetwork* processorNetwork_;
-    // the sorted list of processors obtained through topological sorting
+    // topological order of all processors and connections, updated incrementally
+    util::DynamicTopologicalOrder<Processor*> order_;
+    // the sorted list of processors to evaluate, updated before the next evaluation if dirty
     std::vector<Processor*> processorsSorted_;
+    bool sortedDirty_;
     bool evaulationQueued_;
     EvaluationErrorHandler exceptionHandler_;
+    EvaluationMode evaluationMode_;
+    std::shared_ptr<EvaluationTrace> trace_;
 };
 
 }  // namespace inviwo
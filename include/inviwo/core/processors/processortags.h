@@ -64,6 +64,14 @@ public:
     static const Tag CPU;
     static const Tag PY;
 
+    /**
+     * Marks a processor that can be processed on the thread pool concurrently with other
+     * processors when the network is evaluated with EvaluationMode::Parallel. Its process function
+     * may only use its own ports and read its own properties. It may not modify properties, use
+     * OpenGL, or wait for the main thread.
+     */
+    static const Tag Concurrent;
+
 private:
     std::string tag_;
 };
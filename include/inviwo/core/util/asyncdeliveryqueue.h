@@ -0,0 +1,193 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2021 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#pragma once
+
+#include <inviwo/core/common/inviwocoredefine.h>
+#include <inviwo/core/util/mpscqueue.h>
+#include <inviwo/core/util/threadutil.h>
+
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <utility>
+
+namespace inviwo {
+
+namespace util {
+
+/**
+ * \brief Delivers elements pushed from any thread, in order, on a background thread
+ *
+ * Producers push elements into a util::MPSCQueue and only touch a mutex when the background thread
+ * is waiting for elements. flush waits until everything pushed before the call has been delivered.
+ * Once the queue is stopped, producers that still push deliver their elements themselves, one at a
+ * time, so no element is left in the queue.
+ */
+template <typename T>
+class AsyncDeliveryQueue {
+public:
+    AsyncDeliveryQueue(std::function<void(T&)> deliver, const std::string& threadName)
+        : deliver_{std::move(deliver)} {
+        thread_ = std::thread([this]() { run(); });
+        util::setThreadDescription(thread_, threadName);
+    }
+    AsyncDeliveryQueue(const AsyncDeliveryQueue&) = delete;
+    AsyncDeliveryQueue& operator=(const AsyncDeliveryQueue&) = delete;
+    ~AsyncDeliveryQueue() { stop(); }
+
+    void push(T element) {
+        // Count before linking, a count may run ahead of its element but never lag behind it.
+        // Otherwise a flush could see the count of a later element while an earlier linked one
+        // is still uncounted and return before its own element is delivered.
+        pushed_.fetch_add(1);
+        queue_.push(std::move(element));
+        if (stopped_.load()) {
+            // No background thread anymore. Either this sees stopped_ or the background thread
+            // sees the count above when it drains the queue. A push from within a delivery is
+            // picked up by the loop that is delivering.
+            if (delivering() != this) drain();
+        } else if (waiting_.load()) {
+            std::scoped_lock lock{mutex_};
+            wake_.notify_one();
+        }
+    }
+
+    /**
+     * Wait until all elements pushed before the call have been delivered. Returns directly if
+     * called from the delivering thread.
+     */
+    void flush() {
+        if (std::this_thread::get_id() == thread_.get_id()) return;
+        const auto target = pushed_.load();
+        // Register before checking the count, the delivering thread then either sees the waiter
+        // and notifies it, or has delivered the target already.
+        flushing_.fetch_add(1);
+        {
+            std::unique_lock lock{mutex_};
+            delivered_.wait(lock, [&]() { return deliveredCount_.load() >= target; });
+        }
+        flushing_.fetch_sub(1);
+    }
+
+    /**
+     * Deliver the queued elements and stop the background thread
+     */
+    void stop() {
+        if (!thread_.joinable()) return;
+        {
+            std::scoped_lock lock{mutex_};
+            stop_ = true;
+            wake_.notify_one();
+        }
+        thread_.join();
+    }
+
+private:
+    void run() {
+        for (;;) {
+            deliverQueued();
+            {
+                std::scoped_lock lock{mutex_};
+                delivered_.notify_all();
+            }
+
+            std::unique_lock lock{mutex_};
+            waiting_.store(true);
+            wake_.wait(lock, [&]() { return stop_ || pushed_.load() > deliveredCount_.load(); });
+            waiting_.store(false);
+            if (stop_) {
+                stopped_.store(true);
+                lock.unlock();
+                drain();
+                std::scoped_lock notifyLock{mutex_};
+                delivered_.notify_all();
+                return;
+            }
+        }
+    }
+
+    void drain() {
+        std::scoped_lock lock{drainMutex_};
+        deliverQueued();
+    }
+
+    //! The queue the current thread is delivering elements of, if any
+    static const AsyncDeliveryQueue*& delivering() {
+        thread_local const AsyncDeliveryQueue* queue = nullptr;
+        return queue;
+    }
+
+    void deliverQueued() {
+        struct Delivering {
+            explicit Delivering(const AsyncDeliveryQueue* queue)
+                : previous{std::exchange(delivering(), queue)} {}
+            ~Delivering() { delivering() = previous; }
+            const AsyncDeliveryQueue* previous;
+        } scope{this};
+        while (deliveredCount_.load() < pushed_.load()) {
+            auto element = queue_.pop();
+            if (!element) {
+                // A producer has counted its element but not linked it yet
+                std::this_thread::yield();
+                continue;
+            }
+            deliver_(*element);
+            deliveredCount_.fetch_add(1);
+            // Producers might keep the queue from running empty, wake flushes whose target
+            // has been reached without waiting for that.
+            if (flushing_.load() > 0) {
+                std::scoped_lock lock{mutex_};
+                delivered_.notify_all();
+            }
+        }
+    }
+
+    std::function<void(T&)> deliver_;
+    MPSCQueue<T> queue_;
+    std::atomic<size_t> pushed_{0};
+    std::atomic<size_t> deliveredCount_{0};
+    std::atomic<bool> waiting_{false};
+    std::atomic<size_t> flushing_{0};
+    std::atomic<bool> stopped_{false};  // Producers deliver their own elements
+
+    std::mutex mutex_;
+    std::condition_variable wake_;
+    std::condition_variable delivered_;
+    bool stop_ = false;
+    std::mutex drainMutex_;  // Serializes the deliveries after the queue is stopped
+    std::thread thread_;
+};
+
+}  // namespace util
+
+}  // namespace inviwo
@@ -0,0 +1,428 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2021 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#pragma once
+
+#include <inviwo/core/common/inviwocoredefine.h>
+
+#include <algorithm>
+#include <functional>
+#include <limits>
+#include <queue>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace inviwo {
+namespace util {
+
+/**
+ * Maintains a topological order of a directed graph while nodes and edges are added and removed,
+ * using the algorithm of Pearce and Kelly, "A Dynamic Topological Sort Algorithm for Directed
+ * Acyclic Graphs", 2006. Adding an edge that agrees with the current order is O(1), otherwise only
+ * the nodes in between the two end points of the edge in the order are visited and reordered.
+ * Removing nodes and edges never invalidates the order.
+ *
+ * Between beginBatch() and endBatch() added edges are only recorded, and the order is rebuilt once
+ * in O(N + M) by endBatch(), which is faster when adding many edges at once.
+ *
+ * Edges that would close a cycle are kept, but can not be respected by the order. hasCycle() will
+ * return true until the cycle is broken by removing an edge or a node.
+ * Adding the same edge several times is allowed, it is removed when removed the same number of
+ * times.
+ */
+template <typename T, typename Hash = std::hash<T>>
+class DynamicTopologicalOrder {
+public:
+    DynamicTopologicalOrder() = default;
+
+    /**
+     * Add a node to the end of the order, does nothing if the node already exists.
+     * @return true if the node was added.
+     */
+    bool addNode(const T& node);
+    /**
+     * Remove a node and all its edges.
+     * @return true if the node was found.
+     */
+    bool removeNode(const T& node);
+    bool hasNode(const T& node) const;
+
+    /**
+     * Add an edge, the nodes are added if they do not exist.
+     */
+    void addEdge(const T& from, const T& to);
+    /**
+     * Remove an edge added by addEdge, does nothing if the edge does not exist.
+     */
+    void removeEdge(const T& from, const T& to);
+    bool hasEdge(const T& from, const T& to) const;
+
+    void beginBatch();
+    void endBatch();
+    bool isBatching() const;
+
+    /**
+     * True if the edges contain a cycle, the order of the nodes involved is then arbitrary.
+     * While in a batch the value is only updated by endBatch().
+     */
+    bool hasCycle() const;
+
+    size_t size() const;
+    bool empty() const;
+    void clear();
+
+    /**
+     * Call @p callback for all nodes in topological order.
+     */
+    template <typename Callback>
+    void forEach(Callback&& callback) const;
+    std::vector<T> getOrder() const;
+
+private:
+    static constexpr size_t npos = std::numeric_limits<size_t>::max();
+
+    struct Node {
+        T value;
+        size_t ord;
+        // neighbour id -> number of edges
+        std::unordered_map<size_t, size_t> out;
+        std::unordered_map<size_t, size_t> in;
+    };
+
+    bool reorder(size_t from, size_t to);
+    void rebuild();
+    void compact();
+
+    std::vector<Node> nodes_;
+    std::vector<size_t> free_;
+    std::unordered_map<T, size_t, Hash> ids_;
+    // position -> node id, or npos for removed nodes
+    std::vector<size_t> order_;
+    size_t holes_ = 0;
+    bool batching_ = false;
+    bool dirty_ = false;
+    bool cycle_ = false;
+
+    // scratch space for reorder
+    std::vector<char> visited_;
+    std::vector<size_t> forward_;
+    std::vector<size_t> backward_;
+    std::vector<size_t> stack_;
+    std::vector<size_t> positions_;
+};
+
+template <typename T, typename Hash>
+bool DynamicTopologicalOrder<T, Hash>::addNode(const T& node) {
+    if (ids_.count(node) != 0) return false;
+
+    size_t id;
+    if (free_.empty()) {
+        id = nodes_.size();
+        nodes_.push_back(Node{node, order_.size(), {}, {}});
+        visited_.push_back(0);
+    } else {
+        id = free_.back();
+        free_.pop_back();
+        nodes_[id] = Node{node, order_.size(), {}, {}};
+    }
+    ids_.emplace(node, id);
+    order_.push_back(id);
+    return true;
+}
+
+template <typename T, typename Hash>
+bool DynamicTopologicalOrder<T, Hash>::removeNode(const T& node) {
+    auto it = ids_.find(node);
+    if (it == ids_.end()) return false;
+    const auto id = it->second;
+    ids_.erase(it);
+
+    auto& n = nodes_[id];
+    for (auto& [succ, count] : n.out) nodes_[succ].in.erase(id);
+    for (auto& [pred, count] : n.in) nodes_[pred].out.erase(id);
+    n.out.clear();
+    n.in.clear();
+
+    order_[n.ord] = npos;
+    n.ord = npos;
+    free_.push_back(id);
+    ++holes_;
+
+    if (cycle_ && !batching_) {
+        rebuild();
+    } else if (holes_ > 32 && holes_ > ids_.size()) {
+        compact();
+    }
+    return true;
+}
+
+template <typename T, typename Hash>
+bool DynamicTopologicalOrder<T, Hash>::hasNode(const T& node) const {
+    return ids_.count(node) != 0;
+}
+
+template <typename T, typename Hash>
+void DynamicTopologicalOrder<T, Hash>::addEdge(const T& from, const T& to) {
+    addNode(from);
+    addNode(to);
+    const auto f = ids_[from];
+    const auto t = ids_[to];
+
+    ++nodes_[t].in[f];
+    if (++nodes_[f].out[t] > 1) return;
+
+    if (batching_) {
+        dirty_ = true;
+    } else if (!cycle_ && nodes_[f].ord >= nodes_[t].ord) {
+        if (!reorder(f, t)) cycle_ = true;
+    }
+}
+
+template <typename T, typename Hash>
+void DynamicTopologicalOrder<T, Hash>::removeEdge(const T& from, const T& to) {
+    auto fit = ids_.find(from);
+    auto tit = ids_.find(to);
+    if (fit == ids_.end() || tit == ids_.end()) return;
+    const auto f = fit->second;
+    const auto t = tit->second;
+
+    auto& out = nodes_[f].out;
+    auto it = out.find(t);
+    if (it == out.end()) return;
+    if (--it->second == 0) out.erase(it);
+    auto& in = nodes_[t].in;
+    auto iit = in.find(f);
+    if (--iit->second == 0) in.erase(iit);
+
+    if (cycle_ && !batching_) rebuild();
+}
+
+template <typename T, typename Hash>
+bool DynamicTopologicalOrder<T, Hash>::hasEdge(const T& from, const T& to) const {
+    auto fit = ids_.find(from);
+    auto tit = ids_.find(to);
+    if (fit == ids_.end() || tit == ids_.end()) return false;
+    return nodes_[fit->second].out.count(tit->second) != 0;
+}
+
+template <typename T, typename Hash>
+void DynamicTopologicalOrder<T, Hash>::beginBatch() {
+    batching_ = true;
+}
+
+template <typename T, typename Hash>
+void DynamicTopologicalOrder<T, Hash>::endBatch() {
+    if (!batching_) return;
+    batching_ = false;
+    if (dirty_ || cycle_) rebuild();
+    dirty_ = false;
+}
+
+template <typename T, typename Hash>
+bool DynamicTopologicalOrder<T, Hash>::isBatching() const {
+    return batching_;
+}
+
+template <typename T, typename Hash>
+bool DynamicTopologicalOrder<T, Hash>::hasCycle() const {
+    return cycle_;
+}
+
+template <typename T, typename Hash>
+size_t DynamicTopologicalOrder<T, Hash>::size() const {
+    return ids_.size();
+}
+
+template <typename T, typename Hash>
+bool DynamicTopologicalOrder<T, Hash>::empty() const {
+    return ids_.empty();
+}
+
+template <typename T, typename Hash>
+void DynamicTopologicalOrder<T, Hash>::clear() {
+    nodes_.clear();
+    free_.clear();
+    ids_.clear();
+    order_.clear();
+    visited_.clear();
+    holes_ = 0;
+    dirty_ = false;
+    cycle_ = false;
+}
+
+template <typename T, typename Hash>
+template <typename Callback>
+void DynamicTopologicalOrder<T, Hash>::forEach(Callback&& callback) const {
+    for (auto id : order_) {
+        if (id != npos) callback(nodes_[id].value);
+    }
+}
+
+template <typename T, typename Hash>
+std::vector<T> DynamicTopologicalOrder<T, Hash>::getOrder() const {
+    std::vector<T> res;
+    res.reserve(size());
+    forEach([&](const T& node) { res.push_back(node); });
+    return res;
+}
+
+/**
+ * Restore the order after adding the edge from -> to where ord(to) < ord(from). Finds the nodes
+ * reachable from 'to' and the nodes reaching 'from' within the affected range of the order, and
+ * moves the latter in front of the former reusing their positions.
+ * @return false if the edge closes a cycle, the order is then unchanged
+ */
+template <typename T, typename Hash>
+bool DynamicTopologicalOrder<T, Hash>::reorder(size_t from, size_t to) {
+    const auto lower = nodes_[to].ord;
+    const auto upper = nodes_[from].ord;
+
+    const auto resetVisited = [&]() {
+        for (auto id : forward_) visited_[id] = 0;
+        for (auto id : backward_) visited_[id] = 0;
+    };
+
+    forward_.clear();
+    backward_.clear();
+    stack_.clear();
+
+    stack_.push_back(to);
+    visited_[to] = 1;
+    while (!stack_.empty()) {
+        const auto id = stack_.back();
+        stack_.pop_back();
+        forward_.push_back(id);
+        for (const auto& [succ, count] : nodes_[id].out) {
+            if (succ == from) {
+                for (auto s : stack_) visited_[s] = 0;
+                resetVisited();
+                return false;
+            }
+            if (!visited_[succ] && nodes_[succ].ord < upper) {
+                visited_[succ] = 1;
+                stack_.push_back(succ);
+            }
+        }
+    }
+
+    stack_.push_back(from);
+    visited_[from] = 1;
+    while (!stack_.empty()) {
+        const auto id = stack_.back();
+        stack_.pop_back();
+        backward_.push_back(id);
+        for (const auto& [pred, count] : nodes_[id].in) {
+            if (!visited_[pred] && nodes_[pred].ord > lower) {
+                visited_[pred] = 1;
+                stack_.push_back(pred);
+            }
+        }
+    }
+
+    const auto byOrd = [&](size_t a, size_t b) { return nodes_[a].ord < nodes_[b].ord; };
+    std::sort(forward_.begin(), forward_.end(), byOrd);
+    std::sort(backward_.begin(), backward_.end(), byOrd);
+
+    positions_.clear();
+    for (auto id : backward_) positions_.push_back(nodes_[id].ord);
+    for (auto id : forward_) positions_.push_back(nodes_[id].ord);
+    std::sort(positions_.begin(), positions_.end());
+
+    size_t i = 0;
+    for (auto id : backward_) {
+        nodes_[id].ord = positions_[i];
+        order_[positions_[i++]] = id;
+    }
+    for (auto id : forward_) {
+        nodes_[id].ord = positions_[i];
+        order_[positions_[i++]] = id;
+    }
+
+    resetVisited();
+    return true;
+}
+
+/**
+ * Recompute the order from scratch using Kahn's algorithm. Among the nodes that are ready, the one
+ * earliest in the previous order is taken first, to keep the order as stable as possible. Nodes on
+ * cycles are put last.
+ */
+template <typename T, typename Hash>
+void DynamicTopologicalOrder<T, Hash>::rebuild() {
+    std::vector<size_t> remaining(nodes_.size(), 0);
+    using Item = std::pair<size_t, size_t>;  // previous ord, id
+    std::priority_queue<Item, std::vector<Item>, std::greater<Item>> ready;
+    for (auto id : order_) {
+        if (id == npos) continue;
+        for (const auto& [pred, count] : nodes_[id].in) {
+            if (pred != id) ++remaining[id];
+        }
+        if (remaining[id] == 0 && nodes_[id].out.count(id) == 0) ready.emplace(nodes_[id].ord, id);
+    }
+
+    std::vector<size_t> order;
+    order.reserve(ids_.size());
+    while (!ready.empty()) {
+        const auto id = ready.top().second;
+        ready.pop();
+        order.push_back(id);
+        for (const auto& [succ, count] : nodes_[id].out) {
+            if (--remaining[succ] == 0 && nodes_[succ].out.count(succ) == 0) {
+                ready.emplace(nodes_[succ].ord, succ);
+            }
+        }
+    }
+
+    cycle_ = order.size() != ids_.size();
+    if (cycle_) {
+        for (auto id : order) visited_[id] = 1;
+        for (auto id : order_) {
+            if (id != npos && !visited_[id]) order.push_back(id);
+        }
+        for (auto id : order_) {
+            if (id != npos) visited_[id] = 0;
+        }
+    }
+
+    order_ = std::move(order);
+    holes_ = 0;
+    for (size_t i = 0; i < order_.size(); ++i) nodes_[order_[i]].ord = i;
+}
+
+template <typename T, typename Hash>
+void DynamicTopologicalOrder<T, Hash>::compact() {
+    order_.erase(std::remove(order_.begin(), order_.end(), npos), order_.end());
+    holes_ = 0;
+    for (size_t i = 0; i < order_.size(); ++i) nodes_[order_[i]].ord = i;
+}
+
+}  // namespace util
+
+}  // namespace inviwo
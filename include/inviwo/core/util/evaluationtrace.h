@@ -0,0 +1,191 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2021 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#pragma once
+
+#include <inviwo/core/common/inviwocoredefine.h>
+
+#include <atomic>
+#include <chrono>
+#include <iosfwd>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace inviwo {
+
+/**
+ * The kind of work measured by a TraceEvent
+ */
+enum class TraceEventType {
+    Evaluation,           ///< A complete evaluation of the processor network
+    InitializeResources,  ///< Processor::initializeResources
+    InportOnChange,       ///< The onChange callbacks of all changed inports of a processor
+    Process,              ///< Processor::process
+    BackgroundJob         ///< A job dispatched to the thread pool by a PoolProcessor
+};
+
+template <class Elem, class Traits>
+std::basic_ostream<Elem, Traits>& operator<<(std::basic_ostream<Elem, Traits>& ss,
+                                             TraceEventType type) {
+    switch (type) {
+        case TraceEventType::Evaluation:
+            ss << "Evaluation";
+            break;
+        case TraceEventType::InitializeResources:
+            ss << "InitializeResources";
+            break;
+        case TraceEventType::InportOnChange:
+            ss << "InportOnChange";
+            break;
+        case TraceEventType::Process:
+            ss << "Process";
+            break;
+        case TraceEventType::BackgroundJob:
+            ss << "BackgroundJob";
+            break;
+    }
+    return ss;
+}
+
+/**
+ * A single measurement recorded in an EvaluationTrace
+ */
+struct IVW_CORE_API TraceEvent {
+    TraceEventType type;
+    std::string name;  ///< Identifier of the processor, empty for TraceEventType::Evaluation
+    std::chrono::steady_clock::time_point start;
+    std::chrono::steady_clock::duration duration;
+    size_t thread;       ///< Sequential id of the thread, see EvaluationTrace::getThreadId
+    size_t conversions;  ///< Number of representation conversions
+    size_t bytes;        ///< Size in bytes of the representations created by the conversions
+};
+
+/**
+ * \brief Records the time spent in the network evaluation in a ring buffer
+ *
+ * The ProcessorNetworkEvaluator records one event for the evaluation of the network and one for
+ * each call to Processor::initializeResources, the inport onChange callbacks, and
+ * Processor::process. A PoolProcessor records one event for each of its background jobs. Every
+ * event also counts the representation conversions done by Data::getRepresentation, and the size
+ * of the representations created by them, on the thread of the event. For
+ * TraceEventType::Evaluation the conversions of all threads are counted, including background
+ * jobs that happen to run at the same time.
+ *
+ * Tracing is disabled by default, and only costs a check of a flag then. When the buffer is full
+ * the oldest events are overwritten. The events can be saved as a Chrome trace that can be opened
+ * in chrome://tracing or https://ui.perfetto.dev.
+ *
+ * \code{.cpp}
+ * auto trace = app->getProcessorNetworkEvaluator()->getTrace();
+ * trace->setEnabled(true);
+ * // ... evaluate the network
+ * trace->writeChromeTrace("trace.json");
+ * \endcode
+ */
+class IVW_CORE_API EvaluationTrace {
+public:
+    using clock = std::chrono::steady_clock;
+
+    explicit EvaluationTrace(size_t capacity = 10000);
+    EvaluationTrace(const EvaluationTrace&) = delete;
+    EvaluationTrace& operator=(const EvaluationTrace&) = delete;
+
+    void setEnabled(bool enabled);
+    bool isEnabled() const;
+
+    /**
+     * Set the maximum number of events, keeps the most recent events if there are more.
+     */
+    void setCapacity(size_t capacity);
+    size_t getCapacity() const;
+
+    /**
+     * Add an event, overwrites the oldest event if the buffer is full. Events are recorded even
+     * if the trace is disabled.
+     */
+    void record(TraceEvent event);
+
+    /**
+     * Get a copy of all events in the order they were recorded. Events are recorded when they
+     * finish, so a event can start before a previous one.
+     */
+    std::vector<TraceEvent> getEvents() const;
+    size_t size() const;
+    void clear();
+
+    /**
+     * Write all events in the Chrome trace event format (JSON), timestamps are in microseconds
+     * since the construction of the trace.
+     */
+    void writeChromeTrace(std::ostream& os) const;
+    void writeChromeTrace(std::string_view filename) const;
+
+    /**
+     * Measures the time from construction to destruction and records an event if the trace was
+     * enabled at construction.
+     */
+    class IVW_CORE_API Scope {
+    public:
+        Scope(EvaluationTrace& trace, TraceEventType type, std::string_view name = {});
+        Scope(const Scope&) = delete;
+        Scope& operator=(const Scope&) = delete;
+        ~Scope();
+
+    private:
+        EvaluationTrace* trace_;
+        TraceEventType type_;
+        std::string name_;
+        clock::time_point start_;
+        size_t conversions_;
+        size_t bytes_;
+    };
+
+    /**
+     * Called by Data for every representation that is created or updated from another
+     * representation.
+     * @param bytes size of the new representation, zero if an existing one was updated
+     */
+    static void countConversion(size_t bytes);
+    /**
+     * A sequential id of the calling thread, assigned on first use.
+     */
+    static size_t getThreadId();
+
+private:
+    std::atomic<bool> enabled_;
+    const clock::time_point epoch_;
+    mutable std::mutex mutex_;
+    std::vector<TraceEvent> events_;
+    size_t capacity_;
+    size_t next_;  ///< where the next event goes once events_ is full
+};
+
+}  // namespace inviwo
@@ -32,6 +32,7 @@
 #include <inviwo/core/common/inviwocoredefine.h>
 #include <inviwo/core/common/inviwoapplication.h>
 #include <inviwo/core/util/settings/systemsettings.h>
+#include <inviwo/core/util/parallel.h>
 
 #include <utility>
 
@@ -122,23 +123,28 @@ std::vector<std::future<void>> forEachParallelAsync(const Iterable& iterable, Ca
  * Use multiple threads to iterate over all elements in an iterable data structure (such as
  * std::vector). If the Inviwo pool size is zero it will be executed directly in the same thread as
  * the caller.
- * The function will return once all jobs as has finished processing.
+ * The function will return once all jobs as has finished processing. The calling thread takes part
+ * in the work, hence it is safe to call from within a thread pool task, see util::parallelFor.
  *
  * @param iterable the data structure to iterate over
  * @param callback to call for each element, can be either `[](auto &a){}` or `[](auto &a,
  * size_t id){}` where `a` is an data item from the iterable data structure and `id` is the index in
  * the data structure
- * @param jobs optional parameter specifying how many jobs to create, if jobs==0 (default) it will
- * create pool size * 4 jobs
+ * @param jobs optional parameter specifying how many jobs to create, if jobs==0 (default) the
+ * number of jobs is chosen based on the pool size
  */
 template <typename Iterable, typename Callback>
 void forEachParallel(const Iterable& iterable, Callback&& callback, size_t jobs = 0) {
-    const auto futures =
-        forEachParallelAsync<Iterable, Callback>(iterable, std::forward<Callback>(callback), jobs);
-
-    for (const auto& e : futures) {
-        e.wait();
-    }
+    const size_t size = iterable.size();
+    const size_t grainSize = jobs == 0 ? 0 : (size + jobs - 1) / jobs;
+
+    parallelFor(
+        0, size,
+        [&](size_t start, size_t end) {
+            auto c = callback;
+            detail::foreach (std::begin(iterable) + start, std::begin(iterable) + end, c, start);
+        },
+        grainSize);
 }
 
 }  // namespace util
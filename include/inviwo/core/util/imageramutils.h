@@ -35,6 +35,7 @@
 #include <inviwo/core/datastructures/image/image.h>
 #include <inviwo/core/datastructures/image/layer.h>
 #include <inviwo/core/datastructures/image/layerram.h>
+#include <inviwo/core/util/parallel.h>
 
 #include <memory>
 #include <vector>
@@ -44,10 +45,6 @@ namespace inviwo {
 
 namespace util {
 
-namespace detail {
-IVW_CORE_API size_t getPoolSize();
-}
-
 template <typename C>
 void forEachPixel(const size2_t dims, C callback) {
     size2_t pos;
@@ -63,35 +60,30 @@ void forEachPixel(const LayerRAM& layer, C callback) {
     forEachPixel(layer.getDimensions(), callback);
 }
 
+/**
+ * Call callback for each pixel position using multiple threads. The layer is split along rows and
+ * processed using util::parallelFor, hence the calling thread takes part in the work and it is
+ * safe to call from within a thread pool task.
+ * @param dims dimensions of the layer
+ * @param callback functor called with each `const size2_t&` pixel position
+ * @param jobs optional parameter specifying how many jobs to create, if jobs==0 (default) the
+ * number of jobs is chosen based on the pool size
+ */
 template <typename C>
 void forEachPixelParallel(const size2_t dims, C callback, size_t jobs = 0) {
-    if (jobs == 0) {
-        jobs = 4 * detail::getPoolSize();
-        if (jobs == 0) {  // if poolsize is zero
-            forEachPixel(dims, callback);
-            return;
-        }
-    }
-
-    std::vector<std::future<void>> futures;
-    for (size_t job = 0; job < jobs; ++job) {
-        size2_t start = size2_t(0, job * dims.y / jobs);
-        size2_t stop = size2_t(dims.x, std::min(dims.y, (job + 1) * dims.y / jobs));
+    const size_t grainSize = jobs == 0 ? 0 : (dims.y + jobs - 1) / jobs;
 
-        futures.push_back(dispatchPool([&callback, start, stop]() {
+    parallelFor(
+        0, dims.y,
+        [&](size_t begin, size_t end) {
             size2_t pos{0};
-
-            for (pos.y = start.y; pos.y < stop.y; ++pos.y) {
-                for (pos.x = start.x; pos.x < stop.x; ++pos.x) {
+            for (pos.y = begin; pos.y < end; ++pos.y) {
+                for (pos.x = 0; pos.x < dims.x; ++pos.x) {
                     callback(pos);
                 }
             }
-        }));
-    }
-
-    for (const auto& e : futures) {
-        e.wait();
-    }
+        },
+        grainSize);
 }
 
 template <typename C>
@@ -34,10 +34,23 @@
 #include <inviwo/core/util/exception.h>
 #include <inviwo/core/util/stringconversion.h>
 
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <memory>
+#include <mutex>
 #include <ostream>
 #include <string>
+#include <tuple>
+#include <type_traits>
+#include <unordered_map>
 #include <vector>
 
+#include <warn/push>
+#include <warn/ignore/all>
+#include <fmt/format.h>
+#include <warn/pop>
+
 namespace inviwo {
 
 class Processor;
@@ -143,6 +156,13 @@ std::basic_ostream<Elem, Traits>& operator<<(std::basic_ostream<Elem, Traits>& s
                            __FUNCTION__, __LINE__);                                       \
     }
 
+#define LogFormatSpecial(logger, logLevel, ...)                                                \
+    {                                                                                         \
+        logger->logFormat(inviwo::parseTypeIdName(std::string(typeid(this).name())), logLevel, \
+                          inviwo::LogAudience::Developer, __FILE__, __FUNCTION__, __LINE__,    \
+                          __VA_ARGS__);                                                       \
+    }
+
 #define LogInfo(message) \
     { LogSpecial(inviwo::LogCentral::getPtr(), inviwo::LogLevel::Info, message) }
 #define LogWarn(message) \
@@ -150,6 +170,15 @@ std::basic_ostream<Elem, Traits>& operator<<(std::basic_ostream<Elem, Traits>& s
 #define LogError(message) \
     { LogSpecial(inviwo::LogCentral::getPtr(), inviwo::LogLevel::Error, message) }
 
+// Log using a fmt format string and arguments, i.e. LogInfoFormat("{} of {}", i, n). The message
+// is only formatted if it passes the verbosity, and on the logging thread in asynchronous mode.
+#define LogInfoFormat(...) \
+    { LogFormatSpecial(inviwo::LogCentral::getPtr(), inviwo::LogLevel::Info, __VA_ARGS__) }
+#define LogWarnFormat(...) \
+    { LogFormatSpecial(inviwo::LogCentral::getPtr(), inviwo::LogLevel::Warn, __VA_ARGS__) }
+#define LogErrorFormat(...) \
+    { LogFormatSpecial(inviwo::LogCentral::getPtr(), inviwo::LogLevel::Error, __VA_ARGS__) }
+
 #define LogInfoCustom(source, message) \
     { LogCustomSpecial(inviwo::LogCentral::getPtr(), inviwo::LogLevel::Info, source, message) }
 #define LogWarnCustom(source, message) \
@@ -194,7 +223,7 @@ public:
 class IVW_CORE_API LogCentral : public Singleton<LogCentral>, public Logger {
 public:
     LogCentral();
-    virtual ~LogCentral() = default;
+    virtual ~LogCentral();
 
     void setVerbosity(LogVerbosity verbosity);
     LogVerbosity getVerbosity();
@@ -227,7 +256,84 @@ public:
     void setMessageBreakLevel(MessageBreakLevel level);
     MessageBreakLevel getMessageBreakLevel() const;
 
+    /**
+     * Log a message formatted with fmt from `format` and `args`. Nothing is formatted if the
+     * level is below the verbosity. In asynchronous mode the arguments are copied and the
+     * message is formatted on the logging thread, string arguments such as std::string_view and
+     * const char* are copied into a std::string. In both modes an invalid format string or an
+     * argument that fails to format logs "Invalid log format: <error>" instead of throwing.
+     */
+    template <typename... Args>
+    void logFormat(std::string_view source, LogLevel level, LogAudience audience,
+                   std::string_view file, std::string_view function, int line,
+                   std::string_view format, Args&&... args);
+
+    /**
+     * \brief Deliver messages to the loggers on a separate thread.
+     *
+     * In asynchronous mode log, logProcessor, and logNetwork put the message in a lock-free queue
+     * and return without waiting for any logger. A logging thread delivers the messages in the
+     * order they were queued by each thread. Since a processor might be removed before its
+     * messages are delivered, processor messages are delivered through Logger::log with
+     * "Processor <identifier>" as source. Assertions are always delivered directly, after the
+     * queued messages. Turning the mode off delivers all queued messages first.
+     */
+    void setAsynchronous(bool asynchronous);
+    bool isAsynchronous() const;
+
+    /**
+     * Wait until all messages queued in asynchronous mode have been delivered. Does nothing in
+     * synchronous mode or when called from a logger on the logging thread.
+     */
+    void flush();
+
+    /**
+     * Deliver at most `maxRepeats` copies of the same message, with the same source and level,
+     * within `window`. Further copies are dropped and counted, and the count is reported the next
+     * time the message is logged after the window. A `maxRepeats` of zero turns the limit off,
+     * which is the default.
+     */
+    void setRateLimit(size_t maxRepeats,
+                      std::chrono::milliseconds window = std::chrono::milliseconds{1000});
+    size_t getRateLimit() const;
+
 private:
+    enum class MessageKind { Log, Processor, Network };
+
+    struct Message {
+        MessageKind kind;
+        std::string source;
+        LogLevel level;
+        LogAudience audience;
+        std::string file;
+        std::string function;
+        int line;
+        std::string msg;
+        std::function<std::string()> format;  // Formats msg on the logging thread if set
+    };
+    class AsyncQueue;
+
+    // Arguments captured for asynchronous formatting, strings the caller owns are copied
+    template <typename T>
+    using FormatArg =
+        std::conditional_t<std::is_convertible_v<const std::decay_t<T>&, std::string_view>,
+                           std::string, std::decay_t<T>>;
+    static std::string formatMessage(std::string_view format, fmt::format_args args);
+
+    bool needsStacktrace(LogLevel level, LogAudience audience) const {
+        return logStacktrace_ && level == LogLevel::Error && audience == LogAudience::Developer;
+    }
+    void breakOnMessage(LogLevel level) const;
+    AsyncQueue* asyncQueue() const { return asyncQueue_.load(std::memory_order_acquire); }
+    void enqueue(AsyncQueue* queue, Message message);
+    void deliver(MessageKind kind, Processor* processor, std::string_view source, LogLevel level,
+                 LogAudience audience, std::string_view file, std::string_view function, int line,
+                 std::string_view msg);
+    std::vector<std::shared_ptr<Logger>> liveLoggers();
+    void fanOut(MessageKind kind, Processor* processor, std::string_view source, LogLevel level,
+                LogAudience audience, std::string_view file, std::string_view function, int line,
+                std::string_view msg);
+
     friend Singleton<LogCentral>;
     static LogCentral* instance_;
 
@@ -235,11 +341,53 @@ private:
 #include <warn/push>
 #include <warn/ignore/dll-interface>
     std::vector<std::weak_ptr<Logger>> loggers_;
+    // Only guards the list, the loggers are called after releasing it
+    std::mutex loggersMutex_;
+
+    struct Repeats {
+        std::chrono::steady_clock::time_point start;
+        size_t count;
+        size_t suppressed;
+    };
+    std::atomic<size_t> maxRepeats_{0};
+    std::chrono::milliseconds rateWindow_{1000};
+    std::unordered_map<std::string, Repeats> repeats_;
+    std::mutex repeatsMutex_;  // Guards rateWindow_ and repeats_
+
+    // The current queue, loaded once per message without touching any reference count. Stopped
+    // queues are kept until the LogCentral is destroyed, since producers might still push into
+    // them, see util::AsyncDeliveryQueue::push.
+    std::atomic<AsyncQueue*> asyncQueue_{nullptr};
+    std::vector<std::unique_ptr<AsyncQueue>> asyncQueues_;
+    std::mutex asyncMutex_;  // Serializes turning the asynchronous mode on and off
 #include <warn/pop>
     bool logStacktrace_ = false;
     MessageBreakLevel breakLevel_ = MessageBreakLevel::Off;
 };
 
+template <typename... Args>
+void LogCentral::logFormat(std::string_view source, LogLevel level, LogAudience audience,
+                           std::string_view file, std::string_view function, int line,
+                           std::string_view format, Args&&... args) {
+    if (level < logVerbosity_) {
+        breakOnMessage(level);
+    } else if (auto queue = asyncQueue(); queue && !needsStacktrace(level, audience)) {
+        auto formatter = [f = std::string(format),
+                          a = std::tuple<FormatArg<Args>...>(std::forward<Args>(args)...)]() {
+            return std::apply(
+                [&f](const auto&... as) { return formatMessage(f, fmt::make_format_args(as...)); },
+                a);
+        };
+        enqueue(queue, Message{MessageKind::Log, std::string(source), level, audience,
+                               std::string(file), std::string(function), line, std::string{},
+                               std::move(formatter)});
+        breakOnMessage(level);
+    } else {
+        log(source, level, audience, file, function, line,
+            formatMessage(format, fmt::make_format_args(args...)));
+    }
+}
+
 namespace util {
 
 IVW_CORE_API void log(ExceptionContext context, std::string_view message,
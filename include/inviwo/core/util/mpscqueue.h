@@ -0,0 +1,106 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2021 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#pragma once
+
+#include <inviwo/core/common/inviwocoredefine.h>
+
+#include <atomic>
+#include <optional>
+#include <utility>
+
+namespace inviwo {
+
+namespace util {
+
+/**
+ * \brief An unbounded lock-free multi-producer single-consumer queue
+ *
+ * push may be called concurrently from any number of threads, it allocates one node and
+ * does a single atomic exchange, hence it never blocks on other producers or on the consumer.
+ * pop and empty may only be called from one thread at a time. Elements pushed from the same thread
+ * are popped in the order they were pushed.
+ *
+ * A push becomes visible to the consumer when it is complete, a consumer can momentarily see the
+ * queue as empty while a producer is between its exchange and its link, even if later pushes are
+ * complete. The consumer should hence not treat a failed pop as a guarantee that nothing is
+ * queued, but wait for a separate signal or retry.
+ */
+template <typename T>
+class MPSCQueue {
+public:
+    MPSCQueue() : head_{new Node{}}, tail_{head_.load()} {}
+    MPSCQueue(const MPSCQueue&) = delete;
+    MPSCQueue& operator=(const MPSCQueue&) = delete;
+    ~MPSCQueue() {
+        while (pop()) {
+        }
+        delete tail_;
+    }
+
+    void push(T value) {
+        auto node = new Node{std::move(value)};
+        auto prev = head_.exchange(node, std::memory_order_acq_rel);
+        prev->next.store(node, std::memory_order_release);
+    }
+
+    /**
+     * Remove the oldest element, only to be called from the consumer.
+     */
+    std::optional<T> pop() {
+        auto tail = tail_;
+        auto next = tail->next.load(std::memory_order_acquire);
+        if (!next) return std::nullopt;
+        std::optional<T> res{std::move(next->value)};
+        next->value.reset();
+        tail_ = next;
+        delete tail;
+        return res;
+    }
+
+    /**
+     * Only to be called from the consumer.
+     */
+    bool empty() const { return tail_->next.load(std::memory_order_acquire) == nullptr; }
+
+private:
+    struct Node {
+        Node() = default;
+        explicit Node(T&& v) : value{std::move(v)} {}
+        std::optional<T> value;
+        std::atomic<Node*> next{nullptr};
+    };
+
+    std::atomic<Node*> head_;  // Last pushed node, shared by the producers
+    Node* tail_;               // Node before the oldest element, owned by the consumer
+};
+
+}  // namespace util
+
+}  // namespace inviwo
@@ -0,0 +1,275 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2021 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#pragma once
+
+#include <inviwo/core/common/inviwocoredefine.h>
+
+#include <warn/push>
+#include <warn/ignore/all>
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include <warn/pop>
+
+namespace inviwo {
+
+class ThreadPool;
+
+namespace util {
+
+namespace detail {
+
+/**
+ * Shared state of a fork-join job. The job consists of a fixed number of chunks that are claimed
+ * one at a time by the calling thread and by helper tasks in the thread pool. The calling thread
+ * keeps claiming chunks until none are left, and then only waits for chunks that are already
+ * running in other threads. Hence the job will always make progress even if all workers in the
+ * pool are busy, which makes it safe to use from within pool tasks.
+ */
+class IVW_CORE_API ForkJoinJob {
+public:
+    using Body = void (*)(void* data, size_t chunk);
+
+    ForkJoinJob(size_t chunks, Body body, void* data);
+
+    /**
+     * Claim and run chunks until there are no more unclaimed chunks.
+     */
+    void work();
+
+    /**
+     * Block until all claimed chunks have finished, rethrows the first exception thrown by any
+     * chunk.
+     */
+    void wait();
+
+private:
+    const size_t chunks_;
+    Body body_;
+    void* data_;
+    std::atomic<size_t> next_;
+    std::atomic<size_t> done_;
+    std::atomic<bool> failed_;
+
+    std::mutex mutex_;
+    std::condition_variable condition_;
+    std::exception_ptr exception_;
+};
+
+/**
+ * Run chunks [0, chunks) of body using the given pool. Will block until all chunks are done.
+ */
+IVW_CORE_API void forkJoin(ThreadPool& pool, size_t chunks, ForkJoinJob::Body body, void* data);
+
+/**
+ * Run chunks [0, chunks) of body using the InviwoApplication thread pool, or serially if there is
+ * no application or the pool size is zero. Will block until all chunks are done.
+ */
+IVW_CORE_API void forkJoin(size_t chunks, ForkJoinJob::Body body, void* data);
+
+/**
+ * The number of threads that can work on a fork-join job, i.e. the pool size plus the calling
+ * thread.
+ */
+IVW_CORE_API size_t forkJoinConcurrency(ThreadPool* pool = nullptr);
+
+struct ChunkRange {
+    size_t begin;
+    size_t grainSize;
+    size_t end;
+    size_t chunks;
+
+    size_t chunkBegin(size_t chunk) const { return begin + chunk * grainSize; }
+    size_t chunkEnd(size_t chunk) const { return std::min(end, chunkBegin(chunk) + grainSize); }
+};
+
+inline ChunkRange chunkRange(size_t begin, size_t end, size_t grainSize, size_t concurrency) {
+    const size_t size = end > begin ? end - begin : 0;
+    if (grainSize == 0) {
+        // Aim for 8 chunks per thread to even out the load.
+        grainSize = std::max(size_t{1}, size / (8 * std::max(size_t{1}, concurrency)));
+    }
+    return {begin, grainSize, std::max(begin, end), (size + grainSize - 1) / grainSize};
+}
+
+template <typename Body>
+void runChunk(Body& body, size_t begin, size_t end) {
+    if constexpr (std::is_invocable_v<Body&, size_t, size_t>) {
+        body(begin, end);
+    } else {
+        for (size_t i = begin; i < end; ++i) body(i);
+    }
+}
+
+template <typename Body>
+void parallelFor(ThreadPool* pool, size_t begin, size_t end, Body& body, size_t grainSize) {
+    const auto range = chunkRange(begin, end, grainSize, forkJoinConcurrency(pool));
+    if (range.chunks == 0) return;
+    if (range.chunks == 1) {
+        runChunk(body, range.begin, range.end);
+        return;
+    }
+
+    struct Data {
+        const ChunkRange& range;
+        Body& body;
+    } data{range, body};
+
+    const auto run = [](void* ptr, size_t chunk) {
+        auto& d = *static_cast<Data*>(ptr);
+        runChunk(d.body, d.range.chunkBegin(chunk), d.range.chunkEnd(chunk));
+    };
+
+    if (pool) {
+        forkJoin(*pool, range.chunks, run, &data);
+    } else {
+        forkJoin(range.chunks, run, &data);
+    }
+}
+
+template <typename T, typename Map, typename Reduce>
+T parallelReduce(ThreadPool* pool, size_t begin, size_t end, T identity, Map& map, Reduce& reduce,
+                 size_t grainSize) {
+    const auto range = chunkRange(begin, end, grainSize, forkJoinConcurrency(pool));
+    if (range.chunks == 0) return identity;
+    if (range.chunks == 1) return map(range.begin, range.end, std::move(identity));
+
+    // Keep one partial result per chunk and reduce them in order to get the same result
+    // independent of the scheduling.
+    std::vector<T> partials(range.chunks, identity);
+    struct Data {
+        const ChunkRange& range;
+        Map& map;
+        std::vector<T>& partials;
+    } data{range, map, partials};
+
+    const auto run = [](void* ptr, size_t chunk) {
+        auto& d = *static_cast<Data*>(ptr);
+        d.partials[chunk] = d.map(d.range.chunkBegin(chunk), d.range.chunkEnd(chunk),
+                                  std::move(d.partials[chunk]));
+    };
+
+    if (pool) {
+        forkJoin(*pool, range.chunks, run, &data);
+    } else {
+        forkJoin(range.chunks, run, &data);
+    }
+
+    T result = std::move(identity);
+    for (auto& partial : partials) {
+        result = reduce(std::move(result), std::move(partial));
+    }
+    return result;
+}
+
+}  // namespace detail
+
+/**
+ * Fork-join parallel for loop over the index range [begin, end). The range is split into chunks of
+ * grainSize indices, the chunks are then processed by the calling thread together with the worker
+ * threads of the Inviwo thread pool. The function returns when all indices have been processed.
+ *
+ * In contrast to forEachParallel, the calling thread takes part in the work and never waits for
+ * a chunk that has not been started yet. It is therefore safe to use from within a pool task, i.e.
+ * in a PoolProcessor job, even if all other workers are busy.
+ *
+ * If any call to body throws, the remaining chunks are skipped and the first exception is
+ * rethrown in the calling thread.
+ *
+ * @param begin first index
+ * @param end one past the last index
+ * @param body either `[](size_t i){}` called for every index, or `[](size_t begin, size_t end){}`
+ * called once for every chunk.
+ * @param grainSize number of indices per chunk, if 0 (default) the range is split into about 8
+ * chunks per available thread.
+ */
+template <typename Body>
+void parallelFor(size_t begin, size_t end, Body&& body, size_t grainSize = 0) {
+    detail::parallelFor(nullptr, begin, end, body, grainSize);
+}
+
+/**
+ * Same as parallelFor(begin, end, body, grainSize) but uses the given thread pool.
+ */
+template <typename Body>
+void parallelFor(ThreadPool& pool, size_t begin, size_t end, Body&& body, size_t grainSize = 0) {
+    detail::parallelFor(&pool, begin, end, body, grainSize);
+}
+
+/**
+ * Fork-join parallel reduction over the index range [begin, end). The range is split into chunks
+ * like in parallelFor and map is called once for every chunk. The partial results are then
+ * combined using reduce in chunk order, hence the result is deterministic for a given grainSize
+ * even if reduce is not commutative.
+ *
+ * Example, sum of a vector:
+ * ```{.cpp}
+ * auto sum = util::parallelReduce(
+ *     0, data.size(), 0.0,
+ *     [&](size_t begin, size_t end, double init) {
+ *         return std::accumulate(data.begin() + begin, data.begin() + end, init);
+ *     },
+ *     std::plus<>{});
+ * ```
+ *
+ * @param begin first index
+ * @param end one past the last index
+ * @param identity the identity element of reduce, used as the initial value for every chunk
+ * @param map function of type `(size_t begin, size_t end, T init) -> T` reducing one chunk
+ * @param reduce function of type `(T a, T b) -> T` combining two partial results
+ * @param grainSize number of indices per chunk, if 0 (default) the range is split into about 8
+ * chunks per available thread.
+ */
+template <typename T, typename Map, typename Reduce>
+T parallelReduce(size_t begin, size_t end, T identity, Map&& map, Reduce&& reduce,
+                 size_t grainSize = 0) {
+    return detail::parallelReduce(nullptr, begin, end, std::move(identity), map, reduce,
+                                  grainSize);
+}
+
+/**
+ * Same as parallelReduce(begin, end, identity, map, reduce, grainSize) but uses the given
+ * thread pool.
+ */
+template <typename T, typename Map, typename Reduce>
+T parallelReduce(ThreadPool& pool, size_t begin, size_t end, T identity, Map&& map,
+                 Reduce&& reduce, size_t grainSize = 0) {
+    return detail::parallelReduce(&pool, begin, end, std::move(identity), map, reduce, grainSize);
+}
+
+}  // namespace util
+
+}  // namespace inviwo
@@ -51,6 +51,7 @@ public:
     StringProperty workspaceAuthor_;
     TemplateOptionProperty<UsageMode> applicationUsageMode_;
     IntSizeTProperty poolSize_;
+    BoolProperty parallelEvaluation_;
     BoolProperty enablePortInspectors_;
     IntProperty portInspectorSize_;
     BoolProperty enableTouchProperty_;
@@ -61,6 +62,8 @@ public:
     BoolProperty runtimeModuleReloading_;
     BoolProperty enableResourceManager_;
     TemplateOptionProperty<MessageBreakLevel> breakOnMessage_;
+    BoolProperty asynchronousLogging_;
+    IntSizeTProperty logRateLimit_;
     BoolProperty breakOnException_;
     BoolProperty stackTraceInException_;
 
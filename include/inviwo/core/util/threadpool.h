@@ -61,41 +61,127 @@
 #include <warn/push>
 #include <warn/ignore/all>
 #include <vector>
-#include <queue>
+#include <deque>
+#include <array>
 #include <memory>
 #include <thread>
 #include <mutex>
+#include <shared_mutex>
 #include <condition_variable>
 #include <future>
 #include <functional>
 #include <stdexcept>
 #include <atomic>
+#include <type_traits>
+#include <cstddef>
+#include <new>
 #include <warn/pop>
 
 namespace inviwo {
 
+/**
+ * A work-stealing thread pool.
+ *
+ * Every worker owns one deque per priority lane. Tasks enqueued from within a worker are pushed
+ * onto that worker's own deque and popped in LIFO order, which keeps nested work hot in the cache.
+ * Tasks enqueued from other threads go into a shared injection queue. Idle workers first look in
+ * their own deque, then in the injection queue and finally try to steal the oldest task from the
+ * other workers. Higher priority lanes are always drained before lower ones, hence an interactive
+ * job enqueued with Priority::High will be started before any queued Priority::Low background
+ * work. Running tasks are never interrupted.
+ *
+ * Destroying the pool waits for all queued tasks to finish, hence every future returned by
+ * enqueue will eventually get its value.
+ */
 class IVW_CORE_API ThreadPool {
 public:
+    enum class Priority : size_t {
+        High = 0,    //< Interactive work, i.e. jobs the user is waiting for.
+        Normal = 1,  //< Default priority.
+        Low = 2      //< Background work, like histogram calculations.
+    };
+    static constexpr size_t numPriorities = 3;
+
+    /**
+     * A move-only type erased void() functor. Small functors, like a std::packaged_task or a
+     * lambda with a few captures, are stored inline to avoid any extra heap allocation.
+     */
+    class Task {
+    public:
+        Task() noexcept = default;
+        template <typename F, typename = std::enable_if_t<!std::is_same_v<std::decay_t<F>, Task>>>
+        Task(F&& f);
+        Task(const Task&) = delete;
+        Task& operator=(const Task&) = delete;
+        Task(Task&& rhs) noexcept;
+        Task& operator=(Task&& that) noexcept;
+        ~Task();
+
+        void operator()() { ops_->invoke(&storage_); }
+        explicit operator bool() const noexcept { return ops_ != nullptr; }
+
+    private:
+        static constexpr size_t bufferSize = 6 * sizeof(void*);
+        using Storage = std::aligned_storage_t<bufferSize, alignof(std::max_align_t)>;
+
+        struct Ops {
+            void (*invoke)(void*);
+            void (*move)(void* src, void* dst) noexcept;
+            void (*destroy)(void*) noexcept;
+        };
+
+        template <typename Functor>
+        static constexpr bool isInline = sizeof(Functor) <= bufferSize &&
+                                         alignof(Functor) <= alignof(std::max_align_t) &&
+                                         std::is_nothrow_move_constructible_v<Functor>;
+
+        template <typename Functor>
+        static const Ops* ops();
+
+        Storage storage_;
+        const Ops* ops_ = nullptr;
+    };
+
     ThreadPool(
         size_t threads, std::function<void()> onThreadStart = []() {},
         std::function<void()> onThreadStop = []() {});
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
     ~ThreadPool();
 
     /**
-     * Enqueue function f with arguments args. The function f may throw exceptions.
+     * Enqueue function f with arguments args using Priority::Normal. The function f may throw
+     * exceptions.
      * @return a future to the result of f
      */
     template <class F, class... Args>
     auto enqueue(F&& f, Args&&... args) -> std::future<std::invoke_result_t<F, Args...>>;
 
+    /**
+     * Enqueue function f with arguments args using the given priority. The function f may throw
+     * exceptions.
+     * @return a future to the result of f
+     */
+    template <class F, class... Args>
+    auto enqueue(Priority priority, F&& f, Args&&... args)
+        -> std::future<std::invoke_result_t<F, Args...>>;
+
     /**
      * Enqueue a plain functor. The functor may not throw exceptions.
      */
-    void enqueueRaw(std::function<void()> f);
+    void enqueueRaw(std::function<void()> f, Priority priority = Priority::Normal);
+
+    /**
+     * Enqueue a task. The task may not throw exceptions.
+     */
+    void enqueueTask(Task task, Priority priority = Priority::Normal);
 
     size_t trySetSize(size_t size);
     size_t getSize() const;
 
+    /**
+     * The number of tasks that are waiting to be started.
+     */
     size_t getQueueSize();
 
 private:
@@ -103,10 +189,23 @@ private:
         Free,     //< Worker is waiting for tasks.
         Working,  //< Worker is running a task.
         Stop,     //< Stop after all tasks are done.
-        Abort,    //< Stop as soon as possible, no matter if there are more tasks.
         Done      //< Worker is waiting to be joined.
     };
 
+    class Queue {
+    public:
+        void push(Task task, std::atomic<size_t>& pending);
+        Task popFront(std::atomic<size_t>& pending);
+        Task popBack(std::atomic<size_t>& pending);
+        bool empty() const { return size_.load(std::memory_order_relaxed) == 0; }
+
+    private:
+        std::mutex mutex_;
+        std::deque<Task> tasks_;
+        std::atomic<size_t> size_{0};
+    };
+    using Lanes = std::array<Queue, numPriorities>;
+
     struct Worker {
         Worker(ThreadPool& pool);
         Worker(const Worker&) = delete;
@@ -115,41 +214,113 @@ private:
         Worker& operator=(Worker&& rhs) = delete;
         ~Worker();
 
+        ThreadPool& pool;
+        Lanes local;               //< Tasks enqueued from this worker
         std::atomic<State> state;  //< State of the worker
         std::thread thread;
     };
+
+    /// The worker owning the calling thread, or nullptr if it is not one of our workers
+    Worker* currentWorker() const;
+    void push(Task task, Priority priority);
+    Task take(Worker& worker);
+    Task steal(Worker& thief, size_t lane);
+    void sleep(Worker& worker);
+    void wakeAll();
+
     // need to keep track of threads so we can join them
     std::vector<std::unique_ptr<Worker>> workers;
+    // guards the workers vector against concurrent stealing while resizing
+    mutable std::shared_mutex workersMutex_;
 
-    // the task queue
-    std::queue<std::function<void()>> tasks;
+    // shared queues for tasks enqueued from outside of the pool
+    Lanes injection_;
+    // total number of tasks waiting in any queue
+    std::atomic<size_t> pending_{0};
 
-    // synchronization
-    std::mutex queue_mutex;
-    std::condition_variable condition;
+    // synchronization for idle workers
+    std::atomic<size_t> sleeping_{0};
+    std::mutex sleepMutex_;
+    std::condition_variable condition_;
 
     // Thread start end exit actions
     std::function<void()> onThreadStart_;
     std::function<void()> onThreadStop_;
 };
 
+template <typename F, typename>
+ThreadPool::Task::Task(F&& f) {
+    using Functor = std::decay_t<F>;
+    if constexpr (isInline<Functor>) {
+        ::new (static_cast<void*>(&storage_)) Functor(std::forward<F>(f));
+    } else {
+        ::new (static_cast<void*>(&storage_)) Functor*(new Functor(std::forward<F>(f)));
+    }
+    ops_ = ops<Functor>();
+}
+
+inline ThreadPool::Task::Task(Task&& rhs) noexcept : ops_{rhs.ops_} {
+    if (ops_) {
+        ops_->move(&rhs.storage_, &storage_);
+        rhs.ops_ = nullptr;
+    }
+}
+
+inline ThreadPool::Task& ThreadPool::Task::operator=(Task&& that) noexcept {
+    if (this != &that) {
+        if (ops_) ops_->destroy(&storage_);
+        ops_ = that.ops_;
+        if (ops_) {
+            ops_->move(&that.storage_, &storage_);
+            that.ops_ = nullptr;
+        }
+    }
+    return *this;
+}
+
+inline ThreadPool::Task::~Task() {
+    if (ops_) ops_->destroy(&storage_);
+}
+
+template <typename Functor>
+auto ThreadPool::Task::ops() -> const Ops* {
+    if constexpr (isInline<Functor>) {
+        static constexpr Ops inlineOps{
+            [](void* data) { (*static_cast<Functor*>(data))(); },
+            [](void* src, void* dst) noexcept {
+                auto f = static_cast<Functor*>(src);
+                ::new (dst) Functor(std::move(*f));
+                f->~Functor();
+            },
+            [](void* data) noexcept { static_cast<Functor*>(data)->~Functor(); }};
+        return &inlineOps;
+    } else {
+        static constexpr Ops heapOps{
+            [](void* data) { (**static_cast<Functor**>(data))(); },
+            [](void* src, void* dst) noexcept {
+                ::new (dst) Functor*(*static_cast<Functor**>(src));
+            },
+            [](void* data) noexcept { delete *static_cast<Functor**>(data); }};
+        return &heapOps;
+    }
+}
+
 // add new work item to the pool
 template <class F, class... Args>
 auto ThreadPool::enqueue(F&& f, Args&&... args) -> std::future<std::invoke_result_t<F, Args...>> {
-    using return_type = std::invoke_result_t<F, Args...>;
+    return enqueue(Priority::Normal, std::forward<F>(f), std::forward<Args>(args)...);
+}
 
-    auto task = std::make_shared<std::packaged_task<return_type()>>(
-        std::bind(std::forward<F>(f), std::forward<Args>(args)...));
+template <class F, class... Args>
+auto ThreadPool::enqueue(Priority priority, F&& f, Args&&... args)
+    -> std::future<std::invoke_result_t<F, Args...>> {
+    using return_type = std::invoke_result_t<F, Args...>;
 
-    std::future<return_type> res = task->get_future();
+    std::packaged_task<return_type()> task{
+        std::bind(std::forward<F>(f), std::forward<Args>(args)...)};
+    std::future<return_type> res = task.get_future();
 
-    if (workers.empty()) {
-        (*task)();  // No worker threads, just run the task.
-    } else {
-        std::unique_lock<std::mutex> lock(queue_mutex);
-        tasks.emplace([task]() { (*task)(); });
-    }
-    condition.notify_one();
+    push(Task{std::move(task)}, priority);
     return res;
 }
 
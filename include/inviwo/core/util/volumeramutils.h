@@ -32,6 +32,7 @@
 #include <inviwo/core/common/inviwocoredefine.h>
 #include <inviwo/core/datastructures/volume/volumeram.h>
 #include <inviwo/core/common/inviwoapplication.h>
+#include <inviwo/core/util/parallel.h>
 
 namespace inviwo {
 
@@ -54,40 +55,35 @@ void forEachVoxel(const VolumeRAM& v, C callback) {
     forEachVoxel(v.getDimensions(), callback);
 }
 
+/**
+ * Call callback for each voxel position using multiple threads. The volume is split along rows in
+ * the xy-planes and processed using util::parallelFor, hence the calling thread takes part in the
+ * work and it is safe to call from within a thread pool task.
+ * @param dims dimensions of the volume
+ * @param callback functor called with each `const size3_t&` voxel position
+ * @param jobs optional parameter specifying how many jobs to create, if jobs==0 (default) the
+ * number of jobs is chosen based on the pool size
+ */
 template <typename C>
 void forEachVoxelParallel(const size3_t dims, C callback, size_t jobs = 0) {
-    if (InviwoApplication::isInitialized() && jobs == 0) {
-        jobs = 4 * InviwoApplication::getPtr()->getPoolSize();
-    }
-
-    if (jobs == 0 || !InviwoApplication::isInitialized()) {
-        // fallback to serial version
-        forEachVoxel(dims, callback);
-        return;
-    }
+    const size_t rows = dims.y * dims.z;
+    const size_t grainSize = jobs == 0 ? 0 : (rows + jobs - 1) / jobs;
 
-    std::vector<std::future<void>> futures;
-    for (size_t job = 0; job < jobs; ++job) {
-        size3_t start = size3_t(0, 0, job * dims.z / jobs);
-        size3_t stop = size3_t(dims.x, dims.y, std::min(dims.z, (job + 1) * dims.z / jobs));
-
-        futures.push_back(dispatchPool([&callback, start, stop]() {
+    parallelFor(
+        0, rows,
+        [&](size_t begin, size_t end) {
             size3_t pos{0};
-
-            for (pos.z = start.z; pos.z < stop.z; ++pos.z) {
-                for (pos.y = start.y; pos.y < stop.y; ++pos.y) {
-                    for (pos.x = start.x; pos.x < stop.x; ++pos.x) {
-                        callback(pos);
-                    }
+            for (size_t row = begin; row < end; ++row) {
+                pos.y = row % dims.y;
+                pos.z = row / dims.y;
+                for (pos.x = 0; pos.x < dims.x; ++pos.x) {
+                    callback(pos);
                 }
             }
-        }));
-    }
-
-    for (const auto& e : futures) {
-        e.wait();
-    }
+        },
+        grainSize);
 }
+
 template <typename C>
 void forEachVoxelParallel(const VolumeRAM& v, C callback, size_t jobs = 0) {
     forEachVoxelParallel(v.getDimensions(), callback, jobs);
@@ -37,15 +37,74 @@
 #include <inviwo/core/datastructures/volume/volumeram.h>
 
 #include <inviwo/core/util/spatialsampler.h>
+#include <inviwo/core/util/formatdispatching.h>
+#include <inviwo/core/util/glm.h>
+
+#include <tcb/span.hpp>
+
+#include <array>
 
 namespace inviwo {
 
+namespace detail {
+
+/**
+ * Trilinear sampling of typed volume data in data space. The 2x2x2 neighborhood is fetched using
+ * one base index and constant strides, neighbors outside of the volume are clamped to the border.
+ */
+template <typename DataType, unsigned int DataDims>
+Vector<DataDims, double> volumeSampleTrilinear(const void* data, const size3_t& dims,
+                                               const dvec3& pos) {
+    using R = Vector<DataDims, double>;
+    if (glm::any(glm::lessThan(pos, dvec3(0.0))) || glm::any(glm::greaterThan(pos, dvec3(1.0)))) {
+        return R(0.0);
+    }
+    const auto* typed = static_cast<const DataType*>(data);
+
+    const dvec3 samplePos = pos * dvec3(dims - size3_t(1));
+    const size3_t indexPos = size3_t(samplePos);
+    const dvec3 interpolants = samplePos - dvec3(indexPos);
+
+    const size_t sx = indexPos.x + 1 < dims.x ? 1 : 0;
+    const size_t sy = indexPos.y + 1 < dims.y ? dims.x : 0;
+    const size_t sz = indexPos.z + 1 < dims.z ? dims.x * dims.y : 0;
+    const size_t i = indexPos.x + dims.x * (indexPos.y + dims.y * indexPos.z);
+
+    const R samples[8] = {util::glm_convert<R>(typed[i]),
+                          util::glm_convert<R>(typed[i + sx]),
+                          util::glm_convert<R>(typed[i + sy]),
+                          util::glm_convert<R>(typed[i + sx + sy]),
+                          util::glm_convert<R>(typed[i + sz]),
+                          util::glm_convert<R>(typed[i + sx + sz]),
+                          util::glm_convert<R>(typed[i + sy + sz]),
+                          util::glm_convert<R>(typed[i + sx + sy + sz])};
+
+    return Interpolation<R>::trilinear(samples, interpolants);
+}
+
+template <typename DataType, unsigned int DataDims>
+void volumeSampleTrilinearBatch(const void* data, const size3_t& dims,
+                                util::span<const dvec3> positions,
+                                util::span<Vector<DataDims, double>> result) {
+    const size_t size = std::min(positions.size(), result.size());
+    for (size_t i = 0; i < size; ++i) {
+        result[i] = volumeSampleTrilinear<DataType, DataDims>(data, dims, positions[i]);
+    }
+}
+
+}  // namespace detail
+
 /**
  * \class VolumeDoubleSampler
+ * Trilinear sampling of a volume, returning the values as doubles. The data format of the volume
+ * is dispatched once at construction, samples are then taken directly from the typed data without
+ * going through the virtual VolumeRAM accessors.
  */
 template <unsigned int DataDims>
 class VolumeDoubleSampler : public SpatialSampler<3, DataDims, double> {
 public:
+    using ReturnType = Vector<DataDims, double>;
+
     VolumeDoubleSampler(std::shared_ptr<const Volume> vol,
                         CoordinateSpace space = CoordinateSpace::Data);
     VolumeDoubleSampler(const Volume& vol, CoordinateSpace space = CoordinateSpace::Data);
@@ -53,15 +112,35 @@ public:
 
     VolumeDoubleSampler& operator=(const VolumeDoubleSampler&) = default;
 
+    using SpatialSampler<3, DataDims, double>::sample;
+
+    /**
+     * Sample all positions, given in the coordinate space of the sampler, and write the result
+     * into result. Only min(positions.size(), result.size()) samples are taken.
+     */
+    void sample(util::span<const dvec3> positions, util::span<ReturnType> result) const;
+
     virtual Vector<DataDims, double> sampleDataSpace(const dvec3& pos) const override;
+
+    /**
+     * Sample all positions, given in data space, and write the result into result. Only
+     * min(positions.size(), result.size()) samples are taken.
+     */
+    void sampleDataSpace(util::span<const dvec3> positions, util::span<ReturnType> result) const;
+
     virtual bool withinBoundsDataSpace(const dvec3& pos) const override;
 
 protected:
-    Vector<DataDims, double> getVoxel(const size3_t& pos) const;
+    using SampleFunc = ReturnType (*)(const void*, const size3_t&, const dvec3&);
+    using BatchSampleFunc = void (*)(const void*, const size3_t&, util::span<const dvec3>,
+                                     util::span<ReturnType>);
 
     std::shared_ptr<const Volume> volume_;
     const VolumeRAM* ram_;
     size3_t dims_;
+    const void* data_;
+    SampleFunc sample_;
+    BatchSampleFunc batchSample_;
 };
 
 using VolumeSampler = VolumeDoubleSampler<4>;
@@ -77,53 +156,50 @@ template <unsigned int DataDims>
 VolumeDoubleSampler<DataDims>::VolumeDoubleSampler(const Volume& vol, CoordinateSpace space)
     : SpatialSampler<3, DataDims, double>(vol, space)
     , ram_(vol.getRepresentation<VolumeRAM>())
-    , dims_(vol.getDimensions()) {}
+    , dims_(vol.getDimensions())
+    , data_(ram_->getData())
+    , sample_{nullptr}
+    , batchSample_{nullptr} {
+
+    ram_->dispatch<void>([this](auto vrprecision) {
+        using ValueType = util::PrecisionValueType<decltype(vrprecision)>;
+        sample_ = &detail::volumeSampleTrilinear<ValueType, DataDims>;
+        batchSample_ = &detail::volumeSampleTrilinearBatch<ValueType, DataDims>;
+    });
+}
 
 template <unsigned int DataDims>
 Vector<DataDims, double> VolumeDoubleSampler<DataDims>::sampleDataSpace(const dvec3& pos) const {
-    if (!withinBoundsDataSpace(pos)) {
-        return Vector<DataDims, double>(0.0);
-    }
-    const dvec3 samplePos = pos * dvec3(dims_ - size3_t(1));
-    const size3_t indexPos = size3_t(samplePos);
-    const dvec3 interpolants = samplePos - dvec3(indexPos);
-
-    Vector<DataDims, double> samples[8];
-    samples[0] = getVoxel(indexPos);
-    samples[1] = getVoxel(indexPos + size3_t(1, 0, 0));
-    samples[2] = getVoxel(indexPos + size3_t(0, 1, 0));
-    samples[3] = getVoxel(indexPos + size3_t(1, 1, 0));
-
-    samples[4] = getVoxel(indexPos + size3_t(0, 0, 1));
-    samples[5] = getVoxel(indexPos + size3_t(1, 0, 1));
-    samples[6] = getVoxel(indexPos + size3_t(0, 1, 1));
-    samples[7] = getVoxel(indexPos + size3_t(1, 1, 1));
-
-    return Interpolation<Vector<DataDims, double>>::trilinear(samples, interpolants);
-}
-
-template <>
-inline Vector<1, double> VolumeDoubleSampler<1>::getVoxel(const size3_t& pos) const {
-    const auto p = glm::clamp(pos, size3_t(0), dims_ - size3_t(1));
-    return ram_->getAsDouble(p);
+    return sample_(data_, dims_, pos);
 }
 
-template <>
-inline Vector<2, double> VolumeDoubleSampler<2>::getVoxel(const size3_t& pos) const {
-    const auto p = glm::clamp(pos, size3_t(0), dims_ - size3_t(1));
-    return ram_->getAsDVec2(p);
+template <unsigned int DataDims>
+void VolumeDoubleSampler<DataDims>::sampleDataSpace(util::span<const dvec3> positions,
+                                                    util::span<ReturnType> result) const {
+    batchSample_(data_, dims_, positions, result);
 }
 
-template <>
-inline Vector<3, double> VolumeDoubleSampler<3>::getVoxel(const size3_t& pos) const {
-    const auto p = glm::clamp(pos, size3_t(0), dims_ - size3_t(1));
-    return ram_->getAsDVec3(p);
-}
+template <unsigned int DataDims>
+void VolumeDoubleSampler<DataDims>::sample(util::span<const dvec3> positions,
+                                           util::span<ReturnType> result) const {
+    if (this->space_ == CoordinateSpace::Data) {
+        batchSample_(data_, dims_, positions, result);
+        return;
+    }
 
-template <>
-inline Vector<4, double> VolumeDoubleSampler<4>::getVoxel(const size3_t& pos) const {
-    const auto p = glm::clamp(pos, size3_t(0), dims_ - size3_t(1));
-    return ram_->getAsDVec4(p);
+    // Transform the positions in blocks to data space, and sample each block at once.
+    constexpr size_t blockSize = 256;
+    std::array<dvec3, blockSize> block;
+    const size_t size = std::min(positions.size(), result.size());
+    for (size_t start = 0; start < size; start += blockSize) {
+        const size_t count = std::min(blockSize, size - start);
+        for (size_t i = 0; i < count; ++i) {
+            const auto p = this->transform_ * dvec4(positions[start + i], 1.0);
+            block[i] = dvec3(p) / p.w;
+        }
+        batchSample_(data_, dims_, util::span<const dvec3>(block.data(), count),
+                     result.subspan(start, count));
+    }
 }
 
 template <unsigned int DataDims>
@@ -0,0 +1,141 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2021 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#pragma once
+
+#include <inviwo/qt/editor/inviwoqteditordefine.h>
+
+#include <warn/push>
+#include <warn/ignore/all>
+#include <QByteArray>
+#include <warn/pop>
+
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <tuple>
+
+namespace inviwo {
+
+/**
+ * \class UndoHistory
+ * Stores the serialized workspace states of the undo history. Every `keyframeInterval` state is
+ * a keyframe that is stored compressed in full, the states in between are stored as the
+ * compressed part that differs from the previous keyframe. New states are kept uncompressed until
+ * a background thread has computed the delta and compressed it. All functions are thread safe.
+ * @see UndoManager
+ */
+class IVW_QTEDITOR_API UndoHistory {
+public:
+    static constexpr size_t keyframeInterval = 32;
+    static constexpr size_t defaultMemoryBudget = 256 * 1024 * 1024;
+
+    UndoHistory();
+    UndoHistory(const UndoHistory&) = delete;
+    UndoHistory& operator=(const UndoHistory&) = delete;
+    ~UndoHistory();
+
+    size_t size() const;
+
+    /**
+     * Append a state and drop the oldest states if the memory budget is exceeded. States are
+     * dropped a keyframe and all its deltas at a time, and the last keyframe is always kept.
+     * @return the number of dropped states
+     */
+    size_t push(std::shared_ptr<const std::string> state);
+
+    /**
+     * Get state i, decompressing it if needed.
+     */
+    std::shared_ptr<const std::string> get(size_t i) const;
+
+    /**
+     * Remove all states from index i and onwards.
+     */
+    void truncate(size_t i);
+    void clear();
+
+    void setMemoryBudget(size_t bytes);
+    size_t getMemoryBudget() const;
+    size_t getMemoryUsage() const;
+
+    /**
+     * Wait until the background thread has compressed all pushed states.
+     */
+    void waitForCompression() const;
+
+private:
+    struct Entry {
+        size_t serial = 0;
+        size_t keyframe = 0;  // id of the keyframe the delta refers to
+        // The full state until it has been compressed
+        std::shared_ptr<const std::string> state;
+        // The compressed state for keyframes, or the compressed part that differs from the
+        // keyframe, keyframe[0, prefix) + data + keyframe[size - suffix, size)
+        QByteArray data;
+        size_t prefix = 0;
+        size_t suffix = 0;
+
+        size_t memory() const { return state ? state->size() : static_cast<size_t>(data.size()); }
+    };
+
+    struct Job {
+        size_t id;
+        size_t serial;
+        std::shared_ptr<const std::string> state;
+        std::shared_ptr<const std::string> keyframe;
+    };
+
+    static std::tuple<QByteArray, size_t, size_t> compress(const std::string& state,
+                                                           const std::string* keyframe);
+    size_t trim();
+
+    mutable std::mutex mutex_;
+    std::condition_variable condition_;
+    mutable std::condition_variable idle_;
+    bool quit_;
+    std::deque<Job> jobs_;
+    bool working_ = false;
+
+    std::deque<Entry> entries_;
+    size_t first_ = 0;  // id of the first entry
+    size_t serial_ = 0;
+    size_t memory_ = 0;
+    size_t budget_ = defaultMemoryBudget;
+
+    std::shared_ptr<const std::string> keyframe_;
+    size_t keyframeId_ = 0;
+
+    std::thread worker_;
+};
+
+}  // namespace inviwo
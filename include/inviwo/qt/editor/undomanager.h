@@ -45,9 +45,14 @@ namespace inviwo {
 
 class InviwoMainWindow;
 class AutoSaver;
+class UndoHistory;
 
 /**
  * \class UndoManager
+ * Keeps a history of serialized workspace states for undo and redo. The workspace is serialized
+ * on the main thread whenever it changes, while diffing and compressing the states is done in the
+ * background by the UndoHistory. States are stored as compressed deltas against periodic
+ * keyframes, and the oldest states are dropped when the history exceeds its memory budget.
  */
 class IVW_QTEDITOR_API UndoManager : public ProcessorNetworkObserver {
 public:
@@ -72,6 +77,17 @@ public:
     bool hasRestore() const;
     void restore();
 
+    /**
+     * Set the approximate number of bytes the undo history may use. The oldest states are
+     * dropped when the budget is exceeded, the current state is always kept.
+     */
+    void setMemoryBudget(size_t bytes);
+    size_t getMemoryBudget() const;
+    /**
+     * The number of bytes currently used by the undo history.
+     */
+    size_t getMemoryUsage() const;
+
 private:
     using DiffType = std::vector<std::string>::iterator::difference_type;
 
@@ -93,7 +109,8 @@ private:
     bool dirty_ = true;
     bool isRestoring = false;
     DiffType head_ = -1;
-    std::vector<std::shared_ptr<const std::string>> undoBuffer_;
+    std::unique_ptr<UndoHistory> history_;
+    std::shared_ptr<const std::string> current_;
 
     QAction* undoAction_;
     QAction* redoAction_;
@@ -42,9 +42,14 @@
 namespace inviwo {
 
 void exposeVolumeWriteMethods(pybind11::module& m) {
+    pybind11::enum_<IvfCompression>(m, "IvfCompression")
+        .value("Uncompressed", IvfCompression::None)
+        .value("Zlib", IvfCompression::Zlib);
 
     m.def("saveDatVolume", &util::writeDatVolume);
-    m.def("saveIvfVolume", &util::writeIvfVolume);
+    m.def("saveIvfVolume", &util::writeIvfVolume, pybind11::arg("volume"), pybind11::arg("path"),
+          pybind11::arg("overwrite") = false, pybind11::arg("brickSize") = size3_t{0},
+          pybind11::arg("compression") = IvfCompression::None);
     m.def("saveIvfVolumeSequence", &util::writeIvfVolumeSequence);
     m.def("saveIvfVolumeSequence", [](pybind11::list list, std::string name, std::string path,
                                       std::string reltivePathToTimesteps, bool overwrite) {
@@ -34,10 +34,7 @@
 #include <inviwo/core/datastructures/image/layer.h>
 #include <inviwo/core/datastructures/image/layerram.h>
 #include <inviwo/core/datastructures/image/layerramprecision.h>
-
-#ifdef IVW_USE_OPENMP
-#include <omp.h>
-#endif
+#include <inviwo/core/util/parallel.h>
 
 namespace inviwo {
 
@@ -95,10 +92,6 @@ void util::layerRAMDistanceTransform(const LayerRAMPrecision<T>* inLayer,
                                      Predicate predicate, ValueTransform valueTransform,
                                      ProgressCallback callback) {
 
-#ifdef IVW_USE_OPENMP
-    omp_set_num_threads(std::thread::hardware_concurrency());
-#endif
-
     using int64 = glm::int64;
 
     auto square = [](auto a) { return a * a; };
@@ -152,12 +145,10 @@ void util::layerRAMDistanceTransform(const LayerRAMPrecision<T>* inLayer,
         return predicate(src[srcInd(x / sm.x, y / sm.y)]);
     };
 
-// first pass, forward and backward scan along x
-// result: min distance in x direction
-#ifdef IVW_USE_OPENMP
-#pragma omp parallel for
-#endif
-    for (int64 y = 0; y < dstDim.y; ++y) {
+    // first pass, forward and backward scan along x
+    // result: min distance in x direction
+    util::parallelFor(0, static_cast<size_t>(dstDim.y), [&](size_t yi) {
+        const auto y = static_cast<int64>(yi);
         // forward
         U dist = static_cast<U>(dstDim.x);
         for (int64 x = 0; x < dstDim.x; ++x) {
@@ -179,22 +170,16 @@ void util::layerRAMDistanceTransform(const LayerRAMPrecision<T>* inLayer,
             }
             dst[dstInd(x, y)] = std::min<U>(dst[dstInd(x, y)], squareVoxelSize.x * square(dist));
         }
-    }
+    });
 
     // second pass, scan y direction
     // for each voxel v(x,y,z) find min_i(data(x,i,z) + (y - i)^2), 0 <= i < dimY
     // result: min distance in x and y direction
     callback(0.45);
-#ifdef IVW_USE_OPENMP
-#pragma omp parallel
-#endif
-    {
+    util::parallelFor(0, static_cast<size_t>(dstDim.x), [&](size_t xBegin, size_t xEnd) {
         std::vector<U> buff;
         buff.resize(dstDim.y);
-#ifdef IVW_USE_OPENMP
-#pragma omp for
-#endif
-        for (int64 x = 0; x < dstDim.x; ++x) {
+        for (auto x = static_cast<int64>(xBegin); x < static_cast<int64>(xEnd); ++x) {
 
             // cache column data into temporary buffer
             for (int64 y = 0; y < dstDim.y; ++y) {
@@ -215,17 +200,12 @@ void util::layerRAMDistanceTransform(const LayerRAMPrecision<T>* inLayer,
                 dst[dstInd(x, y)] = d;
             }
         }
-    }
+    });
 
     // scale data
     callback(0.9);
-    const int64 layerSize = dstDim.x * dstDim.y;
-#ifdef IVW_USE_OPENMP
-#pragma omp parallel for
-#endif
-    for (int64 i = 0; i < layerSize; ++i) {
-        dst[i] = valueTransform(dst[i]);
-    }
+    const auto layerSize = static_cast<size_t>(dstDim.x * dstDim.y);
+    util::parallelFor(0, layerSize, [&](size_t i) { dst[i] = valueTransform(dst[i]); });
     callback(1.0);
 }
 
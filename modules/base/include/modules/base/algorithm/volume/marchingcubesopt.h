@@ -64,6 +64,37 @@ IVW_MODULE_BASE_API std::shared_ptr<Mesh> marchingCubesOpt(
     std::shared_ptr<const Volume> volume, double iso, const vec4& color, bool invert, bool enclose,
     std::function<void(float)> progressCallback = nullptr,
     std::function<bool(const size3_t&)> maskingCallback = nullptr);
+
+/**
+ * Extracts an iso surface from a volume using the Marching Cubes algorithm in parallel
+ *
+ * Note: Shares interface with util::marchingCubesOpt
+ * The volume is split into slabs along z that are processed in parallel on the thread pool. The
+ * vertices on the planes between slabs are shared, hence the resulting mesh is identical to the
+ * one of util::marchingCubesOpt up to the order of vertices and triangles. The order does not
+ * depend on the number of threads.
+ *
+ * @param volume the scalar volume
+ * @param iso iso-value for the extracted surface
+ * @param color the color of the resulting surface
+ * @param invert flips the normals of the surface normals (useful when values greater than the
+ * iso-value is 'outside' of the surface)
+ * @param enclose whether to create surface where the iso surface intersects the volume boundaries
+ * @param progressCallback if set, will be called will executing with the current progress in the
+ * interval [0,1], useful for progress bars. Might be called from any thread, but not concurrently.
+ * @param maskingCallback optional callback to test whether current cell should be evaluated or not
+ * (return true to include current cell). Will be called concurrently from several threads.
+ * @param stopCallback optional callback to test whether the extraction should be aborted. If it
+ * returns true the extraction stops as soon as possible and nullptr is returned.
+ * @param skipEmptyBricks if true, the min and max value of each brick of 16^3 cells is computed
+ * first and bricks that can not contain the surface are skipped.
+ */
+IVW_MODULE_BASE_API std::shared_ptr<Mesh> marchingCubesParallel(
+    std::shared_ptr<const Volume> volume, double iso, const vec4& color, bool invert, bool enclose,
+    std::function<void(float)> progressCallback = nullptr,
+    std::function<bool(const size3_t&)> maskingCallback = nullptr,
+    std::function<bool()> stopCallback = nullptr, bool skipEmptyBricks = true);
+
 }  // namespace util
 
 namespace marching {
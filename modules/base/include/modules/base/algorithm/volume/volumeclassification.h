@@ -0,0 +1,63 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2021 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#pragma once
+
+#include <modules/base/basemoduledefine.h>
+
+#include <inviwo/core/util/formats.h>
+
+#include <memory>
+
+namespace inviwo {
+
+class TFLookupTable;
+class Volume;
+
+namespace util {
+
+/**
+ * Classifies a scalar volume by applying a transfer function to every voxel, i.e. the colors
+ * and opacities the volume raycaster would see are computed once on the CPU. The voxels are
+ * processed in parallel on the thread pool.
+ *
+ * @param volume the input volume, values are normalized to [0,1] using its data range
+ * @param tf lookup table of the transfer function applied to the normalized values
+ * @param channel the channel of the input volume to classify
+ * @param format format of the resulting RGBA volume, either DataVec4UInt8 or DataVec4Float32
+ * @return volume with the same dimensions and transformations as the input
+ * @throws Exception if format is not supported
+ */
+IVW_MODULE_BASE_API std::shared_ptr<Volume> classifyVolume(
+    const Volume& volume, const TFLookupTable& tf, size_t channel = 0,
+    const DataFormatBase* format = DataVec4UInt8::get());
+
+}  // namespace util
+
+}  // namespace inviwo
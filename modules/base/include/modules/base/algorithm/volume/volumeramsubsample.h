@@ -36,12 +36,41 @@
 namespace inviwo {
 
 class VolumeRAM;
+class VolumeBrickedRAM;
 
 namespace util {
 
 IVW_MODULE_BASE_API std::shared_ptr<VolumeRAM> volumeSubSample(const VolumeRAM* in,
                                                                size3_t factors);
 
+/**
+ * Subsample a bricked volume. The volume is processed in slabs along z, each slab only loads the
+ * bricks it overlaps, hence the input does not have to fit into memory.
+ */
+IVW_MODULE_BASE_API std::shared_ptr<VolumeRAM> volumeSubSample(const VolumeBrickedRAM* in,
+                                                               size3_t factors);
+
+/**
+ * How the voxels covered by a voxel of a downsampled volume are combined
+ */
+enum class VolumeReduction { Average, Min, Max };
+
+/**
+ * Halve the dimensions of a volume, rounding up, i.e. a dimension of size n becomes (n + 1) / 2.
+ * Each output voxel combines the up to 2x2x2 input voxels it covers using reduction, voxels at the
+ * upper boundary of odd dimensions combine fewer input voxels. Vectors are reduced component wise.
+ * The slices of the output are computed in parallel on the thread pool.
+ */
+IVW_MODULE_BASE_API std::shared_ptr<VolumeRAM> volumeHalfSample(
+    const VolumeRAM* in, VolumeReduction reduction = VolumeReduction::Average);
+
+/**
+ * Halve the dimensions of a bricked volume, like volumeHalfSample for a VolumeRAM. The volume is
+ * processed in slabs along z, hence the input does not have to fit into memory.
+ */
+IVW_MODULE_BASE_API std::shared_ptr<VolumeRAM> volumeHalfSample(
+    const VolumeBrickedRAM* in, VolumeReduction reduction = VolumeReduction::Average);
+
 }  // namespace util
 
 }  // namespace inviwo
@@ -0,0 +1,232 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2021 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#pragma once
+
+#include <modules/base/basemoduledefine.h>
+
+#include <inviwo/core/datastructures/light/lightingstate.h>
+#include <inviwo/core/datastructures/tflookuptable.h>
+#include <inviwo/core/util/glm.h>
+#include <inviwo/core/util/glmvec.h>
+
+#include <algorithm>
+#include <functional>
+#include <memory>
+#include <vector>
+
+namespace inviwo {
+
+class Camera;
+class Image;
+class TransferFunction;
+class Volume;
+
+namespace util {
+
+/**
+ * Parameters of util::raycastVolume
+ */
+struct IVW_MODULE_BASE_API VolumeRaycastingSettings {
+    size_t channel = 0;           ///< Volume channel to render
+    float samplingRate = 2.0f;    ///< Samples per voxel along the ray, as in RaycastingProperty
+    LightingState lighting{
+        ShadingMode::None, vec3{0.0f}, vec3{1.0f}, vec3{1.0f}, vec3{1.0f}, 60.0f};
+    float earlyRayTermination = 0.99f;  ///< Stop a ray when its opacity exceeds this threshold
+    bool emptySpaceSkipping = true;     ///< Skip bricks that are fully transparent in the TF
+    size_t brickSize = 8;               ///< Size in voxels of the bricks used for skipping
+    size_t tileSize = 32;               ///< Size in pixels of the tiles rendered in parallel
+};
+
+/**
+ * One channel of a volume normalized to [0,1] using the data range, stored as floats to make the
+ * trilinear sampling independent of the data format. Positions are given in index space with the
+ * voxel centers at integer coordinates. Only depends on the volume and the channel, hence it can be
+ * reused for rendering many views of the same data.
+ */
+class IVW_MODULE_BASE_API ScalarGrid {
+public:
+    ScalarGrid(const Volume& volume, size_t channel);
+
+    const size3_t& dims() const { return dims_; }
+    const ivec3& maxCell() const { return maxCell_; }
+    size_t channel() const { return channel_; }
+
+    vec3 clamp(const vec3& pos) const { return glm::clamp(pos, vec3(0.0f), vec3(maxIndex_)); }
+
+    //! First voxel of the cell containing the clamped position
+    ivec3 cell(const vec3& pos) const { return glm::min(ivec3(pos), maxCell_); }
+
+    float value(const ivec3& index) const {
+        return data_[index.x + index.y * strides_.y + index.z * strides_.z];
+    }
+
+    //! Trilinear interpolation at a clamped position
+    float sample(const vec3& pos) const {
+        const ivec3 i0 = cell(pos);
+        const vec3 f = pos - vec3(i0);
+        const ivec3 step = glm::min(i0 + 1, maxIndex_) - i0;
+
+        const float* p = data_.data() + i0.x + i0.y * strides_.y + i0.z * strides_.z;
+        const size_t dx = step.x;
+        const size_t dy = step.y * strides_.y;
+        const size_t dz = step.z * strides_.z;
+
+        const float x00 = p[0] + f.x * (p[dx] - p[0]);
+        const float x10 = p[dy] + f.x * (p[dy + dx] - p[dy]);
+        const float x01 = p[dz] + f.x * (p[dz + dx] - p[dz]);
+        const float x11 = p[dz + dy] + f.x * (p[dz + dy + dx] - p[dz + dy]);
+        const float y0 = x00 + f.y * (x10 - x00);
+        const float y1 = x01 + f.y * (x11 - x01);
+        return y0 + f.z * (y1 - y0);
+    }
+
+    //! Central differences in index space with a spacing of one voxel
+    vec3 gradient(const vec3& pos) const {
+        vec3 g;
+        for (int i = 0; i < 3; ++i) {
+            vec3 forward = pos;
+            vec3 backward = pos;
+            forward[i] += 1.0f;
+            backward[i] -= 1.0f;
+            g[i] = 0.5f * (sample(clamp(forward)) - sample(clamp(backward)));
+        }
+        return g;
+    }
+
+private:
+    size3_t dims_;
+    ivec3 maxIndex_;
+    ivec3 maxCell_;
+    size3_t strides_;
+    size_t channel_;
+    std::vector<float> data_;
+};
+
+/**
+ * The masked transfer function as a TFLookupTable, with a prefix count of the visible table entries
+ * to quickly find value ranges that are completely transparent.
+ */
+class IVW_MODULE_BASE_API TFLookup {
+public:
+    explicit TFLookup(const TransferFunction& tf);
+
+    vec4 operator()(float value) const { return table_.sample(value); }
+
+    //! True if all values in [min, max] are mapped to zero opacity
+    bool isTransparent(float min, float max) const {
+        const auto lo = entry(min);
+        const auto hi = std::min(entry(max) + 1, table_.size() - 1);
+        return visible_[hi + 1] == visible_[lo];
+    }
+
+private:
+    //! The table entry at or below value, using the same clamping as TFLookupTable::sample
+    size_t entry(float value) const {
+        const double last = static_cast<double>(table_.size() - 1);
+        const double v = value > 0.0f ? (value < 1.0f ? value : 1.0f) : 0.0f;
+        return static_cast<size_t>(v * last);
+    }
+
+    TFLookupTable table_;
+    std::vector<size_t> visible_;  // Prefix count of table entries with non-zero opacity
+};
+
+/**
+ * Bricks of brickSize^3 cells, marked as empty if the transfer function is transparent for all
+ * values of the brick. Bricks include the voxels of the next brick along each axis such that a
+ * sample anywhere in a cell of the brick only depends on voxels of the brick.
+ */
+class IVW_MODULE_BASE_API BrickGrid {
+public:
+    BrickGrid(const ScalarGrid& grid, const TFLookup& tf, size_t brickSize);
+
+    int brickSize() const { return brickSize_; }
+
+    ivec3 brick(const ivec3& cell) const { return cell / brickSize_; }
+
+    bool isEmpty(const ivec3& brick) const {
+        return empty_[brick.x + dims_.x * (brick.y + dims_.y * brick.z)] != 0;
+    }
+
+private:
+    int brickSize_;
+    ivec3 dims_;
+    std::vector<char> empty_;
+};
+
+/**
+ * Renders a volume with direct volume rendering on the CPU, without any need for OpenGL.
+ * The result matches the DVR mode of the VolumeRaycaster using trilinear interpolation, central
+ * differences, and the same shading and opacity correction. The entry and exit points of each ray
+ * are computed by intersecting the view ray with the volume bounding box. The image is split into
+ * tiles that are rendered on the thread pool. Rays are terminated early when they become opaque
+ * and bricks of voxels where the transfer function is fully transparent are skipped, neither
+ * changes the result.
+ *
+ * The grid, lookup, and bricks are prepared separately since they only depend on the data and the
+ * transfer function and not on the camera, see VolumeRaycasterCPU for how they are reused.
+ *
+ * @param volume the volume to render, only used for its coordinate transforms
+ * @param grid the selected channel of the volume, the channel of settings is ignored
+ * @param lookup transfer function applied to the normalized values of the grid
+ * @param bricks bricks of grid and lookup used for empty space skipping, or nullptr to not skip
+ * @param camera the camera used to generate the rays
+ * @param dimensions size of the resulting image
+ * @param settings sampling rate, lighting, and early ray termination settings, the channel and
+ * the empty space skipping settings are given by grid and bricks
+ * @param stopCallback optional callback to test whether the rendering should be aborted. If it
+ * returns true the rendering stops as soon as possible and nullptr is returned.
+ * @return image with premultiplied colors and the depth of the first non-transparent sample
+ */
+IVW_MODULE_BASE_API std::shared_ptr<Image> raycastVolume(
+    const Volume& volume, const ScalarGrid& grid, const TFLookup& lookup, const BrickGrid* bricks,
+    const Camera& camera, size2_t dimensions, const VolumeRaycastingSettings& settings = {},
+    std::function<bool()> stopCallback = nullptr);
+
+/**
+ * Convenience function that prepares the grid, lookup, and bricks for a single rendering.
+ *
+ * @param volume the volume to render, the values are normalized using its data range
+ * @param tf transfer function applied to the normalized values of the selected channel
+ * @param camera the camera used to generate the rays
+ * @param dimensions size of the resulting image
+ * @param settings channel, sampling rate, lighting, and acceleration settings
+ * @param stopCallback optional callback to test whether the rendering should be aborted
+ * @see raycastVolume(const Volume&, const ScalarGrid&, const TFLookup&, const BrickGrid*,
+ * const Camera&, size2_t, const VolumeRaycastingSettings&, std::function<bool()>)
+ */
+IVW_MODULE_BASE_API std::shared_ptr<Image> raycastVolume(
+    const Volume& volume, const TransferFunction& tf, const Camera& camera, size2_t dimensions,
+    const VolumeRaycastingSettings& settings = {},
+    std::function<bool()> stopCallback = nullptr);
+
+}  // namespace util
+
+}  // namespace inviwo
@@ -43,6 +43,15 @@
 namespace inviwo {
 namespace util {
 
+/**
+ * Algorithms for computing the Voronoi segmentation, both give the same result.
+ *
+ *     * BruteForce compares every voxel with every seed point, O(voxels * seeds).
+ *     * SpatialIndex finds the closest seed points using a k-d tree of the seed points,
+ *       O(voxels * log(seeds)) when the weights are of similar size.
+ */
+enum class VoronoiMethod { BruteForce, SpatialIndex };
+
 /**
  * Implementation of Voronoi segmentation.
  *
@@ -58,12 +67,15 @@ namespace util {
  *     * wrapping the wrapping mode of the volume, @see Wrapping3D.
  *     * weigths is an optional vector containing the weights for each seed point. If set the
  *       weighted version of voronoi should be used.
+ *     * method the algorithm to use, @see VoronoiMethod. If several seed points are equally
+ *       close the first one is used.
  */
 
 IVW_MODULE_BASE_API std::shared_ptr<Volume> voronoiSegmentation(
     const size3_t volumeDimensions, const mat4& indexToModelMatrix,
     const std::vector<std::pair<uint32_t, vec3>>& seedPointsWithIndices, const Wrapping3D& wrapping,
-    const std::optional<std::vector<float>>& weights);
+    const std::optional<std::vector<float>>& weights,
+    VoronoiMethod method = VoronoiMethod::SpatialIndex);
 
 }  // namespace util
 }  // namespace inviwo
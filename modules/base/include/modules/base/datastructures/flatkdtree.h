@@ -0,0 +1,346 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2021 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#pragma once
+
+#include <inviwo/core/util/glm.h>
+#include <inviwo/core/util/parallel.h>
+
+#include <tcb/span.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <limits>
+#include <utility>
+#include <vector>
+
+namespace inviwo {
+
+/**
+ * \brief A static, balanced k-d tree stored in flat arrays.
+ *
+ * In contrast to KDTree, which allocates one node per point, the FlatKDTree is built once from all
+ * points and keeps no nodes at all. The points are reordered such that every range of the point
+ * array corresponds to a subtree: the median of a range is the splitting point of the subtree and
+ * the lower and upper halves are its two children. Ranges of at most `leafSize` points are leaves
+ * that are scanned linearly. The coordinates are stored per dimension (structure of arrays) in
+ * tree order, only the splitting dimension of every inner node and the original index of every
+ * point are stored in addition.
+ *
+ * The tree is built by splitting along the dimension of largest extent at the median, where
+ * every level of the tree is split in parallel on the thread pool. Queries return the indices of
+ * the points in the input, and write into caller provided buffers to avoid allocations. The batch
+ * query functions process many query points in parallel.
+ *
+ * Example:
+ * ```{.cpp}
+ * std::vector<vec3> points = ...;
+ * FlatKDTree<3, float> tree(points);
+ *
+ * std::array<size_t, 8> indices;
+ * std::array<float, 8> sqDistances;
+ * const auto found = tree.findNNearest(vec3{0.5f}, 8, indices, sqDistances);
+ * ```
+ * @see KDTree
+ */
+template <unsigned int N, typename P = double>
+class FlatKDTree {
+public:
+    using Point = Vector<N, P>;
+    /// Index used for missing results
+    static constexpr size_t npos = std::numeric_limits<size_t>::max();
+    static constexpr size_t defaultLeafSize = 16;
+
+    FlatKDTree() = default;
+    /**
+     * Build a tree from the given points. Indices returned from queries refer to positions in
+     * `points`.
+     */
+    explicit FlatKDTree(util::span<const Point> points, size_t leafSize = defaultLeafSize);
+    explicit FlatKDTree(const std::vector<Point>& points, size_t leafSize = defaultLeafSize)
+        : FlatKDTree(util::span<const Point>{points.data(), points.size()}, leafSize) {}
+
+    size_t size() const { return indices_.size(); }
+    bool empty() const { return indices_.empty(); }
+    size_t getLeafSize() const { return leafSize_; }
+
+    /**
+     * Find the point closest to `pos`.
+     * @return the index of the closest point or npos if the tree is empty.
+     */
+    size_t findNearest(const Point& pos) const;
+
+    /**
+     * Find the `k` points closest to `pos`. The indices and squared distances of the found points
+     * are written to the first elements of `indices` and `sqDistances`, ordered from closest to
+     * farthest. Both buffers need to hold at least `k` elements.
+     * @return the number of points found, min(k, size()).
+     */
+    size_t findNNearest(const Point& pos, size_t k, util::span<size_t> indices,
+                        util::span<P> sqDistances) const;
+
+    /**
+     * Find all points within `radius` of `pos`. The indices of the points are written to `result`,
+     * in no particular order, replacing its previous content.
+     */
+    void findCloseTo(const Point& pos, P radius, std::vector<size_t>& result) const;
+
+    /**
+     * Batch version of findNearest, `result[i]` is set to the closest point of `queries[i]`.
+     * The queries are processed in parallel.
+     */
+    void findNearest(util::span<const Point> queries, util::span<size_t> result) const;
+
+    /**
+     * Batch version of findNNearest, the results of `queries[i]` are written to
+     * `indices[i * k, (i + 1) * k)` and `sqDistances[i * k, (i + 1) * k)`. Missing results are
+     * set to npos and infinity. The queries are processed in parallel.
+     */
+    void findNNearest(util::span<const Point> queries, size_t k, util::span<size_t> indices,
+                      util::span<P> sqDistances) const;
+
+    /**
+     * Batch version of findCloseTo, `results` is resized to the number of queries and
+     * `results[i]` is filled with the points close to `queries[i]`. Reusing `results` between
+     * calls avoids reallocations. The queries are processed in parallel.
+     */
+    void findCloseTo(util::span<const Point> queries, P radius,
+                     std::vector<std::vector<size_t>>& results) const;
+
+private:
+    struct Range {
+        size_t begin;
+        size_t end;
+    };
+
+    /// A bounded list of the closest points found so far, sorted by distance
+    struct Neighbors {
+        size_t k;
+        size_t count;
+        size_t* indices;
+        P* sqDistances;
+
+        P worst() const {
+            return count < k ? std::numeric_limits<P>::infinity() : sqDistances[k - 1];
+        }
+        void add(size_t index, P sqDist) {
+            if (sqDist >= worst()) return;
+            size_t i = count < k ? count++ : k - 1;
+            for (; i > 0 && sqDistances[i - 1] > sqDist; --i) {
+                sqDistances[i] = sqDistances[i - 1];
+                indices[i] = indices[i - 1];
+            }
+            sqDistances[i] = sqDist;
+            indices[i] = index;
+        }
+    };
+
+    size_t mid(size_t begin, size_t end) const { return begin + (end - begin) / 2; }
+    bool isLeaf(size_t begin, size_t end) const { return end - begin <= leafSize_; }
+
+    P sqDistance(size_t i, const Point& pos) const {
+        P sum{0};
+        for (unsigned int d = 0; d < N; ++d) {
+            const P diff = coords_[d][i] - pos[d];
+            sum += diff * diff;
+        }
+        return sum;
+    }
+
+    void nearest(size_t begin, size_t end, const Point& pos, Neighbors& neighbors) const;
+    void closeTo(size_t begin, size_t end, const Point& pos, P sqRadius,
+                 std::vector<size_t>& result) const;
+
+    size_t leafSize_ = defaultLeafSize;
+    std::array<std::vector<P>, N> coords_;  // coordinates in tree order
+    std::vector<size_t> indices_;           // input index of each point in tree order
+    std::vector<std::uint8_t> splitDims_;   // split dimension of inner nodes, at the median
+};
+
+template <typename P = double>
+using FlatK2DTree = FlatKDTree<2, P>;
+template <typename P = double>
+using FlatK3DTree = FlatKDTree<3, P>;
+template <typename P = double>
+using FlatK4DTree = FlatKDTree<4, P>;
+
+template <unsigned int N, typename P>
+FlatKDTree<N, P>::FlatKDTree(util::span<const Point> points, size_t leafSize)
+    : leafSize_{std::max(leafSize, size_t{1})}, indices_(points.size()), splitDims_(points.size()) {
+
+    for (size_t i = 0; i < indices_.size(); ++i) indices_[i] = i;
+
+    // Split all ranges of one level of the tree in parallel. The first levels only have a few
+    // large ranges, those are partitioned by a single thread each.
+    std::vector<Range> level;
+    if (!isLeaf(0, points.size())) level.push_back({0, points.size()});
+    std::vector<Range> next;
+    while (!level.empty()) {
+        next.assign(2 * level.size(), Range{0, 0});
+        util::parallelFor(
+            0, level.size(),
+            [&](size_t r) {
+                const auto [begin, end] = level[r];
+
+                Point lower{std::numeric_limits<P>::max()};
+                Point upper{std::numeric_limits<P>::lowest()};
+                for (size_t i = begin; i < end; ++i) {
+                    lower = glm::min(lower, points[indices_[i]]);
+                    upper = glm::max(upper, points[indices_[i]]);
+                }
+                const auto extent = upper - lower;
+                std::uint8_t dim = 0;
+                for (unsigned int d = 1; d < N; ++d) {
+                    if (extent[d] > extent[dim]) dim = static_cast<std::uint8_t>(d);
+                }
+
+                const auto m = mid(begin, end);
+                std::nth_element(
+                    indices_.begin() + begin, indices_.begin() + m, indices_.begin() + end,
+                    [&](size_t a, size_t b) { return points[a][dim] < points[b][dim]; });
+                splitDims_[m] = dim;
+
+                if (!isLeaf(begin, m)) next[2 * r] = Range{begin, m};
+                if (!isLeaf(m + 1, end)) next[2 * r + 1] = Range{m + 1, end};
+            },
+            1);
+        next.erase(std::remove_if(next.begin(), next.end(),
+                                  [](const Range& range) { return range.begin == range.end; }),
+                   next.end());
+        std::swap(level, next);
+    }
+
+    for (auto& coord : coords_) coord.resize(points.size());
+    util::parallelFor(0, points.size(), [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+            for (unsigned int d = 0; d < N; ++d) coords_[d][i] = points[indices_[i]][d];
+        }
+    });
+}
+
+template <unsigned int N, typename P>
+void FlatKDTree<N, P>::nearest(size_t begin, size_t end, const Point& pos,
+                               Neighbors& neighbors) const {
+    if (isLeaf(begin, end)) {
+        for (size_t i = begin; i < end; ++i) neighbors.add(i, sqDistance(i, pos));
+        return;
+    }
+
+    const auto m = mid(begin, end);
+    const auto dim = splitDims_[m];
+    const P diff = pos[dim] - coords_[dim][m];
+    neighbors.add(m, sqDistance(m, pos));
+
+    // Visit the side containing pos first, and the other only if it can contain closer points
+    if (diff < P{0}) {
+        nearest(begin, m, pos, neighbors);
+        if (diff * diff < neighbors.worst()) nearest(m + 1, end, pos, neighbors);
+    } else {
+        nearest(m + 1, end, pos, neighbors);
+        if (diff * diff < neighbors.worst()) nearest(begin, m, pos, neighbors);
+    }
+}
+
+template <unsigned int N, typename P>
+void FlatKDTree<N, P>::closeTo(size_t begin, size_t end, const Point& pos, P sqRadius,
+                               std::vector<size_t>& result) const {
+    if (isLeaf(begin, end)) {
+        for (size_t i = begin; i < end; ++i) {
+            if (sqDistance(i, pos) <= sqRadius) result.push_back(indices_[i]);
+        }
+        return;
+    }
+
+    const auto m = mid(begin, end);
+    const auto dim = splitDims_[m];
+    const P diff = pos[dim] - coords_[dim][m];
+    if (sqDistance(m, pos) <= sqRadius) result.push_back(indices_[m]);
+    if (diff <= P{0} || diff * diff <= sqRadius) closeTo(begin, m, pos, sqRadius, result);
+    if (diff >= P{0} || diff * diff <= sqRadius) closeTo(m + 1, end, pos, sqRadius, result);
+}
+
+template <unsigned int N, typename P>
+size_t FlatKDTree<N, P>::findNearest(const Point& pos) const {
+    size_t index = npos;
+    P sqDist;
+    findNNearest(pos, 1, util::span<size_t>{&index, 1}, util::span<P>{&sqDist, 1});
+    return index;
+}
+
+template <unsigned int N, typename P>
+size_t FlatKDTree<N, P>::findNNearest(const Point& pos, size_t k, util::span<size_t> indices,
+                                      util::span<P> sqDistances) const {
+    k = std::min({k, indices.size(), sqDistances.size()});
+    if (k == 0 || empty()) return 0;
+
+    Neighbors neighbors{k, 0, indices.data(), sqDistances.data()};
+    nearest(0, size(), pos, neighbors);
+    // The search works on tree positions, translate them to input indices
+    for (size_t i = 0; i < neighbors.count; ++i) indices[i] = indices_[indices[i]];
+    return neighbors.count;
+}
+
+template <unsigned int N, typename P>
+void FlatKDTree<N, P>::findCloseTo(const Point& pos, P radius, std::vector<size_t>& result) const {
+    result.clear();
+    if (empty()) return;
+    closeTo(0, size(), pos, radius * radius, result);
+}
+
+template <unsigned int N, typename P>
+void FlatKDTree<N, P>::findNearest(util::span<const Point> queries,
+                                   util::span<size_t> result) const {
+    util::parallelFor(0, std::min(queries.size(), result.size()),
+                      [&](size_t i) { result[i] = findNearest(queries[i]); });
+}
+
+template <unsigned int N, typename P>
+void FlatKDTree<N, P>::findNNearest(util::span<const Point> queries, size_t k,
+                                    util::span<size_t> indices, util::span<P> sqDistances) const {
+    if (k == 0) return;
+    const auto count = std::min({queries.size(), indices.size() / k, sqDistances.size() / k});
+    util::parallelFor(0, count, [&](size_t i) {
+        auto ind = indices.subspan(i * k, k);
+        auto dist = sqDistances.subspan(i * k, k);
+        const auto found = findNNearest(queries[i], k, ind, dist);
+        std::fill(ind.begin() + found, ind.end(), npos);
+        std::fill(dist.begin() + found, dist.end(), std::numeric_limits<P>::infinity());
+    });
+}
+
+template <unsigned int N, typename P>
+void FlatKDTree<N, P>::findCloseTo(util::span<const Point> queries, P radius,
+                                   std::vector<std::vector<size_t>>& results) const {
+    results.resize(queries.size());
+    util::parallelFor(0, queries.size(),
+                      [&](size_t i) { findCloseTo(queries[i], radius, results[i]); });
+}
+
+}  // namespace inviwo
@@ -0,0 +1,108 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2021 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#pragma once
+
+#include <modules/base/basemoduledefine.h>
+#include <modules/base/algorithm/volume/volumeramsubsample.h>
+
+#include <inviwo/core/datastructures/volume/volume.h>
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace inviwo {
+
+/**
+ * \brief A multi-resolution pyramid of a volume where the levels are computed on demand
+ *
+ * Level 0 is the volume itself, every following level halves the dimensions of the previous one,
+ * rounding up, and the last level has a single voxel. Level i is computed from level i - 1 with
+ * util::volumeHalfSample, so every level only reads the next finer one. Level 1 is computed from
+ * the VolumeBrickedRAM representation of the volume if it has one, hence a preview of a large
+ * bricked volume never needs a RAM representation of the full resolution.
+ *
+ * Levels are created on first request and are kept as long as the pyramid. Use
+ * VolumePyramid::get to share a pyramid between all users of the same volume. All functions are
+ * thread safe. Every level is computed once, callers of getLevel asking for a level that is being
+ * computed wait for it, while hasLevel never waits.
+ */
+class IVW_MODULE_BASE_API VolumePyramid {
+public:
+    explicit VolumePyramid(std::shared_ptr<const Volume> volume,
+                           VolumeReduction reduction = VolumeReduction::Average);
+
+    /**
+     * Get the pyramid of volume with the given reduction. The pyramid is shared with any other
+     * caller asking for the same volume and reduction as long as someone keeps a reference to it,
+     * otherwise a new one is created. The pyramid assumes that the volume is not modified.
+     */
+    static std::shared_ptr<VolumePyramid> get(std::shared_ptr<const Volume> volume,
+                                              VolumeReduction reduction = VolumeReduction::Average);
+
+    const std::shared_ptr<const Volume>& getVolume() const;
+    VolumeReduction getReduction() const;
+
+    size_t getNumberOfLevels() const;
+    size3_t getDimensions(size_t level) const;
+
+    /**
+     * The finest level with at most maxVoxels voxels, or the last level if no level is that small
+     */
+    size_t getLevelForVoxelBudget(size_t maxVoxels) const;
+
+    /**
+     * Returns true if the level has been computed already. Does not wait for a level that is
+     * being computed by another thread.
+     */
+    bool hasLevel(size_t level) const;
+
+    /**
+     * Get a level of the pyramid, computing it and any missing finer level first. The
+     * levels share the meta data, data map, and transformations of the volume.
+     * @throw RangeException if level >= getNumberOfLevels()
+     */
+    std::shared_ptr<const Volume> getLevel(size_t level);
+
+private:
+    std::shared_ptr<const Volume> volume_;
+    VolumeReduction reduction_;
+    std::vector<size3_t> dimensions_;
+
+    struct Level {
+        std::once_flag once;
+        std::atomic<bool> done{false};
+        std::shared_ptr<const Volume> volume;
+    };
+    std::vector<Level> levels_;
+};
+
+}  // namespace inviwo
@@ -0,0 +1,123 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2021 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#pragma once
+
+#include <modules/base/basemoduledefine.h>
+
+#include <inviwo/core/datastructures/volume/volume.h>
+#include <inviwo/core/util/threadpool.h>
+
+#include <future>
+#include <memory>
+#include <optional>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+namespace inviwo {
+
+/**
+ * \brief Loads the time steps of a volume sequence ahead of time
+ *
+ * Volumes read from disk, for example by the DatVolumeSequenceReader, only create their RAM
+ * representation when it is first requested, which stalls playback of a sequence on every time
+ * step. Every call to access() tells the prefetcher which time step is used. It then loads the
+ * following time steps, in the direction of playback, on the thread pool. Memory mapped data is
+ * read as well. Loaded time steps outside of the lookahead window are released again when the
+ * memory budget is exceeded, starting with the ones that will be needed last. Only volumes with a
+ * valid disk representation that are not referenced anywhere else are released. Hence no edited
+ * data and no volume in use by a port is lost.
+ *
+ * All functions have to be called from the same thread, usually the main thread.
+ */
+class IVW_MODULE_BASE_API VolumeSequencePrefetcher {
+public:
+    struct Statistics {
+        size_t hits = 0;        ///< Accessed time steps that were already loaded
+        size_t misses = 0;      ///< Accessed time steps that were not yet loaded
+        size_t prefetched = 0;  ///< Time steps loaded in the background
+        size_t evicted = 0;     ///< Time steps that were released
+    };
+
+    /**
+     * @param lookahead number of time steps to load ahead of the accessed one
+     * @param memoryBudget max number of bytes used by the loaded time steps, the accessed time
+     * step is always kept
+     * @param pool the thread pool to load the time steps on, the pool of the InviwoApplication
+     * if null
+     */
+    explicit VolumeSequencePrefetcher(size_t lookahead = 2,
+                                      size_t memoryBudget = size_t{1} << 30,
+                                      ThreadPool* pool = nullptr);
+
+    void setSequence(std::shared_ptr<const VolumeSequence> sequence);
+    void setLookahead(size_t lookahead);
+    size_t getLookahead() const;
+    void setMemoryBudget(size_t bytes);
+    size_t getMemoryBudget() const;
+
+    /**
+     * Register that the time step at index is used. Updates the statistics and the direction of
+     * playback, releases time steps if needed, and starts loading the next time steps.
+     */
+    void access(size_t index);
+
+    const Statistics& getStatistics() const;
+    void resetStatistics();
+
+    /**
+     * The number of bytes used by the time steps that are loaded or are being loaded
+     */
+    size_t getLoadedBytes() const;
+
+    /**
+     * Wait until all time steps that are being loaded are done
+     */
+    void waitForPrefetches();
+
+private:
+    std::vector<size_t> window(size_t index) const;
+    void collectFinished();
+    void evict(size_t index, const std::vector<size_t>& window, size_t required);
+    void evict(size_t index);
+
+    std::shared_ptr<const VolumeSequence> sequence_;
+    size_t lookahead_;
+    size_t memoryBudget_;
+    ThreadPool* pool_;
+
+    std::optional<size_t> previous_;
+    bool forward_ = true;
+    std::unordered_map<size_t, std::future<void>> pending_;
+    std::unordered_set<size_t> loaded_;
+    Statistics stats_;
+};
+
+}  // namespace inviwo
@@ -0,0 +1,95 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2021 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#pragma once
+
+#include <modules/base/basemoduledefine.h>
+#include <inviwo/core/datastructures/volume/volumebrickedram.h>
+
+#include <cstdint>
+#include <iosfwd>
+#include <string>
+#include <vector>
+
+namespace inviwo {
+
+class Volume;
+
+/**
+ * Compression of the bricks in a bricked ivf raw file
+ */
+enum class IvfCompression { None, Zlib };
+
+/**
+ * \class CompressedVolumeBrickLoader
+ * \brief Loads the bricks of a VolumeBrickedRAM from a compressed bricked raw file.
+ *
+ * A compressed raw file starts with an index of `numberOfBricks + 1` 64-bit byte offsets,
+ * counted from the start of the index. Brick `i`, in the same order as in a RawVolumeBrickLoader
+ * file, is stored compressed between entry `i` and `i + 1`. The index is read once on
+ * construction, every brick is then read and decompressed independently, so the bricks of a
+ * region are decoded concurrently by VolumeBrickedRAM::getRegion and only the bricks that are
+ * used are ever read.
+ * @see util::writeCompressedBricks, IvfVolumeReader
+ */
+class IVW_MODULE_BASE_API CompressedVolumeBrickLoader : public VolumeBrickLoader {
+public:
+    /**
+     * @throw DataReaderException if the index can not be read
+     */
+    CompressedVolumeBrickLoader(const std::string& rawFile, size_t offset, bool littleEndian,
+                                IvfCompression compression, size_t numberOfBricks);
+    virtual std::shared_ptr<VolumeRAM> loadBrick(const VolumeBrickedRAM& volume,
+                                                 size3_t brick) const override;
+
+    const std::vector<std::uint64_t>& getIndex() const;
+
+private:
+    std::string rawFile_;
+    size_t offset_;
+    bool littleEndian_;
+    IvfCompression compression_;
+    std::vector<std::uint64_t> index_;
+};
+
+namespace util {
+
+/**
+ * Write `data` as a compressed bricked raw file to `out`, see CompressedVolumeBrickLoader for the
+ * layout. The bricks are extracted and compressed in parallel, a batch at a time, and written in
+ * order. If `data` has a VolumeBrickedRAM representation the bricks are taken from it and the
+ * volume does not need to fit in memory.
+ * @throw DataWriterException if compression fails
+ */
+IVW_MODULE_BASE_API void writeCompressedBricks(const Volume& data, size3_t brickSize,
+                                               IvfCompression compression, std::ostream& out);
+
+}  // namespace util
+
+}  // namespace inviwo
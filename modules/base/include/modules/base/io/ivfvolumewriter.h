@@ -30,6 +30,7 @@
 #pragma once
 
 #include <modules/base/basemoduledefine.h>
+#include <modules/base/io/compressedvolumebrickloader.h>
 #include <inviwo/core/io/datawriter.h>
 #include <inviwo/core/datastructures/volume/volume.h>
 
@@ -47,11 +48,43 @@ public:
     virtual ~IvfVolumeWriter() {}
 
     virtual void writeData(const Volume* data, const std::string filePath) const;
+
+    /**
+     * Write the raw data in bricks of the given size, a brick size of zero writes an unbricked
+     * file.
+     * @see util::writeIvfVolume
+     */
+    void setBrickSize(size3_t brickSize);
+    size3_t getBrickSize() const;
+
+    /**
+     * Compress the bricks of the raw data, compressed files are always bricked.
+     * @see util::writeIvfVolume
+     */
+    void setCompression(IvfCompression compression);
+    IvfCompression getCompression() const;
+
+private:
+    size3_t brickSize_{0};
+    IvfCompression compression_{IvfCompression::None};
 };
 
 namespace util {
+/**
+ * Write `data` to an ivf file and a raw file next to it. If `brickSize` is non zero the raw data
+ * is written in bricks, see RawVolumeBrickLoader for the layout. Reading such a file will give a
+ * volume with a VolumeBrickedRAM representation that only loads the bricks that are used. When
+ * writing a bricked file from a volume that has a VolumeBrickedRAM representation the bricks are
+ * copied one at a time, the volume does not need to fit in memory.
+ *
+ * If `compression` is not IvfCompression::None the bricks are compressed individually and the raw
+ * file starts with an index of the bricks, see CompressedVolumeBrickLoader. A brick size of
+ * 64x64x64 is used if `brickSize` is zero. Reading such a file gives a VolumeBrickedRAM that
+ * decompresses the bricks in parallel and only reads the bricks of the requested regions.
+ */
 IVW_MODULE_BASE_API void writeIvfVolume(const Volume& data, const std::string filePath,
-                                        bool overwrite = false);
+                                        bool overwrite = false, size3_t brickSize = size3_t{0},
+                                        IvfCompression compression = IvfCompression::None);
 }
 
 }  // namespace inviwo
@@ -0,0 +1,77 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2021 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#pragma once
+
+#include <modules/base/basemoduledefine.h>
+#include <inviwo/core/processors/poolprocessor.h>
+#include <inviwo/core/ports/volumeport.h>
+#include <inviwo/core/properties/optionproperty.h>
+#include <inviwo/core/properties/transferfunctionproperty.h>
+#include <inviwo/core/util/formats.h>
+
+namespace inviwo {
+
+/** \docpage{org.inviwo.VolumeClassificationCPU, Volume Classification CPU}
+ * ![](org.inviwo.VolumeClassificationCPU.png?classIdentifier=org.inviwo.VolumeClassificationCPU)
+ * Applies a transfer function to a scalar volume on the CPU, resulting in an RGBA volume with
+ * the colors and opacities of the voxels. Useful for offline classification and for exporting
+ * classified data. See util::classifyVolume.
+ *
+ * ### Inports
+ *   * __volume__ input volume
+ *
+ * ### Outports
+ *   * __outport__ classified RGBA volume
+ *
+ * ### Properties
+ *   * __Channel__ selects which channel of the input volume is classified
+ *   * __Transfer Function__ transfer function applied to the normalized volume values
+ *   * __Output Format__ 8 bit unsigned integer or 32 bit float RGBA
+ */
+class IVW_MODULE_BASE_API VolumeClassificationCPU : public PoolProcessor {
+public:
+    VolumeClassificationCPU();
+    virtual ~VolumeClassificationCPU() = default;
+
+    virtual void process() override;
+
+    virtual const ProcessorInfo getProcessorInfo() const override;
+    static const ProcessorInfo processorInfo_;
+
+private:
+    VolumeInport volume_;
+    VolumeOutport outport_;
+
+    OptionPropertyInt channel_;
+    TransferFunctionProperty tf_;
+    TemplateOptionProperty<DataFormatId> format_;
+};
+
+}  // namespace inviwo
@@ -0,0 +1,85 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2021 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#pragma once
+
+#include <modules/base/basemoduledefine.h>
+#include <modules/base/datastructures/volumepyramid.h>
+#include <inviwo/core/processors/poolprocessor.h>
+#include <inviwo/core/ports/volumeport.h>
+#include <inviwo/core/properties/optionproperty.h>
+#include <inviwo/core/properties/ordinalproperty.h>
+
+namespace inviwo {
+
+/** \docpage{org.inviwo.VolumeLevelOfDetail, Volume Level Of Detail}
+ * ![](org.inviwo.VolumeLevelOfDetail.png?classIdentifier=org.inviwo.VolumeLevelOfDetail)
+ * Outputs a downsampled level of a volume for interactive previews. The levels are taken from a
+ * VolumePyramid, so each level is computed only once and from the next finer level. The pyramid
+ * is shared with other processors that use the same volume and reduction.
+ *
+ * ### Inports
+ *   * __volume__ input volume
+ *
+ * ### Outports
+ *   * __outport__ the selected level, the input volume itself for level 0
+ *
+ * ### Properties
+ *   * __Select Level By__ use a fixed level or the finest level within a voxel budget
+ *   * __Level__ level to output, 0 is full resolution and each level halves the dimensions
+ *   * __Max Voxels (millions)__ the voxel budget
+ *   * __Reduction__ how voxels are combined: average, minimum, or maximum
+ *   * __Output Dimensions__ dimensions of the selected level (read-only)
+ */
+class IVW_MODULE_BASE_API VolumeLevelOfDetail : public PoolProcessor {
+public:
+    enum class Selection { Level, VoxelBudget };
+
+    VolumeLevelOfDetail();
+    virtual ~VolumeLevelOfDetail() = default;
+
+    virtual void process() override;
+
+    virtual const ProcessorInfo getProcessorInfo() const override;
+    static const ProcessorInfo processorInfo_;
+
+private:
+    VolumeInport volume_;
+    VolumeOutport outport_;
+
+    TemplateOptionProperty<Selection> selection_;
+    IntSizeTProperty level_;
+    DoubleProperty voxelBudget_;
+    TemplateOptionProperty<VolumeReduction> reduction_;
+    IntSize3Property outputDimensions_;
+
+    std::shared_ptr<VolumePyramid> pyramid_;
+};
+
+}  // namespace inviwo
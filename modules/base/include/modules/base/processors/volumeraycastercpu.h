@@ -0,0 +1,123 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2021 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#pragma once
+
+#include <modules/base/basemoduledefine.h>
+#include <inviwo/core/processors/poolprocessor.h>
+#include <inviwo/core/ports/imageport.h>
+#include <inviwo/core/ports/volumeport.h>
+#include <inviwo/core/properties/boolproperty.h>
+#include <inviwo/core/properties/cameraproperty.h>
+#include <inviwo/core/properties/optionproperty.h>
+#include <inviwo/core/properties/ordinalproperty.h>
+#include <inviwo/core/properties/simplelightingproperty.h>
+#include <inviwo/core/properties/transferfunctionproperty.h>
+
+#include <memory>
+#include <mutex>
+
+namespace inviwo {
+
+namespace util {
+class ScalarGrid;
+class TFLookup;
+class BrickGrid;
+}  // namespace util
+
+/** \docpage{org.inviwo.VolumeRaycasterCPU, Volume Raycaster CPU}
+ * ![](org.inviwo.VolumeRaycasterCPU.png?classIdentifier=org.inviwo.VolumeRaycasterCPU)
+ * Direct volume rendering on the CPU, for systems without a GPU like headless render nodes.
+ * The entry and exit points are computed from the camera and the volume bounding box, hence no
+ * EntryExitPoints processor is needed. The image is rendered in tiles on the thread pool, see
+ * util::raycastVolume. The normalized volume and the empty space skipping bricks are kept between
+ * renderings and only recomputed when the volume, the channel, or the transfer function changes.
+ *
+ * ### Inports
+ *   * __volume__ input volume
+ *
+ * ### Outports
+ *   * __outport__ output image containing the volume rendering of the input
+ *
+ * ### Properties
+ *   * __Render Channel__ selects which channel of the input volume is rendered
+ *   * __Sampling Rate__ number of samples per voxel along the rays
+ *   * __Transfer Function__ transfer function applied to the normalized volume values
+ *   * __Early Ray Termination__ rays are stopped when their opacity exceeds this threshold
+ *   * __Empty Space Skipping__ skip bricks of voxels that are fully transparent
+ *   * __Camera__ camera used to generate the rays
+ *   * __Lighting__ lighting properties
+ */
+class IVW_MODULE_BASE_API VolumeRaycasterCPU : public PoolProcessor {
+public:
+    VolumeRaycasterCPU();
+    virtual ~VolumeRaycasterCPU() = default;
+
+    virtual void process() override;
+
+    virtual const ProcessorInfo getProcessorInfo() const override;
+    static const ProcessorInfo processorInfo_;
+
+private:
+    /**
+     * A value computed on demand by the first background job that needs it and then shared with
+     * all later jobs. The processor replaces the whole object when its inputs change.
+     */
+    template <typename T>
+    class Cached {
+    public:
+        template <typename Create>
+        std::shared_ptr<const T> get(Create&& create) {
+            std::scoped_lock lock{mutex_};
+            if (!value_) value_ = create();
+            return value_;
+        }
+
+    private:
+        std::mutex mutex_;
+        std::shared_ptr<const T> value_;
+    };
+
+    VolumeInport volume_;
+    ImageOutport outport_;
+
+    OptionPropertyInt channel_;
+    FloatProperty samplingRate_;
+    TransferFunctionProperty tf_;
+    FloatProperty earlyRayTermination_;
+    BoolProperty emptySpaceSkipping_;
+    CameraProperty camera_;
+    SimpleLightingProperty lighting_;
+
+    std::shared_ptr<Cached<util::ScalarGrid>> grid_;
+    std::shared_ptr<const util::TFLookup> lookup_;
+    std::shared_ptr<Cached<util::BrickGrid>> bricks_;
+};
+
+}  // namespace inviwo
@@ -32,6 +32,10 @@
 #include <modules/base/basemoduledefine.h>
 #include <inviwo/core/datastructures/volume/volume.h>
 #include <inviwo/core/ports/volumeport.h>
+#include <inviwo/core/properties/boolcompositeproperty.h>
+#include <inviwo/core/properties/buttonproperty.h>
+#include <inviwo/core/properties/ordinalproperty.h>
+#include <modules/base/datastructures/volumesequenceprefetcher.h>
 #include <modules/base/processors/vectorelementselectorprocessor.h>
 
 namespace inviwo {
@@ -39,7 +43,8 @@ namespace inviwo {
 /** \docpage{org.inviwo.TimeStepSelector, Volume Sequence/Time Selector}
  * ![](org.inviwo.TimeStepSelector.png?classIdentifier=org.inviwo.TimeStepSelector)
  *
- * Select a specific volume out of a sequence of volumes
+ * Select a specific volume out of a sequence of volumes. The following time steps are loaded
+ * in the background, see VolumeSequencePrefetcher.
  *
  * ### Inport
  *   * __inport__ Sequence of volumes
@@ -48,6 +53,11 @@ namespace inviwo {
  *
  * ### Properties
  *   * __Step__ The volume sequence index to extract
+ *   * __Prefetch__ Load the next time steps in the direction of playback in the background
+ *       + __Time Steps Ahead__ Number of time steps to load ahead
+ *       + __Memory Budget (MB)__ Loaded time steps outside of the lookahead are released when
+ *         more memory is used
+ *       + __Hits__, __Misses__ Number of selected time steps that were or were not loaded yet
  */
 class IVW_MODULE_BASE_API VolumeSequenceElementSelectorProcessor
     : public VectorElementSelectorProcessor<Volume> {
@@ -55,8 +65,22 @@ public:
     VolumeSequenceElementSelectorProcessor();
     virtual ~VolumeSequenceElementSelectorProcessor() = default;
 
+    virtual void process() override;
+
     virtual const ProcessorInfo getProcessorInfo() const override;
     static const ProcessorInfo processorInfo_;
+
+private:
+    void updateStatistics();
+
+    BoolCompositeProperty prefetch_;
+    IntSizeTProperty lookahead_;
+    IntSizeTProperty memoryBudget_;
+    IntSizeTProperty hits_;
+    IntSizeTProperty misses_;
+    ButtonProperty resetStatistics_;
+
+    VolumeSequencePrefetcher prefetcher_;
 };
 
 }  // namespace inviwo
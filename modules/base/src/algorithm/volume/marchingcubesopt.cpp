@@ -30,13 +30,17 @@
 #include <modules/base/algorithm/volume/marchingcubesopt.h>
 #include <modules/base/algorithm/volume/surfaceextraction.h>
 #include <inviwo/core/util/indexmapper.h>
+#include <inviwo/core/util/parallel.h>
 
 #include <modules/base/datastructures/disjointsets.h>
 #include <glm/gtx/normal.hpp>
 
 #include <algorithm>
-#include <limits>
+#include <atomic>
 #include <bitset>
+#include <cstdint>
+#include <limits>
+#include <mutex>
 
 namespace inviwo {
 
@@ -429,6 +433,90 @@ template <typename T, typename IsoTest>
 const std::array<OffsetIndexMasks, 4> Index<T, IsoTest>::oim_ = {
     {{0, 1, {0, 0, 0}}, {3, 2, {0, 1, 0}}, {4, 5, {0, 0, 1}}, {7, 6, {0, 1, 1}}}};
 
+constexpr std::uint32_t noVertex = std::numeric_limits<std::uint32_t>::max();
+
+/**
+ * Vertex ids for the edges of one layer of cells. The x and y edges are stored for the lower
+ * (curr) and upper (next) plane of the layer, the z edges for the edges between the planes.
+ */
+class EdgeCache {
+public:
+    enum Plane { xCurr, yCurr, xNext, yNext, zEdge };
+
+    EdgeCache(const size2_t& dim) : dimX_{dim.x} {
+        for (auto& plane : cache_) plane.assign(dim.x * dim.y, noVertex);
+    }
+
+    std::uint32_t& get(const size3_t& ind, int edge) {
+        const auto& [plane, dx, dy] = edges_[edge];
+        return cache_[plane][(ind.y + dy) * dimX_ + ind.x + dx];
+    }
+
+    void nextLayer() {
+        std::swap(cache_[xCurr], cache_[xNext]);
+        std::swap(cache_[yCurr], cache_[yNext]);
+        for (auto plane : {xNext, yNext, zEdge}) {
+            std::fill(cache_[plane].begin(), cache_[plane].end(), noVertex);
+        }
+    }
+
+    /**
+     * Append the vertices of the lower or upper plane as (edge key, vertex id), sorted by key.
+     */
+    void collect(bool next, std::vector<std::pair<size_t, std::uint32_t>>& vertices) const {
+        const auto& xs = cache_[next ? xNext : xCurr];
+        const auto& ys = cache_[next ? yNext : yCurr];
+        for (size_t i = 0; i < xs.size(); ++i) {
+            if (xs[i] != noVertex) vertices.emplace_back(2 * i, xs[i]);
+            if (ys[i] != noVertex) vertices.emplace_back(2 * i + 1, ys[i]);
+        }
+    }
+
+private:
+    struct EdgePos {
+        Plane plane;
+        size_t dx;
+        size_t dy;
+    };
+    static constexpr std::array<EdgePos, 12> edges_{{{xCurr, 0, 0},
+                                                     {yCurr, 1, 0},
+                                                     {xCurr, 0, 1},
+                                                     {yCurr, 0, 0},
+                                                     {zEdge, 0, 0},
+                                                     {zEdge, 1, 0},
+                                                     {zEdge, 1, 1},
+                                                     {zEdge, 0, 1},
+                                                     {xNext, 0, 0},
+                                                     {yNext, 1, 0},
+                                                     {xNext, 0, 1},
+                                                     {yNext, 0, 0}}};
+
+    size_t dimX_;
+    std::array<std::vector<std::uint32_t>, 5> cache_;
+};
+
+/**
+ * The part of the mesh extracted from one slab of cell layers. The vertices on the bottom plane
+ * are also found in the previous slab, they are merged once all slabs are done.
+ */
+struct Slab {
+    std::vector<vec3> positions;
+    std::vector<vec3> normals;
+    std::vector<std::uint32_t> indices;
+
+    std::vector<std::pair<size_t, std::uint32_t>> bottom;
+    std::vector<std::pair<size_t, std::uint32_t>> top;
+    // (vertex, vertex in the previous slab) for the vertices shared with the previous slab
+    std::vector<std::pair<std::uint32_t, std::uint32_t>> shared;
+
+    std::vector<std::uint32_t> global;
+    size_t vertexOffset = 0;
+    size_t indexOffset = 0;
+};
+
+constexpr size_t slabLayers = 16;
+constexpr size_t brickCells = 16;
+
 }  // namespace
 
 namespace util {
@@ -581,6 +669,275 @@ std::shared_ptr<Mesh> marchingCubesOpt(std::shared_ptr<const Volume> volume, dou
 
     return mesh;
 }
+
+std::shared_ptr<Mesh> marchingCubesParallel(std::shared_ptr<const Volume> volume, double iso,
+                                            const vec4& color, bool invert, bool enclose,
+                                            std::function<void(float)> progressCallback,
+                                            std::function<bool(const size3_t&)> maskingCallback,
+                                            std::function<bool()> stopCallback,
+                                            bool skipEmptyBricks) {
+
+    auto indexBuffer = std::make_shared<IndexBuffer>();
+    auto vertexBuffer = std::make_shared<Buffer<vec3>>();
+    auto textureBuffer = std::make_shared<Buffer<vec3>>();
+    auto colorBuffer = std::make_shared<Buffer<vec4>>();
+    auto normalBuffer = std::make_shared<Buffer<vec3>>();
+
+    auto indexRAM = indexBuffer->getEditableRAMRepresentation();
+    auto& indices = indexRAM->getDataContainer();
+    auto& positions = vertexBuffer->getEditableRAMRepresentation()->getDataContainer();
+    auto& textures = textureBuffer->getEditableRAMRepresentation()->getDataContainer();
+    auto& colors = colorBuffer->getEditableRAMRepresentation()->getDataContainer();
+    auto& normals = normalBuffer->getEditableRAMRepresentation()->getDataContainer();
+
+    if (progressCallback) progressCallback(0.0f);
+
+    std::atomic<bool> stopped{false};
+    const auto shouldStop = [&]() {
+        if (!stopped && stopCallback && stopCallback()) stopped = true;
+        return stopped.load();
+    };
+
+    const auto mc = [&](auto ram, auto isoTest, auto mapValue) {
+        using T = util::PrecisionValueType<decltype(ram)>;
+        static const marching::Config cube{};
+
+        const T* src = ram->getDataTyped();
+        const size3_t dim{volume->getDimensions()};
+        const size3_t dim1 = dim - size3_t{1, 1, 1};
+        const util::IndexMapper3D im(dim);
+
+        const auto dr = dvec3(1.0) / dvec3{glm::max(size3_t{1}, (dim - size3_t{1}))};
+
+        const auto interpolate = [src, im, dr, &mapValue](const size3_t& ind,
+                                                          marching::Config::EdgeId e) {
+            const auto a = cube.vertices[cube.edges[e][0]];
+            const auto b = cube.vertices[cube.edges[e][1]];
+            const auto v0 = mapValue(src[im(ind + a)]);
+            const auto v1 = mapValue(src[im(ind + b)]);
+
+            const auto t = v0 / (v0 - v1);
+            const auto r0 = dr * dvec3{ind + a};
+            const auto r1 = dr * dvec3{ind + b};
+            return r0 + t * (r1 - r0);
+        };
+
+        const float err =
+            static_cast<float>(4.0 * glm::epsilon<double>() * glm::epsilon<double>() * dr.x * dr.y);
+
+        // Find the bricks of cells that contain the surface, a brick can be skipped if the min and
+        // max values of its voxels are on the same side of the iso value.
+        const size3_t nBricks = (dim1 + size3_t{brickCells - 1}) / size3_t{brickCells};
+        const util::IndexMapper3D bim(nBricks);
+        std::vector<char> activeBricks;
+        if (skipEmptyBricks) {
+            activeBricks.resize(glm::compMul(nBricks));
+            util::parallelFor(0, activeBricks.size(), [&](size_t i) {
+                const auto begin = bim(i) * brickCells;
+                const auto end = glm::min(begin + size3_t{brickCells}, dim1);
+                T min = src[im(begin)];
+                T max = min;
+                for (size_t z = begin.z; z <= end.z; ++z) {
+                    for (size_t y = begin.y; y <= end.y; ++y) {
+                        for (size_t x = begin.x; x <= end.x; ++x) {
+                            const auto val = src[im(x, y, z)];
+                            if (val < min) min = val;
+                            if (max < val) max = val;
+                        }
+                    }
+                }
+                activeBricks[i] = isoTest(min) != isoTest(max);
+            });
+        }
+
+        std::atomic<size_t> layersDone{0};
+        std::mutex progressMutex;
+
+        const auto extractSlab = [&](Slab& slab, size_t z0, size_t z1) {
+            EdgeCache cache(size2_t{dim.x, dim.y});
+            Index<T, decltype(isoTest)> index(src, im, isoTest);
+            size3_t ind;
+
+            for (ind.z = z0; ind.z < z1; ++ind.z) {
+                if (shouldStop()) return;
+                if (ind.z != z0) cache.nextLayer();
+
+                for (ind.y = 0; ind.y < dim1.y; ++ind.y) {
+                    const auto cInd = im(size3_t{0, ind.y, ind.z});
+                    for (size_t bx = 0; bx < nBricks.x; ++bx) {
+                        if (!activeBricks.empty() &&
+                            !activeBricks[bim(bx, ind.y / brickCells, ind.z / brickCells)]) {
+                            continue;
+                        }
+                        ind.x = bx * brickCells;
+                        const auto xEnd = std::min(ind.x + brickCells, dim1.x);
+                        index.init(cInd + ind.x);
+                        for (; ind.x < xEnd; ++ind.x) {
+                            index.update(cInd + ind.x);
+                            if (index == 0 || index == 255) continue;
+                            if (maskingCallback && !maskingCallback(ind)) continue;
+
+                            std::array<std::uint32_t, 12> inds;
+                            for (const auto edge : cube.caseEdges[index]) {
+                                auto& vertex = cache.get(ind, edge);
+                                if (vertex == noVertex) {
+                                    vertex = static_cast<std::uint32_t>(slab.positions.size());
+                                    slab.positions.emplace_back(interpolate(ind, edge));
+                                    slab.normals.emplace_back(0.0f, 0.0f, 0.0f);
+                                }
+                                inds[edge] = vertex;
+                            }
+                            for (const auto& tri : cube.caseTriangles[index]) {
+                                const auto& p0 = slab.positions[inds[tri[0]]];
+                                const auto side0 = slab.positions[inds[tri[1]]] - p0;
+                                const auto side1 = slab.positions[inds[tri[2]]] - p0;
+                                auto n = glm::cross(side0, side1);
+                                if (glm::length2(n) < err) {
+                                    continue;  // triangle is so small area is 0.
+                                }
+                                n = glm::normalize(n);
+                                for (int v = 0; v < 3; ++v) {
+                                    slab.indices.push_back(inds[tri[v]]);
+                                    slab.normals[inds[tri[v]]] += n;
+                                }
+                            }
+                        }
+                    }
+                }
+                if (ind.z == z0) cache.collect(false, slab.bottom);
+
+                const auto done = ++layersDone;
+                if (progressCallback) {
+                    std::unique_lock<std::mutex> lock(progressMutex, std::try_to_lock);
+                    if (lock) {
+                        progressCallback(0.9f * static_cast<float>(done) /
+                                         static_cast<float>(dim1.z));
+                    }
+                }
+            }
+            cache.collect(true, slab.top);
+        };
+
+        std::vector<Slab> slabs((dim1.z + slabLayers - 1) / slabLayers);
+        util::parallelFor(
+            0, slabs.size(),
+            [&](size_t s) {
+                extractSlab(slabs[s], s * slabLayers, std::min(s * slabLayers + slabLayers, dim1.z));
+            },
+            1);
+        if (shouldStop()) return;
+
+        // Match the vertices on the bottom plane of each slab with the top plane of the previous
+        // one, both lists are sorted by edge key.
+        util::parallelFor(
+            1, slabs.size(),
+            [&](size_t s) {
+                const auto& top = slabs[s - 1].top;
+                const auto& bottom = slabs[s].bottom;
+                auto it = top.begin();
+                for (const auto& [key, vertex] : bottom) {
+                    it = std::lower_bound(it, top.end(), key,
+                                          [](const auto& item, size_t k) { return item.first < k; });
+                    if (it == top.end()) break;
+                    if (it->first == key) slabs[s].shared.emplace_back(vertex, it->second);
+                }
+            },
+            1);
+
+        size_t vertexCount = 0;
+        size_t indexCount = 0;
+        for (auto& slab : slabs) {
+            slab.vertexOffset = vertexCount;
+            slab.indexOffset = indexCount;
+            vertexCount += slab.positions.size() - slab.shared.size();
+            indexCount += slab.indices.size();
+        }
+        positions.resize(vertexCount);
+        normals.resize(vertexCount);
+        indices.resize(indexCount);
+
+        // Each slab first writes the vertices it owns and then adds its normals to the shared
+        // vertices owned by the previous slab
+        util::parallelFor(
+            0, slabs.size(),
+            [&](size_t s) {
+                auto& slab = slabs[s];
+                slab.global.assign(slab.positions.size(), 0);
+                for (const auto& item : slab.shared) slab.global[item.first] = noVertex;
+                auto next = slab.vertexOffset;
+                for (size_t i = 0; i < slab.positions.size(); ++i) {
+                    if (slab.global[i] == noVertex) continue;
+                    slab.global[i] = static_cast<std::uint32_t>(next);
+                    positions[next] = slab.positions[i];
+                    normals[next] = slab.normals[i];
+                    ++next;
+                }
+            },
+            1);
+        util::parallelFor(
+            0, slabs.size(),
+            [&](size_t s) {
+                auto& slab = slabs[s];
+                for (const auto& [vertex, prevVertex] : slab.shared) {
+                    const auto global = slabs[s - 1].global[prevVertex];
+                    slab.global[vertex] = global;
+                    normals[global] += slab.normals[vertex];
+                }
+                std::transform(slab.indices.begin(), slab.indices.end(),
+                               indices.begin() + slab.indexOffset,
+                               [&](std::uint32_t i) { return slab.global[i]; });
+            },
+            1);
+
+        if (enclose) {
+            marching::encloseSurfce(src, dim, indexRAM, positions, normals, iso, invert, dr.x, dr.y,
+                                    dr.z);
+        }
+    };
+    if (invert) {
+        volume->getRepresentation<VolumeRAM>()->dispatch<void, dispatching::filter::Scalars>(
+            [&](auto ram) {
+                using ValueType = util::PrecisionValueType<decltype(ram)>;
+                mc(
+                    ram,
+                    [tiso = util::glm_convert<ValueType>(iso)](auto&& val) { return val > tiso; },
+                    [iso](auto&& val) { return util::glm_convert<double>(val) - iso; });
+            });
+    } else {
+        volume->getRepresentation<VolumeRAM>()->dispatch<void, dispatching::filter::Scalars>(
+            [&](auto ram) {
+                using ValueType = util::PrecisionValueType<decltype(ram)>;
+                mc(
+                    ram,
+                    [tiso = util::glm_convert<ValueType>(iso)](auto&& val) { return val < tiso; },
+                    [iso](auto&& val) { return -(util::glm_convert<double>(val) - iso); });
+            });
+    }
+    if (stopped) return nullptr;
+
+    ivwAssert(positions.size() == normals.size(), "positions and normals must be equal size");
+
+    util::parallelFor(0, normals.size(), [&](size_t begin, size_t end) {
+        std::transform(normals.begin() + begin, normals.begin() + end, normals.begin() + begin,
+                       [](const vec3& n) { return glm::normalize(n); });
+    });
+    textures.insert(textures.begin(), positions.begin(), positions.end());
+    colors.reserve(positions.size());
+    std::fill_n(std::back_inserter(colors), positions.size(), color);
+
+    auto mesh = std::make_shared<Mesh>();
+    mesh->setModelMatrix(volume->getModelMatrix());
+    mesh->setWorldMatrix(volume->getWorldMatrix());
+    mesh->addIndices({DrawType::Triangles, ConnectivityType::None}, indexBuffer);
+    mesh->addBuffer(BufferType::PositionAttrib, vertexBuffer);
+    mesh->addBuffer(BufferType::TexCoordAttrib, textureBuffer);
+    mesh->addBuffer(BufferType::ColorAttrib, colorBuffer);
+    mesh->addBuffer(BufferType::NormalAttrib, normalBuffer);
+
+    if (progressCallback) progressCallback(1.0f);
+
+    return mesh;
+}
 }  // namespace util
 
 }  // namespace inviwo
@@ -0,0 +1,110 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2021 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#include <modules/base/algorithm/volume/volumeclassification.h>
+
+#include <inviwo/core/datastructures/tflookuptable.h>
+#include <inviwo/core/datastructures/volume/volume.h>
+#include <inviwo/core/datastructures/volume/volumeram.h>
+#include <inviwo/core/datastructures/volume/volumeramprecision.h>
+#include <inviwo/core/util/exception.h>
+#include <inviwo/core/util/formatdispatching.h>
+#include <inviwo/core/util/glm.h>
+#include <inviwo/core/util/parallel.h>
+
+#include <algorithm>
+
+namespace inviwo {
+
+namespace util {
+
+namespace {
+
+template <typename Dst>
+Dst toColor(const vec4& color) {
+    if constexpr (std::is_same_v<Dst, glm::u8vec4>) {
+        return Dst(glm::round(glm::clamp(color, 0.0f, 1.0f) * 255.0f));
+    } else {
+        return color;
+    }
+}
+
+template <typename Dst>
+std::shared_ptr<VolumeRAMPrecision<Dst>> classify(const Volume& volume, const TFLookupTable& tf,
+                                                  size_t channel) {
+    const auto dims = volume.getDimensions();
+    auto dst = std::make_shared<VolumeRAMPrecision<Dst>>(dims);
+    auto dstData = dst->getDataTyped();
+
+    const auto range = volume.dataMap_.dataRange;
+    const double scale = range.y > range.x ? 1.0 / (range.y - range.x) : 0.0;
+
+    volume.getRepresentation<VolumeRAM>()->dispatch<void>([&](auto ram) {
+        using ValueType = util::PrecisionValueType<decltype(ram)>;
+        const auto src = ram->getDataTyped();
+        const size_t comp = std::min(channel, util::extent<ValueType>::value - 1);
+        util::parallelFor(0, glm::compMul(dims), [&](size_t begin, size_t end) {
+            for (size_t i = begin; i < end; ++i) {
+                const double value = static_cast<double>(util::glmcomp(src[i], comp));
+                dstData[i] = toColor<Dst>(tf.sample((value - range.x) * scale));
+            }
+        });
+    });
+    return dst;
+}
+
+}  // namespace
+
+std::shared_ptr<Volume> classifyVolume(const Volume& volume, const TFLookupTable& tf,
+                                       size_t channel, const DataFormatBase* format) {
+    std::shared_ptr<VolumeRepresentation> ram;
+    if (format == DataVec4UInt8::get()) {
+        ram = classify<glm::u8vec4>(volume, tf, channel);
+    } else if (format == DataVec4Float32::get()) {
+        ram = classify<vec4>(volume, tf, channel);
+    } else {
+        throw Exception("Unsupported format for the classified volume: " +
+                            std::string(format->getString()),
+                        IVW_CONTEXT_CUSTOM("util::classifyVolume"));
+    }
+
+    auto result = std::make_shared<Volume>(ram);
+    result->setModelMatrix(volume.getModelMatrix());
+    result->setWorldMatrix(volume.getWorldMatrix());
+    result->copyMetaDataFrom(volume);
+    if (format == DataVec4Float32::get()) {
+        result->dataMap_.dataRange = dvec2{0.0, 1.0};
+        result->dataMap_.valueRange = dvec2{0.0, 1.0};
+    }
+    return result;
+}
+
+}  // namespace util
+
+}  // namespace inviwo
@@ -30,12 +30,16 @@
 #include <modules/base/algorithm/volume/volumeramsubsample.h>
 #include <inviwo/core/datastructures/volume/volumeram.h>
 #include <inviwo/core/datastructures/volume/volumeramprecision.h>
+#include <inviwo/core/datastructures/volume/volumebrickedram.h>
 #include <inviwo/core/util/indexmapper.h>
+#include <inviwo/core/util/parallel.h>
 
 #ifdef IVW_USE_OPENMP
 #include <omp.h>
 #endif
 
+#include <algorithm>
+
 namespace inviwo {
 
 std::shared_ptr<VolumeRAM> util::volumeSubSample(const VolumeRAM* volume, size3_t f) {
@@ -94,4 +98,115 @@ std::shared_ptr<VolumeRAM> util::volumeSubSample(const VolumeRAM* volume, size3_
         });
 }
 
+std::shared_ptr<VolumeRAM> util::volumeSubSample(const VolumeBrickedRAM* volume, size3_t f) {
+    const size3_t srcDims{volume->getDimensions()};
+    const size3_t destDims{srcDims / f};
+    auto destVol = createVolumeRAM(destDims, volume->getDataFormat(), nullptr,
+                                   volume->getSwizzleMask(), volume->getInterpolation(),
+                                   volume->getWrapping());
+    if (glm::compMul(destDims) == 0) return destVol;
+
+    // Use slabs of about one brick layer, rounded to a whole number of output slices
+    const size_t slabSize = std::max(size_t{1}, volume->getBrickSize().z / f.z);
+    const size_t sliceBytes = destDims.x * destDims.y * volume->getDataFormat()->getSize();
+    for (size_t z = 0; z < destDims.z; z += slabSize) {
+        const size_t slices = std::min(slabSize, destDims.z - z);
+        const auto region = volume->getRegion(size3_t{0, 0, z * f.z},
+                                              size3_t{destDims.x * f.x, destDims.y * f.y,
+                                                      slices * f.z});
+        const auto slab = volumeSubSample(region.get(), f);
+        std::copy_n(static_cast<const char*>(slab->getData()), slices * sliceBytes,
+                    static_cast<char*>(destVol->getData()) + z * sliceBytes);
+    }
+    return destVol;
+}
+
+std::shared_ptr<VolumeRAM> util::volumeHalfSample(const VolumeRAM* volume,
+                                                  VolumeReduction reduction) {
+    return volume->dispatch<std::shared_ptr<VolumeRAM>>(
+        [reduction](auto srcVol) -> std::shared_ptr<VolumeRAM> {
+            using ValueType = util::PrecisionValueType<decltype(srcVol)>;
+            using P = typename util::same_extent<ValueType, double>::type;
+
+            const size3_t srcDims{srcVol->getDimensions()};
+            const size3_t destDims{(srcDims + size3_t{1}) / size3_t{2}};
+
+            auto destVol = std::make_shared<VolumeRAMPrecision<ValueType>>(
+                destDims, srcVol->getSwizzleMask(), srcVol->getInterpolation(),
+                srcVol->getWrapping());
+
+            const auto src = srcVol->getDataTyped();
+            auto dst = destVol->getDataTyped();
+
+            const util::IndexMapper3D o(srcDims);
+            const util::IndexMapper3D n(destDims);
+
+            util::parallelFor(0, destDims.z, [&](size_t z) {
+                for (size_t y = 0; y < destDims.y; ++y) {
+                    for (size_t x = 0; x < destDims.x; ++x) {
+                        const size3_t begin{2 * x, 2 * y, 2 * z};
+                        const size3_t end{glm::min(begin + size3_t{2}, srcDims)};
+
+                        P val{0.0};
+                        size_t count = 0;
+                        for (size_t oz = begin.z; oz < end.z; ++oz) {
+                            for (size_t oy = begin.y; oy < end.y; ++oy) {
+                                for (size_t ox = begin.x; ox < end.x; ++ox) {
+                                    const auto v = static_cast<P>(src[o(ox, oy, oz)]);
+                                    switch (reduction) {
+                                        case VolumeReduction::Min:
+                                            val = count == 0 ? v : glm::min(val, v);
+                                            break;
+                                        case VolumeReduction::Max:
+                                            val = count == 0 ? v : glm::max(val, v);
+                                            break;
+                                        case VolumeReduction::Average:
+                                        default:
+                                            val += v;
+                                            break;
+                                    }
+                                    ++count;
+                                }
+                            }
+                        }
+                        if (reduction == VolumeReduction::Average) {
+                            val /= static_cast<double>(count);
+                        }
+
+#include <warn/push>
+#include <warn/ignore/conversion>
+                        dst[n(x, y, z)] = static_cast<ValueType>(val);
+#include <warn/pop>
+                    }
+                }
+            });
+
+            return destVol;
+        });
+}
+
+std::shared_ptr<VolumeRAM> util::volumeHalfSample(const VolumeBrickedRAM* volume,
+                                                  VolumeReduction reduction) {
+    const size3_t srcDims{volume->getDimensions()};
+    const size3_t destDims{(srcDims + size3_t{1}) / size3_t{2}};
+    auto destVol = createVolumeRAM(destDims, volume->getDataFormat(), nullptr,
+                                   volume->getSwizzleMask(), volume->getInterpolation(),
+                                   volume->getWrapping());
+    if (glm::compMul(destDims) == 0) return destVol;
+
+    // Use slabs of about one brick layer, i.e. an even number of input slices
+    const size_t slabSize = std::max(size_t{1}, volume->getBrickSize().z / 2);
+    const size_t sliceBytes = destDims.x * destDims.y * volume->getDataFormat()->getSize();
+    for (size_t z = 0; z < destDims.z; z += slabSize) {
+        const size_t slices = std::min(slabSize, destDims.z - z);
+        const size_t srcSlices = std::min(2 * slices, srcDims.z - 2 * z);
+        const auto region = volume->getRegion(size3_t{0, 0, 2 * z},
+                                              size3_t{srcDims.x, srcDims.y, srcSlices});
+        const auto slab = volumeHalfSample(region.get(), reduction);
+        std::copy_n(static_cast<const char*>(slab->getData()), slices * sliceBytes,
+                    static_cast<char*>(destVol->getData()) + z * sliceBytes);
+    }
+    return destVol;
+}
+
 }  // namespace inviwo
@@ -0,0 +1,330 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2021 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#include <modules/base/algorithm/volume/volumeraycasting.h>
+
+#include <inviwo/core/datastructures/camera/camera.h>
+#include <inviwo/core/datastructures/image/image.h>
+#include <inviwo/core/datastructures/image/layerramprecision.h>
+#include <inviwo/core/datastructures/transferfunction.h>
+#include <inviwo/core/datastructures/volume/volume.h>
+#include <inviwo/core/datastructures/volume/volumeram.h>
+#include <inviwo/core/util/formatdispatching.h>
+#include <inviwo/core/util/glm.h>
+#include <inviwo/core/util/parallel.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <limits>
+#include <optional>
+#include <vector>
+
+namespace inviwo {
+
+namespace util {
+
+namespace {
+
+// Reference sampling interval for the opacity correction, same as in compositing.glsl
+constexpr float refSamplingInterval = 150.0f;
+
+vec3 shade(const LightingState& light, const vec3& color, const vec3& position,
+           const vec3& normal, const vec3& toCameraDir) {
+    // Same as the functions in shading.glsl with ambient and diffuse material color equal to
+    // color and white specular material color.
+    const auto diffuse = [&](const vec3& toLightDir) {
+        return color * light.diffuse * std::max(glm::dot(normal, toLightDir), 0.0f);
+    };
+    const auto specularPhong = [&](const vec3& toLightDir) {
+        if (glm::dot(toLightDir, normal) < 0.0f) return vec3(0.0f);
+        const vec3 r = glm::reflect(-toLightDir, normal);
+        return light.specular *
+               std::pow(std::max(glm::dot(r, toCameraDir), 0.0f), light.exponent * 0.25f);
+    };
+    const auto specularBlinnPhong = [&](const vec3& toLightDir) {
+        const vec3 halfway = toCameraDir + toLightDir;
+        if (glm::dot(halfway, halfway) < 1.0e-6f) return vec3(0.0f);
+        return light.specular * std::pow(std::max(glm::dot(normal, glm::normalize(halfway)), 0.0f),
+                                         light.exponent);
+    };
+
+    const vec3 toLightDir = glm::normalize(light.position - position);
+    switch (light.shadingMode) {
+        case ShadingMode::Ambient:
+            return color * light.ambient;
+        case ShadingMode::Diffuse:
+            return diffuse(toLightDir);
+        case ShadingMode::Specular:
+            return specularPhong(toLightDir);
+        case ShadingMode::BlinnPhong:
+            return color * light.ambient + diffuse(toLightDir) + specularBlinnPhong(toLightDir);
+        case ShadingMode::Phong:
+            return color * light.ambient + diffuse(toLightDir) + specularPhong(toLightDir);
+        case ShadingMode::None:
+        default:
+            return color;
+    }
+}
+
+/**
+ * Intersect the segment from a to b with the unit cube, the result is the interval of the
+ * segment parameter in [0,1], empty if x >= y.
+ */
+vec2 intersectUnitCube(const vec3& a, const vec3& b) {
+    const vec3 dir = b - a;
+    vec2 range{0.0f, 1.0f};
+    for (int i = 0; i < 3; ++i) {
+        if (dir[i] == 0.0f) {
+            if (a[i] < 0.0f || a[i] > 1.0f) return vec2{1.0f, 0.0f};
+            continue;
+        }
+        float t0 = -a[i] / dir[i];
+        float t1 = (1.0f - a[i]) / dir[i];
+        if (t0 > t1) std::swap(t0, t1);
+        range.x = std::max(range.x, t0);
+        range.y = std::min(range.y, t1);
+    }
+    return range;
+}
+
+}  // namespace
+
+ScalarGrid::ScalarGrid(const Volume& volume, size_t channel)
+    : dims_{volume.getDimensions()}
+    , maxIndex_{glm::max(ivec3(dims_) - 1, ivec3(0))}
+    , maxCell_{glm::max(ivec3(dims_) - 2, ivec3(0))}
+    , strides_{1, dims_.x, dims_.x * dims_.y}
+    , channel_{channel}
+    , data_(glm::compMul(dims_)) {
+
+    const auto range = volume.dataMap_.dataRange;
+    const double scale = range.y > range.x ? 1.0 / (range.y - range.x) : 0.0;
+
+    volume.getRepresentation<VolumeRAM>()->dispatch<void>([&](auto ram) {
+        using ValueType = util::PrecisionValueType<decltype(ram)>;
+        const auto src = ram->getDataTyped();
+        const size_t comp = std::min(channel, util::extent<ValueType>::value - 1);
+        util::parallelFor(0, data_.size(), [&](size_t begin, size_t end) {
+            for (size_t i = begin; i < end; ++i) {
+                const double value = static_cast<double>(util::glmcomp(src[i], comp));
+                data_[i] = static_cast<float>((value - range.x) * scale);
+            }
+        });
+    });
+}
+
+TFLookup::TFLookup(const TransferFunction& tf) : table_{tf}, visible_(table_.size() + 1, 0) {
+    const auto& entries = table_.getTable();
+    for (size_t i = 0; i < entries.size(); ++i) {
+        visible_[i + 1] = visible_[i] + (entries[i].a > 0.0f ? 1 : 0);
+    }
+}
+
+BrickGrid::BrickGrid(const ScalarGrid& grid, const TFLookup& tf, size_t brickSize)
+    : brickSize_{static_cast<int>(std::max(brickSize, size_t{1}))}
+    , dims_{(grid.maxCell() + brickSize_) / brickSize_}
+    , empty_(static_cast<size_t>(glm::compMul(dims_)), false) {
+
+    const ivec3 maxIndex = glm::max(ivec3(grid.dims()) - 1, ivec3(0));
+    util::parallelFor(0, empty_.size(), [&](size_t i) {
+        const ivec3 brick{static_cast<int>(i) % dims_.x, (static_cast<int>(i) / dims_.x) % dims_.y,
+                          static_cast<int>(i) / (dims_.x * dims_.y)};
+        const ivec3 begin = brick * brickSize_;
+        const ivec3 end = glm::min(begin + brickSize_, maxIndex);
+
+        float min = std::numeric_limits<float>::max();
+        float max = std::numeric_limits<float>::lowest();
+        for (int z = begin.z; z <= end.z; ++z) {
+            for (int y = begin.y; y <= end.y; ++y) {
+                for (int x = begin.x; x <= end.x; ++x) {
+                    const float value = grid.value({x, y, z});
+                    min = std::min(min, value);
+                    max = std::max(max, value);
+                }
+            }
+        }
+        empty_[i] = tf.isTransparent(min, max);
+    });
+}
+
+std::shared_ptr<Image> raycastVolume(const Volume& volume, const TransferFunction& tf,
+                                     const Camera& camera, size2_t dimensions,
+                                     const VolumeRaycastingSettings& settings,
+                                     std::function<bool()> stopCallback) {
+    const ScalarGrid grid(volume, settings.channel);
+    const TFLookup lookup(tf);
+    std::optional<BrickGrid> bricks;
+    if (settings.emptySpaceSkipping) bricks.emplace(grid, lookup, settings.brickSize);
+
+    return raycastVolume(volume, grid, lookup, bricks ? &*bricks : nullptr, camera, dimensions,
+                         settings, std::move(stopCallback));
+}
+
+std::shared_ptr<Image> raycastVolume(const Volume& volume, const ScalarGrid& grid,
+                                     const TFLookup& lookup, const BrickGrid* bricks,
+                                     const Camera& camera, size2_t dimensions,
+                                     const VolumeRaycastingSettings& settings,
+                                     std::function<bool()> stopCallback) {
+
+    auto image = std::make_shared<Image>(dimensions, DataVec4UInt8::get());
+    auto colorData = static_cast<LayerRAMPrecision<glm::u8vec4>*>(
+                         image->getColorLayer()->getEditableRepresentation<LayerRAM>())
+                         ->getDataTyped();
+    auto depthData = static_cast<LayerRAMPrecision<float>*>(
+                         image->getDepthLayer()->getEditableRepresentation<LayerRAM>())
+                         ->getDataTyped();
+
+    const auto& transformer = volume.getCoordinateTransformer();
+    const mat4 worldToTexture = transformer.getWorldToTextureMatrix();
+    const mat4 textureToWorld = transformer.getTextureToWorldMatrix();
+    // The gradient is computed in index space, transform it like a normal to world space
+    const mat3 gradientToWorld = glm::transpose(mat3(transformer.getWorldToIndexMatrix()));
+    const mat4 ndcToWorld = camera.getInverseViewMatrix() * camera.getInverseProjectionMatrix();
+    const mat4 worldToClip = camera.getProjectionMatrix() * camera.getViewMatrix();
+
+    const vec3 dims{grid.dims()};
+    const bool shading = settings.lighting.shadingMode != ShadingMode::None;
+
+    const auto toTexture = [&](const vec3& ndc) {
+        const vec4 world = ndcToWorld * vec4(ndc, 1.0f);
+        return vec3(worldToTexture * vec4(vec3(world) / world.w, 1.0f));
+    };
+
+    // Returns the premultiplied color and the depth of the ray through the given pixel
+    const auto castRay = [&](const vec2& ndc) -> std::pair<vec4, float> {
+        const vec3 a = toTexture(vec3(ndc, -1.0f));
+        const vec3 b = toTexture(vec3(ndc, 1.0f));
+        const vec2 range = intersectUnitCube(a, b);
+        if (range.x >= range.y) return {vec4(0.0f), 1.0f};
+
+        const vec3 entry = a + range.x * (b - a);
+        const vec3 exit = a + range.y * (b - a);
+
+        // Same sampling as raycasting.frag
+        const vec3 rayDir = exit - entry;
+        const float tEnd = glm::length(rayDir);
+        if (tEnd <= 0.0f) return {vec4(0.0f), 1.0f};
+        float tIncr = std::min(tEnd, tEnd / (settings.samplingRate * glm::length(rayDir * dims)));
+        const auto samples = static_cast<int>(std::ceil(tEnd / tIncr));
+        tIncr = tEnd / static_cast<float>(samples);
+        const vec3 dir = rayDir / tEnd;
+        const vec3 toCameraDir = glm::normalize(vec3(textureToWorld * vec4(entry, 1.0f)) -
+                                                vec3(textureToWorld * vec4(exit, 1.0f)));
+        const float alphaExponent = tIncr * refSamplingInterval;
+
+        // The sample position in index space is q0 + t * dq
+        const vec3 q0 = entry * dims - 0.5f;
+        const vec3 dq = dir * dims;
+
+        vec4 result{0.0f};
+        float tDepth = -1.0f;
+        for (int k = 0; k < samples; ++k) {
+            const float t = (static_cast<float>(k) + 0.5f) * tIncr;
+            const vec3 q = grid.clamp(q0 + t * dq);
+
+            if (bricks) {
+                const ivec3 brick = bricks->brick(grid.cell(q));
+                if (bricks->isEmpty(brick)) {
+                    // Jump to the last sample before the ray leaves the brick, every sample in
+                    // between would be transparent.
+                    const vec3 lower{brick * bricks->brickSize()};
+                    const vec3 upper = lower + vec3(static_cast<float>(bricks->brickSize()));
+                    float tExit = std::numeric_limits<float>::max();
+                    for (int i = 0; i < 3; ++i) {
+                        if (dq[i] > 0.0f) tExit = std::min(tExit, (upper[i] - q0[i]) / dq[i]);
+                        if (dq[i] < 0.0f) tExit = std::min(tExit, (lower[i] - q0[i]) / dq[i]);
+                    }
+                    const float last = std::min(std::floor(tExit / tIncr - 0.501f),
+                                                static_cast<float>(samples));
+                    if (last > static_cast<float>(k + 1)) k = static_cast<int>(last) - 1;
+                    continue;
+                }
+            }
+
+            vec4 color = lookup(grid.sample(q));
+            if (color.a <= 0.0f) continue;
+
+            if (tDepth < 0.0f) tDepth = t;
+            if (shading) {
+                const vec3 gradient = gradientToWorld * grid.gradient(q);
+                const float length = glm::length(gradient);
+                // The normal points towards lower values, i.e. against the gradient
+                const vec3 normal = length > 0.0f ? -gradient / length : vec3(0.0f);
+                const vec3 position{textureToWorld * vec4(entry + t * dir, 1.0f)};
+                color = vec4(shade(settings.lighting, vec3(color), position, normal, toCameraDir),
+                             color.a);
+            }
+
+            const float alpha = 1.0f - std::pow(1.0f - color.a, alphaExponent);
+            result += (1.0f - result.a) * alpha * vec4(vec3(color), 1.0f);
+
+            if (result.a > settings.earlyRayTermination) break;
+        }
+
+        if (tDepth < 0.0f) return {result, 1.0f};
+        const vec4 clip = worldToClip * textureToWorld * vec4(entry + tDepth * dir, 1.0f);
+        return {result, 0.5f * clip.z / clip.w + 0.5f};
+    };
+
+    const size_t tileSize = std::max(settings.tileSize, size_t{1});
+    const size2_t tiles = (dimensions + tileSize - size_t{1}) / tileSize;
+    const vec2 pixelToNdc = 2.0f / vec2(dimensions);
+
+    std::atomic<bool> stopped{false};
+    util::parallelFor(
+        0, tiles.x * tiles.y,
+        [&](size_t tile) {
+            if (stopped) return;
+            if (stopCallback && stopCallback()) {
+                stopped = true;
+                return;
+            }
+            const size2_t begin = size2_t{tile % tiles.x, tile / tiles.x} * tileSize;
+            const size2_t end = glm::min(begin + tileSize, dimensions);
+            for (size_t y = begin.y; y < end.y; ++y) {
+                for (size_t x = begin.x; x < end.x; ++x) {
+                    const vec2 ndc = (vec2(x, y) + 0.5f) * pixelToNdc - 1.0f;
+                    const auto [color, depth] = castRay(ndc);
+                    const size_t i = x + y * dimensions.x;
+                    colorData[i] =
+                        glm::u8vec4(glm::round(glm::clamp(color, 0.0f, 1.0f) * 255.0f));
+                    depthData[i] = depth;
+                }
+            }
+        },
+        1);
+
+    if (stopped) return nullptr;
+    return image;
+}
+
+}  // namespace util
+
+}  // namespace inviwo
@@ -28,8 +28,13 @@
  *********************************************************************************/
 
 #include <modules/base/algorithm/volume/volumevoronoi.h>
+#include <modules/base/datastructures/flatkdtree.h>
 
+#include <inviwo/core/util/parallel.h>
+
+#include <algorithm>
 #include <array>
+#include <cmath>
 
 namespace inviwo {
 namespace util {
@@ -121,10 +126,87 @@ void weightedVoronoiSegmentationImpl(
     });
 }
 
+/**
+ * Finds the closest seed point of each voxel using a k-d tree. For repeating axes the tree also
+ * holds the images of the seed points shifted by +-size, such that every distance computed by
+ * detail::distance2 is the euclidean distance to one of the points in the tree. The closest point
+ * in the tree gives an upper bound of the power distance, all seed points that can be closer are
+ * then within sqrt(bound + max weight^2) and are compared using the same distance as the brute
+ * force version. If weights is empty the unweighted distance is used.
+ */
+template <Wrapping X, Wrapping Y, Wrapping Z>
+void spatialIndexVoronoiSegmentationImpl(
+    const size3_t volumeDimensions, const mat4& indexToModelMatrix,
+    const std::vector<std::pair<uint32_t, vec3>>& seedPointsWithIndices,
+    const std::vector<float>& weights, VolumeRAMPrecision<unsigned short>& voronoiVolumeRep) {
+
+    auto volumeIndices = voronoiVolumeRep.getDataTyped();
+    util::IndexMapper3D index(volumeDimensions);
+
+    const auto size = vec3{indexToModelMatrix * vec4{volumeDimensions, 1.0f}} -
+                      vec3{indexToModelMatrix * vec4{0.0f, 0.0f, 0.0f, 1.0f}};
+
+    const auto shifts = [](bool repeat, float extent) {
+        return repeat ? std::vector<float>{0.0f, -extent, extent} : std::vector<float>{0.0f};
+    };
+    std::vector<vec3> points;
+    std::vector<size_t> seeds;
+    for (auto dz : shifts(Z == Wrapping::Repeat, size.z)) {
+        for (auto dy : shifts(Y == Wrapping::Repeat, size.y)) {
+            for (auto dx : shifts(X == Wrapping::Repeat, size.x)) {
+                for (size_t i = 0; i < seedPointsWithIndices.size(); ++i) {
+                    points.push_back(seedPointsWithIndices[i].second + vec3{dx, dy, dz});
+                    seeds.push_back(i);
+                }
+            }
+        }
+    }
+    const FlatK3DTree<float> tree{points};
+
+    float maxWeight2 = 0.0f;
+    for (auto w : weights) maxWeight2 = std::max(maxWeight2, w * w);
+    // Margin for the rounding differences between the shifted points and detail::distance2
+    const auto margin = 1e-4f * glm::compMax(glm::abs(size));
+
+    const auto power = [&](size_t i, const vec3& pos) {
+        const auto d2 = detail::distance2<X, Y, Z>(seedPointsWithIndices[i].second, pos, size);
+        return weights.empty() ? d2 : d2 - weights[i] * weights[i];
+    };
+
+    const size_t rows = volumeDimensions.y * volumeDimensions.z;
+    util::parallelFor(0, rows, [&](size_t begin, size_t end) {
+        std::vector<size_t> candidates;
+        size3_t voxelPos{0};
+        for (size_t row = begin; row < end; ++row) {
+            voxelPos.y = row % volumeDimensions.y;
+            voxelPos.z = row / volumeDimensions.y;
+            for (voxelPos.x = 0; voxelPos.x < volumeDimensions.x; ++voxelPos.x) {
+                const auto transformedVoxelPos = vec3{indexToModelMatrix * vec4{voxelPos, 1.0f}};
+
+                auto best = seeds[tree.findNearest(transformedVoxelPos)];
+                auto bestPower = power(best, transformedVoxelPos);
+
+                const auto radius = std::sqrt(std::max(0.0f, bestPower + maxWeight2)) * 1.0001f;
+                tree.findCloseTo(transformedVoxelPos, radius + margin, candidates);
+                for (auto candidate : candidates) {
+                    const auto seed = seeds[candidate];
+                    const auto p = power(seed, transformedVoxelPos);
+                    if (p < bestPower || (p == bestPower && seed < best)) {
+                        best = seed;
+                        bestPower = p;
+                    }
+                }
+                volumeIndices[index(voxelPos)] =
+                    static_cast<unsigned short>(seedPointsWithIndices[best].first);
+            }
+        }
+    });
+}
+
 std::shared_ptr<Volume> voronoiSegmentation(
     const size3_t volumeDimensions, const mat4& indexToModelMatrix,
     const std::vector<std::pair<uint32_t, vec3>>& seedPointsWithIndices, const Wrapping3D& wrapping,
-    const std::optional<std::vector<float>>& weights) {
+    const std::optional<std::vector<float>>& weights, VoronoiMethod method) {
 
     if (seedPointsWithIndices.size() == 0) {
         throw Exception("No seed points, cannot create volume voronoi segmentation",
@@ -150,7 +232,38 @@ std::shared_ptr<Volume> voronoiSegmentation(
     voronoiVolume->dataMap_.dataRange = dvec2{0.0, static_cast<double>(imax->first)};
     voronoiVolume->dataMap_.valueRange = voronoiVolume->dataMap_.dataRange;
 
-    if (weights.has_value()) {
+    if (method == VoronoiMethod::SpatialIndex) {
+        using Functor =
+            void (*)(const size3_t, const mat4&, const std::vector<std::pair<uint32_t, vec3>>&,
+                     const std::vector<float>&, VolumeRAMPrecision<unsigned short>&);
+
+        constexpr auto table = detail::build_array<3>([&](auto x) constexpr {
+            using XT = decltype(x);
+            return detail::build_array<3>([&](auto y) constexpr {
+                using YT = decltype(y);
+                return detail::build_array<3>([&](auto z) constexpr->Functor {
+                    using ZT = decltype(z);
+                    return [](const size3_t dim, const mat4& matrix,
+                              const std::vector<std::pair<uint32_t, vec3>>& sp,
+                              const std::vector<float>& w,
+                              VolumeRAMPrecision<unsigned short>& volRep) {
+                        constexpr auto X = static_cast<Wrapping>(XT::value);
+                        constexpr auto Y = static_cast<Wrapping>(YT::value);
+                        constexpr auto Z = static_cast<Wrapping>(ZT::value);
+                        spatialIndexVoronoiSegmentationImpl<X, Y, Z>(dim, matrix, sp, w, volRep);
+                    };
+                });
+            });
+        });
+
+        const std::vector<float> noWeights;
+        table[static_cast<size_t>(wrapping[0])][static_cast<size_t>(wrapping[1])]
+             [static_cast<size_t>(wrapping[2])](volumeDimensions, indexToModelMatrix,
+                                                seedPointsWithIndices,
+                                                weights.has_value() ? *weights : noWeights,
+                                                *voronoiVolumeRep);
+
+    } else if (weights.has_value()) {
         using Functor =
             void (*)(const size3_t, const mat4&, const std::vector<std::pair<uint32_t, vec3>>&,
                      const std::vector<float>&, VolumeRAMPrecision<unsigned short>&);
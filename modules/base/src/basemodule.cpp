@@ -73,8 +73,10 @@
 #include <modules/base/processors/transform.h>
 #include <modules/base/processors/trianglestowireframe.h>
 #include <modules/base/processors/volumeboundaryplanes.h>
+#include <modules/base/processors/volumeclassificationcpu.h>
 #include <modules/base/processors/volumeconverter.h>
 #include <modules/base/processors/volumecreator.h>
+#include <modules/base/processors/volumelevelofdetail.h>
 #include <modules/base/processors/volumesequenceelementselectorprocessor.h>
 #include <modules/base/processors/volumesource.h>
 #include <modules/base/processors/volumeexport.h>
@@ -90,6 +92,7 @@
 #include <modules/base/processors/volumedivergencecpuprocessor.h>
 #include <modules/base/processors/volumegradientcpuprocessor.h>
 #include <modules/base/processors/volumelaplacianprocessor.h>
+#include <modules/base/processors/volumeraycastercpu.h>
 #include <modules/base/processors/volumesequencetospatial4dsampler.h>
 #include <modules/base/processors/worldtransformdeprecated.h>
 #include <modules/base/processors/camerafrustum.h>
@@ -207,6 +210,9 @@ BaseModule::BaseModule(InviwoApplication* app) : InviwoModule(app, "Base") {
     registerProcessor<VolumeInformation>();
     registerProcessor<TFSelector>();
     registerProcessor<VolumeShifter>();
+    registerProcessor<VolumeRaycasterCPU>();
+    registerProcessor<VolumeClassificationCPU>();
+    registerProcessor<VolumeLevelOfDetail>();
 
     // input selectors
     registerProcessor<InputSelector<MultiDataInport<Volume>, VolumeOutport>>();
@@ -0,0 +1,140 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2021 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#include <modules/base/datastructures/volumepyramid.h>
+
+#include <inviwo/core/datastructures/volume/volumeram.h>
+#include <inviwo/core/datastructures/volume/volumebrickedram.h>
+#include <inviwo/core/util/exception.h>
+
+#include <algorithm>
+
+namespace inviwo {
+
+VolumePyramid::VolumePyramid(std::shared_ptr<const Volume> volume, VolumeReduction reduction)
+    : volume_{std::move(volume)}
+    , reduction_{reduction}
+    , dimensions_{[](size3_t dims) {
+        std::vector<size3_t> res{dims};
+        while (glm::compMax(dims) > 1) {
+            dims = (dims + size3_t{1}) / size3_t{2};
+            res.push_back(dims);
+        }
+        return res;
+    }(volume_->getDimensions())}
+    , levels_(dimensions_.size()) {
+    // Level 0 is the volume itself and must never be computed
+    std::call_once(levels_[0].once, [&]() {
+        levels_[0].volume = volume_;
+        levels_[0].done = true;
+    });
+}
+
+std::shared_ptr<VolumePyramid> VolumePyramid::get(std::shared_ptr<const Volume> volume,
+                                                  VolumeReduction reduction) {
+    struct Entry {
+        std::weak_ptr<const Volume> volume;
+        VolumeReduction reduction;
+        std::weak_ptr<VolumePyramid> pyramid;
+    };
+    static std::mutex mutex;
+    static std::vector<Entry> cache;
+
+    std::scoped_lock lock{mutex};
+    cache.erase(std::remove_if(cache.begin(), cache.end(),
+                               [](const Entry& e) {
+                                   return e.volume.expired() || e.pyramid.expired();
+                               }),
+                cache.end());
+
+    for (const auto& entry : cache) {
+        if (entry.reduction == reduction && entry.volume.lock() == volume) {
+            if (auto pyramid = entry.pyramid.lock()) return pyramid;
+        }
+    }
+
+    auto pyramid = std::make_shared<VolumePyramid>(volume, reduction);
+    cache.push_back({volume, reduction, pyramid});
+    return pyramid;
+}
+
+const std::shared_ptr<const Volume>& VolumePyramid::getVolume() const { return volume_; }
+
+VolumeReduction VolumePyramid::getReduction() const { return reduction_; }
+
+size_t VolumePyramid::getNumberOfLevels() const { return dimensions_.size(); }
+
+size3_t VolumePyramid::getDimensions(size_t level) const { return dimensions_.at(level); }
+
+size_t VolumePyramid::getLevelForVoxelBudget(size_t maxVoxels) const {
+    const auto it =
+        std::find_if(dimensions_.begin(), dimensions_.end(),
+                     [&](const size3_t& dims) { return glm::compMul(dims) <= maxVoxels; });
+    return it != dimensions_.end() ? static_cast<size_t>(it - dimensions_.begin())
+                                   : dimensions_.size() - 1;
+}
+
+bool VolumePyramid::hasLevel(size_t level) const {
+    return level < levels_.size() && levels_[level].done.load(std::memory_order_acquire);
+}
+
+std::shared_ptr<const Volume> VolumePyramid::getLevel(size_t level) {
+    if (level >= dimensions_.size()) {
+        throw RangeException("Level " + std::to_string(level) +
+                                 " is out of range, the pyramid has " +
+                                 std::to_string(dimensions_.size()) + " levels",
+                             IVW_CONTEXT);
+    }
+
+    // No lock is held while computing, concurrent callers asking for the same level wait in
+    // call_once, everyone else, including hasLevel, goes on. A level whose computation throws is
+    // tried again on the next request.
+    auto& current = levels_[level];
+    std::call_once(current.once, [&]() {
+        const auto prev = getLevel(level - 1);
+        // Read the original volume brick by brick unless it is in RAM already, every other level
+        // is small enough to be in RAM
+        auto ram = (level == 1 && prev->hasRepresentation<VolumeBrickedRAM>() &&
+                    !prev->hasRepresentation<VolumeRAM>())
+                       ? util::volumeHalfSample(prev->getRepresentation<VolumeBrickedRAM>(),
+                                                reduction_)
+                       : util::volumeHalfSample(prev->getRepresentation<VolumeRAM>(), reduction_);
+
+        auto volume = std::make_shared<Volume>(ram);
+        volume->copyMetaDataFrom(*volume_);
+        volume->dataMap_ = volume_->dataMap_;
+        volume->setModelMatrix(volume_->getModelMatrix());
+        volume->setWorldMatrix(volume_->getWorldMatrix());
+        current.volume = volume;
+        current.done.store(true, std::memory_order_release);
+    });
+    return current.volume;
+}
+
+}  // namespace inviwo
@@ -0,0 +1,232 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2021 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#include <modules/base/datastructures/volumesequenceprefetcher.h>
+
+#include <inviwo/core/common/inviwoapplication.h>
+#include <inviwo/core/datastructures/volume/volumedisk.h>
+#include <inviwo/core/datastructures/volume/volumeram.h>
+#include <inviwo/core/util/exception.h>
+#include <inviwo/core/util/logcentral.h>
+
+#include <algorithm>
+#include <chrono>
+
+namespace inviwo {
+
+namespace {
+
+size_t sizeInBytes(const Volume& volume) {
+    return glm::compMul(volume.getDimensions()) * volume.getDataFormat()->getSize();
+}
+
+void load(const Volume& volume) {
+    const auto ram = volume.getRepresentation<VolumeRAM>();
+
+    // Memory mapped data is only read from disk when it is accessed, touch every page
+    constexpr size_t pageSize = 4096;
+    const auto data = static_cast<const unsigned char*>(ram->getData());
+    const auto bytes = ram->getNumberOfBytes();
+    unsigned char sum = 0;
+    for (size_t i = 0; i < bytes; i += pageSize) sum += data[i];
+    volatile unsigned char sink = sum;
+    (void)sink;
+}
+
+}  // namespace
+
+VolumeSequencePrefetcher::VolumeSequencePrefetcher(size_t lookahead, size_t memoryBudget,
+                                                   ThreadPool* pool)
+    : lookahead_{lookahead}, memoryBudget_{memoryBudget}, pool_{pool} {}
+
+void VolumeSequencePrefetcher::setSequence(std::shared_ptr<const VolumeSequence> sequence) {
+    if (sequence == sequence_) return;
+    sequence_ = std::move(sequence);
+    previous_.reset();
+    forward_ = true;
+    // Running jobs keep their volume alive, the futures do not block on destruction
+    pending_.clear();
+    loaded_.clear();
+}
+
+void VolumeSequencePrefetcher::setLookahead(size_t lookahead) { lookahead_ = lookahead; }
+
+size_t VolumeSequencePrefetcher::getLookahead() const { return lookahead_; }
+
+void VolumeSequencePrefetcher::setMemoryBudget(size_t bytes) { memoryBudget_ = bytes; }
+
+size_t VolumeSequencePrefetcher::getMemoryBudget() const { return memoryBudget_; }
+
+void VolumeSequencePrefetcher::access(size_t index) {
+    if (!sequence_ || index >= sequence_->size()) return;
+    const auto size = sequence_->size();
+
+    if (previous_ && size > 1) {
+        const size_t step = (index + size - *previous_) % size;
+        if (step == 1) {
+            forward_ = true;
+        } else if (step == size - 1) {
+            forward_ = false;
+        }
+    }
+    previous_ = index;
+
+    collectFinished();
+
+    // A volume that is being loaded is locked, hence check the pending jobs first
+    if (pending_.count(index) == 0 && (*sequence_)[index]->hasValidRepresentation<VolumeRAM>()) {
+        ++stats_.hits;
+    } else {
+        ++stats_.misses;
+    }
+    // The accessed time step will be loaded by whoever uses it
+    loaded_.insert(index);
+
+    const auto steps = window(index);
+    for (auto next : steps) {
+        if (loaded_.count(next) != 0 || pending_.count(next) != 0) continue;
+
+        auto volume = (*sequence_)[next];
+        if (volume->hasValidRepresentation<VolumeRAM>()) {
+            loaded_.insert(next);
+            continue;
+        }
+
+        const auto bytes = sizeInBytes(*volume);
+        evict(index, steps, bytes);
+        if (getLoadedBytes() + bytes > memoryBudget_) break;
+
+        // Drop the reference before the future is ready, otherwise the time step counts as in use
+        // and can not be released right after it has been loaded
+        auto job = [volume]() mutable {
+            load(*volume);
+            volume.reset();
+        };
+        pending_.emplace(next, pool_ ? pool_->enqueue(ThreadPool::Priority::Low, std::move(job))
+                                     : util::dispatchPool(ThreadPool::Priority::Low,
+                                                          std::move(job)));
+        ++stats_.prefetched;
+    }
+
+    // Also applies a lowered budget when nothing new is loaded
+    evict(index, steps, 0);
+}
+
+const VolumeSequencePrefetcher::Statistics& VolumeSequencePrefetcher::getStatistics() const {
+    return stats_;
+}
+
+void VolumeSequencePrefetcher::resetStatistics() { stats_ = Statistics{}; }
+
+size_t VolumeSequencePrefetcher::getLoadedBytes() const {
+    if (!sequence_) return 0;
+    size_t bytes = 0;
+    for (auto index : loaded_) bytes += sizeInBytes(*(*sequence_)[index]);
+    for (auto& item : pending_) {
+        if (loaded_.count(item.first) == 0) bytes += sizeInBytes(*(*sequence_)[item.first]);
+    }
+    return bytes;
+}
+
+void VolumeSequencePrefetcher::waitForPrefetches() {
+    for (auto& item : pending_) item.second.wait();
+    collectFinished();
+}
+
+std::vector<size_t> VolumeSequencePrefetcher::window(size_t index) const {
+    const auto size = sequence_->size();
+    const auto steps = std::min(lookahead_, size - 1);
+    std::vector<size_t> result;
+    result.reserve(steps);
+    for (size_t k = 1; k <= steps; ++k) {
+        result.push_back(forward_ ? (index + k) % size : (index + size - k) % size);
+    }
+    return result;
+}
+
+void VolumeSequencePrefetcher::collectFinished() {
+    for (auto it = pending_.begin(); it != pending_.end();) {
+        if (it->second.wait_for(std::chrono::seconds{0}) != std::future_status::ready) {
+            ++it;
+            continue;
+        }
+        try {
+            it->second.get();
+            loaded_.insert(it->first);
+        } catch (const Exception& e) {
+            LogWarn("Failed to prefetch time step " << it->first + 1 << ": " << e.getMessage());
+        } catch (const std::exception& e) {
+            LogWarn("Failed to prefetch time step " << it->first + 1 << ": " << e.what());
+        }
+        it = pending_.erase(it);
+    }
+}
+
+void VolumeSequencePrefetcher::evict(size_t index, const std::vector<size_t>& window,
+                                     size_t required) {
+    if (getLoadedBytes() + required <= memoryBudget_) return;
+
+    const auto size = sequence_->size();
+    std::vector<size_t> candidates;
+    for (auto i : loaded_) {
+        if (i != index && pending_.count(i) == 0 &&
+            std::find(window.begin(), window.end(), i) == window.end()) {
+            candidates.push_back(i);
+        }
+    }
+    // The time steps right behind the current one are reached last during playback
+    const auto distance = [&](size_t i) {
+        return forward_ ? (index + size - i) % size : (i + size - index) % size;
+    };
+    std::sort(candidates.begin(), candidates.end(),
+              [&](size_t a, size_t b) { return distance(a) < distance(b); });
+
+    for (auto i : candidates) {
+        if (getLoadedBytes() + required <= memoryBudget_) break;
+        evict(i);
+    }
+}
+
+void VolumeSequencePrefetcher::evict(size_t index) {
+    const auto& volume = (*sequence_)[index];
+    if (!volume->hasRepresentation<VolumeRAM>()) {
+        loaded_.erase(index);
+        return;
+    }
+    // Only release data that can be loaded again and that is not used by anyone else
+    if (volume.use_count() > 1 || !volume->hasValidRepresentation<VolumeRAM>() ||
+        !volume->hasValidRepresentation<VolumeDisk>()) {
+        return;
+    }
+    volume->removeRepresentation(volume->getRepresentation<VolumeRAM>());
+    loaded_.erase(index);
+    ++stats_.evicted;
+}
+
+}  // namespace inviwo
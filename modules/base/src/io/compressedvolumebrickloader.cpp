@@ -0,0 +1,212 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2021 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#include <modules/base/io/compressedvolumebrickloader.h>
+#include <modules/base/algorithm/volume/volumeramsubset.h>
+#include <inviwo/core/datastructures/volume/volume.h>
+#include <inviwo/core/datastructures/volume/volumeram.h>
+#include <inviwo/core/io/bytereaderutil.h>
+#include <inviwo/core/io/datareaderexception.h>
+#include <inviwo/core/io/datawriterexception.h>
+#include <inviwo/core/util/filesystem.h>
+#include <inviwo/core/util/indexmapper.h>
+#include <inviwo/core/util/parallel.h>
+
+#include <zlib.h>
+
+#include <algorithm>
+#include <cstring>
+#include <limits>
+#include <ostream>
+
+namespace inviwo {
+
+namespace {
+
+// Number of bricks extracted and compressed concurrently while writing, bounds the memory used
+constexpr size_t writeBatchSize = 256;
+
+std::vector<char> compress(const char* src, size_t bytes, IvfCompression compression) {
+    switch (compression) {
+        case IvfCompression::Zlib: {
+            if (bytes > std::numeric_limits<uLong>::max()) {
+                throw DataWriterException("Brick too large for zlib compression",
+                                          IVW_CONTEXT_CUSTOM("util::writeCompressedBricks"));
+            }
+            uLongf size = compressBound(static_cast<uLong>(bytes));
+            std::vector<char> res(size);
+            // Favor speed, the label and segmentation volumes this is used for compress well
+            // even at the lowest level and decompression speed does not depend on the level
+            if (compress2(reinterpret_cast<Bytef*>(res.data()), &size,
+                          reinterpret_cast<const Bytef*>(src), static_cast<uLong>(bytes),
+                          Z_BEST_SPEED) != Z_OK) {
+                throw DataWriterException("zlib compression failed",
+                                          IVW_CONTEXT_CUSTOM("util::writeCompressedBricks"));
+            }
+            res.resize(size);
+            return res;
+        }
+        case IvfCompression::None:
+        default:
+            return std::vector<char>(src, src + bytes);
+    }
+}
+
+void decompress(const char* src, size_t srcBytes, char* dst, size_t dstBytes,
+                IvfCompression compression, const std::string& file) {
+    switch (compression) {
+        case IvfCompression::Zlib: {
+            uLongf size = static_cast<uLongf>(dstBytes);
+            if (uncompress(reinterpret_cast<Bytef*>(dst), &size,
+                           reinterpret_cast<const Bytef*>(src),
+                           static_cast<uLong>(srcBytes)) != Z_OK ||
+                size != dstBytes) {
+                throw DataReaderException("Error: Corrupt compressed brick in file: " + file,
+                                          IVW_CONTEXT_CUSTOM("CompressedVolumeBrickLoader"));
+            }
+            break;
+        }
+        case IvfCompression::None:
+        default:
+            if (srcBytes != dstBytes) {
+                throw DataReaderException("Error: Corrupt brick in file: " + file,
+                                          IVW_CONTEXT_CUSTOM("CompressedVolumeBrickLoader"));
+            }
+            std::memcpy(dst, src, dstBytes);
+            break;
+    }
+}
+
+void swapBytes(char* data, size_t bytes, size_t elementSize) {
+    for (size_t i = 0; i < bytes; i += elementSize) {
+        std::reverse(data + i, data + i + elementSize);
+    }
+}
+
+}  // namespace
+
+CompressedVolumeBrickLoader::CompressedVolumeBrickLoader(const std::string& rawFile,
+                                                         size_t offset, bool littleEndian,
+                                                         IvfCompression compression,
+                                                         size_t numberOfBricks)
+    : rawFile_(rawFile)
+    , offset_(offset)
+    , littleEndian_(littleEndian)
+    , compression_(compression)
+    , index_(numberOfBricks + 1) {
+
+    util::readBytesIntoBuffer(rawFile_, offset_, index_.size() * sizeof(std::uint64_t),
+                              littleEndian_, sizeof(std::uint64_t), index_.data());
+    if (index_.front() != index_.size() * sizeof(std::uint64_t) ||
+        !std::is_sorted(index_.begin(), index_.end())) {
+        throw DataReaderException("Error: Invalid brick index in file: " + rawFile_, IVW_CONTEXT);
+    }
+}
+
+std::shared_ptr<VolumeRAM> CompressedVolumeBrickLoader::loadBrick(const VolumeBrickedRAM& volume,
+                                                                  size3_t brick) const {
+    const auto extent = volume.getBrickExtent(brick);
+    auto res = createVolumeRAM(extent, volume.getDataFormat(), nullptr, volume.getSwizzleMask(),
+                               volume.getInterpolation(), volume.getWrapping());
+
+    const util::IndexMapper3D im(volume.getNumberOfBricks());
+    const auto i = im(brick);
+    if (i + 1 >= index_.size()) {
+        throw DataReaderException("Error: Brick outside of index in file: " + rawFile_,
+                                  IVW_CONTEXT);
+    }
+
+    std::vector<char> compressed(static_cast<size_t>(index_[i + 1] - index_[i]));
+    auto fin = filesystem::ifstream(rawFile_, std::ios::in | std::ios::binary);
+    fin.seekg(offset_ + index_[i]);
+    fin.read(compressed.data(), compressed.size());
+    if (!fin) {
+        throw DataReaderException("Error: Could not read from file: " + rawFile_, IVW_CONTEXT);
+    }
+
+    const auto elementSize = volume.getDataFormat()->getSize();
+    const auto bytes = glm::compMul(extent) * elementSize;
+    auto data = static_cast<char*>(res->getData());
+    decompress(compressed.data(), compressed.size(), data, bytes, compression_, rawFile_);
+    if (!littleEndian_ && elementSize > 1) swapBytes(data, bytes, elementSize);
+    return res;
+}
+
+const std::vector<std::uint64_t>& CompressedVolumeBrickLoader::getIndex() const {
+    return index_;
+}
+
+void util::writeCompressedBricks(const Volume& data, size3_t brickSize,
+                                 IvfCompression compression, std::ostream& out) {
+    const auto dims = data.getDimensions();
+    const auto bricked = data.hasRepresentation<VolumeBrickedRAM>()
+                             ? data.getRepresentation<VolumeBrickedRAM>()
+                             : nullptr;
+    const auto ram = bricked ? nullptr : data.getRepresentation<VolumeRAM>();
+
+    const size3_t numBricks = (dims + brickSize - size3_t{1}) / brickSize;
+    const auto nBricks = glm::compMul(numBricks);
+    const util::IndexMapper3D im(numBricks);
+
+    // Reserve space for the index, it is written when all brick sizes are known
+    std::vector<std::uint64_t> index(nBricks + 1);
+    const auto indexPos = out.tellp();
+    out.write(reinterpret_cast<const char*>(index.data()), index.size() * sizeof(std::uint64_t));
+    index[0] = index.size() * sizeof(std::uint64_t);
+
+    std::vector<std::vector<char>> batch;
+    for (size_t first = 0; first < nBricks; first += writeBatchSize) {
+        const auto last = std::min(nBricks, first + writeBatchSize);
+        batch.resize(last - first);
+        util::parallelFor(first, last, [&](size_t i) {
+            const auto offset = im(i) * brickSize;
+            const auto extent = glm::min(offset + brickSize, dims) - offset;
+            const auto brick = bricked ? bricked->getRegion(offset, extent)
+                                       : VolumeRAMSubSet::apply(ram, extent, offset);
+            batch[i - first] = compress(static_cast<const char*>(brick->getData()),
+                                        brick->getNumberOfBytes(), compression);
+        });
+        for (size_t i = first; i < last; ++i) {
+            const auto& chunk = batch[i - first];
+            out.write(chunk.data(), chunk.size());
+            index[i + 1] = index[i] + chunk.size();
+        }
+    }
+
+    const auto end = out.tellp();
+    out.seekp(indexPos);
+    out.write(reinterpret_cast<const char*>(index.data()), index.size() * sizeof(std::uint64_t));
+    out.seekp(end);
+    if (!out) {
+        throw DataWriterException("Could not write compressed bricks",
+                                  IVW_CONTEXT_CUSTOM("util::writeCompressedBricks"));
+    }
+}
+
+}  // namespace inviwo
@@ -28,12 +28,15 @@
  *********************************************************************************/
 
 #include <modules/base/io/ivfvolumereader.h>
+#include <modules/base/io/compressedvolumebrickloader.h>
 #include <inviwo/core/datastructures/volume/volumeramprecision.h>
 #include <inviwo/core/datastructures/volume/volumedisk.h>
+#include <inviwo/core/datastructures/volume/volumebrickedram.h>
 #include <inviwo/core/util/filesystem.h>
 #include <inviwo/core/common/inviwoapplication.h>
 #include <inviwo/core/io/datareaderexception.h>
 #include <inviwo/core/io/rawvolumeramloader.h>
+#include <inviwo/core/io/rawvolumebrickloader.h>
 
 namespace inviwo {
 
@@ -55,6 +58,7 @@ std::shared_ptr<Volume> IvfVolumeReader::readData(const std::string& filePath) {
     std::string rawFile;
     size3_t dimensions{0u};
     size_t byteOffset = 0u;
+    size3_t brickSize{0u};
     const DataFormatBase* format = nullptr;
     bool littleEndian = true;
 
@@ -62,6 +66,18 @@ std::shared_ptr<Volume> IvfVolumeReader::readData(const std::string& filePath) {
     d.deserialize("RawFile", rawFile);
     rawFile = fileDirectory + "/" + rawFile;
     d.deserialize("ByteOffset", byteOffset);
+    d.deserialize("BrickSize", brickSize);
+    std::string compression;
+    d.deserialize("Compression", compression);
+    if (!compression.empty() && compression != "zlib") {
+        throw DataReaderException("Error unsupported compression '" + compression +
+                                      "' in file: " + filePath,
+                                  IVW_CONTEXT);
+    }
+    if (!compression.empty() && glm::compMul(brickSize) == 0) {
+        throw DataReaderException("Error compressed file without brick size: " + filePath,
+                                  IVW_CONTEXT);
+    }
     std::string formatFlag;
     d.deserialize("Format", formatFlag);
     format = DataFormatBase::get(formatFlag);
@@ -90,6 +106,25 @@ std::shared_ptr<Volume> IvfVolumeReader::readData(const std::string& filePath) {
 
     volume->getMetaDataMap()->deserialize(d);
     littleEndian = volume->getMetaData<BoolMetaData>("LittleEndian", littleEndian);
+
+    if (!compression.empty()) {
+        // Compressed files are always bricked, each brick is decompressed when needed
+        const size3_t numBricks = (dimensions + brickSize - size3_t{1}) / brickSize;
+        auto loader = std::make_shared<CompressedVolumeBrickLoader>(
+            rawFile, byteOffset, littleEndian, IvfCompression::Zlib, glm::compMul(numBricks));
+        volume->addRepresentation(std::make_shared<VolumeBrickedRAM>(
+            loader, dimensions, brickSize, format, swizzleMask, interpolation, wrapping));
+        return volume;
+    }
+
+    if (glm::compMul(brickSize) != 0) {
+        // Bricked raw files are loaded one brick at a time as needed
+        auto loader = std::make_shared<RawVolumeBrickLoader>(rawFile, byteOffset, littleEndian);
+        volume->addRepresentation(std::make_shared<VolumeBrickedRAM>(
+            loader, dimensions, brickSize, format, swizzleMask, interpolation, wrapping));
+        return volume;
+    }
+
     auto vd = std::make_shared<VolumeDisk>(filePath, dimensions, format, swizzleMask, interpolation,
                                            wrapping);
 
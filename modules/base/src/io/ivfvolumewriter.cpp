@@ -30,6 +30,9 @@
 #include <modules/base/io/ivfvolumewriter.h>
 #include <inviwo/core/util/filesystem.h>
 #include <inviwo/core/datastructures/volume/volumeram.h>
+#include <inviwo/core/datastructures/volume/volumebrickedram.h>
+#include <inviwo/core/util/indexmapper.h>
+#include <modules/base/algorithm/volume/volumeramsubset.h>
 #include <inviwo/core/io/datawriterexception.h>
 
 namespace inviwo {
@@ -45,11 +48,42 @@ IvfVolumeWriter& IvfVolumeWriter::operator=(const IvfVolumeWriter& that) = defau
 IvfVolumeWriter* IvfVolumeWriter::clone() const { return new IvfVolumeWriter(*this); }
 
 void IvfVolumeWriter::writeData(const Volume* volume, const std::string filePath) const {
-    util::writeIvfVolume(*volume, filePath, getOverwrite());
+    util::writeIvfVolume(*volume, filePath, getOverwrite(), brickSize_, compression_);
 }
 
+void IvfVolumeWriter::setBrickSize(size3_t brickSize) { brickSize_ = brickSize; }
+
+size3_t IvfVolumeWriter::getBrickSize() const { return brickSize_; }
+
+void IvfVolumeWriter::setCompression(IvfCompression compression) { compression_ = compression; }
+
+IvfCompression IvfVolumeWriter::getCompression() const { return compression_; }
+
 namespace util {
-void writeIvfVolume(const Volume& data, const std::string filePath, bool overwrite) {
+namespace {
+
+void writeBricks(const Volume& data, size3_t brickSize, std::ostream& out) {
+    const auto dims = data.getDimensions();
+    const auto bricked = data.hasRepresentation<VolumeBrickedRAM>()
+                             ? data.getRepresentation<VolumeBrickedRAM>()
+                             : nullptr;
+    const auto ram = bricked ? nullptr : data.getRepresentation<VolumeRAM>();
+
+    const size3_t numBricks = (dims + brickSize - size3_t{1}) / brickSize;
+    const util::IndexMapper3D im(numBricks);
+    for (size_t i = 0; i < glm::compMul(numBricks); ++i) {
+        const auto offset = im(i) * brickSize;
+        const auto extent = glm::min(offset + brickSize, dims) - offset;
+        const auto brick = bricked ? bricked->getRegion(offset, extent)
+                                   : VolumeRAMSubSet::apply(ram, extent, offset);
+        out.write(static_cast<const char*>(brick->getData()), brick->getNumberOfBytes());
+    }
+}
+
+}  // namespace
+
+void writeIvfVolume(const Volume& data, const std::string filePath, bool overwrite,
+                    size3_t brickSize, IvfCompression compression) {
     std::string rawPath = filesystem::replaceFileExtension(filePath, "raw");
 
     if (filesystem::fileExists(filePath) && !overwrite)
@@ -60,12 +94,23 @@ void writeIvfVolume(const Volume& data, const std::string filePath, bool overwri
         throw DataWriterException("Output file: " + rawPath + " already exists",
                                   IVW_CONTEXT_CUSTOM("util::writeIvfVolume"));
 
+    const bool compressed = compression != IvfCompression::None;
+    if (compressed && glm::compMul(brickSize) == 0) brickSize = size3_t{64};
+    const bool writeBricked = glm::compMul(brickSize) != 0;
+    // Avoid loading the whole volume if it is bricked and we write bricks
+    const VolumeRepresentation* vr =
+        writeBricked && data.hasRepresentation<VolumeBrickedRAM>()
+            ? static_cast<const VolumeRepresentation*>(
+                  data.getRepresentation<VolumeBrickedRAM>())
+            : data.getRepresentation<VolumeRAM>();
+
     const std::string fileName = filesystem::getFileNameWithoutExtension(filePath);
-    const VolumeRAM* vr = data.getRepresentation<VolumeRAM>();
     Serializer s(filePath);
     s.serialize("RawFile", fileName + ".raw");
     s.serialize("Format", vr->getDataFormatString());
     s.serialize("ByteOffset", 0u);
+    if (writeBricked) s.serialize("BrickSize", brickSize);
+    if (compressed) s.serialize("Compression", std::string{"zlib"});
     s.serialize("BasisAndOffset", data.getModelMatrix());
     s.serialize("WorldTransform", data.getWorldMatrix());
     s.serialize("Dimension", data.getDimensions());
@@ -81,8 +126,15 @@ void writeIvfVolume(const Volume& data, const std::string filePath, bool overwri
     s.writeFile();
 
     if (auto fout = filesystem::ofstream(rawPath, std::ios::out | std::ios::binary)) {
-        fout.write(static_cast<const char*>(vr->getData()),
-                   glm::compMul(vr->getDimensions()) * vr->getDataFormat()->getSize());
+        if (compressed) {
+            writeCompressedBricks(data, brickSize, compression, fout);
+        } else if (writeBricked) {
+            writeBricks(data, brickSize, fout);
+        } else {
+            const auto ram = static_cast<const VolumeRAM*>(vr);
+            fout.write(static_cast<const char*>(ram->getData()),
+                       glm::compMul(ram->getDimensions()) * ram->getDataFormat()->getSize());
+        }
     } else {
         throw DataWriterException("Could not write to raw file: " + rawPath,
                                   IVW_CONTEXT_CUSTOM("util::writeIvfVolume"));
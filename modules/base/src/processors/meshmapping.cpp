@@ -29,6 +29,7 @@
 
 #include <modules/base/processors/meshmapping.h>
 
+#include <inviwo/core/datastructures/tflookuptable.h>
 #include <inviwo/core/datastructures/transferfunction.h>
 #include <inviwo/core/datastructures/geometry/mesh.h>
 #include <inviwo/core/datastructures/buffer/bufferramprecision.h>
@@ -162,12 +163,12 @@ void MeshMapping::process() {
         srcBuffer->dispatch<void>([comp = component_.getSelectedIndex(),
                                    range = useCustomDataRange_.get() ? customDataRange_.get()
                                                                      : dataRange_.get(),
-                                   dst = &colorsOut, tf = &tf_.get()](auto pBuffer) {
+                                   dst = &colorsOut, tf = TFLookupTable(tf_.get())](auto pBuffer) {
             auto& vec = pBuffer->getDataContainer();
             std::transform(vec.begin(), vec.end(), dst->begin(), [&](auto& v) {
                 auto value = util::glmcomp(v, comp);
                 double normalized = (static_cast<double>(value) - range.x) / (range.y - range.x);
-                return tf->sample(normalized);
+                return tf.sample(normalized);
             });
         });
 
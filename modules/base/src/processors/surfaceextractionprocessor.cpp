@@ -61,8 +61,9 @@ SurfaceExtraction::SurfaceExtraction()
     , method_("method", "Method",
               {{"marchingtetrahedron", "Marching Tetrahedron", Method::MarchingTetrahedron},
                {"marchingcubes", "Marching Cubes", Method::MarchingCubes},
-               {"marchingCubesOpt", "Marching Cubes Optimized", Method::MarchingCubesOpt}},
-              2)
+               {"marchingCubesOpt", "Marching Cubes Optimized", Method::MarchingCubesOpt},
+               {"marchingCubesParallel", "Marching Cubes Parallel", Method::MarchingCubesParallel}},
+              3)
     , isoValue_("iso", "ISO Value", 0.5f, 0.0f, 1.0f, 0.01f)
     , invertIso_("invert", "Invert ISO", false)
     , encloseSurface_("enclose", "Enclose Surface", true)
@@ -102,10 +103,14 @@ void SurfaceExtraction::process() {
     const auto computeSurface = [this](vec4 color, std::shared_ptr<const Volume> vol) {
         return [vol, color, method = method_.get(), iso = isoValue_.get(),
                 invert = invertIso_.get(),
-                enclose = encloseSurface_.get()](pool::Progress progress) -> std::shared_ptr<Mesh> {
+                enclose = encloseSurface_.get()](pool::Stop stop,
+                                                 pool::Progress progress) -> std::shared_ptr<Mesh> {
             RenderContext::getPtr()->activateLocalRenderContext();
 
             switch (method) {
+                case Method::MarchingCubesParallel:
+                    return util::marchingCubesParallel(vol, iso, color, invert, enclose, progress,
+                                                       nullptr, [stop]() -> bool { return stop; });
                 case Method::MarchingCubes:
                     return util::marchingcubes(vol, iso, color, invert, enclose, progress);
                 case Method::MarchingCubesOpt:
@@ -118,7 +123,7 @@ void SurfaceExtraction::process() {
     };
 
     const auto changeColor = [](vec4 color, std::shared_ptr<const Mesh> oldmesh) {
-        return [oldmesh, color](pool::Progress) -> std::shared_ptr<Mesh> {
+        return [oldmesh, color](pool::Stop, pool::Progress) -> std::shared_ptr<Mesh> {
             RenderContext::getPtr()->activateLocalRenderContext();
 
             auto mesh = std::make_shared<Mesh>(oldmesh->getDefaultMeshInfo());
@@ -165,7 +170,8 @@ void SurfaceExtraction::process() {
             newResults();
         });
     } else {  // Only update the modified ones
-        std::vector<std::function<std::shared_ptr<Mesh>(pool::Progress progress)>> jobs;
+        std::vector<std::function<std::shared_ptr<Mesh>(pool::Stop stop, pool::Progress progress)>>
+            jobs;
         std::vector<size_t> inds;
         for (auto [i, item] : util::enumerate(volume_.changedAndData())) {
             const auto portChanged = item.first;
@@ -0,0 +1,96 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2021 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#include <modules/base/processors/volumeclassificationcpu.h>
+#include <modules/base/algorithm/volume/volumeclassification.h>
+
+#include <inviwo/core/datastructures/tflookuptable.h>
+#include <inviwo/core/datastructures/volume/volume.h>
+
+namespace inviwo {
+
+// The Class Identifier has to be globally unique. Use a reverse DNS naming scheme
+const ProcessorInfo VolumeClassificationCPU::processorInfo_{
+    "org.inviwo.VolumeClassificationCPU",  // Class identifier
+    "Volume Classification CPU",           // Display name
+    "Volume Operation",                    // Category
+    CodeState::Experimental,               // Code state
+    "CPU, Volume, Transfer Function",      // Tags
+};
+const ProcessorInfo VolumeClassificationCPU::getProcessorInfo() const { return processorInfo_; }
+
+VolumeClassificationCPU::VolumeClassificationCPU()
+    : PoolProcessor(pool::Option::DelayDispatch)
+    , volume_("volume")
+    , outport_("outport")
+    , channel_("channel", "Channel", {{"Channel 1", "Channel 1", 0}}, 0)
+    , tf_("transferFunction", "Transfer Function", &volume_)
+    , format_("outputFormat", "Output Format",
+              {{DataVec4UInt8::str(), DataVec4UInt8::str(), DataVec4UInt8::id()},
+               {DataVec4Float32::str(), DataVec4Float32::str(), DataVec4Float32::id()}},
+              0) {
+
+    addPort(volume_);
+    addPort(outport_);
+
+    channel_.setSerializationMode(PropertySerializationMode::All);
+    volume_.onChange([this]() {
+        if (!volume_.hasData()) return;
+        const size_t channels = volume_.getData()->getDataFormat()->getComponents();
+        if (channels == channel_.size()) return;
+
+        std::vector<OptionPropertyIntOption> channelOptions;
+        for (size_t i = 0; i < channels; i++) {
+            channelOptions.emplace_back("Channel " + toString(i + 1), "Channel " + toString(i + 1),
+                                        static_cast<int>(i));
+        }
+        channel_.replaceOptions(channelOptions);
+        channel_.setCurrentStateAsDefault();
+    });
+
+    addProperties(channel_, tf_, format_);
+}
+
+void VolumeClassificationCPU::process() {
+    // The lookup table is created here since the transfer function may only be accessed from the
+    // main thread
+    const auto calc = [volume = volume_.getData(), tf = TFLookupTable(tf_.get()),
+                       channel = static_cast<size_t>(channel_.get()),
+                       format = DataFormatBase::get(format_.get())](
+                          pool::Stop) -> std::shared_ptr<Volume> {
+        return util::classifyVolume(*volume, tf, channel, format);
+    };
+
+    dispatchOne(calc, [this](std::shared_ptr<Volume> result) {
+        outport_.setData(result);
+        newResults();
+    });
+}
+
+}  // namespace inviwo
@@ -0,0 +1,122 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2021 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#include <modules/base/processors/volumelevelofdetail.h>
+
+#include <inviwo/core/datastructures/volume/volume.h>
+
+namespace inviwo {
+
+// The Class Identifier has to be globally unique. Use a reverse DNS naming scheme
+const ProcessorInfo VolumeLevelOfDetail::processorInfo_{
+    "org.inviwo.VolumeLevelOfDetail",  // Class identifier
+    "Volume Level Of Detail",          // Display name
+    "Volume Operation",                // Category
+    CodeState::Experimental,           // Code state
+    Tags::CPU,                         // Tags
+};
+const ProcessorInfo VolumeLevelOfDetail::getProcessorInfo() const { return processorInfo_; }
+
+VolumeLevelOfDetail::VolumeLevelOfDetail()
+    : PoolProcessor(pool::Option::QueuedDispatch)
+    , volume_("volume")
+    , outport_("outport")
+    , selection_("selection", "Select Level By",
+                 {{"level", "Level", Selection::Level},
+                  {"voxelBudget", "Voxel Budget", Selection::VoxelBudget}},
+                 1)
+    , level_("level", "Level", 1, 0, 32)
+    , voxelBudget_("voxelBudget", "Max Voxels (millions)", 16.0, 0.0, 1024.0, 0.1)
+    , reduction_("reduction", "Reduction",
+                 {{"average", "Average", VolumeReduction::Average},
+                  {"min", "Minimum", VolumeReduction::Min},
+                  {"max", "Maximum", VolumeReduction::Max}},
+                 0)
+    , outputDimensions_("outputDimensions", "Output Dimensions", size3_t(0),
+                        size3_t(0), size3_t(std::numeric_limits<size_t>::max()), size3_t(1),
+                        InvalidationLevel::Valid, PropertySemantics::Text) {
+
+    addPort(volume_);
+    addPort(outport_);
+
+    addProperties(selection_, level_, voxelBudget_, reduction_, outputDimensions_);
+    level_.visibilityDependsOn(selection_,
+                               [](const auto& p) { return p.get() == Selection::Level; });
+    voxelBudget_.visibilityDependsOn(
+        selection_, [](const auto& p) { return p.get() == Selection::VoxelBudget; });
+    outputDimensions_.setReadOnly(true);
+    outputDimensions_.setSerializationMode(PropertySerializationMode::None);
+}
+
+void VolumeLevelOfDetail::process() {
+    auto volume = volume_.getData();
+    if (!pyramid_ || pyramid_->getVolume() != volume ||
+        pyramid_->getReduction() != reduction_.get()) {
+        pyramid_ = VolumePyramid::get(volume, reduction_.get());
+    }
+
+    const size_t level = [&]() {
+        if (selection_ == Selection::Level) {
+            return std::min(level_.get(), pyramid_->getNumberOfLevels() - 1);
+        } else {
+            const auto voxels = static_cast<size_t>(voxelBudget_.get() * 1.0e6);
+            return pyramid_->getLevelForVoxelBudget(voxels);
+        }
+    }();
+    outputDimensions_.set(pyramid_->getDimensions(level));
+
+    // Existing levels also go through the pool, dispatching stops any job for a previous level
+    // that would otherwise overwrite this one when it finishes.
+    using Result = std::shared_ptr<const Volume>;
+    auto done = [this](Result result) {
+        outport_.setData(result);
+        newResults();
+    };
+    if (pyramid_->hasLevel(level)) {
+        dispatchOne([volume = pyramid_->getLevel(level)]() -> Result { return volume; },
+                    std::move(done));
+        return;
+    }
+
+    outport_.clear();
+    // Compute one level at a time to be able to stop in between
+    const auto calc = [pyramid = pyramid_, level](pool::Stop stop,
+                                                  pool::Progress progress) -> Result {
+        for (size_t i = 1; i < level; ++i) {
+            if (stop) return nullptr;
+            progress(i, level);
+            pyramid->getLevel(i);
+        }
+        return pyramid->getLevel(level);
+    };
+
+    dispatchOne(calc, std::move(done));
+}
+
+}  // namespace inviwo
@@ -0,0 +1,127 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2021 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#include <modules/base/processors/volumeraycastercpu.h>
+#include <modules/base/algorithm/volume/volumeraycasting.h>
+
+#include <inviwo/core/algorithm/boundingbox.h>
+#include <inviwo/core/datastructures/image/image.h>
+
+namespace inviwo {
+
+// The Class Identifier has to be globally unique. Use a reverse DNS naming scheme
+const ProcessorInfo VolumeRaycasterCPU::processorInfo_{
+    "org.inviwo.VolumeRaycasterCPU",  // Class identifier
+    "Volume Raycaster CPU",           // Display name
+    "Volume Rendering",               // Category
+    CodeState::Experimental,          // Code state
+    "CPU, DVR, Raycasting",           // Tags
+};
+const ProcessorInfo VolumeRaycasterCPU::getProcessorInfo() const { return processorInfo_; }
+
+VolumeRaycasterCPU::VolumeRaycasterCPU()
+    : PoolProcessor(pool::Option::QueuedDispatch | pool::Option::DelayInvalidation)
+    , volume_("volume")
+    , outport_("outport")
+    , channel_("channel", "Render Channel", {{"Channel 1", "Channel 1", 0}}, 0)
+    , samplingRate_("samplingRate", "Sampling Rate", 2.0f, 0.1f, 20.0f)
+    , tf_("transferFunction", "Transfer Function", &volume_)
+    , earlyRayTermination_("earlyRayTermination", "Early Ray Termination", 0.99f, 0.5f, 1.0f)
+    , emptySpaceSkipping_("emptySpaceSkipping", "Empty Space Skipping", true)
+    , camera_("camera", "Camera", util::boundingBox(volume_))
+    , lighting_("lighting", "Lighting", &camera_) {
+
+    addPort(volume_);
+    addPort(outport_);
+
+    channel_.setSerializationMode(PropertySerializationMode::All);
+    volume_.onChange([this]() {
+        if (!volume_.hasData()) return;
+        const size_t channels = volume_.getData()->getDataFormat()->getComponents();
+        if (channels == channel_.size()) return;
+
+        std::vector<OptionPropertyIntOption> channelOptions;
+        for (size_t i = 0; i < channels; i++) {
+            channelOptions.emplace_back("Channel " + toString(i + 1), "Channel " + toString(i + 1),
+                                        static_cast<int>(i));
+        }
+        channel_.replaceOptions(channelOptions);
+        channel_.setCurrentStateAsDefault();
+    });
+
+    addProperties(channel_, samplingRate_, tf_, earlyRayTermination_, emptySpaceSkipping_, camera_,
+                  lighting_);
+}
+
+void VolumeRaycasterCPU::process() {
+    // The normalized volume and the bricks do not depend on the camera, the image size, or the
+    // lighting. Keep them as long as their inputs are unchanged.
+    if (!grid_ || volume_.isChanged() || channel_.isModified()) {
+        grid_ = std::make_shared<Cached<util::ScalarGrid>>();
+        bricks_ = std::make_shared<Cached<util::BrickGrid>>();
+    }
+    if (!lookup_ || tf_.isModified()) {
+        lookup_ = std::make_shared<util::TFLookup>(tf_.get());
+        bricks_ = std::make_shared<Cached<util::BrickGrid>>();
+    }
+
+    util::VolumeRaycastingSettings settings;
+    settings.channel = static_cast<size_t>(channel_.get());
+    settings.samplingRate = samplingRate_.get();
+    settings.lighting = lighting_.getState();
+    settings.earlyRayTermination = earlyRayTermination_.get();
+    settings.emptySpaceSkipping = emptySpaceSkipping_.get();
+
+    const auto calc = [volume = volume_.getData(), grid = grid_, lookup = lookup_, bricks = bricks_,
+                       camera = std::shared_ptr<const Camera>(camera_.get().clone()),
+                       dimensions = outport_.getDimensions(),
+                       settings](pool::Stop stop) -> std::shared_ptr<Image> {
+        const auto scalars = grid->get([&]() {
+            return std::make_shared<util::ScalarGrid>(*volume, settings.channel);
+        });
+        if (stop) return nullptr;
+
+        std::shared_ptr<const util::BrickGrid> skipping;
+        if (settings.emptySpaceSkipping) {
+            skipping = bricks->get([&]() {
+                return std::make_shared<util::BrickGrid>(*scalars, *lookup, settings.brickSize);
+            });
+        }
+
+        return util::raycastVolume(*volume, *scalars, *lookup, skipping.get(), *camera, dimensions,
+                                   settings, [stop]() -> bool { return stop; });
+    };
+
+    dispatchOne(calc, [this](std::shared_ptr<Image> result) {
+        outport_.setData(result);
+        newResults();
+    });
+}
+
+}  // namespace inviwo
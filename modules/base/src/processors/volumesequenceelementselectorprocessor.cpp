@@ -42,9 +42,54 @@ const ProcessorInfo VolumeSequenceElementSelectorProcessor::getProcessorInfo() c
     return processorInfo_;
 }
 VolumeSequenceElementSelectorProcessor::VolumeSequenceElementSelectorProcessor()
-    : VectorElementSelectorProcessor<Volume>() {
+    : VectorElementSelectorProcessor<Volume>()
+    , prefetch_("prefetch", "Prefetch", true)
+    , lookahead_("lookahead", "Time Steps Ahead", 2, 0, 16, 1)
+    , memoryBudget_("memoryBudget", "Memory Budget (MB)", 1024, 0, 65536, 64)
+    , hits_("hits", "Hits", 0, 0, std::numeric_limits<size_t>::max(), 1, InvalidationLevel::Valid,
+            PropertySemantics("Text"))
+    , misses_("misses", "Misses", 0, 0, std::numeric_limits<size_t>::max(), 1,
+              InvalidationLevel::Valid, PropertySemantics("Text"))
+    , resetStatistics_("resetStatistics", "Reset Statistics",
+                       [this]() {
+                           prefetcher_.resetStatistics();
+                           updateStatistics();
+                       },
+                       InvalidationLevel::Valid)
+    , prefetcher_(lookahead_.get(), memoryBudget_.get() << 20) {
     timeStep_.index_.autoLinkToProperty<VolumeSequenceElementSelectorProcessor>(
         "timeStep.selectedSequenceIndex");
+
+    for (auto prop : {&hits_, &misses_}) {
+        prop->setReadOnly(true);
+        prop->setSerializationMode(PropertySerializationMode::None);
+    }
+    prefetch_.addProperties(lookahead_, memoryBudget_, hits_, misses_, resetStatistics_);
+    addProperty(prefetch_);
+
+    prefetch_.getBoolProperty()->onChange([this]() {
+        if (!prefetch_.isChecked()) prefetcher_.setSequence(nullptr);
+    });
+    lookahead_.onChange([this]() { prefetcher_.setLookahead(lookahead_.get()); });
+    memoryBudget_.onChange([this]() { prefetcher_.setMemoryBudget(memoryBudget_.get() << 20); });
+}
+
+void VolumeSequenceElementSelectorProcessor::process() {
+    if (prefetch_.isChecked() && inport_.isReady()) {
+        if (auto data = inport_.getData(); data && !data->empty()) {
+            prefetcher_.setSequence(data);
+            // Register the access before the volume is passed on and loaded by the consumers
+            prefetcher_.access(std::min(data->size() - 1, timeStep_.index_.get() - 1));
+            updateStatistics();
+        }
+    }
+    VectorElementSelectorProcessor<Volume>::process();
+}
+
+void VolumeSequenceElementSelectorProcessor::updateStatistics() {
+    const auto& stats = prefetcher_.getStatistics();
+    hits_.set(stats.hits);
+    misses_.set(stats.misses);
 }
 
 }  // namespace inviwo
@@ -34,6 +34,7 @@
 
 #include <inviwo/core/datastructures/volume/volume.h>
 #include <inviwo/core/datastructures/volume/volumeramprecision.h>
+#include <inviwo/core/datastructures/volume/volumebrickedram.h>
 #include <inviwo/core/datastructures/image/imageram.h>
 #include <inviwo/core/datastructures/image/layerramprecision.h>
 
@@ -137,96 +138,112 @@ void VolumeSlice::process() {
             break;
     }
 
-    auto image =
-        vol->getRepresentation<VolumeRAM>()
-            ->dispatch<std::shared_ptr<Image>, dispatching::filter::All>(
-                [axis = static_cast<CartesianCoordinateAxis>(sliceAlongAxis_.get()),
-                 slice = static_cast<size_t>(sliceNumber_.get() - 1),
-                 &cache = imageCache_](const auto vrprecision) {
-                    using T = util::PrecisionValueType<decltype(vrprecision)>;
-
-                    const T* voldata = vrprecision->getDataTyped();
-                    const auto voldim = vrprecision->getDimensions();
-
-                    const auto imgdim = [&]() {
-                        switch (axis) {
-                            default:
-                                return size2_t(voldim.z, voldim.y);
-                            case CartesianCoordinateAxis::X:
-                                return size2_t(voldim.z, voldim.y);
-                            case CartesianCoordinateAxis::Y:
-                                return size2_t(voldim.x, voldim.z);
-                            case CartesianCoordinateAxis::Z:
-                                return size2_t(voldim.x, voldim.y);
-                        }
-                    }();
-
-                    auto res = cache.getTypedUnused<T>(imgdim);
-                    auto sliceImage = res.first;
-                    auto layerrep = res.second;
-                    auto layerdata = layerrep->getDataTyped();
-
-                    switch (util::extent<T, 0>::value) {
-                        case 0:  // util::extent<T, 0>::value returns zero for non-glm types
-                        case 1:
-                            layerrep->setSwizzleMask({{ImageChannel::Red, ImageChannel::Red,
-                                                       ImageChannel::Red, ImageChannel::One}});
-                            break;
-                        case 2:
-                            layerrep->setSwizzleMask({{ImageChannel::Red, ImageChannel::Green,
-                                                       ImageChannel::Zero, ImageChannel::One}});
-                            break;
-                        case 3:
-                            layerrep->setSwizzleMask({{ImageChannel::Red, ImageChannel::Green,
-                                                       ImageChannel::Blue, ImageChannel::One}});
-                            break;
-                        default:
-                        case 4:
-                            layerrep->setSwizzleMask({{ImageChannel::Red, ImageChannel::Green,
-                                                       ImageChannel::Blue, ImageChannel::Alpha}});
-                    }
+    const auto axis = static_cast<CartesianCoordinateAxis>(sliceAlongAxis_.get());
+    auto slice = static_cast<size_t>(sliceNumber_.get() - 1);
 
-                    size_t offsetVolume;
-                    size_t offsetImage;
-                    switch (axis) {
-                        case CartesianCoordinateAxis::X: {
-                            util::IndexMapper3D vm(voldim);
-                            util::IndexMapper2D im(imgdim);
-                            auto x = glm::clamp(slice, size_t{0}, voldim.x - 1);
-                            for (size_t z = 0; z < voldim.z; z++) {
-                                for (size_t y = 0; y < voldim.y; y++) {
-                                    offsetVolume = vm(x, y, z);
-                                    offsetImage = im(z, y);
-                                    layerdata[offsetImage] = voldata[offsetVolume];
-                                }
-                            }
-                            break;
-                        }
-                        case CartesianCoordinateAxis::Y: {
-                            auto y = glm::clamp(slice, size_t{0}, voldim.y - 1);
-                            const size_t dataSize = voldim.x;
-                            const size_t initialStartPos = y * voldim.x;
-                            for (size_t j = 0; j < voldim.z; j++) {
-                                offsetVolume = (j * voldim.x * voldim.y) + initialStartPos;
-                                offsetImage = j * voldim.x;
-                                std::copy(voldata + offsetVolume, voldata + offsetVolume + dataSize,
-                                          layerdata + offsetImage);
-                            }
-                            break;
-                        }
-                        case CartesianCoordinateAxis::Z: {
-                            auto z = glm::clamp(slice, size_t{0}, voldim.z - 1);
-                            const size_t dataSize = voldim.x * voldim.y;
-                            const size_t initialStartPos = z * voldim.x * voldim.y;
-
-                            std::copy(voldata + initialStartPos,
-                                      voldata + initialStartPos + dataSize, layerdata);
-                            break;
+    // For bricked volumes only the bricks intersecting the slice are loaded, the slice is then
+    // extracted from a volume of thickness one.
+    std::shared_ptr<const VolumeRAM> sliceRegion;
+    const VolumeRAM* volram = nullptr;
+    if (vol->hasRepresentation<VolumeBrickedRAM>()) {
+        const auto axisIndex = static_cast<size_t>(axis);
+        size3_t offset{0};
+        size3_t extent{dims};
+        offset[axisIndex] = std::min(slice, dims[axisIndex] - 1);
+        extent[axisIndex] = 1;
+        sliceRegion = vol->getRepresentation<VolumeBrickedRAM>()->getRegion(offset, extent);
+        volram = sliceRegion.get();
+        slice = 0;
+    } else {
+        volram = vol->getRepresentation<VolumeRAM>();
+    }
+
+    auto image = volram->dispatch<std::shared_ptr<Image>, dispatching::filter::All>(
+        [axis, slice, &cache = imageCache_](const auto vrprecision) {
+            using T = util::PrecisionValueType<decltype(vrprecision)>;
+
+            const T* voldata = vrprecision->getDataTyped();
+            const auto voldim = vrprecision->getDimensions();
+
+            const auto imgdim = [&]() {
+                switch (axis) {
+                    default:
+                        return size2_t(voldim.z, voldim.y);
+                    case CartesianCoordinateAxis::X:
+                        return size2_t(voldim.z, voldim.y);
+                    case CartesianCoordinateAxis::Y:
+                        return size2_t(voldim.x, voldim.z);
+                    case CartesianCoordinateAxis::Z:
+                        return size2_t(voldim.x, voldim.y);
+                }
+            }();
+
+            auto res = cache.getTypedUnused<T>(imgdim);
+            auto sliceImage = res.first;
+            auto layerrep = res.second;
+            auto layerdata = layerrep->getDataTyped();
+
+            switch (util::extent<T, 0>::value) {
+                case 0:  // util::extent<T, 0>::value returns zero for non-glm types
+                case 1:
+                    layerrep->setSwizzleMask({{ImageChannel::Red, ImageChannel::Red,
+                                               ImageChannel::Red, ImageChannel::One}});
+                    break;
+                case 2:
+                    layerrep->setSwizzleMask({{ImageChannel::Red, ImageChannel::Green,
+                                               ImageChannel::Zero, ImageChannel::One}});
+                    break;
+                case 3:
+                    layerrep->setSwizzleMask({{ImageChannel::Red, ImageChannel::Green,
+                                               ImageChannel::Blue, ImageChannel::One}});
+                    break;
+                default:
+                case 4:
+                    layerrep->setSwizzleMask({{ImageChannel::Red, ImageChannel::Green,
+                                               ImageChannel::Blue, ImageChannel::Alpha}});
+            }
+
+            size_t offsetVolume;
+            size_t offsetImage;
+            switch (axis) {
+                case CartesianCoordinateAxis::X: {
+                    util::IndexMapper3D vm(voldim);
+                    util::IndexMapper2D im(imgdim);
+                    auto x = glm::clamp(slice, size_t{0}, voldim.x - 1);
+                    for (size_t z = 0; z < voldim.z; z++) {
+                        for (size_t y = 0; y < voldim.y; y++) {
+                            offsetVolume = vm(x, y, z);
+                            offsetImage = im(z, y);
+                            layerdata[offsetImage] = voldata[offsetVolume];
                         }
                     }
-                    cache.add(sliceImage);
-                    return sliceImage;
-                });
+                    break;
+                }
+                case CartesianCoordinateAxis::Y: {
+                    auto y = glm::clamp(slice, size_t{0}, voldim.y - 1);
+                    const size_t dataSize = voldim.x;
+                    const size_t initialStartPos = y * voldim.x;
+                    for (size_t j = 0; j < voldim.z; j++) {
+                        offsetVolume = (j * voldim.x * voldim.y) + initialStartPos;
+                        offsetImage = j * voldim.x;
+                        std::copy(voldata + offsetVolume, voldata + offsetVolume + dataSize,
+                                  layerdata + offsetImage);
+                    }
+                    break;
+                }
+                case CartesianCoordinateAxis::Z: {
+                    auto z = glm::clamp(slice, size_t{0}, voldim.z - 1);
+                    const size_t dataSize = voldim.x * voldim.y;
+                    const size_t initialStartPos = z * voldim.x * voldim.y;
+
+                    std::copy(voldata + initialStartPos,
+                              voldata + initialStartPos + dataSize, layerdata);
+                    break;
+                }
+            }
+            cache.add(sliceImage);
+            return sliceImage;
+        });
 
     outport_.setData(image);
 }
@@ -31,6 +31,7 @@
 #include <inviwo/core/common/inviwoapplication.h>
 #include <inviwo/core/util/stdextensions.h>
 #include <inviwo/core/datastructures/volume/volumeram.h>
+#include <inviwo/core/datastructures/volume/volumebrickedram.h>
 
 namespace inviwo {
 
@@ -77,8 +78,11 @@ void VolumeSubsample::process() {
 
 std::shared_ptr<Volume> VolumeSubsample::subsample(std::shared_ptr<const Volume> volume,
                                                    size3_t f) {
-    auto vol = volume->getRepresentation<VolumeRAM>();
-    auto sample = std::make_shared<Volume>(util::volumeSubSample(vol, f));
+    // Bricked volumes are subsampled a few bricks at a time
+    auto sample = std::make_shared<Volume>(
+        volume->hasRepresentation<VolumeBrickedRAM>()
+            ? util::volumeSubSample(volume->getRepresentation<VolumeBrickedRAM>(), f)
+            : util::volumeSubSample(volume->getRepresentation<VolumeRAM>(), f));
     sample->copyMetaDataFrom(*volume);
     sample->dataMap_ = volume->dataMap_;
     sample->setModelMatrix(volume->getModelMatrix());
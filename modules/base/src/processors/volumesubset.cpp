@@ -29,6 +29,7 @@
 
 #include <modules/base/processors/volumesubset.h>
 #include <modules/base/algorithm/volume/volumeramsubset.h>
+#include <inviwo/core/datastructures/volume/volumebrickedram.h>
 #include <inviwo/core/network/networklock.h>
 #include <glm/gtx/vector_angle.hpp>
 
@@ -88,14 +89,19 @@ VolumeSubset::~VolumeSubset() = default;
 
 void VolumeSubset::process() {
     if (enabled_.get()) {
-        const auto vol = inport_.getData()->getRepresentation<VolumeRAM>();
         const size3_t offset{rangeX_.get().x, rangeY_.get().x, rangeZ_.get().x};
         const size3_t dim = size3_t{rangeX_.get().y, rangeY_.get().y, rangeZ_.get().y} - offset;
 
         if (dim == dims_)
             outport_.setData(inport_.getData());
         else {
-            auto volume = std::make_shared<Volume>(VolumeRAMSubSet::apply(vol, dim, offset));
+            const auto& data = *inport_.getData();
+            // Bricked volumes only load the bricks overlapping the subset
+            auto subset = data.hasRepresentation<VolumeBrickedRAM>()
+                              ? data.getRepresentation<VolumeBrickedRAM>()->getRegion(offset, dim)
+                              : VolumeRAMSubSet::apply(data.getRepresentation<VolumeRAM>(), dim,
+                                                       offset);
+            auto volume = std::make_shared<Volume>(subset);
             // pass meta data on
             volume->copyMetaDataFrom(*inport_.getData());
             volume->dataMap_ = inport_.getData()->dataMap_;
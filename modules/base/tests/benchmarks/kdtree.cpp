@@ -0,0 +1,181 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2021 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#ifdef _MSC_VER
+#pragma comment(linker, "/SUBSYSTEM:CONSOLE")
+#endif
+
+#include <inviwo/core/common/inviwoapplication.h>
+#include <inviwo/core/util/logcentral.h>
+#include <modules/base/datastructures/kdtree.h>
+#include <modules/base/datastructures/flatkdtree.h>
+
+#include <benchmark/benchmark.h>
+
+#include <array>
+#include <random>
+
+using namespace inviwo;
+
+namespace {
+
+std::vector<vec3> randomPoints(size_t count, unsigned int seed) {
+    std::mt19937 gen(seed);
+    std::uniform_real_distribution<float> dist(0.0f, 1.0f);
+    std::vector<vec3> points(count);
+    for (auto& p : points) p = vec3{dist(gen), dist(gen), dist(gen)};
+    return points;
+}
+
+constexpr size_t nQueries = 10000;
+constexpr size_t k = 8;
+
+}  // namespace
+
+static void BuildOld(benchmark::State& state) {
+    const auto points = randomPoints(static_cast<size_t>(state.range(0)), 0);
+    for (auto _ : state) {
+        K3DTree<size_t, float> tree;
+        for (size_t i = 0; i < points.size(); ++i) tree.insert(points[i], i);
+        benchmark::DoNotOptimize(tree.size());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+static void BuildFlat(benchmark::State& state) {
+    const auto points = randomPoints(static_cast<size_t>(state.range(0)), 0);
+    for (auto _ : state) {
+        FlatK3DTree<float> tree(points);
+        benchmark::DoNotOptimize(tree.size());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+static void NNearestOld(benchmark::State& state) {
+    const auto points = randomPoints(static_cast<size_t>(state.range(0)), 0);
+    const auto queries = randomPoints(nQueries, 1);
+    K3DTree<size_t, float> tree;
+    for (size_t i = 0; i < points.size(); ++i) tree.insert(points[i], i);
+
+    for (auto _ : state) {
+        for (const auto& q : queries) {
+            benchmark::DoNotOptimize(tree.findNNearest(q, static_cast<int>(k)));
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * nQueries);
+}
+
+static void NNearestFlat(benchmark::State& state) {
+    const auto points = randomPoints(static_cast<size_t>(state.range(0)), 0);
+    const auto queries = randomPoints(nQueries, 1);
+    FlatK3DTree<float> tree(points);
+
+    std::array<size_t, k> indices;
+    std::array<float, k> sqDistances;
+    for (auto _ : state) {
+        for (const auto& q : queries) {
+            benchmark::DoNotOptimize(tree.findNNearest(q, k, indices, sqDistances));
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * nQueries);
+}
+
+static void NNearestFlatBatch(benchmark::State& state) {
+    const auto points = randomPoints(static_cast<size_t>(state.range(0)), 0);
+    const auto queries = randomPoints(nQueries, 1);
+    FlatK3DTree<float> tree(points);
+
+    std::vector<size_t> indices(nQueries * k);
+    std::vector<float> sqDistances(nQueries * k);
+    for (auto _ : state) {
+        tree.findNNearest(queries, k, indices, sqDistances);
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * nQueries);
+}
+
+static void CloseToOld(benchmark::State& state) {
+    const auto points = randomPoints(static_cast<size_t>(state.range(0)), 0);
+    const auto queries = randomPoints(nQueries, 1);
+    K3DTree<size_t, float> tree;
+    for (size_t i = 0; i < points.size(); ++i) tree.insert(points[i], i);
+
+    for (auto _ : state) {
+        for (const auto& q : queries) benchmark::DoNotOptimize(tree.findCloseTo(q, 0.05f));
+    }
+    state.SetItemsProcessed(state.iterations() * nQueries);
+}
+
+static void CloseToFlat(benchmark::State& state) {
+    const auto points = randomPoints(static_cast<size_t>(state.range(0)), 0);
+    const auto queries = randomPoints(nQueries, 1);
+    FlatK3DTree<float> tree(points);
+
+    std::vector<size_t> result;
+    for (auto _ : state) {
+        for (const auto& q : queries) {
+            tree.findCloseTo(q, 0.05f, result);
+            benchmark::DoNotOptimize(result.data());
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * nQueries);
+}
+
+static void CloseToFlatBatch(benchmark::State& state) {
+    const auto points = randomPoints(static_cast<size_t>(state.range(0)), 0);
+    const auto queries = randomPoints(nQueries, 1);
+    FlatK3DTree<float> tree(points);
+
+    std::vector<std::vector<size_t>> results;
+    for (auto _ : state) {
+        tree.findCloseTo(queries, 0.05f, results);
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * nQueries);
+}
+
+BENCHMARK(BuildOld)->RangeMultiplier(10)->Range(1000, 1000000);
+BENCHMARK(BuildFlat)->RangeMultiplier(10)->Range(1000, 1000000);
+
+BENCHMARK(NNearestOld)->RangeMultiplier(10)->Range(1000, 1000000);
+BENCHMARK(NNearestFlat)->RangeMultiplier(10)->Range(1000, 1000000);
+BENCHMARK(NNearestFlatBatch)->RangeMultiplier(10)->Range(1000, 1000000);
+
+BENCHMARK(CloseToOld)->RangeMultiplier(10)->Range(1000, 100000);
+BENCHMARK(CloseToFlat)->RangeMultiplier(10)->Range(1000, 100000);
+BENCHMARK(CloseToFlatBatch)->RangeMultiplier(10)->Range(1000, 100000);
+
+int main(int argc, char** argv) {
+    LogCentral::init();
+    InviwoApplication app(argc, argv, "Inviwo-Benchmark-KDTree");
+
+    benchmark::Initialize(&argc, argv);
+    benchmark::RunSpecifiedBenchmarks();
+    return 0;
+}
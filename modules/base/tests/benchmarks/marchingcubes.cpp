@@ -31,6 +31,8 @@
 #pragma comment(linker, "/SUBSYSTEM:CONSOLE")
 #endif
 
+#include <inviwo/core/common/inviwoapplication.h>
+#include <inviwo/core/util/logcentral.h>
 #include <modules/base/algorithm/volume/volumegeneration.h>
 
 #include <modules/base/algorithm/volume/marchingcubes.h>
@@ -75,6 +77,21 @@ static void SphereNew(benchmark::State& state) {
         static_cast<double>(state.range(0) * state.range(0) * state.range(0));
 }
 
+static void SphereParallel(benchmark::State& state) {
+    auto v = std::shared_ptr<Volume>(
+        util::makeSphericalVolume(size3_t{static_cast<size_t>(state.range(0))}));
+
+    for (auto _ : state) {
+        auto mesh = util::marchingCubesParallel(v, 0.5, {0.5f, 0.0f, 0.0f, 1.0f}, false, false);
+        state.counters["Vertices"] = static_cast<double>(mesh->getBuffer(0)->getSize());
+        state.counters["Indices"] =
+            static_cast<double>(mesh->getIndexBuffers().front().second->getSize());
+        benchmark::ClobberMemory();
+    }
+    state.counters["Voxels"] =
+        static_cast<double>(state.range(0) * state.range(0) * state.range(0));
+}
+
 static void RippleOld(benchmark::State& state) {
     auto v = std::shared_ptr<Volume>(
         util::makeRippleVolume(size3_t{static_cast<size_t>(state.range(0))}));
@@ -105,6 +122,21 @@ static void RippleNew(benchmark::State& state) {
         static_cast<double>(state.range(0) * state.range(0) * state.range(0));
 }
 
+static void RippleParallel(benchmark::State& state) {
+    auto v = std::shared_ptr<Volume>(
+        util::makeRippleVolume(size3_t{static_cast<size_t>(state.range(0))}));
+
+    for (auto _ : state) {
+        auto mesh = util::marchingCubesParallel(v, 0.5, {0.5f, 0.0f, 0.0f, 1.0f}, false, false);
+        state.counters["Vertices"] = static_cast<double>(mesh->getBuffer(0)->getSize());
+        state.counters["Indices"] =
+            static_cast<double>(mesh->getIndexBuffers().front().second->getSize());
+        benchmark::ClobberMemory();
+    }
+    state.counters["Voxels"] =
+        static_cast<double>(state.range(0) * state.range(0) * state.range(0));
+}
+
 static void MiniOld(benchmark::State& state) {
     auto v = std::shared_ptr<Volume>(
         util::makeSingleVoxelVolume(size3_t{static_cast<size_t>(state.range(0))}));
@@ -137,9 +169,11 @@ static void MiniNew(benchmark::State& state) {
 
 BENCHMARK(SphereOld)->RangeMultiplier(2)->Range(8, 8 << 5);
 BENCHMARK(SphereNew)->RangeMultiplier(2)->Range(8, 8 << 6);
+BENCHMARK(SphereParallel)->RangeMultiplier(2)->Range(8, 8 << 7);
 
 BENCHMARK(RippleOld)->RangeMultiplier(2)->Range(8, 8 << 4);
 BENCHMARK(RippleNew)->RangeMultiplier(2)->Range(8, 8 << 5);
+BENCHMARK(RippleParallel)->RangeMultiplier(2)->Range(8, 8 << 6);
 
 // BENCHMARK(MiniOld)->RangeMultiplier(2)->Range(8, 8 << 5);
 // BENCHMARK(MiniNew)->RangeMultiplier(2)->Range(8, 8 << 5);
@@ -150,6 +184,8 @@ BENCHMARK(RippleNew)->RangeMultiplier(2)->Range(8, 8 << 5);
 // BENCHMARK(SphereNew)->Arg(5);
 
 int main(int argc, char** argv) {
+    LogCentral::init();
+    InviwoApplication app(argc, argv, "Inviwo-Benchmark-MarchingCubes");
 
     benchmark::Initialize(&argc, argv);
     benchmark::RunSpecifiedBenchmarks();
@@ -0,0 +1,123 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2021 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#ifdef _MSC_VER
+#pragma comment(linker, "/SUBSYSTEM:CONSOLE")
+#endif
+
+#include <inviwo/core/datastructures/volume/volumeramprecision.h>
+#include <modules/base/algorithm/algorithmoptions.h>
+#include <modules/base/algorithm/dataminmax.h>
+#include <modules/base/algorithm/volume/volumeramsubsample.h>
+
+#include <benchmark/benchmark.h>
+
+#include <random>
+
+using namespace inviwo;
+
+namespace {
+
+template <typename T>
+std::shared_ptr<VolumeRAMPrecision<T>> makeVolume(size_t size) {
+    auto ram = std::make_shared<VolumeRAMPrecision<T>>(size3_t{size});
+    auto data = ram->getDataTyped();
+    std::mt19937 gen{1};
+    std::uniform_real_distribution<double> dist{0.0, 100.0};
+    for (size_t i = 0; i < size * size * size; ++i) {
+        data[i] = util::glm_convert<T>(dvec4{dist(gen), dist(gen), dist(gen), dist(gen)});
+    }
+    return ram;
+}
+
+template <typename T>
+void MinMax(benchmark::State& state) {
+    const auto size = static_cast<size_t>(state.range(0));
+    const auto ram = makeVolume<T>(size);
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(util::volumeMinMax(ram.get()));
+    }
+    state.SetItemsProcessed(state.iterations() * size * size * size);
+    state.SetBytesProcessed(state.iterations() * size * size * size * sizeof(T));
+}
+
+template <typename T>
+void MinMaxIgnoreSpecial(benchmark::State& state) {
+    const auto size = static_cast<size_t>(state.range(0));
+    const auto ram = makeVolume<T>(size);
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(util::volumeMinMax(ram.get(), IgnoreSpecialValues::Yes));
+    }
+    state.SetItemsProcessed(state.iterations() * size * size * size);
+    state.SetBytesProcessed(state.iterations() * size * size * size * sizeof(T));
+}
+
+template <typename T>
+void SubSample(benchmark::State& state) {
+    const auto size = static_cast<size_t>(state.range(0));
+    const auto factor = static_cast<size_t>(state.range(1));
+    const auto ram = makeVolume<T>(size);
+
+    for (auto _ : state) {
+        auto res = util::volumeSubSample(ram.get(), size3_t{factor});
+        benchmark::DoNotOptimize(res.get());
+    }
+    state.SetItemsProcessed(state.iterations() * size * size * size);
+    state.SetBytesProcessed(state.iterations() * size * size * size * sizeof(T));
+}
+
+void volumeArgs(benchmark::internal::Benchmark* b) {
+    b->ArgName("size")->RangeMultiplier(4)->Range(16, 256)->Unit(benchmark::kMillisecond);
+}
+
+void subSampleArgs(benchmark::internal::Benchmark* b) {
+    b->ArgNames({"size", "factor"});
+    for (int size : {64, 256}) {
+        for (int factor : {2, 4}) {
+            b->Args({size, factor});
+        }
+    }
+    b->Unit(benchmark::kMillisecond);
+}
+
+}  // namespace
+
+BENCHMARK_TEMPLATE(MinMax, float)->Apply(volumeArgs);
+BENCHMARK_TEMPLATE(MinMax, glm::u8vec4)->Apply(volumeArgs);
+BENCHMARK_TEMPLATE(MinMaxIgnoreSpecial, float)->Apply(volumeArgs);
+BENCHMARK_TEMPLATE(SubSample, float)->Apply(subSampleArgs)->UseRealTime();
+BENCHMARK_TEMPLATE(SubSample, glm::u8vec4)->Apply(subSampleArgs)->UseRealTime();
+
+int main(int argc, char** argv) {
+    benchmark::Initialize(&argc, argv);
+    benchmark::RunSpecifiedBenchmarks();
+    return 0;
+}
@@ -0,0 +1,116 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2021 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#ifdef _MSC_VER
+#pragma comment(linker, "/SUBSYSTEM:CONSOLE")
+#endif
+
+#include <inviwo/core/common/inviwoapplication.h>
+#include <inviwo/core/util/logcentral.h>
+#include <modules/base/algorithm/volume/volumevoronoi.h>
+
+#include <benchmark/benchmark.h>
+
+#include <random>
+
+using namespace inviwo;
+
+namespace {
+
+std::vector<std::pair<uint32_t, vec3>> randomSeeds(size_t count, const vec3& size) {
+    std::mt19937 gen(0);
+    std::uniform_real_distribution<float> dist(0.0f, 1.0f);
+    std::vector<std::pair<uint32_t, vec3>> seeds(count);
+    for (size_t i = 0; i < count; ++i) {
+        seeds[i] = {static_cast<uint32_t>(i % 65536), vec3{dist(gen), dist(gen), dist(gen)} * size};
+    }
+    return seeds;
+}
+
+/**
+ * Segment a 64^3 volume with state.range(0) random seed points
+ */
+void segment(benchmark::State& state, VoronoiMethod method, bool weighted, Wrapping wrapping) {
+    const size3_t dims{64};
+    const auto seeds = randomSeeds(static_cast<size_t>(state.range(0)), vec3{dims});
+    std::optional<std::vector<float>> weights;
+    if (weighted) {
+        std::mt19937 gen(1);
+        std::uniform_real_distribution<float> dist(0.0f, 2.0f);
+        weights = std::vector<float>(seeds.size());
+        for (auto& w : *weights) w = dist(gen);
+    }
+
+    for (auto _ : state) {
+        auto volume = util::voronoiSegmentation(dims, mat4{1.0f}, seeds,
+                                                Wrapping3D{wrapping, wrapping, wrapping}, weights,
+                                                method);
+        benchmark::DoNotOptimize(volume.get());
+    }
+    state.SetItemsProcessed(state.iterations() * glm::compMul(dims));
+}
+
+}  // namespace
+
+static void BruteForce(benchmark::State& state) {
+    segment(state, VoronoiMethod::BruteForce, false, Wrapping::Clamp);
+}
+static void SpatialIndex(benchmark::State& state) {
+    segment(state, VoronoiMethod::SpatialIndex, false, Wrapping::Clamp);
+}
+static void SpatialIndexRepeat(benchmark::State& state) {
+    segment(state, VoronoiMethod::SpatialIndex, false, Wrapping::Repeat);
+}
+static void BruteForceWeighted(benchmark::State& state) {
+    segment(state, VoronoiMethod::BruteForce, true, Wrapping::Clamp);
+}
+static void SpatialIndexWeighted(benchmark::State& state) {
+    segment(state, VoronoiMethod::SpatialIndex, true, Wrapping::Clamp);
+}
+
+BENCHMARK(BruteForce)->RangeMultiplier(10)->Range(10, 1000)->Unit(benchmark::kMillisecond);
+BENCHMARK(SpatialIndex)->RangeMultiplier(10)->Range(10, 100000)->Unit(benchmark::kMillisecond);
+BENCHMARK(SpatialIndexRepeat)
+    ->RangeMultiplier(10)
+    ->Range(10, 100000)
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK(BruteForceWeighted)->RangeMultiplier(10)->Range(10, 1000)->Unit(benchmark::kMillisecond);
+BENCHMARK(SpatialIndexWeighted)
+    ->RangeMultiplier(10)
+    ->Range(10, 100000)
+    ->Unit(benchmark::kMillisecond);
+
+int main(int argc, char** argv) {
+    LogCentral::init();
+    InviwoApplication app(argc, argv, "Inviwo-Benchmark-Voronoi");
+
+    benchmark::Initialize(&argc, argv);
+    benchmark::RunSpecifiedBenchmarks();
+    return 0;
+}
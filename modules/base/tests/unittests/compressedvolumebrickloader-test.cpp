@@ -0,0 +1,114 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2021 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#include <warn/push>
+#include <warn/ignore/all>
+#include <gtest/gtest.h>
+#include <warn/pop>
+
+#include <modules/base/io/compressedvolumebrickloader.h>
+#include <inviwo/core/datastructures/volume/volume.h>
+#include <inviwo/core/datastructures/volume/volumeramprecision.h>
+#include <inviwo/core/io/datareaderexception.h>
+#include <inviwo/core/io/tempfilehandle.h>
+#include <inviwo/core/util/filesystem.h>
+#include <inviwo/core/util/indexmapper.h>
+
+#include <cstdint>
+#include <cstring>
+
+namespace inviwo {
+
+namespace {
+
+std::shared_ptr<VolumeRAMPrecision<std::uint16_t>> createLabels(size3_t dims) {
+    // A few large constant regions, like a segmentation
+    auto vol = std::make_shared<VolumeRAMPrecision<std::uint16_t>>(dims);
+    auto data = vol->getDataTyped();
+    for (size_t i = 0; i < glm::compMul(dims); ++i) {
+        data[i] = static_cast<std::uint16_t>(i / 100);
+    }
+    return vol;
+}
+
+}  // namespace
+
+TEST(CompressedVolumeBrickLoader, roundTrip) {
+    const size3_t dims{21, 17, 9};
+    const size3_t brickSize{8, 8, 8};
+    auto source = createLabels(dims);
+    Volume volume(source);
+
+    util::TempFileHandle tmp("inviwo", ".raw");
+    {
+        auto out = filesystem::ofstream(tmp.getFileName(), std::ios::out | std::ios::binary);
+        util::writeCompressedBricks(volume, brickSize, IvfCompression::Zlib, out);
+        ASSERT_TRUE(out.good());
+        EXPECT_LT(static_cast<size_t>(out.tellp()), source->getNumberOfBytes());
+    }
+
+    const size3_t numBricks{3, 3, 2};
+    auto loader = std::make_shared<CompressedVolumeBrickLoader>(
+        tmp.getFileName(), 0, true, IvfCompression::Zlib, glm::compMul(numBricks));
+    EXPECT_EQ(glm::compMul(numBricks) + 1, loader->getIndex().size());
+
+    VolumeBrickedRAM fromFile(loader, dims, brickSize, DataUInt16::get());
+    ASSERT_EQ(numBricks, fromFile.getNumberOfBricks());
+    auto full = fromFile.getRegion(size3_t{0}, dims);
+    EXPECT_EQ(0, std::memcmp(source->getData(), full->getData(), source->getNumberOfBytes()));
+
+    // A region inside one brick only decompresses that brick
+    const size3_t offset{9, 9, 1};
+    const size3_t extent{5, 3, 4};
+    auto region = fromFile.getRegion(offset, extent);
+    const auto regionData = static_cast<const std::uint16_t*>(region->getData());
+    const util::IndexMapper3D srcIm(dims);
+    const util::IndexMapper3D dstIm(extent);
+    for (size_t z = 0; z < extent.z; ++z) {
+        for (size_t y = 0; y < extent.y; ++y) {
+            for (size_t x = 0; x < extent.x; ++x) {
+                const size3_t pos{x, y, z};
+                ASSERT_EQ(source->getDataTyped()[srcIm(offset + pos)], regionData[dstIm(pos)]);
+            }
+        }
+    }
+}
+
+TEST(CompressedVolumeBrickLoader, invalidIndex) {
+    util::TempFileHandle tmp("inviwo", ".raw");
+    {
+        auto out = filesystem::ofstream(tmp.getFileName(), std::ios::out | std::ios::binary);
+        const std::uint64_t index[3] = {0, 0, 0};
+        out.write(reinterpret_cast<const char*>(index), sizeof(index));
+    }
+    EXPECT_THROW(CompressedVolumeBrickLoader(tmp.getFileName(), 0, true, IvfCompression::Zlib, 2),
+                 DataReaderException);
+}
+
+}  // namespace inviwo
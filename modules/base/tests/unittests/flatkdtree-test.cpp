@@ -0,0 +1,167 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2021 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#include <warn/push>
+#include <warn/ignore/all>
+#include <gtest/gtest.h>
+#include <warn/pop>
+
+#include <modules/base/datastructures/flatkdtree.h>
+
+#include <algorithm>
+#include <random>
+
+namespace inviwo {
+
+namespace {
+
+std::vector<vec3> randomPoints(size_t count, unsigned int seed) {
+    std::mt19937 gen(seed);
+    std::uniform_real_distribution<float> dist(0.0f, 1.0f);
+    std::vector<vec3> points(count);
+    for (auto& p : points) p = vec3{dist(gen), dist(gen), dist(gen)};
+    return points;
+}
+
+std::vector<std::pair<float, size_t>> sortedDistances(const std::vector<vec3>& points,
+                                                      const vec3& pos) {
+    std::vector<std::pair<float, size_t>> dists;
+    for (size_t i = 0; i < points.size(); ++i) {
+        const auto d = points[i] - pos;
+        dists.emplace_back(glm::dot(d, d), i);
+    }
+    std::sort(dists.begin(), dists.end());
+    return dists;
+}
+
+}  // namespace
+
+TEST(FlatKDTreeTests, empty) {
+    FlatK3DTree<float> tree;
+    EXPECT_TRUE(tree.empty());
+    EXPECT_EQ(tree.findNearest(vec3{0.0f}), FlatK3DTree<float>::npos);
+
+    std::vector<size_t> result{1, 2, 3};
+    tree.findCloseTo(vec3{0.0f}, 1.0f, result);
+    EXPECT_TRUE(result.empty());
+}
+
+TEST(FlatKDTreeTests, nearest) {
+    const auto points = randomPoints(1000, 0);
+    const auto queries = randomPoints(100, 1);
+
+    for (size_t leafSize : {1, 4, 16, 2000}) {
+        FlatK3DTree<float> tree(points, leafSize);
+        EXPECT_EQ(tree.size(), points.size());
+
+        std::vector<size_t> batch(queries.size());
+        tree.findNearest(queries, batch);
+
+        for (size_t i = 0; i < queries.size(); ++i) {
+            const auto expected = sortedDistances(points, queries[i]).front().second;
+            EXPECT_EQ(tree.findNearest(queries[i]), expected);
+            EXPECT_EQ(batch[i], expected);
+        }
+    }
+}
+
+TEST(FlatKDTreeTests, nNearest) {
+    const auto points = randomPoints(1000, 2);
+    const auto queries = randomPoints(100, 3);
+    const size_t k = 10;
+
+    FlatK3DTree<float> tree(points);
+    std::vector<size_t> indices(queries.size() * k);
+    std::vector<float> sqDistances(queries.size() * k);
+    tree.findNNearest(queries, k, indices, sqDistances);
+
+    for (size_t i = 0; i < queries.size(); ++i) {
+        const auto expected = sortedDistances(points, queries[i]);
+        for (size_t j = 0; j < k; ++j) {
+            EXPECT_EQ(indices[i * k + j], expected[j].second);
+            EXPECT_FLOAT_EQ(sqDistances[i * k + j], expected[j].first);
+        }
+    }
+}
+
+TEST(FlatKDTreeTests, nNearestFewPoints) {
+    const auto points = randomPoints(5, 4);
+    FlatK3DTree<float> tree(points);
+
+    std::vector<size_t> indices(8);
+    std::vector<float> sqDistances(8);
+    tree.findNNearest(util::span<const vec3>{points.data(), 1}, 8, indices, sqDistances);
+
+    EXPECT_EQ(indices[0], 0);
+    EXPECT_EQ(sqDistances[0], 0.0f);
+    for (size_t j = 5; j < 8; ++j) {
+        EXPECT_EQ(indices[j], FlatK3DTree<float>::npos);
+    }
+}
+
+TEST(FlatKDTreeTests, closeTo) {
+    const auto points = randomPoints(1000, 5);
+    const auto queries = randomPoints(100, 6);
+    const float radius = 0.15f;
+
+    FlatK3DTree<float> tree(points);
+    std::vector<std::vector<size_t>> batch;
+    tree.findCloseTo(queries, radius, batch);
+    ASSERT_EQ(batch.size(), queries.size());
+
+    std::vector<size_t> result;
+    for (size_t i = 0; i < queries.size(); ++i) {
+        std::vector<size_t> expected;
+        for (auto& [sqDist, index] : sortedDistances(points, queries[i])) {
+            if (sqDist <= radius * radius) expected.push_back(index);
+        }
+        std::sort(expected.begin(), expected.end());
+
+        tree.findCloseTo(queries[i], radius, result);
+        std::sort(result.begin(), result.end());
+        EXPECT_EQ(result, expected);
+
+        std::sort(batch[i].begin(), batch[i].end());
+        EXPECT_EQ(batch[i], expected);
+    }
+}
+
+TEST(FlatKDTreeTests, duplicatePoints) {
+    std::vector<vec3> points(100, vec3{0.5f});
+    points.push_back(vec3{1.0f});
+
+    FlatK3DTree<float> tree(points, 4);
+    EXPECT_EQ(tree.findNearest(vec3{0.9f}), 100);
+
+    std::vector<size_t> result;
+    tree.findCloseTo(vec3{0.5f}, 0.01f, result);
+    EXPECT_EQ(result.size(), 100);
+}
+
+}  // namespace inviwo
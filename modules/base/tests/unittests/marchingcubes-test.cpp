@@ -33,6 +33,7 @@
 #include <warn/pop>
 
 #include <cmath>
+#include <tuple>
 #include <modules/base/algorithm/volume/volumegeneration.h>
 
 #include <modules/base/algorithm/volume/marchingcubes.h>
@@ -334,4 +335,61 @@ TEST(Marchingcubes, sphere) {
     */
 }
 
+TEST(Marchingcubes, parallel) {
+    // Large enough to span several slabs and bricks
+    for (auto& v : {std::shared_ptr<Volume>(util::makeSphericalVolume(size3_t{40, 33, 70})),
+                    std::shared_ptr<Volume>(util::makeRippleVolume(size3_t{50, 20, 37}))}) {
+        for (bool skipEmpty : {false, true}) {
+            auto mesh1 = util::marchingCubesOpt(v, 0.5, {0.5f, 0.0f, 0.0f, 1.0f}, false, false);
+            auto mesh2 = util::marchingCubesParallel(v, 0.5, {0.5f, 0.0f, 0.0f, 1.0f}, false,
+                                                     false, nullptr, nullptr, nullptr, skipEmpty);
+
+            auto& pos1 = getBufferData<vec3>(*mesh1, 0);
+            auto& pos2 = getBufferData<vec3>(*mesh2, 0);
+            auto& ind1 = getBufferIndexData(*mesh1, 0);
+            auto& ind2 = getBufferIndexData(*mesh2, 0);
+
+            // Shared vertices between slabs should be merged, i.e. the same number of vertices
+            ASSERT_EQ(pos1.size(), pos2.size());
+            ASSERT_EQ(ind1.size(), ind2.size());
+
+            // The order differs, compare the triangles as sorted lists of vertex positions. The
+            // positions are rounded since they are not calculated in exactly the same way.
+            const auto triangles = [](const std::vector<vec3>& pos,
+                                      const std::vector<uint32_t>& ind) {
+                std::vector<std::array<i64vec3, 3>> tris;
+                for (size_t i = 0; i < ind.size(); i += 3) {
+                    std::array<i64vec3, 3> tri;
+                    for (size_t j = 0; j < 3; ++j) {
+                        tri[j] = i64vec3{glm::round(dvec3{pos[ind[i + j]]} * 1.0e5)};
+                    }
+                    // rotate the smallest vertex first, keeping the orientation
+                    const auto first = std::min_element(
+                        tri.begin(), tri.end(), [](const i64vec3& a, const i64vec3& b) {
+                            return std::tie(a.x, a.y, a.z) < std::tie(b.x, b.y, b.z);
+                        });
+                    std::rotate(tri.begin(), first, tri.end());
+                    tris.push_back(tri);
+                }
+                std::sort(tris.begin(), tris.end(), [](const auto& a, const auto& b) {
+                    return std::lexicographical_compare(
+                        a.begin(), a.end(), b.begin(), b.end(),
+                        [](const i64vec3& u, const i64vec3& v) {
+                            return std::tie(u.x, u.y, u.z) < std::tie(v.x, v.y, v.z);
+                        });
+                });
+                return tris;
+            };
+            EXPECT_EQ(triangles(pos1, ind1), triangles(pos2, ind2));
+        }
+    }
+}
+
+TEST(Marchingcubes, parallelStop) {
+    auto v = std::shared_ptr<Volume>(util::makeSphericalVolume(size3_t{20}));
+    auto mesh = util::marchingCubesParallel(v, 0.5, {0.5f, 0.0f, 0.0f, 1.0f}, false, false,
+                                            nullptr, nullptr, []() { return true; });
+    EXPECT_EQ(mesh, nullptr);
+}
+
 }  // namespace inviwo
@@ -0,0 +1,128 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2022 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+
+#include <warn/push>
+#include <warn/ignore/all>
+#include <gtest/gtest.h>
+#include <warn/pop>
+
+#include <modules/base/algorithm/volume/volumeclassification.h>
+#include <inviwo/core/datastructures/tflookuptable.h>
+#include <inviwo/core/datastructures/transferfunction.h>
+#include <inviwo/core/datastructures/volume/volume.h>
+#include <inviwo/core/datastructures/volume/volumeram.h>
+#include <inviwo/core/datastructures/volume/volumeramprecision.h>
+#include <inviwo/core/util/glm.h>
+
+#include <numeric>
+
+namespace inviwo {
+
+namespace {
+
+// All 256 values of an unsigned char, normalized to k / 255
+std::shared_ptr<Volume> createRamp() {
+    const size3_t dims{4, 8, 8};
+    auto ram = std::make_shared<VolumeRAMPrecision<unsigned char>>(dims);
+    auto data = ram->getDataTyped();
+    std::iota(data, data + glm::compMul(dims), static_cast<unsigned char>(0));
+    auto volume = std::make_shared<Volume>(ram);
+    volume->dataMap_.dataRange = dvec2{0.0, 255.0};
+    volume->dataMap_.valueRange = dvec2{0.0, 255.0};
+    return volume;
+}
+
+// The color of TransferFunction::sample, with zero opacity outside of the mask
+vec4 sampleMasked(const TransferFunction& tf, double v) {
+    auto color = tf.sample(v);
+    if (v < tf.getMaskMin() || v > tf.getMaskMax()) color.a = 0.0f;
+    return color;
+}
+
+template <typename T>
+const T* getData(const Volume& volume) {
+    return static_cast<const VolumeRAMPrecision<T>*>(volume.getRepresentation<VolumeRAM>())
+        ->getDataTyped();
+}
+
+// The points are on entries of a table of size 4097, so the table interpolates the same
+// values as TransferFunction::sample
+TransferFunction createTF() {
+    return TransferFunction{{{0.25, vec4{0.0f, 1.0f, 0.0f, 0.5f}},
+                             {0.5, vec4{1.0f, 0.0f, 0.5f, 1.0f}},
+                             {0.75, vec4{0.2f, 0.3f, 1.0f, 0.0f}}}};
+}
+
+void expectSameAsSample(const TransferFunction& tf) {
+    const auto volume = createRamp();
+    const TFLookupTable table(tf, 4097);
+
+    const auto floats = util::classifyVolume(*volume, table, 0, DataVec4Float32::get());
+    ASSERT_EQ(volume->getDimensions(), floats->getDimensions());
+    const auto bytes = util::classifyVolume(*volume, table);
+    ASSERT_EQ(volume->getDimensions(), bytes->getDimensions());
+
+    const auto floatData = getData<vec4>(*floats);
+    const auto byteData = getData<glm::u8vec4>(*bytes);
+    for (size_t k = 0; k < 256; ++k) {
+        const double v = static_cast<double>(k) / 255.0;
+        const vec4 expected = sampleMasked(tf, v);
+        for (int i = 0; i < 4; ++i) {
+            EXPECT_NEAR(expected[i], floatData[k][i], 1e-5f) << "voxel " << k;
+            EXPECT_NEAR(expected[i] * 255.0f, static_cast<float>(byteData[k][i]), 0.5001f)
+                << "voxel " << k;
+        }
+    }
+}
+
+}  // namespace
+
+TEST(VolumeClassification, SameAsSample) { expectSameAsSample(createTF()); }
+
+// The mask bounds fall between voxel values, 63/255 < 0.25 < 64/255 and 191/255 < 0.75 < 192/255,
+// and more than a table entry away from them
+TEST(VolumeClassification, MaskedSameAsSample) {
+    auto tf = createTF();
+    tf.setMaskMin(0.25);
+    tf.setMaskMax(0.75);
+    expectSameAsSample(tf);
+}
+
+TEST(VolumeClassification, KeepsTransformations) {
+    const auto volume = createRamp();
+    volume->setModelMatrix(glm::scale(vec3{2.0f, 3.0f, 4.0f}));
+    volume->setWorldMatrix(glm::translate(vec3{1.0f, 2.0f, 3.0f}));
+
+    const auto classified = util::classifyVolume(*volume, TFLookupTable(createTF()));
+    EXPECT_EQ(volume->getModelMatrix(), classified->getModelMatrix());
+    EXPECT_EQ(volume->getWorldMatrix(), classified->getWorldMatrix());
+}
+
+}  // namespace inviwo
@@ -0,0 +1,182 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2021 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#include <warn/push>
+#include <warn/ignore/all>
+#include <gtest/gtest.h>
+#include <warn/pop>
+#include <modules/base/algorithm/volume/volumeramsubsample.h>
+#include <modules/base/datastructures/volumepyramid.h>
+#include <inviwo/core/datastructures/volume/volume.h>
+#include <inviwo/core/datastructures/volume/volumebrickcache.h>
+#include <inviwo/core/datastructures/volume/volumebrickedram.h>
+#include <inviwo/core/datastructures/volume/volumeram.h>
+#include <inviwo/core/datastructures/volume/volumeramprecision.h>
+#include <inviwo/core/util/exception.h>
+#include <inviwo/core/util/raiiutils.h>
+
+#include <chrono>
+#include <future>
+#include <mutex>
+#include <numeric>
+
+namespace inviwo {
+
+namespace {
+
+std::shared_ptr<VolumeRAMPrecision<float>> createRamp(size3_t dims) {
+    auto ram = std::make_shared<VolumeRAMPrecision<float>>(dims);
+    auto data = ram->getDataTyped();
+    std::iota(data, data + glm::compMul(dims), 0.0f);
+    return ram;
+}
+
+const float* getData(const VolumeRAM* ram) {
+    return static_cast<const VolumeRAMPrecision<float>*>(ram)->getDataTyped();
+}
+
+// Holds every brick until released, to keep a level computation going for as long as needed
+class BlockingBrickLoader : public VolumeRAMBrickLoader {
+public:
+    using VolumeRAMBrickLoader::VolumeRAMBrickLoader;
+
+    virtual std::shared_ptr<VolumeRAM> loadBrick(const VolumeBrickedRAM& volume,
+                                                 size3_t brick) const override {
+        std::call_once(startedFlag_, [&]() { started_.set_value(); });
+        released_.wait();
+        return VolumeRAMBrickLoader::loadBrick(volume, brick);
+    }
+
+    void waitForStart() const { startedFuture_.wait(); }
+    void release() {
+        std::call_once(releaseFlag_, [&]() { release_.set_value(); });
+    }
+
+private:
+    mutable std::once_flag startedFlag_;
+    mutable std::promise<void> started_;
+    std::shared_future<void> startedFuture_{started_.get_future().share()};
+    std::once_flag releaseFlag_;
+    std::promise<void> release_;
+    std::shared_future<void> released_{release_.get_future().share()};
+};
+
+}  // namespace
+
+TEST(VolumeHalfSample, NonPowerOfTwoDimensions) {
+    // 0 1 2
+    // 3 4 5
+    // 6 7 8
+    // 9 10 11
+    // 12 13 14
+    auto ram = createRamp(size3_t{3, 5, 1});
+
+    auto average = util::volumeHalfSample(ram.get(), VolumeReduction::Average);
+    ASSERT_EQ(size3_t(2, 3, 1), average->getDimensions());
+    const std::vector<float> expectedAverage{2.0f, 3.5f, 8.0f, 9.5f, 12.5f, 14.0f};
+    EXPECT_EQ(expectedAverage, std::vector<float>(getData(average.get()),
+                                                  getData(average.get()) + 6));
+
+    auto min = util::volumeHalfSample(ram.get(), VolumeReduction::Min);
+    const std::vector<float> expectedMin{0.0f, 2.0f, 6.0f, 8.0f, 12.0f, 14.0f};
+    EXPECT_EQ(expectedMin, std::vector<float>(getData(min.get()), getData(min.get()) + 6));
+
+    auto max = util::volumeHalfSample(ram.get(), VolumeReduction::Max);
+    const std::vector<float> expectedMax{4.0f, 5.0f, 10.0f, 11.0f, 13.0f, 14.0f};
+    EXPECT_EQ(expectedMax, std::vector<float>(getData(max.get()), getData(max.get()) + 6));
+}
+
+TEST(VolumePyramid, Levels) {
+    auto volume = std::make_shared<Volume>(createRamp(size3_t{5, 3, 2}));
+    VolumePyramid pyramid(volume, VolumeReduction::Max);
+
+    ASSERT_EQ(size_t{4}, pyramid.getNumberOfLevels());
+    EXPECT_EQ(size3_t(5, 3, 2), pyramid.getDimensions(0));
+    EXPECT_EQ(size3_t(3, 2, 1), pyramid.getDimensions(1));
+    EXPECT_EQ(size3_t(2, 1, 1), pyramid.getDimensions(2));
+    EXPECT_EQ(size3_t(1, 1, 1), pyramid.getDimensions(3));
+
+    EXPECT_EQ(size_t{0}, pyramid.getLevelForVoxelBudget(30));
+    EXPECT_EQ(size_t{1}, pyramid.getLevelForVoxelBudget(6));
+    EXPECT_EQ(size_t{3}, pyramid.getLevelForVoxelBudget(0));
+
+    EXPECT_TRUE(pyramid.hasLevel(0));
+    EXPECT_FALSE(pyramid.hasLevel(2));
+    auto last = pyramid.getLevel(3);
+    EXPECT_TRUE(pyramid.hasLevel(1));
+    EXPECT_TRUE(pyramid.hasLevel(2));
+    EXPECT_EQ(last, pyramid.getLevel(3));
+    EXPECT_EQ(volume, pyramid.getLevel(0));
+    EXPECT_EQ(29.0f, getData(last->getRepresentation<VolumeRAM>())[0]);
+
+    EXPECT_THROW(pyramid.getLevel(4), RangeException);
+}
+
+TEST(VolumePyramid, SharedPyramid) {
+    auto volume = std::make_shared<Volume>(createRamp(size3_t{4, 4, 4}));
+
+    auto average = VolumePyramid::get(volume, VolumeReduction::Average);
+    EXPECT_EQ(average, VolumePyramid::get(volume, VolumeReduction::Average));
+    EXPECT_NE(average, VolumePyramid::get(volume, VolumeReduction::Min));
+
+    EXPECT_EQ(average->getLevel(1), VolumePyramid::get(volume)->getLevel(1));
+}
+
+// VolumeLevelOfDetail calls hasLevel from the main thread while a pool job builds the level,
+// hasLevel must answer without waiting for the job
+TEST(VolumePyramid, HasLevelDoesNotBlock) {
+    const size3_t dims{8, 8, 8};
+    auto loader = std::make_shared<BlockingBrickLoader>(createRamp(dims));
+    auto volume = std::make_shared<Volume>(std::make_shared<VolumeBrickedRAM>(
+        loader, dims, size3_t{4}, DataFloat32::get(), swizzlemasks::rgba,
+        InterpolationType::Linear, wrapping3d::clampAll, std::make_shared<VolumeBrickCache>()));
+    VolumePyramid pyramid(volume);
+
+    // Release the loader before waiting for the futures, also if an assertion fails
+    std::future<std::shared_ptr<const Volume>> level;
+    std::future<std::pair<bool, bool>> has;
+    util::OnScopeExit releaseLoader{[&]() { loader->release(); }};
+
+    level = std::async(std::launch::async, [&]() { return pyramid.getLevel(1); });
+    loader->waitForStart();
+
+    has = std::async(std::launch::async, [&]() {
+        return std::make_pair(pyramid.hasLevel(0), pyramid.hasLevel(1));
+    });
+    ASSERT_EQ(std::future_status::ready, has.wait_for(std::chrono::seconds{10}));
+    EXPECT_EQ(std::make_pair(true, false), has.get());
+
+    loader->release();
+    const auto result = level.get();
+    EXPECT_TRUE(pyramid.hasLevel(1));
+    EXPECT_EQ(result, pyramid.getLevel(1));
+    EXPECT_EQ(size3_t(4, 4, 4), result->getDimensions());
+}
+
+}  // namespace inviwo
@@ -0,0 +1,162 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2021 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#include <warn/push>
+#include <warn/ignore/all>
+#include <gtest/gtest.h>
+#include <warn/pop>
+
+#include <modules/base/algorithm/volume/volumeraycasting.h>
+#include <modules/base/algorithm/volume/volumegeneration.h>
+#include <inviwo/core/datastructures/camera/perspectivecamera.h>
+#include <inviwo/core/datastructures/image/image.h>
+#include <inviwo/core/datastructures/image/layerramprecision.h>
+#include <inviwo/core/datastructures/transferfunction.h>
+
+namespace inviwo {
+
+namespace {
+
+const glm::u8vec4* colorData(const Image& image) {
+    return static_cast<const LayerRAMPrecision<glm::u8vec4>*>(
+               image.getColorLayer()->getRepresentation<LayerRAM>())
+        ->getDataTyped();
+}
+
+const float* depthData(const Image& image) {
+    return static_cast<const LayerRAMPrecision<float>*>(
+               image.getDepthLayer()->getRepresentation<LayerRAM>())
+        ->getDataTyped();
+}
+
+PerspectiveCamera makeCamera() {
+    return PerspectiveCamera(vec3{0.3f, 0.4f, 2.0f}, vec3{0.0f}, vec3{0.0f, 1.0f, 0.0f}, 0.1f,
+                             10.0f, 38.0f, 1.0f);
+}
+
+}  // namespace
+
+TEST(VolumeRaycasting, TransparentTF_EmptyImage) {
+    const auto volume = util::makeSphericalVolume(size3_t{16});
+    const TransferFunction tf({{0.0, vec4{0.0f}}, {1.0, vec4{1.0f, 1.0f, 1.0f, 0.0f}}});
+
+    const auto camera = makeCamera();
+    const size2_t dims{32, 32};
+    const auto image = util::raycastVolume(*volume, tf, camera, dims);
+    ASSERT_TRUE(image);
+    EXPECT_EQ(image->getDimensions(), dims);
+
+    const auto colors = colorData(*image);
+    const auto depths = depthData(*image);
+    for (size_t i = 0; i < dims.x * dims.y; ++i) {
+        EXPECT_EQ(colors[i], glm::u8vec4{0});
+        EXPECT_EQ(depths[i], 1.0f);
+    }
+}
+
+TEST(VolumeRaycasting, EmptySpaceSkipping_SameImage) {
+    const auto volume = util::makeSphericalVolume(size3_t{32, 24, 28});
+    const TransferFunction tf({{0.0, vec4{0.0f}},
+                               {0.6, vec4{0.0f}},
+                               {0.8, vec4{1.0f, 0.5f, 0.0f, 0.05f}},
+                               {1.0, vec4{0.0f, 0.5f, 1.0f, 0.8f}}});
+
+    util::VolumeRaycastingSettings settings;
+    settings.lighting.shadingMode = ShadingMode::Phong;
+    settings.lighting.position = vec3{2.0f, 2.0f, 2.0f};
+    settings.lighting.ambient = vec3{0.2f};
+    settings.lighting.diffuse = vec3{0.7f};
+    settings.lighting.specular = vec3{0.5f};
+    settings.brickSize = 4;
+
+    const auto camera = makeCamera();
+    const size2_t dims{48, 40};
+    settings.emptySpaceSkipping = false;
+    const auto reference = util::raycastVolume(*volume, tf, camera, dims, settings);
+    settings.emptySpaceSkipping = true;
+    const auto skipped = util::raycastVolume(*volume, tf, camera, dims, settings);
+    ASSERT_TRUE(reference);
+    ASSERT_TRUE(skipped);
+
+    const auto refColors = colorData(*reference);
+    const auto colors = colorData(*skipped);
+    const auto refDepths = depthData(*reference);
+    const auto depths = depthData(*skipped);
+    for (size_t i = 0; i < dims.x * dims.y; ++i) {
+        EXPECT_EQ(colors[i], refColors[i]) << "pixel " << i;
+        EXPECT_EQ(depths[i], refDepths[i]) << "pixel " << i;
+    }
+
+    // The dense center of the volume is visible and occludes, the corners show the background.
+    const size_t center = dims.x / 2 + dims.x * (dims.y / 2);
+    EXPECT_GT(colors[center].a, 0);
+    EXPECT_LT(depths[center], 1.0f);
+    EXPECT_EQ(colors[0], glm::u8vec4{0});
+    EXPECT_EQ(depths[0], 1.0f);
+}
+
+TEST(VolumeRaycasting, PreparedGrids_SameImage) {
+    const auto volume = util::makeSphericalVolume(size3_t{20});
+    const TransferFunction tf({{0.0, vec4{0.0f}},
+                               {0.5, vec4{0.0f}},
+                               {1.0, vec4{1.0f, 0.5f, 0.0f, 0.6f}}});
+    util::VolumeRaycastingSettings settings;
+    settings.brickSize = 4;
+
+    const util::ScalarGrid grid(*volume, settings.channel);
+    const util::TFLookup lookup(tf);
+    const util::BrickGrid bricks(grid, lookup, settings.brickSize);
+
+    const size2_t dims{32, 32};
+    for (const auto& camera :
+         {makeCamera(), PerspectiveCamera(vec3{-1.5f, 0.5f, -1.0f}, vec3{0.0f},
+                                          vec3{0.0f, 1.0f, 0.0f}, 0.1f, 10.0f, 38.0f, 1.0f)}) {
+        const auto reference = util::raycastVolume(*volume, tf, camera, dims, settings);
+        const auto prepared =
+            util::raycastVolume(*volume, grid, lookup, &bricks, camera, dims, settings);
+        ASSERT_TRUE(reference);
+        ASSERT_TRUE(prepared);
+
+        const auto refColors = colorData(*reference);
+        const auto colors = colorData(*prepared);
+        for (size_t i = 0; i < dims.x * dims.y; ++i) {
+            EXPECT_EQ(colors[i], refColors[i]) << "pixel " << i;
+        }
+    }
+}
+
+TEST(VolumeRaycasting, Stop_ReturnsNull) {
+    const auto volume = util::makeSphericalVolume(size3_t{16});
+    const TransferFunction tf({{0.0, vec4{0.0f}}, {1.0, vec4{1.0f}}});
+    const auto camera = makeCamera();
+    EXPECT_FALSE(
+        util::raycastVolume(*volume, tf, camera, size2_t{64, 64}, {}, []() { return true; }));
+}
+
+}  // namespace inviwo
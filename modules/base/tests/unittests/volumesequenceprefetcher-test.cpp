@@ -0,0 +1,180 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2021 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#include <warn/push>
+#include <warn/ignore/all>
+#include <gtest/gtest.h>
+#include <warn/pop>
+
+#include <modules/base/datastructures/volumesequenceprefetcher.h>
+#include <inviwo/core/datastructures/volume/volume.h>
+#include <inviwo/core/datastructures/volume/volumedisk.h>
+#include <inviwo/core/datastructures/volume/volumeram.h>
+#include <inviwo/core/datastructures/volume/volumeramprecision.h>
+#include <inviwo/core/util/threadpool.h>
+
+#include <memory>
+
+namespace inviwo {
+
+namespace {
+
+// Every time step is 10 x 10 x 10 bytes
+constexpr size3_t dims{10, 10, 10};
+constexpr size_t bytes = 1000;
+
+class ZeroVolumeLoader : public DiskRepresentationLoader<VolumeRepresentation> {
+public:
+    virtual ZeroVolumeLoader* clone() const override { return new ZeroVolumeLoader(*this); }
+    virtual std::shared_ptr<VolumeRepresentation> createRepresentation(
+        const VolumeRepresentation& src) const override {
+        return std::make_shared<VolumeRAMPrecision<unsigned char>>(src.getDimensions());
+    }
+    virtual void updateRepresentation(std::shared_ptr<VolumeRepresentation>,
+                                      const VolumeRepresentation&) const override {}
+};
+
+// Time steps that are only on disk until loaded, like the ones of the DatVolumeSequenceReader
+std::shared_ptr<VolumeSequence> createSequence(size_t size) {
+    auto sequence = std::make_shared<VolumeSequence>();
+    for (size_t i = 0; i < size; ++i) {
+        auto disk = std::make_shared<VolumeDisk>(dims, DataUInt8::get());
+        disk->setLoader(new ZeroVolumeLoader());
+        sequence->push_back(std::make_shared<Volume>(disk));
+    }
+    return sequence;
+}
+
+std::vector<bool> loaded(const VolumeSequence& sequence) {
+    std::vector<bool> res;
+    for (const auto& volume : sequence) res.push_back(volume->hasRepresentation<VolumeRAM>());
+    return res;
+}
+
+// The processor using the time step creates its RAM representation
+void use(const VolumeSequence& sequence, size_t index) {
+    sequence[index]->getRepresentation<VolumeRAM>();
+}
+
+}  // namespace
+
+TEST(VolumeSequencePrefetcher, windowInBothDirections) {
+    ThreadPool pool(1);
+    VolumeSequencePrefetcher prefetcher(2, size_t{1} << 20, &pool);
+    auto sequence = createSequence(6);
+    prefetcher.setSequence(sequence);
+
+    prefetcher.access(0);
+    use(*sequence, 0);
+    prefetcher.waitForPrefetches();
+    EXPECT_EQ(std::vector<bool>({true, true, true, false, false, false}), loaded(*sequence));
+
+    prefetcher.access(1);
+    prefetcher.waitForPrefetches();
+    EXPECT_EQ(std::vector<bool>({true, true, true, true, false, false}), loaded(*sequence));
+
+    // Stepping back turns the window around, wrapping around the start of the sequence
+    prefetcher.access(0);
+    prefetcher.waitForPrefetches();
+    EXPECT_EQ(std::vector<bool>({true, true, true, true, true, true}), loaded(*sequence));
+
+    EXPECT_EQ(size_t{5}, prefetcher.getStatistics().prefetched);
+    EXPECT_EQ(size_t{0}, prefetcher.getStatistics().evicted);
+    EXPECT_EQ(6 * bytes, prefetcher.getLoadedBytes());
+}
+
+TEST(VolumeSequencePrefetcher, evictionKeepsVolumesInUse) {
+    ThreadPool pool(1);
+    VolumeSequencePrefetcher prefetcher(1, 3 * bytes, &pool);
+    auto sequence = createSequence(6);
+    prefetcher.setSequence(sequence);
+
+    prefetcher.access(0);
+    use(*sequence, 0);
+    prefetcher.waitForPrefetches();
+    prefetcher.access(1);
+    prefetcher.waitForPrefetches();
+    EXPECT_EQ(std::vector<bool>({true, true, true, false, false, false}), loaded(*sequence));
+    EXPECT_EQ(3 * bytes, prefetcher.getLoadedBytes());
+
+    // Loading time step 3 exceeds the budget, time step 1 is right behind the current one and
+    // will be needed last
+    prefetcher.access(2);
+    prefetcher.waitForPrefetches();
+    EXPECT_EQ(std::vector<bool>({true, false, true, true, false, false}), loaded(*sequence));
+    EXPECT_EQ(size_t{1}, prefetcher.getStatistics().evicted);
+
+    // Time step 2 is still in use, time step 0 is released instead
+    {
+        const auto inUse = (*sequence)[2];
+        prefetcher.access(3);
+        prefetcher.waitForPrefetches();
+    }
+    EXPECT_EQ(std::vector<bool>({false, false, true, true, true, false}), loaded(*sequence));
+    EXPECT_EQ(size_t{2}, prefetcher.getStatistics().evicted);
+    EXPECT_EQ(3 * bytes, prefetcher.getLoadedBytes());
+
+    // A lowered budget is applied on the next access, the accessed time step is always kept
+    prefetcher.setMemoryBudget(0);
+    prefetcher.access(4);
+    EXPECT_EQ(std::vector<bool>({false, false, false, false, true, false}), loaded(*sequence));
+    EXPECT_EQ(size_t{4}, prefetcher.getStatistics().evicted);
+    EXPECT_EQ(bytes, prefetcher.getLoadedBytes());
+}
+
+TEST(VolumeSequencePrefetcher, hitAndMissCounters) {
+    // Without workers the prefetched time steps stay pending
+    ThreadPool pool(0);
+    VolumeSequencePrefetcher prefetcher(0, size_t{1} << 20, &pool);
+    auto sequence = createSequence(6);
+    prefetcher.setSequence(sequence);
+
+    prefetcher.access(0);
+    use(*sequence, 0);
+    prefetcher.access(0);
+    prefetcher.access(1);
+    EXPECT_EQ(size_t{1}, prefetcher.getStatistics().hits);
+    EXPECT_EQ(size_t{2}, prefetcher.getStatistics().misses);
+    EXPECT_EQ(size_t{0}, prefetcher.getStatistics().prefetched);
+
+    prefetcher.resetStatistics();
+    EXPECT_EQ(size_t{0}, prefetcher.getStatistics().hits);
+    EXPECT_EQ(size_t{0}, prefetcher.getStatistics().misses);
+
+    // A time step that is still being loaded is a miss
+    prefetcher.setLookahead(1);
+    prefetcher.access(2);
+    use(*sequence, 3);
+    prefetcher.access(3);
+    EXPECT_EQ(size_t{0}, prefetcher.getStatistics().hits);
+    EXPECT_EQ(size_t{2}, prefetcher.getStatistics().misses);
+    EXPECT_EQ(size_t{2}, prefetcher.getStatistics().prefetched);
+}
+
+}  // namespace inviwo
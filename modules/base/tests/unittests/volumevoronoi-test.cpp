@@ -36,6 +36,9 @@
 #include <inviwo/core/datastructures/volume/volumeramprecision.h>
 #include <inviwo/core/util/indexmapper.h>
 
+#include <array>
+#include <random>
+
 namespace inviwo {
 
 constexpr auto clamp3D = Wrapping3D{Wrapping::Clamp, Wrapping::Clamp, Wrapping::Clamp};
@@ -206,4 +209,44 @@ TEST(VolumeVoronoi, Voronoi_ThreeSeedPoints_PartitionsVolumeInThree) {
     }
 }
 
+TEST(VolumeVoronoi, SpatialIndex_RandomSeedPoints_SameAsBruteForce) {
+    std::mt19937 gen(0);
+    std::uniform_real_distribution<float> dist(0.0f, 1.0f);
+
+    const auto dimensions = size3_t{17, 11, 13};
+    const mat4 indexToModel{vec4{0.5, 0.0, 0.0, 0.0}, vec4{0.0, 1.0, 0.0, 0.0},
+                            vec4{0.0, 0.0, 2.0, 0.0}, vec4{-1.0, 0.0, 1.0, 1.0}};
+    const auto size = vec3{dimensions} * vec3{0.5f, 1.0f, 2.0f};
+
+    std::vector<std::pair<uint32_t, vec3>> seedPoints;
+    std::vector<float> weights;
+    for (uint32_t i = 0; i < 200; ++i) {
+        seedPoints.emplace_back(i, vec3{-1.0f, 0.0f, 1.0f} +
+                                       vec3{dist(gen), dist(gen), dist(gen)} * size);
+        weights.push_back(2.0f * dist(gen));
+    }
+    // equally close seed points should give the first one
+    seedPoints.push_back({200, seedPoints[10].second});
+    weights.push_back(weights[10]);
+
+    const auto repeatXZ = Wrapping3D{Wrapping::Repeat, Wrapping::Clamp, Wrapping::Repeat};
+    const std::array<std::optional<std::vector<float>>, 2> weightOptions{std::nullopt, weights};
+
+    for (const auto& wrapping : {clamp3D, repeatXZ}) {
+        for (const auto& w : weightOptions) {
+            SCOPED_TRACE(w ? "Weighted" : "Unweighted");
+            auto bruteForce = util::voronoiSegmentation(dimensions, indexToModel, seedPoints,
+                                                        wrapping, w, VoronoiMethod::BruteForce);
+            auto spatialIndex = util::voronoiSegmentation(dimensions, indexToModel, seedPoints,
+                                                          wrapping, w, VoronoiMethod::SpatialIndex);
+
+            const auto expected = static_cast<const unsigned short*>(
+                bruteForce->getRepresentation<VolumeRAM>()->getData());
+            const auto result = static_cast<const unsigned short*>(
+                spatialIndex->getRepresentation<VolumeRAM>()->getData());
+            EXPECT_TRUE(std::equal(expected, expected + glm::compMul(dimensions), result));
+        }
+    }
+}
+
 }  // namespace inviwo
@@ -80,7 +80,9 @@ IVW_MODULE_DATAFRAME_API std::shared_ptr<DataFrame> appendRows(const DataFrame&
  * \brief create a new DataFrame by using an inner join of DataFrame \p left and DataFrame \p right.
  * That is only rows with matching keys are kept.
  *
- * It is assumed that the entries in the key columns are unique. Otherwise results are undefined.
+ * Each row of \p left is matched with the first row of \p right where all key columns are equal.
+ * Categorical key columns are matched by their category strings. NaN keys never match. Depending on
+ * the key columns, either a hash join or a sort-merge join is used, both run on the thread pool.
  * @param left
  * @param right
  * @param keyColumn   header of the column used as key for the join operation (default: index
@@ -99,8 +101,9 @@ IVW_MODULE_DATAFRAME_API std::shared_ptr<DataFrame> innerJoin(
  * \brief create a new DataFrame by using an outer left join of DataFrame \p left and DataFrame \p
  * right. That is all rows of \p left are augmented with matching rows from \p right.
  *
- * It is assumed that the entries in the key columns of \p right are unique. Otherwise results are
- * undefined.
+ * Each row of \p left is matched with the first row of \p right where all key columns are equal.
+ * Rows without a match are filled with 0 or "undefined" (for categorical columns).
+ * See innerJoin() for details on how keys are matched.
  *
  * @param left
  * @param right
@@ -32,10 +32,21 @@
 #include <inviwo/core/util/document.h>
 #include <inviwo/core/util/stdextensions.h>
 #include <inviwo/core/util/assertion.h>
+#include <inviwo/core/util/glm.h>
+#include <inviwo/core/util/hashcombine.h>
+#include <inviwo/core/util/parallel.h>
 
 #include <fmt/format.h>
+#include <tcb/span.hpp>
 
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <numeric>
 #include <optional>
+#include <string_view>
+#include <unordered_map>
 
 namespace inviwo {
 
@@ -192,99 +203,399 @@ void columnCheck(const DataFrame& left, const DataFrame& right,
 }
 
 /**
- * \brief for each row in leftCol return a list of matching row indices in rightCol
+ * \brief hash of a single key value
+ * Floating point values are hashed as double after adding 0.0, which maps -0.0 onto 0.0 since
+ * both compare equal.
  */
-template <bool firstMatchOnly = false>
-std::vector<std::vector<size_t>> getMatchingRows(std::shared_ptr<const Column> leftCol,
-                                                 std::shared_ptr<const Column> rightCol) {
-    std::vector<std::vector<size_t>> rows(leftCol->getSize());
-
-    if (auto catCol1 = dynamic_cast<const CategoricalColumn*>(leftCol.get())) {
-        // need to match values of categorical columns instead of indices stored in buffer
-        auto catCol2 = dynamic_cast<const CategoricalColumn*>(rightCol.get());
-        IVW_ASSERT(catCol2, "right column is not categorical");
-
-        auto valuesRight = catCol2->getValues();
-        for (auto&& [i, key] : util::enumerate(catCol1->getValues())) {
-            // find all matching rows in right column
-            std::vector<size_t> matches;
-            for (auto&& [r, value] : util::enumerate(valuesRight)) {
-                if (key == value) {
-                    matches.emplace_back(r);
-                    if constexpr (firstMatchOnly) break;
-                }
-            }
-            rows[i] = std::move(matches);
+template <typename T>
+std::size_t joinKeyHash(const T& value) {
+    if constexpr (util::rank<T>::value == 0) {
+        if constexpr (util::is_floating_point<T>::value) {
+            return std::hash<double>{}(static_cast<double>(value) + 0.0);
+        } else {
+            return std::hash<T>{}(value);
         }
     } else {
-        leftCol->getBuffer()->getRepresentation<BufferRAM>()->dispatch<void>(
-            [rightBuffer = rightCol->getBuffer(), &rows](auto typedBuf) {
-                using ValueType = util::PrecisionValueType<decltype(typedBuf)>;
+        std::size_t seed = 0;
+        for (size_t i = 0; i < util::flat_extent<T>::value; ++i) {
+            util::hash_combine(seed, joinKeyHash(util::glmcomp(value, i)));
+        }
+        return seed;
+    }
+}
 
-                const auto& left = typedBuf->getDataContainer();
-                const auto& right = static_cast<const BufferRAMPrecision<ValueType>*>(
-                                        rightBuffer->getRepresentation<BufferRAM>())
-                                        ->getDataContainer();
-
-                for (auto&& [i, key] : util::enumerate(left)) {
-                    // find all matching rows in right
-                    std::vector<size_t> matches;
-                    for (auto&& [r, value] : util::enumerate(right)) {
-                        if (key == value) {
-                            matches.emplace_back(r);
-                            if constexpr (firstMatchOnly) break;
-                        }
+/**
+ * \brief find the first position in the sorted range \p keys not less than \p key
+ * The search starts at \p first and probes with exponentially growing steps before doing a binary
+ * search. Looking up sorted keys one after another is thereby linear in the number of keys, i.e. a
+ * merge.
+ */
+template <typename T>
+size_t gallop(util::span<const T> keys, size_t first, const T& key) {
+    size_t lo = first;
+    size_t hi = first;
+    size_t step = 1;
+    while (hi < keys.size() && keys[hi] < key) {
+        lo = hi + 1;
+        hi = first + step;
+        step *= 2;
+    }
+    hi = std::min(hi, keys.size());
+    return static_cast<size_t>(std::lower_bound(keys.begin() + lo, keys.begin() + hi, key) -
+                               keys.begin());
+}
+
+/**
+ * \brief check whether the scalar \p keys are sorted in ascending order and do not contain NaN
+ */
+template <typename T>
+bool isSortedKey(util::span<const T> keys) {
+    if constexpr (util::rank<T>::value == 0) {
+        for (size_t i = 0; i < keys.size(); ++i) {
+            if (!(keys[i] == keys[i]) || (i > 0 && keys[i] < keys[i - 1])) return false;
+        }
+        return true;
+    } else {
+        return false;
+    }
+}
+
+/**
+ * \brief type-erased access to the values of one key column in the left and the right DataFrame
+ */
+class JoinKey {
+public:
+    virtual ~JoinKey() = default;
+
+    /**
+     * combine the hashes of all left (right) key values with \p hashes
+     */
+    virtual void hashLeft(std::vector<std::size_t>& hashes) const = 0;
+    virtual void hashRight(std::vector<std::size_t>& hashes) const = 0;
+
+    virtual bool equal(size_t leftRow, size_t rightRow) const = 0;
+    virtual bool equalRight(size_t rightRow1, size_t rightRow2) const = 0;
+
+    /**
+     * only scalar keys can be joined with sortMergeJoin()
+     */
+    virtual bool isScalar() const = 0;
+    virtual bool isLeftSorted() const = 0;
+    virtual bool isRightSorted() const = 0;
+
+    /**
+     * \brief for each left row return the first matching right row
+     * Sorts the right keys unless they are sorted already and merges the left keys with them.
+     * Requires isScalar() to be true.
+     */
+    virtual std::vector<std::optional<size_t>> sortMergeJoin() const = 0;
+};
+
+template <typename T>
+class TypedJoinKey : public JoinKey {
+public:
+    TypedJoinKey(util::span<const T> left, util::span<const T> right)
+        : left_{left}
+        , right_{right}
+        , leftSorted_{isSortedKey(left_)}
+        , rightSorted_{isSortedKey(right_)} {}
+
+    TypedJoinKey(std::vector<T> left, std::vector<T> right)
+        : leftStorage_{std::move(left)}
+        , rightStorage_{std::move(right)}
+        , left_{leftStorage_}
+        , right_{rightStorage_}
+        , leftSorted_{isSortedKey(left_)}
+        , rightSorted_{isSortedKey(right_)} {}
+
+    virtual void hashLeft(std::vector<std::size_t>& hashes) const override {
+        util::parallelFor(0, left_.size(), [&](size_t i) {
+            util::hash_combine(hashes[i], joinKeyHash(left_[i]));
+        });
+    }
+    virtual void hashRight(std::vector<std::size_t>& hashes) const override {
+        util::parallelFor(0, right_.size(), [&](size_t i) {
+            util::hash_combine(hashes[i], joinKeyHash(right_[i]));
+        });
+    }
+
+    virtual bool equal(size_t leftRow, size_t rightRow) const override {
+        return left_[leftRow] == right_[rightRow];
+    }
+    virtual bool equalRight(size_t rightRow1, size_t rightRow2) const override {
+        return right_[rightRow1] == right_[rightRow2];
+    }
+
+    virtual bool isScalar() const override { return util::rank<T>::value == 0; }
+    virtual bool isLeftSorted() const override { return leftSorted_; }
+    virtual bool isRightSorted() const override { return rightSorted_; }
+
+    virtual std::vector<std::optional<size_t>> sortMergeJoin() const override {
+        std::vector<std::optional<size_t>> rows(left_.size());
+        if constexpr (util::rank<T>::value == 0) {
+            // the stable sort keeps equal keys in row order, the first match is thus the lowest
+            // right row. Rows with NaN keys never match and are left out.
+            std::vector<size_t> order;
+            std::vector<T> sorted;
+            util::span<const T> keys = right_;
+            if (!rightSorted_) {
+                order.reserve(right_.size());
+                for (size_t i = 0; i < right_.size(); ++i) {
+                    if (right_[i] == right_[i]) order.push_back(i);
+                }
+                std::stable_sort(order.begin(), order.end(),
+                                 [&](size_t a, size_t b) { return right_[a] < right_[b]; });
+                sorted = util::transform(order, [&](size_t i) { return right_[i]; });
+                keys = sorted;
+            }
+
+            util::parallelFor(0, left_.size(), [&](size_t begin, size_t end) {
+                size_t first = 0;
+                std::optional<T> prev;
+                for (size_t i = begin; i < end; ++i) {
+                    const T& key = left_[i];
+                    if (!(key == key)) continue;
+                    // restart the search from the beginning if the left keys are not ascending
+                    if (prev && key < *prev) first = 0;
+                    prev = key;
+
+                    first = gallop(keys, first, key);
+                    if (first < keys.size() && keys[first] == key) {
+                        rows[i] = rightSorted_ ? first : order[first];
                     }
-                    rows[i] = std::move(matches);
                 }
             });
+        }
+        return rows;
     }
-    return rows;
-}
 
-std::vector<std::vector<size_t>> getMatchingRows(const DataFrame& left, const DataFrame& right,
-                                                 const std::vector<std::string>& keyColumns) {
-    auto indexCol1 = left.getColumn(keyColumns.front());
-    auto indexCol2 = right.getColumn(keyColumns.front());
-
-    auto rows = detail::getMatchingRows(indexCol1, indexCol2);
-    // narrow down row selection by filtering with remaining keys
-    for (auto keyColName : util::as_range(keyColumns.begin() + 1, keyColumns.end())) {
-        auto leftCol = left.getColumn(keyColName);
-        auto rightCol = right.getColumn(keyColName);
-
-        if (auto catCol1 = dynamic_cast<const CategoricalColumn*>(leftCol.get())) {
-            auto catCol2 = dynamic_cast<const CategoricalColumn*>(rightCol.get());
-            IVW_ASSERT(catCol2, "right column is not categorical");
-
-            auto valuesLeft = catCol1->getValues();
-            auto valuesRight = catCol2->getValues();
-            for (auto&& [i, rowMatches] : util::enumerate(rows)) {
-                util::erase_remove_if(rowMatches, [key = valuesLeft[i], &valuesRight](auto row) {
-                    return key != valuesRight[row];
-                });
+private:
+    std::vector<T> leftStorage_;
+    std::vector<T> rightStorage_;
+    util::span<const T> left_;
+    util::span<const T> right_;
+    bool leftSorted_;
+    bool rightSorted_;
+};
+
+/**
+ * \brief create a JoinKey for the matching key columns \p left and \p right
+ * Categorical columns are compared by their category ids instead of the category strings. The ids
+ * of both columns are therefore mapped onto a common set of ids first, where each category string
+ * is represented by a single id.
+ */
+std::unique_ptr<JoinKey> createJoinKey(const Column& left, const Column& right) {
+    if (auto catLeft = dynamic_cast<const CategoricalColumn*>(&left)) {
+        auto catRight = dynamic_cast<const CategoricalColumn*>(&right);
+        IVW_ASSERT(catRight, "right column is not categorical");
+
+        const auto& leftCategories = catLeft->getCategories();
+        const auto& rightCategories = catRight->getCategories();
+        std::unordered_map<std::string_view, std::uint32_t> ids;
+        auto mapIds = [&](const std::vector<std::string>& categories, size_t offset) {
+            std::vector<std::uint32_t> map(categories.size());
+            for (auto&& [i, category] : util::enumerate(categories)) {
+                map[i] = ids.try_emplace(category, static_cast<std::uint32_t>(offset + i))
+                             .first->second;
             }
-        } else {
-            leftCol->getBuffer()->getRepresentation<BufferRAM>()->dispatch<void>(
-                [&rows, rightBuffer = rightCol->getBuffer()](auto typedBuf) {
-                    using ValueType = util::PrecisionValueType<decltype(typedBuf)>;
+            return map;
+        };
+        const auto leftMap = mapIds(leftCategories, 0);
+        const auto rightMap = mapIds(rightCategories, leftCategories.size());
+
+        auto mapValues = [](const CategoricalColumn& col, const std::vector<std::uint32_t>& map) {
+            return util::transform(
+                col.getTypedBuffer()->getRAMRepresentation()->getDataContainer(),
+                [&](std::uint32_t id) { return map[id]; });
+        };
+        return std::make_unique<TypedJoinKey<std::uint32_t>>(mapValues(*catLeft, leftMap),
+                                                              mapValues(*catRight, rightMap));
+    } else {
+        return left.getBuffer()->getRepresentation<BufferRAM>()->dispatch<std::unique_ptr<JoinKey>>(
+            [rightBuffer = right.getBuffer()](auto typedBuf) -> std::unique_ptr<JoinKey> {
+                using ValueType = util::PrecisionValueType<decltype(typedBuf)>;
 
-                    const auto& left = typedBuf->getDataContainer();
-                    const auto& right = static_cast<const BufferRAMPrecision<ValueType>*>(
+                const auto& leftData = typedBuf->getDataContainer();
+                const auto& rightData = static_cast<const BufferRAMPrecision<ValueType>*>(
                                             rightBuffer->getRepresentation<BufferRAM>())
                                             ->getDataContainer();
+                return std::make_unique<TypedJoinKey<ValueType>>(
+                    util::span<const ValueType>{leftData}, util::span<const ValueType>{rightData});
+            });
+    }
+}
 
-                    for (auto&& [i, rowMatches] : util::enumerate(rows)) {
-                        util::erase_remove_if(rowMatches, [key = left[i], &right](auto row) {
-                            return key != right[row];
-                        });
+/**
+ * \brief all key columns of a join, rows match if all keys are equal
+ */
+class JoinKeys {
+public:
+    JoinKeys(const DataFrame& left, const DataFrame& right,
+             const std::vector<std::string>& keyColumns)
+        : leftRows_{left.getColumn(keyColumns.front())->getSize()}
+        , rightRows_{right.getColumn(keyColumns.front())->getSize()} {
+        for (const auto& col : keyColumns) {
+            keys_.push_back(createJoinKey(*left.getColumn(col), *right.getColumn(col)));
+        }
+    }
+
+    size_t leftRows() const { return leftRows_; }
+    size_t rightRows() const { return rightRows_; }
+
+    std::vector<std::size_t> hashLeft() const {
+        std::vector<std::size_t> hashes(leftRows_, 0);
+        for (const auto& key : keys_) key->hashLeft(hashes);
+        return hashes;
+    }
+    std::vector<std::size_t> hashRight() const {
+        std::vector<std::size_t> hashes(rightRows_, 0);
+        for (const auto& key : keys_) key->hashRight(hashes);
+        return hashes;
+    }
+
+    bool equal(size_t leftRow, size_t rightRow) const {
+        return std::all_of(keys_.begin(), keys_.end(),
+                           [&](const auto& key) { return key->equal(leftRow, rightRow); });
+    }
+    bool equalRight(size_t rightRow1, size_t rightRow2) const {
+        return std::all_of(keys_.begin(), keys_.end(), [&](const auto& key) {
+            return key->equalRight(rightRow1, rightRow2);
+        });
+    }
+
+    /**
+     * return the key if there is only a single scalar key column, nullptr otherwise
+     */
+    const JoinKey* scalarKey() const {
+        if (keys_.size() == 1 && keys_.front()->isScalar()) return keys_.front().get();
+        return nullptr;
+    }
+
+private:
+    size_t leftRows_;
+    size_t rightRows_;
+    std::vector<std::unique_ptr<JoinKey>> keys_;
+};
+
+/**
+ * \brief open addressing hash table holding the first right row of each distinct key
+ * For large tables, the rows are partitioned by the upper bits of their hash and the partitions
+ * are built in parallel. Rows keep their order within a partition, so the first inserted row of a
+ * key is also the lowest right row with that key.
+ */
+class JoinHashTable {
+public:
+    JoinHashTable(const std::vector<std::size_t>& hashes, const JoinKeys& keys)
+        : partitionBits_{hashes.size() < (size_t{1} << 16) ? 0 : 6} {
+        const size_t numPartitions = size_t{1} << partitionBits_;
+
+        std::vector<size_t> offsets(numPartitions + 1, 0);
+        for (auto hash : hashes) {
+            ++offsets[partition(mix(hash)) + 1];
+        }
+        std::partial_sum(offsets.begin(), offsets.end(), offsets.begin());
+
+        std::vector<size_t> rows(hashes.size());
+        {
+            auto pos = offsets;
+            for (size_t row = 0; row < hashes.size(); ++row) {
+                rows[pos[partition(mix(hashes[row]))]++] = row;
+            }
+        }
+
+        partitions_.resize(numPartitions);
+        util::parallelFor(
+            0, numPartitions,
+            [&](size_t p) {
+                size_t capacity = 16;
+                while (capacity < 2 * (offsets[p + 1] - offsets[p])) capacity *= 2;
+                const size_t mask = capacity - 1;
+
+                auto& table = partitions_[p];
+                table.assign(capacity, Entry{0, empty});
+                for (size_t i = offsets[p]; i < offsets[p + 1]; ++i) {
+                    const size_t row = rows[i];
+                    // rows not equal to themselves, i.e. NaN keys, can never match
+                    if (!keys.equalRight(row, row)) continue;
+
+                    const auto hash = mix(hashes[row]);
+                    size_t slot = hash & mask;
+                    while (table[slot].row != empty &&
+                           !(table[slot].hash == hash && keys.equalRight(table[slot].row, row))) {
+                        slot = (slot + 1) & mask;
                     }
-                });
+                    if (table[slot].row == empty) table[slot] = Entry{hash, row};
+                }
+            },
+            1);
+    }
+
+    std::optional<size_t> find(std::size_t hash, size_t leftRow, const JoinKeys& keys) const {
+        const auto mixed = mix(hash);
+        const auto& table = partitions_[partition(mixed)];
+        const size_t mask = table.size() - 1;
+        for (size_t slot = mixed & mask; table[slot].row != empty; slot = (slot + 1) & mask) {
+            if (table[slot].hash == mixed && keys.equal(leftRow, table[slot].row)) {
+                return table[slot].row;
+            }
         }
+        return std::nullopt;
     }
+
+private:
+    struct Entry {
+        std::uint64_t hash;
+        size_t row;
+    };
+    static constexpr size_t empty = std::numeric_limits<size_t>::max();
+
+    /**
+     * finalizer of splitmix64, spreads the bits of hashes like std::hash<int> (identity)
+     */
+    static std::uint64_t mix(std::uint64_t x) {
+        x ^= x >> 30;
+        x *= 0xbf58476d1ce4e5b9ull;
+        x ^= x >> 27;
+        x *= 0x94d049bb133111ebull;
+        x ^= x >> 31;
+        return x;
+    }
+    size_t partition(std::uint64_t mixed) const {
+        return partitionBits_ == 0 ? 0 : static_cast<size_t>(mixed >> (64 - partitionBits_));
+    }
+
+    int partitionBits_;
+    std::vector<std::vector<Entry>> partitions_;
+};
+
+std::vector<std::optional<size_t>> hashJoin(const JoinKeys& keys) {
+    const auto leftHashes = keys.hashLeft();
+    const JoinHashTable table(keys.hashRight(), keys);
+
+    std::vector<std::optional<size_t>> rows(keys.leftRows());
+    util::parallelFor(0, rows.size(),
+                      [&](size_t i) { rows[i] = table.find(leftHashes[i], i, keys); });
     return rows;
 }
 
+/**
+ * \brief for each row in \p left return the first row in \p right where all key columns match
+ *
+ * A single scalar key is joined by merging if the right keys are sorted already or if the left
+ * keys are sorted and the right DataFrame is not larger than the left one. In all other cases,
+ * e.g. for multiple keys or vector keys, a hash join is used.
+ */
+std::vector<std::optional<size_t>> getMatchingRows(const DataFrame& left, const DataFrame& right,
+                                                   const std::vector<std::string>& keyColumns) {
+    const JoinKeys keys(left, right, keyColumns);
+    if (auto key = keys.scalarKey();
+        key && (key->isRightSorted() ||
+                (key->isLeftSorted() && keys.rightRows() <= keys.leftRows()))) {
+        return key->sortMergeJoin();
+    }
+    return hashJoin(keys);
+}
+
 void addColumns(std::shared_ptr<DataFrame> dst, const DataFrame& srcDataFrame,
                 const std::vector<std::string>& keyColumns, bool skipKeyCol) {
     for (auto srcCol : srcDataFrame) {
@@ -351,29 +662,7 @@ void addColumns(std::shared_ptr<DataFrame> dst, const DataFrame& srcDataFrame,
 
 std::shared_ptr<DataFrame> innerJoin(const DataFrame& left, const DataFrame& right,
                                      const std::string& keyColumn) {
-    detail::columnCheck(left, right, {keyColumn}, "dataframe::innerJoin");
-
-    auto indexCol1 = left.getColumn(keyColumn);
-    auto indexCol2 = right.getColumn(keyColumn);
-
-    std::vector<size_t> rowsLeft;
-    std::vector<size_t> rowsRight;
-    for (auto&& [i, rowIndices] :
-         util::enumerate(detail::getMatchingRows<true>(indexCol1, indexCol2))) {
-        if (!rowIndices.empty()) {
-            rowsLeft.push_back(i);
-            rowsRight.push_back(rowIndices.front());
-        }
-    }
-
-    IVW_ASSERT(rowsLeft.size() == rowsRight.size(), "incorrect number of matching row indices");
-
-    auto dataframe = std::make_shared<DataFrame>();
-    detail::addColumns(dataframe, left, rowsLeft, {keyColumn}, false);
-    detail::addColumns(dataframe, right, rowsRight, {keyColumn}, true);
-
-    dataframe->updateIndexBuffer();
-    return dataframe;
+    return innerJoin(left, right, std::vector<std::string>{keyColumn});
 }
 
 std::shared_ptr<DataFrame> innerJoin(const DataFrame& left, const DataFrame& right,
@@ -386,11 +675,10 @@ std::shared_ptr<DataFrame> innerJoin(const DataFrame& left, const DataFrame& rig
 
     std::vector<size_t> rowsLeft;
     std::vector<size_t> rowsRight;
-    for (auto&& [i, rowIndices] :
-         util::enumerate(detail::getMatchingRows(left, right, keyColumns))) {
-        if (!rowIndices.empty()) {
+    for (auto&& [i, match] : util::enumerate(detail::getMatchingRows(left, right, keyColumns))) {
+        if (match) {
             rowsLeft.push_back(i);
-            rowsRight.push_back(rowIndices.front());
+            rowsRight.push_back(*match);
         }
     }
 
@@ -406,28 +694,7 @@ std::shared_ptr<DataFrame> innerJoin(const DataFrame& left, const DataFrame& rig
 
 std::shared_ptr<DataFrame> leftJoin(const DataFrame& left, const DataFrame& right,
                                     const std::string& keyColumn) {
-    detail::columnCheck(left, right, {keyColumn}, "dataframe::leftJoin");
-
-    auto indexCol1 = left.getColumn(keyColumn);
-    auto indexCol2 = right.getColumn(keyColumn);
-
-    auto rows = util::transform(detail::getMatchingRows<true>(indexCol1, indexCol2),
-                                [](const std::vector<size_t>& rowIndices) -> std::optional<size_t> {
-                                    if (rowIndices.empty()) {
-                                        return {};
-                                    } else {
-                                        return rowIndices.front();
-                                    }
-                                });
-
-    IVW_ASSERT(indexCol1->getSize() == rows.size(), "incorrect number of matching row indices");
-
-    auto dataframe = std::make_shared<DataFrame>();
-    detail::addColumns(dataframe, left, {keyColumn}, false);
-    detail::addColumns(dataframe, right, rows, {keyColumn}, true);
-
-    dataframe->updateIndexBuffer();
-    return dataframe;
+    return leftJoin(left, right, std::vector<std::string>{keyColumn});
 }
 
 std::shared_ptr<DataFrame> leftJoin(const DataFrame& left, const DataFrame& right,
@@ -438,14 +705,10 @@ std::shared_ptr<DataFrame> leftJoin(const DataFrame& left, const DataFrame& righ
 
     detail::columnCheck(left, right, keyColumns, "dataframe::leftJoin");
 
-    auto rows = util::transform(detail::getMatchingRows(left, right, keyColumns),
-                                [](const std::vector<size_t>& rowIndices) -> std::optional<size_t> {
-                                    if (rowIndices.empty()) {
-                                        return {};
-                                    } else {
-                                        return rowIndices.front();
-                                    }
-                                });
+    const auto rows = detail::getMatchingRows(left, right, keyColumns);
+
+    IVW_ASSERT(left.getColumn(keyColumns.front())->getSize() == rows.size(),
+               "incorrect number of matching row indices");
 
     auto dataframe = std::make_shared<DataFrame>();
     detail::addColumns(dataframe, left, keyColumns, false);
@@ -0,0 +1,126 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2021 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#ifdef _MSC_VER
+#pragma comment(linker, "/SUBSYSTEM:CONSOLE")
+#endif
+
+#include <inviwo/core/common/inviwoapplication.h>
+#include <inviwo/core/common/coremodulesharedlibrary.h>
+#include <inviwo/core/datastructures/buffer/buffer.h>
+#include <inviwo/dataframe/datastructures/dataframe.h>
+#include <inviwo/dataframe/util/dataframeutil.h>
+
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace {
+
+using namespace inviwo;
+
+/**
+ * Creates a DataFrame like the SyntheticDataFrame processor, i.e. a number of uniformly
+ * distributed float columns, together with an int key column with values in [0, numKeys) and a
+ * categorical key column with 16 categories.
+ */
+DataFrame syntheticDataFrame(size_t rows, int numKeys, bool sortedKeys, unsigned int seed) {
+    std::mt19937 gen(seed);
+    std::uniform_int_distribution<int> keyDist(0, numKeys - 1);
+    std::uniform_int_distribution<int> catDist(0, 15);
+    std::uniform_real_distribution<float> floatDist(-1.0f, 1.0f);
+
+    std::vector<int> keys(rows);
+    std::vector<std::string> categories(rows);
+    for (size_t i = 0; i < rows; ++i) {
+        keys[i] = keyDist(gen);
+        categories[i] = "category " + std::to_string(catDist(gen));
+    }
+    if (sortedKeys) std::sort(keys.begin(), keys.end());
+
+    DataFrame dataframe;
+    dataframe.addColumnFromBuffer("key", util::makeBuffer(std::move(keys)));
+    dataframe.addCategoricalColumn("cat", categories);
+    for (int c = 0; c < 4; ++c) {
+        std::vector<float> values(rows);
+        for (auto& v : values) v = floatDist(gen);
+        dataframe.addColumnFromBuffer("Column " + std::to_string(dataframe.getNumberOfColumns()),
+                                      util::makeBuffer(std::move(values)));
+    }
+    dataframe.updateIndexBuffer();
+    return dataframe;
+}
+
+void joinBenchmark(benchmark::State& state, bool sortedKeys, std::vector<std::string> keys) {
+    const auto rows = static_cast<size_t>(state.range(0));
+    const auto left = syntheticDataFrame(rows, static_cast<int>(rows), sortedKeys, 1);
+    const auto right = syntheticDataFrame(rows, static_cast<int>(rows), sortedKeys, 2);
+
+    for (auto _ : state) {
+        auto dataframe = dataframe::leftJoin(left, right, keys);
+        benchmark::DoNotOptimize(dataframe);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+void HashJoin(benchmark::State& state) { joinBenchmark(state, false, {"key"}); }
+void SortMergeJoin(benchmark::State& state) { joinBenchmark(state, true, {"key"}); }
+void MultiKeyJoin(benchmark::State& state) { joinBenchmark(state, false, {"key", "cat"}); }
+void CategoricalJoin(benchmark::State& state) { joinBenchmark(state, false, {"cat"}); }
+
+}  // namespace
+
+BENCHMARK(HashJoin)->RangeMultiplier(8)->Range(1 << 10, 1 << 20)->Unit(benchmark::kMillisecond);
+BENCHMARK(SortMergeJoin)
+    ->RangeMultiplier(8)
+    ->Range(1 << 10, 1 << 20)
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK(MultiKeyJoin)->RangeMultiplier(8)->Range(1 << 10, 1 << 20)->Unit(benchmark::kMillisecond);
+BENCHMARK(CategoricalJoin)
+    ->RangeMultiplier(8)
+    ->Range(1 << 10, 1 << 20)
+    ->Unit(benchmark::kMillisecond);
+
+int main(int argc, char** argv) {
+    benchmark::Initialize(&argc, argv);
+
+    InviwoApplication app("Inviwo-Benchmark-DataFrame");
+    {
+        std::vector<std::unique_ptr<InviwoModuleFactoryObject>> modules;
+        modules.emplace_back(createInviwoCore());
+        app.registerModules(std::move(modules));
+    }
+    app.processFront();
+
+    benchmark::RunSpecifiedBenchmarks();
+    return 0;
+}
@@ -42,6 +42,10 @@
 
 #include <fmt/format.h>
 
+#include <cmath>
+#include <map>
+#include <random>
+
 namespace inviwo {
 
 namespace {
@@ -385,4 +389,93 @@ TEST(LeftJoin, MultipleKeyColumns) {
                                {4.0f, 3.0f, 0.0f, 0.0f, 5.0f, 0.0f, 6.0f, 7.0f});
 }
 
+TEST(InnerJoin, DuplicateKeysUseFirstMatch) {
+    DataFrame left;
+    left.addColumnFromBuffer("int", util::makeBuffer(std::vector<int>{3, 7, 1, 3}));
+    left.updateIndexBuffer();
+
+    DataFrame right;
+    right.addColumnFromBuffer("int", util::makeBuffer(std::vector<int>{7, 3, 5, 3, 7}));
+    right.addColumnFromBuffer("float",
+                              util::makeBuffer(std::vector<float>{1.0f, 2.0f, 3.0f, 4.0f, 5.0f}));
+    right.updateIndexBuffer();
+
+    auto dataframe = dataframe::innerJoin(left, right, "int");
+    EXPECT_EQ(3, dataframe->getNumberOfRows()) << "inner join should result in 3 rows";
+
+    checkColumnContents<int>(*dataframe->getColumn("int"), {3, 7, 3});
+    checkColumnContents<float>(*dataframe->getColumn("float"), {2.0f, 1.0f, 2.0f});
+}
+
+TEST(LeftJoin, SortedKeyColumn) {
+    DataFrame left;
+    left.addColumnFromBuffer(
+        "float", util::makeBuffer(std::vector<float>{-0.0f, 2.0f, NAN, 1.5f, 2.0f, 9.0f}));
+    left.updateIndexBuffer();
+
+    DataFrame right;
+    right.addColumnFromBuffer("float",
+                              util::makeBuffer(std::vector<float>{0.0f, 1.5f, 2.0f, 2.0f, 3.0f}));
+    right.addColumnFromBuffer("int", util::makeBuffer(std::vector<int>{1, 2, 3, 4, 5}));
+    right.updateIndexBuffer();
+
+    auto dataframe = dataframe::leftJoin(left, right, "float");
+    EXPECT_EQ(6, dataframe->getNumberOfRows()) << "left join should result in 6 rows";
+
+    checkColumnContents<int>(*dataframe->getColumn("int"), {1, 3, 0, 2, 3, 0});
+}
+
+TEST(LeftJoin, LargeMultipleKeyColumns) {
+    const size_t leftRows = 20000;
+    const size_t rightRows = 100000;
+    const std::vector<std::string> categories = {"a", "b", "c", "d", "e", "f", "g"};
+
+    std::mt19937 gen(42);
+    std::uniform_int_distribution<int> intDist(0, 999);
+    std::uniform_int_distribution<size_t> catDist(0, categories.size() - 1);
+
+    std::vector<int> leftInts(leftRows);
+    std::vector<std::string> leftCats(leftRows);
+    for (size_t i = 0; i < leftRows; ++i) {
+        leftInts[i] = intDist(gen);
+        leftCats[i] = categories[catDist(gen)];
+    }
+    std::vector<int> rightInts(rightRows);
+    std::vector<std::string> rightCats(rightRows);
+    std::vector<int> rightValues(rightRows);
+    for (size_t i = 0; i < rightRows; ++i) {
+        rightInts[i] = intDist(gen);
+        // the categories of the right column are used in a different order
+        rightCats[i] = categories[categories.size() - 1 - catDist(gen)];
+        rightValues[i] = static_cast<int>(i) + 1;
+    }
+
+    std::map<std::pair<int, std::string>, int> firstMatch;
+    for (size_t i = 0; i < rightRows; ++i) {
+        firstMatch.try_emplace({rightInts[i], rightCats[i]}, rightValues[i]);
+    }
+    std::vector<int> expected(leftRows, 0);
+    for (size_t i = 0; i < leftRows; ++i) {
+        if (auto it = firstMatch.find({leftInts[i], leftCats[i]}); it != firstMatch.end()) {
+            expected[i] = it->second;
+        }
+    }
+
+    DataFrame left;
+    left.addColumnFromBuffer("int", util::makeBuffer(std::move(leftInts)));
+    left.addCategoricalColumn("cat", leftCats);
+    left.updateIndexBuffer();
+
+    DataFrame right;
+    right.addColumnFromBuffer("int", util::makeBuffer(std::move(rightInts)));
+    right.addCategoricalColumn("cat", rightCats);
+    right.addColumnFromBuffer("value", util::makeBuffer(std::move(rightValues)));
+    right.updateIndexBuffer();
+
+    auto dataframe = dataframe::leftJoin(left, right, std::vector<std::string>{"int", "cat"});
+    EXPECT_EQ(leftRows, dataframe->getNumberOfRows()) << "left join should keep all left rows";
+
+    checkColumnContents<int>(*dataframe->getColumn("value"), expected);
+}
+
 }  // namespace inviwo
@@ -100,6 +100,32 @@ public:
 
     const std::vector<T>& data() const { return buffer_; }
 
+    /**
+     * \brief Contiguous view of all elements
+     * Invalidated when the buffer is resized.
+     * @tparam VecNT Element type of the view
+     */
+    template <typename VecNT = DefaultVec>
+    util::span<VecNT> view() {
+        static_assert(sizeof(VecNT) == sizeof(T) * N,
+                      "Size and type do not agree with the vector type.");
+        return util::span<VecNT>(reinterpret_cast<VecNT*>(buffer_.data()),
+                                 static_cast<size_t>(size()));
+    }
+
+    /**
+     * \brief Contiguous constant view of all elements
+     * Invalidated when the buffer is resized.
+     * @tparam VecNT Element type of the view
+     */
+    template <typename VecNT = DefaultVec>
+    util::span<const VecNT> view() const {
+        static_assert(sizeof(VecNT) == sizeof(T) * N,
+                      "Size and type do not agree with the vector type.");
+        return util::span<const VecNT>(reinterpret_cast<const VecNT*>(buffer_.data()),
+                                       static_cast<size_t>(size()));
+    }
+
     /**
      * \brief Indexed point access
      * @param index Linear point index
@@ -156,6 +182,16 @@ protected:
         memcpy(dest, &buffer_[index * N], sizeof(T) * N);
     }
 
+    /**
+     * \brief Range access, a single copy of the contiguous elements
+     * @param dest Position to write to, expect write of (end - begin) * NumComponents many T
+     * @param begin First linear point index
+     * @param end Linear point index after the last one
+     */
+    virtual void fillRawRange(T* dest, ind begin, ind end) const override {
+        if (end > begin) memcpy(dest, &buffer_[begin * N], sizeof(T) * N * (end - begin));
+    }
+
     /**
      * \brief Vector containing the buffer data
      * Resizeable only by DataSet. Handle with care:
@@ -35,6 +35,10 @@
 #include <modules/discretedata/channels/channelgetter.h>
 #include <modules/discretedata/channels/channeliterator.h>
 
+#include <inviwo/core/util/assertion.h>
+
+#include <tcb/span.hpp>
+
 namespace inviwo {
 namespace discretedata {
 
@@ -47,6 +51,17 @@ public:
 
 protected:
     virtual void fillRaw(T* dest, ind index) const = 0;
+
+    /**
+     * \brief Copy the elements [begin, end) to dest, expect T[(end - begin) * NumComponents]
+     * Calls fillRaw per element by default, override where the range can be copied faster.
+     */
+    virtual void fillRawRange(T* dest, ind begin, ind end) const {
+        for (ind index = begin; index < end; ++index, dest += N) {
+            fillRaw(dest, index);
+        }
+    }
+
     virtual ChannelGetter<T, N>* newIterator() = 0;
 };
 
@@ -101,6 +116,22 @@ public:
         this->fillRaw(reinterpret_cast<T*>(&dest), index);
     }
 
+    /**
+     * \brief Range access, copy the data of the elements [begin, end)
+     * Only one virtual call for the whole range. Thread safe.
+     * @param dest Memory to write to, expect at least end - begin elements
+     * @param begin First linear point index
+     * @param end Linear point index after the last one
+     */
+    template <typename VecNT>
+    void fill(util::span<VecNT> dest, ind begin, ind end) const {
+        static_assert(sizeof(VecNT) == sizeof(T) * N,
+                      "Size and type do not agree with the vector type.");
+        IVW_ASSERT(begin >= 0 && begin <= end && end <= this->size(), "Range out of bounds.");
+        IVW_ASSERT(static_cast<ind>(dest.size()) >= end - begin, "Destination is too small.");
+        this->fillRawRange(reinterpret_cast<T*>(dest.data()), begin, end);
+    }
+
     template <typename VecNT>
     void operator()(VecNT& dest, ind index) const {
         fill(dest, index);
@@ -240,6 +271,7 @@ void DataChannel<T, N>::getMinMax(VecNT& minDest, VecNT& maxDest) const {
 template <typename T, ind N>
 void DataChannel<T, N>::computeMinMax() const {
     using Vec = std::array<T, N>;
+    constexpr ind chunkSize = 1024;
 
     Vec minT;
     Vec maxT;
@@ -247,10 +279,16 @@ void DataChannel<T, N>::computeMinMax() const {
     this->fill(minT, 0);
     this->fill(maxT, 0);
 
-    for (const Vec& val : this->all<Vec>()) {
-        for (ind dim = 0; dim < N; ++dim) {
-            minT[dim] = std::min(minT[dim], val[dim]);
-            maxT[dim] = std::max(maxT[dim], val[dim]);
+    const ind numElements = this->size();
+    std::vector<Vec> chunk(static_cast<size_t>(std::min(chunkSize, numElements)));
+    for (ind begin = 0; begin < numElements; begin += chunkSize) {
+        const ind end = std::min(begin + chunkSize, numElements);
+        this->fill(util::span<Vec>(chunk), begin, end);
+        for (ind i = 0; i < end - begin; ++i) {
+            for (ind dim = 0; dim < N; ++dim) {
+                minT[dim] = std::min(minT[dim], chunk[i][dim]);
+                maxT[dim] = std::max(maxT[dim], chunk[i][dim]);
+            }
         }
     }
 
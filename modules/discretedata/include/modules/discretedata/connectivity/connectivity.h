@@ -36,6 +36,12 @@
 #include <modules/discretedata/connectivity/cell.h>
 #include <modules/discretedata/connectivity/elementiterator.h>
 
+#include <tcb/span.hpp>
+
+#include <map>
+#include <memory>
+#include <mutex>
+
 namespace inviwo {
 namespace discretedata {
 
@@ -64,6 +70,24 @@ namespace discretedata {
  */
 class IVW_MODULE_DISCRETEDATA_API Connectivity {
 public:
+    /**
+     * \brief All connections from one GridPrimitive type to another in compressed sparse rows
+     * The connections of element i are indices[offsets[i]] to indices[offsets[i+1]].
+     */
+    struct ConnectionTable {
+        //! Number of elements in the 'from' dimension
+        ind size() const { return static_cast<ind>(offsets.size()) - 1; }
+
+        //! Connections of the element at index
+        util::span<const ind> operator[](ind index) const {
+            return util::span<const ind>(indices.data() + offsets[index],
+                                         static_cast<size_t>(offsets[index + 1] - offsets[index]));
+        }
+
+        std::vector<ind> offsets;
+        std::vector<ind> indices;
+    };
+
     Connectivity(GridPrimitive gridDimension)
         : gridDimension_(gridDimension)
         , numGridPrimitives_(static_cast<ind>(gridDimension) + 1, -1) {
@@ -92,6 +116,28 @@ public:
     virtual void getConnections(std::vector<ind>& result, ind index, GridPrimitive from,
                                 GridPrimitive to, bool isPosition = false) const = 0;
 
+    /**
+     * \brief Get the connections from all elements of one dimension to another
+     * The table is built on first use by calling getConnections for every element and kept
+     * until the connectivity changes. Prefer this over getConnections when iterating over
+     * the neighborhoods of many elements. Thread safe.
+     * @param from Dimension the indices of the table live in, its size has to be known
+     * @param to Dimension the connected indices live in
+     */
+    const ConnectionTable& getConnectionTable(GridPrimitive from, GridPrimitive to) const;
+
+    /**
+     * \brief Get the map from one element to another from the cached connection table
+     * Same result as getConnections without the isPosition flag, without copying.
+     * @param index Index of element in dimension 'from'
+     * @param from Dimension the index lives in
+     * @param to Dimension the result lives in
+     */
+    util::span<const ind> getCachedConnections(ind index, GridPrimitive from,
+                                               GridPrimitive to) const {
+        return getConnectionTable(from, to)[index];
+    }
+
     /**
      * \brief Range of all elements to iterate over
      * @param dim Dimension to return the elements of
@@ -111,6 +157,10 @@ public:
      */
     virtual CellType getCellType(ElementIterator& element) const;
 
+protected:
+    //! Drop all cached connection tables, call when the connections change
+    void invalidateConnectionTables();
+
     // Attributes
 protected:
     //! Highest dimension of GridPrimitives
@@ -118,6 +168,11 @@ protected:
 
     //! Saves the known number of primitves
     mutable std::vector<ind> numGridPrimitives_;
+
+private:
+    mutable std::mutex connectionTableMutex_;
+    mutable std::map<std::pair<GridPrimitive, GridPrimitive>, std::unique_ptr<ConnectionTable>>
+        connectionTables_;
 };
 
 }  // namespace discretedata
@@ -55,7 +55,11 @@ public:
 
     bool isPeriodic(ind dim) const { return isDimPeriodic_[dim]; }
 
-    void setPeriodic(ind dim, bool periodic = true) { isDimPeriodic_[dim] = periodic; }
+    void setPeriodic(ind dim, bool periodic = true) {
+        if (isDimPeriodic_[dim] == periodic) return;
+        isDimPeriodic_[dim] = periodic;
+        invalidateConnectionTables();
+    }
 
     virtual void getConnections(std::vector<ind>& result, ind index, GridPrimitive from,
                                 GridPrimitive to, bool isPosition = false) const override;
@@ -43,6 +43,35 @@ ind Connectivity::getNumElements(GridPrimitive elementType) const {
     return numGridPrimitives_[(int)elementType];
 }
 
+const Connectivity::ConnectionTable& Connectivity::getConnectionTable(GridPrimitive from,
+                                                                     GridPrimitive to) const {
+    std::scoped_lock lock{connectionTableMutex_};
+    auto& table = connectionTables_[{from, to}];
+    if (table) return *table;
+
+    const ind numElements = getNumElements(from);
+    auto newTable = std::make_unique<ConnectionTable>();
+    newTable->offsets.reserve(numElements + 1);
+    newTable->offsets.push_back(0);
+
+    std::vector<ind> connections;
+    for (ind index = 0; index < numElements; ++index) {
+        connections.clear();
+        getConnections(connections, index, from, to);
+        newTable->indices.insert(newTable->indices.end(), connections.begin(), connections.end());
+        newTable->offsets.push_back(static_cast<ind>(newTable->indices.size()));
+    }
+    newTable->indices.shrink_to_fit();
+
+    table = std::move(newTable);
+    return *table;
+}
+
+void Connectivity::invalidateConnectionTables() {
+    std::scoped_lock lock{connectionTableMutex_};
+    connectionTables_.clear();
+}
+
 ElementRange Connectivity::all(GridPrimitive dim) const { return ElementRange(dim, this); }
 
 CellType Connectivity::getCellType(GridPrimitive dim, ind) const {
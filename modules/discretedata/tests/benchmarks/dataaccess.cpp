@@ -0,0 +1,275 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2021 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#ifdef _MSC_VER
+#pragma comment(linker, "/SUBSYSTEM:CONSOLE")
+#endif
+
+#include <modules/discretedata/channels/bufferchannel.h>
+#include <modules/discretedata/channels/analyticchannel.h>
+#include <modules/discretedata/connectivity/structuredgrid.h>
+#include <modules/discretedata/connectivity/periodicgrid.h>
+#include <modules/discretedata/connectivity/elementiterator.h>
+#include <modules/discretedata/connectivity/connectioniterator.h>
+
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <numeric>
+
+using namespace inviwo;
+using namespace discretedata;
+
+namespace {
+
+std::shared_ptr<BufferChannel<float, 3>> makeBuffer(ind numElements) {
+    std::vector<float> data(numElements * 3);
+    std::iota(data.begin(), data.end(), 0.0f);
+    return std::make_shared<BufferChannel<float, 3>>(std::move(data), "Buffer");
+}
+
+std::shared_ptr<AnalyticChannel<float, 3, vec3>> makeAnalytic(ind numElements) {
+    return std::make_shared<AnalyticChannel<float, 3, vec3>>(
+        [](vec3& data, ind idx) { data = vec3(static_cast<float>(idx), 1.0f, 2.0f); },
+        numElements, "Analytic");
+}
+
+std::shared_ptr<StructuredGrid> makeGrid(ind cellsPerDim, bool periodic) {
+    const std::vector<ind> size(3, cellsPerDim);
+    if (periodic) {
+        return std::make_shared<PeriodicGrid>(GridPrimitive::Volume, size,
+                                              std::vector<bool>{true, true, false});
+    }
+    return std::make_shared<StructuredGrid>(GridPrimitive::Volume, size);
+}
+
+constexpr ind chunkSize = 1024;
+
+void gridArgs(benchmark::internal::Benchmark* b) {
+    for (int64_t cellsPerDim : {16, 64}) {
+        for (int64_t periodic : {0, 1}) {
+            b->Args({cellsPerDim, periodic});
+        }
+    }
+    b->ArgNames({"cells", "periodic"});
+}
+
+}  // namespace
+
+static void BufferFillPerElement(benchmark::State& state) {
+    const auto channel = makeBuffer(state.range(0));
+    const DataChannel<float, 3>& data = *channel;
+    for (auto _ : state) {
+        vec3 sum{0.0f};
+        vec3 value;
+        for (ind i = 0; i < data.size(); ++i) {
+            data.fill(value, i);
+            sum += value;
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+static void BufferConstIterator(benchmark::State& state) {
+    const auto channel = makeBuffer(state.range(0));
+    const DataChannel<float, 3>& data = *channel;
+    for (auto _ : state) {
+        vec3 sum{0.0f};
+        for (const vec3& value : data.all<vec3>()) sum += value;
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+static void BufferFillRange(benchmark::State& state) {
+    const auto channel = makeBuffer(state.range(0));
+    const DataChannel<float, 3>& data = *channel;
+    std::vector<vec3> chunk(chunkSize);
+    for (auto _ : state) {
+        vec3 sum{0.0f};
+        for (ind begin = 0; begin < data.size(); begin += chunkSize) {
+            const ind end = std::min(begin + chunkSize, data.size());
+            data.fill(util::span<vec3>(chunk), begin, end);
+            for (ind i = 0; i < end - begin; ++i) sum += chunk[i];
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+static void BufferView(benchmark::State& state) {
+    const auto channel = makeBuffer(state.range(0));
+    for (auto _ : state) {
+        vec3 sum{0.0f};
+        for (const vec3& value : channel->view<vec3>()) sum += value;
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+static void AnalyticFillPerElement(benchmark::State& state) {
+    const auto channel = makeAnalytic(state.range(0));
+    const DataChannel<float, 3>& data = *channel;
+    for (auto _ : state) {
+        vec3 sum{0.0f};
+        vec3 value;
+        for (ind i = 0; i < data.size(); ++i) {
+            data.fill(value, i);
+            sum += value;
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+static void AnalyticFillRange(benchmark::State& state) {
+    const auto channel = makeAnalytic(state.range(0));
+    const DataChannel<float, 3>& data = *channel;
+    std::vector<vec3> chunk(chunkSize);
+    for (auto _ : state) {
+        vec3 sum{0.0f};
+        for (ind begin = 0; begin < data.size(); begin += chunkSize) {
+            const ind end = std::min(begin + chunkSize, data.size());
+            data.fill(util::span<vec3>(chunk), begin, end);
+            for (ind i = 0; i < end - begin; ++i) sum += chunk[i];
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+static void CellNeighborhoodRange(benchmark::State& state) {
+    const auto grid = makeGrid(state.range(0), state.range(1) != 0);
+    const ind numCells = grid->getNumElements(GridPrimitive::Volume);
+    for (auto _ : state) {
+        ind sum = 0;
+        for (auto cell : grid->all(GridPrimitive::Volume)) {
+            for (auto vert : cell.connection(GridPrimitive::Vertex)) sum += vert.getIndex();
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(state.iterations() * numCells);
+}
+
+static void CellNeighborhoodGetConnections(benchmark::State& state) {
+    const auto grid = makeGrid(state.range(0), state.range(1) != 0);
+    const ind numCells = grid->getNumElements(GridPrimitive::Volume);
+    std::vector<ind> connections;
+    for (auto _ : state) {
+        ind sum = 0;
+        for (ind cell = 0; cell < numCells; ++cell) {
+            connections.clear();
+            grid->getConnections(connections, cell, GridPrimitive::Volume, GridPrimitive::Vertex);
+            for (ind vert : connections) sum += vert;
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(state.iterations() * numCells);
+}
+
+static void CellNeighborhoodTable(benchmark::State& state) {
+    const auto grid = makeGrid(state.range(0), state.range(1) != 0);
+    const ind numCells = grid->getNumElements(GridPrimitive::Volume);
+    // Build the table outside of the timing, it is cached in the grid
+    grid->getConnectionTable(GridPrimitive::Volume, GridPrimitive::Vertex);
+    for (auto _ : state) {
+        const auto& table = grid->getConnectionTable(GridPrimitive::Volume, GridPrimitive::Vertex);
+        ind sum = 0;
+        for (ind cell = 0; cell < numCells; ++cell) {
+            for (ind vert : table[cell]) sum += vert;
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(state.iterations() * numCells);
+}
+
+static void VertexNeighborhoodGetConnections(benchmark::State& state) {
+    const auto grid = makeGrid(state.range(0), state.range(1) != 0);
+    const ind numVerts = grid->getNumElements(GridPrimitive::Vertex);
+    std::vector<ind> connections;
+    for (auto _ : state) {
+        ind sum = 0;
+        for (ind vert = 0; vert < numVerts; ++vert) {
+            connections.clear();
+            grid->getConnections(connections, vert, GridPrimitive::Vertex, GridPrimitive::Vertex);
+            for (ind neighbor : connections) sum += neighbor;
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(state.iterations() * numVerts);
+}
+
+static void VertexNeighborhoodTable(benchmark::State& state) {
+    const auto grid = makeGrid(state.range(0), state.range(1) != 0);
+    const ind numVerts = grid->getNumElements(GridPrimitive::Vertex);
+    grid->getConnectionTable(GridPrimitive::Vertex, GridPrimitive::Vertex);
+    for (auto _ : state) {
+        const auto& table = grid->getConnectionTable(GridPrimitive::Vertex, GridPrimitive::Vertex);
+        ind sum = 0;
+        for (ind vert = 0; vert < numVerts; ++vert) {
+            for (ind neighbor : table[vert]) sum += neighbor;
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(state.iterations() * numVerts);
+}
+
+static void BuildConnectionTable(benchmark::State& state) {
+    for (auto _ : state) {
+        const auto grid = makeGrid(state.range(0), state.range(1) != 0);
+        benchmark::DoNotOptimize(
+            grid->getConnectionTable(GridPrimitive::Volume, GridPrimitive::Vertex).size());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0) * state.range(0) *
+                            state.range(0));
+}
+
+BENCHMARK(BufferFillPerElement)->RangeMultiplier(10)->Range(1000, 1000000);
+BENCHMARK(BufferConstIterator)->RangeMultiplier(10)->Range(1000, 1000000);
+BENCHMARK(BufferFillRange)->RangeMultiplier(10)->Range(1000, 1000000);
+BENCHMARK(BufferView)->RangeMultiplier(10)->Range(1000, 1000000);
+
+BENCHMARK(AnalyticFillPerElement)->RangeMultiplier(10)->Range(1000, 1000000);
+BENCHMARK(AnalyticFillRange)->RangeMultiplier(10)->Range(1000, 1000000);
+
+BENCHMARK(CellNeighborhoodRange)->Apply(gridArgs);
+BENCHMARK(CellNeighborhoodGetConnections)->Apply(gridArgs);
+BENCHMARK(CellNeighborhoodTable)->Apply(gridArgs);
+
+BENCHMARK(VertexNeighborhoodGetConnections)->Apply(gridArgs);
+BENCHMARK(VertexNeighborhoodTable)->Apply(gridArgs);
+
+BENCHMARK(BuildConnectionTable)->Apply(gridArgs);
+
+int main(int argc, char** argv) {
+    benchmark::Initialize(&argc, argv);
+    benchmark::RunSpecifiedBenchmarks();
+    return 0;
+}
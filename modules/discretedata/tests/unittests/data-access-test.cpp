@@ -39,6 +39,7 @@
 #include <modules/discretedata/connectivity/elementiterator.h>
 #include <modules/discretedata/connectivity/connectioniterator.h>
 #include <modules/discretedata/connectivity/structuredgrid.h>
+#include <modules/discretedata/connectivity/periodicgrid.h>
 
 namespace inviwo {
 namespace discretedata {
@@ -73,5 +74,74 @@ TEST(AccessingData, Connectivity) {
     EXPECT_TRUE(allFine && "Connectivity is not bi-directional.");
 }
 
+TEST(AccessingData, RangeFill) {
+    const ind numElements = 1000;
+    std::vector<float> raw(numElements * 3);
+    for (size_t i = 0; i < raw.size(); ++i) raw[i] = 0.5f * i;
+
+    BufferChannel<float, 3> buffer(raw, "Buffer");
+    AnalyticChannel<float, 3, glm::vec3> analytic(
+        [](glm::vec3& data, ind idx) { data = glm::vec3(1.5f * idx, 1.5f * idx + 0.5f, 1.0f); },
+        numElements, "Analytic");
+
+    auto view = buffer.view<glm::vec3>();
+    ASSERT_EQ(view.size(), static_cast<size_t>(numElements));
+
+    std::vector<glm::vec3> bufferRange(300);
+    std::vector<glm::vec3> analyticRange(300);
+    buffer.fill(util::span<glm::vec3>(bufferRange), 650, 950);
+    analytic.fill(util::span<glm::vec3>(analyticRange), 650, 950);
+
+    for (ind i = 0; i < 300; ++i) {
+        glm::vec3 bufferValue, analyticValue;
+        buffer.fill(bufferValue, 650 + i);
+        analytic.fill(analyticValue, 650 + i);
+        EXPECT_EQ(bufferRange[i], bufferValue);
+        EXPECT_EQ(bufferRange[i], view[650 + i]);
+        EXPECT_EQ(analyticRange[i], analyticValue);
+        EXPECT_EQ(bufferRange[i].x, analyticRange[i].x);
+    }
+
+    glm::vec3 min, max;
+    analytic.getMinMax(min, max);
+    EXPECT_EQ(min, glm::vec3(0.0f, 0.5f, 1.0f));
+    EXPECT_EQ(max, glm::vec3(1.5f * (numElements - 1), 1.5f * (numElements - 1) + 0.5f, 1.0f));
+}
+
+TEST(AccessingData, ConnectionTable) {
+    std::vector<ind> size = {4, 5, 6};
+    auto structured = std::make_shared<StructuredGrid>(GridPrimitive::Volume, size);
+    auto periodic = std::make_shared<PeriodicGrid>(GridPrimitive::Volume, size,
+                                                   std::vector<bool>{true, false, false});
+
+    const auto compare = [](const Connectivity& grid, GridPrimitive from, GridPrimitive to) {
+        const auto& table = grid.getConnectionTable(from, to);
+        ASSERT_EQ(table.size(), grid.getNumElements(from));
+
+        std::vector<ind> connections;
+        for (ind idx = 0; idx < table.size(); ++idx) {
+            connections.clear();
+            grid.getConnections(connections, idx, from, to);
+            auto cached = grid.getCachedConnections(idx, from, to);
+            ASSERT_EQ(cached.size(), connections.size());
+            EXPECT_TRUE(std::equal(cached.begin(), cached.end(), connections.begin()));
+        }
+    };
+
+    for (const Connectivity* grid : {static_cast<const Connectivity*>(structured.get()),
+                                     static_cast<const Connectivity*>(periodic.get())}) {
+        compare(*grid, GridPrimitive::Volume, GridPrimitive::Vertex);
+        compare(*grid, GridPrimitive::Vertex, GridPrimitive::Volume);
+        compare(*grid, GridPrimitive::Vertex, GridPrimitive::Vertex);
+        compare(*grid, GridPrimitive::Volume, GridPrimitive::Volume);
+    }
+
+    // Changing the periodicity has to rebuild the cached connections.
+    periodic->setPeriodic(0, false);
+    periodic->setPeriodic(2, true);
+    compare(*periodic, GridPrimitive::Vertex, GridPrimitive::Vertex);
+    compare(*periodic, GridPrimitive::Volume, GridPrimitive::Volume);
+}
+
 }  // namespace discretedata
 }  // namespace inviwo
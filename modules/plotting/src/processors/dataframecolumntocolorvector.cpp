@@ -28,6 +28,7 @@
  *********************************************************************************/
 
 #include <modules/plotting/processors/dataframecolumntocolorvector.h>
+#include <inviwo/core/datastructures/tflookuptable.h>
 
 namespace inviwo {
 
@@ -75,8 +76,10 @@ void DataFrameColumnToColorVector::process() {
                     double maxV = static_cast<double>(*minMax.second);
                     const double range = (maxV - minV);
 
+                    const TFLookupTable tf(tf_.get());
+                    colors->reserve(vec.size());
                     for (const auto& v : vec) {
-                        colors->push_back(tf_.get().sample((v - minV) / range));
+                        colors->push_back(tf.sample((v - minV) / range));
                     }
 
                     return colors;
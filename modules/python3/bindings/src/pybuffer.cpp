@@ -68,7 +68,8 @@ struct BufferRAMHelper {
                      pyutil::checkDataFormat<1>(DataFormat::get(), data.shape(0), data);
                      auto ram = std::make_shared<BufferRAMPrecision<T, BufferTarget::Data>>(
                          data.shape(0), usage);
-                     memcpy(ram->getData(), data.data(0), data.nbytes());
+                     const auto src = pyutil::ensureContiguous(data);
+                     std::memcpy(ram->getData(), src.data(), src.nbytes());
                      return new Buffer<T, BufferTarget::Data>(ram);
                  }),
                  py::arg("data"), py::arg("usage") = BufferUsage::Static);
@@ -82,7 +83,8 @@ struct BufferRAMHelper {
                      pyutil::checkDataFormat<1>(DataFormat::get(), data.shape(0), data);
                      auto ram = std::make_shared<BufferRAMPrecision<T, BufferTarget::Index>>(
                          data.shape(0), usage);
-                     memcpy(ram->getData(), data.data(0), data.nbytes());
+                     const auto src = pyutil::ensureContiguous(data);
+                     std::memcpy(ram->getData(), src.data(), src.nbytes());
                      return new Buffer<T, BufferTarget::Index>(ram);
                  }),
                  py::arg("data"), py::arg("usage") = BufferUsage::Static);
@@ -132,7 +134,8 @@ void exposeBuffer(pybind11::module& m) {
         .def_property("size", &BufferBase::getSize, &BufferBase::setSize)
         .def_property(
             "data",
-            [&](BufferBase* buffer) -> py::array {
+            [](py::object self) -> py::array {
+                auto buffer = self.cast<BufferBase*>();
                 auto df = buffer->getDataFormat();
                 std::vector<size_t> shape = {buffer->getSize()};
                 std::vector<size_t> strides = {df->getSize()};
@@ -142,14 +145,18 @@ void exposeBuffer(pybind11::module& m) {
                     strides.push_back(df->getSize() / df->getComponents());
                 }
 
+                // The array is a view of the RAM representation and keeps the buffer alive
                 auto data = buffer->getEditableRepresentation<BufferRAM>()->getData();
-                return py::array(pyutil::toNumPyFormat(df), shape, strides, data, py::cast<>(1));
+                return py::array(pyutil::toNumPyFormat(df), shape, strides, data, self);
             },
             [](BufferBase* buffer, py::array data) {
                 auto rep = buffer->getEditableRepresentation<BufferRAM>();
                 pyutil::checkDataFormat<1>(rep->getDataFormat(), rep->getSize(), data);
 
-                memcpy(rep->getData(), data.data(0), data.nbytes());
+                const auto src = pyutil::ensureContiguous(data);
+                if (src.data() != rep->getData()) {
+                    std::memcpy(rep->getData(), src.data(), src.nbytes());
+                }
             })
         .def("__repr__", [](const BufferBase& self) {
             return fmt::format("<Buffer: target = {} usage = {} format = {} size = {}>",
@@ -140,7 +140,10 @@ void exposeImage(py::module& m) {
         .def(py::init<size2_t, const DataFormatBase*, LayerType, const SwizzleMask&,
                       InterpolationType, const Wrapping2D&>())
         .def("clone", [](Layer& self) { return self.clone(); })
-        .def(py::init([](py::array data) { return pyutil::createLayer(data).release(); }))
+        .def(py::init([](py::array data, bool copy) {
+                 return pyutil::createLayer(data, copy).release();
+             }),
+             py::arg("data"), py::arg("copy") = true)
         .def("setDimensions", &Layer::setDimensions)
         .def_property_readonly("dimensions", &Layer::getDimensions)
         .def_property("swizzlemask", &Layer::getSwizzleMask, &Layer::setSwizzleMask)
@@ -158,7 +161,8 @@ void exposeImage(py::module& m) {
              })
         .def_property(
             "data",
-            [&](Layer* layer) -> py::array {
+            [](py::object self) -> py::array {
+                auto layer = self.cast<Layer*>();
                 auto df = layer->getDataFormat();
                 auto dims = layer->getDimensions();
 
@@ -170,14 +174,18 @@ void exposeImage(py::module& m) {
                     strides.push_back(df->getSize() / df->getComponents());
                 }
 
+                // The array is a view of the RAM representation and keeps the layer alive
                 auto data = layer->getEditableRepresentation<LayerRAM>()->getData();
-                return py::array(pyutil::toNumPyFormat(df), shape, strides, data, py::cast<>(1));
+                return py::array(pyutil::toNumPyFormat(df), shape, strides, data, self);
             },
             [](Layer* layer, py::array data) {
                 auto rep = layer->getEditableRepresentation<LayerRAM>();
                 pyutil::checkDataFormat<2>(rep->getDataFormat(), rep->getDimensions(), data);
 
-                memcpy(rep->getData(), data.data(0), data.nbytes());
+                const auto src = pyutil::ensureContiguous(data);
+                if (src.data() != rep->getData()) {
+                    std::memcpy(rep->getData(), src.data(), src.nbytes());
+                }
             })
         .def("__repr__", [](const Layer& self) {
             return fmt::format(
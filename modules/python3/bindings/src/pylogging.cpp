@@ -80,6 +80,8 @@ void exposeLogging(pybind11::module& m) {
         .def_property("logStacktrace", &LogCentral::getLogStacktrace, &LogCentral::setLogStacktrace)
         .def_property("messageBreakLevel", &LogCentral::getMessageBreakLevel,
                       &LogCentral::setMessageBreakLevel)
+        .def_property("asynchronous", &LogCentral::isAsynchronous, &LogCentral::setAsynchronous)
+        .def("flush", &LogCentral::flush)
         .def_static("get", &LogCentral::getPtr, py::return_value_policy::reference);
 
     py::class_<ConsoleLogger, Logger, std::shared_ptr<ConsoleLogger>>(m, "ConsoleLogger")
@@ -35,12 +35,16 @@
 #include <inviwo/core/network/portconnection.h>
 #include <inviwo/core/links/propertylink.h>
 #include <inviwo/core/network/processornetwork.h>
+#include <inviwo/core/network/processornetworkevaluator.h>
 #include <inviwo/core/ports/port.h>
 #include <inviwo/core/ports/inport.h>
 #include <inviwo/core/common/inviwoapplication.h>
+#include <inviwo/core/util/evaluationtrace.h>
 
 #include <inviwopy/vectoridentifierwrapper.h>
 
+#include <sstream>
+
 namespace py = pybind11;
 
 namespace inviwo {
@@ -60,6 +64,47 @@ void exposeNetwork(py::module& m) {
         .def_property_readonly("destination", &PropertyLink::getDestination,
                                py::return_value_policy::reference);
 
+    py::enum_<TraceEventType>(m, "TraceEventType")
+        .value("Evaluation", TraceEventType::Evaluation)
+        .value("InitializeResources", TraceEventType::InitializeResources)
+        .value("InportOnChange", TraceEventType::InportOnChange)
+        .value("Process", TraceEventType::Process)
+        .value("BackgroundJob", TraceEventType::BackgroundJob);
+
+    using seconds = std::chrono::duration<double>;
+    py::class_<TraceEvent>(m, "TraceEvent")
+        .def_readonly("type", &TraceEvent::type)
+        .def_readonly("name", &TraceEvent::name)
+        .def_property_readonly(
+            "start",
+            [](const TraceEvent& e) { return seconds(e.start.time_since_epoch()).count(); },
+            "Start time in seconds of a monotonic clock")
+        .def_property_readonly(
+            "duration", [](const TraceEvent& e) { return seconds(e.duration).count(); },
+            "Duration in seconds")
+        .def_readonly("thread", &TraceEvent::thread)
+        .def_readonly("conversions", &TraceEvent::conversions)
+        .def_readonly("bytes", &TraceEvent::bytes)
+        .def("__repr__", [](const TraceEvent& e) {
+            std::ostringstream oss;
+            oss << "<TraceEvent: " << e.type << " " << e.name << " "
+                << seconds(e.duration).count() * 1000.0 << "ms>";
+            return oss.str();
+        });
+
+    py::class_<EvaluationTrace, std::shared_ptr<EvaluationTrace>>(m, "EvaluationTrace")
+        .def_property("enabled", &EvaluationTrace::isEnabled, &EvaluationTrace::setEnabled)
+        .def_property("capacity", &EvaluationTrace::getCapacity, &EvaluationTrace::setCapacity)
+        .def_property_readonly("events", &EvaluationTrace::getEvents)
+        .def("__len__", &EvaluationTrace::size)
+        .def("clear", &EvaluationTrace::clear)
+        .def(
+            "writeChromeTrace",
+            [](const EvaluationTrace& trace, std::string_view filename) {
+                trace.writeChromeTrace(filename);
+            },
+            py::arg("filename"));
+
     py::class_<ProcessorNetwork>(m, "ProcessorNetwork")
         .def_property_readonly("processors", &ProcessorNetwork::getProcessors,
                                py::return_value_policy::reference)
@@ -137,6 +182,12 @@ void exposeNetwork(py::module& m) {
         .def_property_readonly("invalidating", &ProcessorNetwork::isInvalidating)
         .def_property_readonly("linking", &ProcessorNetwork::isLinking)
         .def_property_readonly("runningBackgroundJobs", &ProcessorNetwork::runningBackgroundJobs)
+        .def_property_readonly(
+            "evaluationTrace",
+            [](ProcessorNetwork* pn) {
+                return pn->getApplication()->getProcessorNetworkEvaluator()->getTrace();
+            },
+            "The timings of the evaluations of the network, see EvaluationTrace")
         .def("lock", &ProcessorNetwork::lock)
         .def("unlock", &ProcessorNetwork::unlock)
         .def("isLocked", &ProcessorNetwork::islocked)
@@ -59,7 +59,10 @@ void exposeVolume(pybind11::module& m) {
         .def(py::init<size3_t, const DataFormatBase*>())
         .def(py::init<size3_t, const DataFormatBase*, const SwizzleMask&, InterpolationType,
                       const Wrapping3D&>())
-        .def(py::init([](py::array data) { return pyutil::createVolume(data).release(); }))
+        .def(py::init([](py::array data, bool copy) {
+                 return pyutil::createVolume(data, copy).release();
+             }),
+             py::arg("data"), py::arg("copy") = true)
         .def("clone", [](Volume& self) { return self.clone(); })
         .def_property("modelMatrix", &Volume::getModelMatrix, &Volume::setModelMatrix)
         .def_property("worldMatrix", &Volume::getWorldMatrix, &Volume::setWorldMatrix)
@@ -74,7 +77,8 @@ void exposeVolume(pybind11::module& m) {
         .def_readwrite("dataMap", &Volume::dataMap_)
         .def_property(
             "data",
-            [&](Volume* volume) -> py::array {
+            [](py::object self) -> py::array {
+                auto volume = self.cast<Volume*>();
                 auto df = volume->getDataFormat();
                 auto dims = volume->getDimensions();
 
@@ -87,14 +91,18 @@ void exposeVolume(pybind11::module& m) {
                     strides.push_back(df->getSize() / df->getComponents());
                 }
 
+                // The array is a view of the RAM representation and keeps the volume alive
                 auto data = volume->getEditableRepresentation<VolumeRAM>()->getData();
-                return py::array(pyutil::toNumPyFormat(df), shape, strides, data, py::cast<>(1));
+                return py::array(pyutil::toNumPyFormat(df), shape, strides, data, self);
             },
             [](Volume* volume, py::array data) {
                 auto rep = volume->getEditableRepresentation<VolumeRAM>();
                 pyutil::checkDataFormat<3>(rep->getDataFormat(), rep->getDimensions(), data);
 
-                memcpy(rep->getData(), data.data(0), data.nbytes());
+                const auto src = pyutil::ensureContiguous(data);
+                if (src.data() != rep->getData()) {
+                    std::memcpy(rep->getData(), src.data(), src.nbytes());
+                }
             })
         .def("__repr__", [](const Volume& volume) {
             std::ostringstream oss;
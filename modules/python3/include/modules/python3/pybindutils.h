@@ -54,9 +54,38 @@ namespace pyutil {
 
 IVW_MODULE_PYTHON3_API pybind11::dtype toNumPyFormat(const DataFormatBase* df);
 IVW_MODULE_PYTHON3_API const DataFormatBase* getDataFormat(size_t components, pybind11::array& arr);
+
+/**
+ * Returns @p arr if it is either C or Fortran contiguous, otherwise a C contiguous copy of it.
+ */
+IVW_MODULE_PYTHON3_API pybind11::array ensureContiguous(const pybind11::array& arr);
+
+/**
+ * Create a Buffer from a NumPy array. The data is always copied since BufferRAMPrecision keeps
+ * its data in a std::vector.
+ */
 IVW_MODULE_PYTHON3_API std::unique_ptr<BufferBase> createBuffer(pybind11::array& arr);
-IVW_MODULE_PYTHON3_API std::unique_ptr<Layer> createLayer(pybind11::array& arr);
-IVW_MODULE_PYTHON3_API std::unique_ptr<Volume> createVolume(pybind11::array& arr);
+
+/**
+ * Create a Layer from a NumPy array of shape (x, y) or (x, y, components). The data is interpreted
+ * in memory order, non-contiguous arrays are first made C contiguous.
+ * @param arr the data
+ * @param copy if false and @p arr is contiguous, writeable and aligned, the LayerRAM will use the
+ * memory of @p arr directly and keep a reference to it. Changes to the array will be visible in
+ * the layer and vice versa. Otherwise the data is copied.
+ */
+IVW_MODULE_PYTHON3_API std::unique_ptr<Layer> createLayer(pybind11::array& arr, bool copy = true);
+
+/**
+ * Create a Volume from a NumPy array of shape (x, y, z) or (x, y, z, components). The data is
+ * interpreted in memory order, non-contiguous arrays are first made C contiguous.
+ * @param arr the data
+ * @param copy if false and @p arr is contiguous, writeable and aligned, the VolumeRAM will use the
+ * memory of @p arr directly and keep a reference to it. Changes to the array will be visible in
+ * the volume and vice versa. Otherwise the data is copied.
+ */
+IVW_MODULE_PYTHON3_API std::unique_ptr<Volume> createVolume(pybind11::array& arr,
+                                                            bool copy = true);
 
 template <int Dim>
 void checkDataFormat(const DataFormatBase* format, const Vector<Dim, size_t>& dim,
@@ -48,6 +48,9 @@
 
 #include <inviwo/core/util/stdextensions.h>
 
+#include <cstdint>
+#include <cstring>
+
 namespace inviwo {
 
 namespace pyutil {
@@ -90,14 +93,82 @@ const DataFormatBase* getDataFormat(size_t components, pybind11::array& arr) {
     return format;
 }
 
+namespace {
+
+void releaseArray(pybind11::array& arr) {
+    if (!arr) return;
+    if (Py_IsInitialized()) {
+        // The representation might be destroyed from any thread
+        pybind11::gil_scoped_acquire gil;
+        arr = pybind11::array{};
+    } else {
+        // The interpreter is gone, and so is the memory, nothing left to decrement
+        arr.release();
+    }
+}
+
+bool isContiguous(const pybind11::array& arr) {
+    return (arr.flags() & (pybind11::array::c_style | pybind11::array::f_style)) != 0;
+}
+
+template <typename T>
+bool canAdopt(const pybind11::array& arr) {
+    return isContiguous(arr) && arr.writeable() &&
+           reinterpret_cast<std::uintptr_t>(arr.data()) % alignof(T) == 0;
+}
+
+/**
+ * A VolumeRAM that uses the memory of a NumPy array as storage. The data is not owned by the
+ * VolumeRAMPrecision but kept alive by holding a reference to the array. Clones are regular
+ * VolumeRAMPrecisions with a copy of the data.
+ */
+template <typename T>
+class NumPyVolumeRAM : public VolumeRAMPrecision<T> {
+public:
+    NumPyVolumeRAM(pybind11::array array, size3_t dimensions)
+        : VolumeRAMPrecision<T>(static_cast<T*>(array.mutable_data()), dimensions)
+        , array_{std::move(array)} {
+        this->removeDataOwnership();
+    }
+    virtual ~NumPyVolumeRAM() { releaseArray(array_); }
+
+private:
+    pybind11::array array_;
+};
+
+/**
+ * A LayerRAM that uses the memory of a NumPy array as storage, see NumPyVolumeRAM.
+ */
+template <typename T>
+class NumPyLayerRAM : public LayerRAMPrecision<T> {
+public:
+    NumPyLayerRAM(pybind11::array array, size2_t dimensions)
+        : LayerRAMPrecision<T>(static_cast<T*>(array.mutable_data()), dimensions)
+        , array_{std::move(array)} {
+        this->removeDataOwnership();
+    }
+    virtual ~NumPyLayerRAM() { releaseArray(array_); }
+
+private:
+    pybind11::array array_;
+};
+
+}  // namespace
+
+pybind11::array ensureContiguous(const pybind11::array& arr) {
+    if (isContiguous(arr)) return arr;
+    return pybind11::array::ensure(arr, pybind11::array::c_style);
+}
+
 struct BufferFromArrayDispatcher {
     using type = std::unique_ptr<BufferBase>;
 
     template <typename Result, typename T>
     std::unique_ptr<BufferBase> operator()(pybind11::array& arr) {
         using Type = typename T::type;
-        auto buf = std::make_unique<Buffer<Type>>(arr.shape(0));
-        memcpy(buf->getEditableRAMRepresentation()->getData(), arr.data(0), arr.nbytes());
+        const auto src = ensureContiguous(arr);
+        auto buf = std::make_unique<Buffer<Type>>(src.shape(0));
+        std::memcpy(buf->getEditableRAMRepresentation()->getData(), src.data(), src.nbytes());
         return buf;
     }
 };
@@ -106,11 +177,15 @@ struct LayerFromArrayDispatcher {
     using type = std::unique_ptr<Layer>;
 
     template <typename Result, typename T>
-    std::unique_ptr<Layer> operator()(pybind11::array& arr) {
+    std::unique_ptr<Layer> operator()(pybind11::array& arr, bool copy) {
         using Type = typename T::type;
         size2_t dims(arr.shape(0), arr.shape(1));
+        if (!copy && canAdopt<Type>(arr)) {
+            return std::make_unique<Layer>(std::make_shared<NumPyLayerRAM<Type>>(arr, dims));
+        }
+        const auto src = ensureContiguous(arr);
         auto layerRAM = std::make_shared<LayerRAMPrecision<Type>>(dims);
-        memcpy(layerRAM->getData(), arr.data(0), arr.nbytes());
+        std::memcpy(layerRAM->getData(), src.data(), src.nbytes());
         return std::make_unique<Layer>(layerRAM);
     }
 };
@@ -119,11 +194,15 @@ struct VolumeFromArrayDispatcher {
     using type = std::unique_ptr<Volume>;
 
     template <typename Result, typename T>
-    std::unique_ptr<Volume> operator()(pybind11::array& arr) {
+    std::unique_ptr<Volume> operator()(pybind11::array& arr, bool copy) {
         using Type = typename T::type;
         size3_t dims(arr.shape(0), arr.shape(1), arr.shape(2));
+        if (!copy && canAdopt<Type>(arr)) {
+            return std::make_unique<Volume>(std::make_shared<NumPyVolumeRAM<Type>>(arr, dims));
+        }
+        const auto src = ensureContiguous(arr);
         auto volumeRAM = std::make_shared<VolumeRAMPrecision<Type>>(dims);
-        memcpy(volumeRAM->getData(), arr.data(0), arr.nbytes());
+        std::memcpy(volumeRAM->getData(), src.data(), src.nbytes());
         return std::make_unique<Volume>(volumeRAM);
     }
 };
@@ -137,22 +216,22 @@ std::unique_ptr<BufferBase> createBuffer(pybind11::array& arr) {
         df->getId(), dispatcher, arr);
 }
 
-std::unique_ptr<Layer> createLayer(pybind11::array& arr) {
+std::unique_ptr<Layer> createLayer(pybind11::array& arr, bool copy) {
     auto ndim = arr.ndim();
     ivwAssert(ndim == 2 || ndim == 3, "Ndims must be either 2 or 3");
     auto df = pyutil::getDataFormat(ndim == 2 ? 1 : arr.shape(2), arr);
     LayerFromArrayDispatcher dispatcher;
-    return dispatching::dispatch<std::unique_ptr<Layer>, dispatching::filter::All>(df->getId(),
-                                                                                   dispatcher, arr);
+    return dispatching::dispatch<std::unique_ptr<Layer>, dispatching::filter::All>(
+        df->getId(), dispatcher, arr, copy);
 }
 
-std::unique_ptr<Volume> createVolume(pybind11::array& arr) {
+std::unique_ptr<Volume> createVolume(pybind11::array& arr, bool copy) {
     auto ndim = arr.ndim();
     ivwAssert(ndim == 3 || ndim == 4, "Ndims must be either 3 or 4");
     auto df = pyutil::getDataFormat(ndim == 3 ? 1 : arr.shape(3), arr);
     VolumeFromArrayDispatcher dispatcher;
     return dispatching::dispatch<std::unique_ptr<Volume>, dispatching::filter::All>(
-        df->getId(), dispatcher, arr);
+        df->getId(), dispatcher, arr, copy);
 }
 
 }  // namespace pyutil
@@ -57,6 +57,8 @@
 
 #include <glm/gtc/epsilon.hpp>
 
+#include <cstdint>
+
 namespace inviwo {
 
 namespace {
@@ -96,6 +98,57 @@ TEST(Python3Scripts, SimpleBufferTest) {
     EXPECT_TRUE(status);
 }
 
+TEST(Python3Scripts, ZeroCopyVolumeTest) {
+    PythonScript s;
+    s.setSource(
+        "import numpy as np\n"
+        "a = np.arange(24, dtype=np.float32).reshape((2, 3, 4))\n"
+        "b = np.arange(48, dtype=np.float32).reshape((2, 3, 8))[:, :, ::2]\n");
+    bool status = false;
+    s.run([&](pybind11::dict dict) {
+        auto a = pybind11::cast<pybind11::array>(dict["a"]);
+        auto adopted = pyutil::createVolume(a, false);
+        auto copied = pyutil::createVolume(a);
+        EXPECT_EQ(a.data(), adopted->getRepresentation<VolumeRAM>()->getData());
+        EXPECT_NE(a.data(), copied->getRepresentation<VolumeRAM>()->getData());
+
+        static_cast<float*>(a.mutable_data())[5] = 42.0f;
+        EXPECT_EQ(42.0, adopted->getRepresentation<VolumeRAM>()->getAsDouble(size3_t{1, 2, 0}));
+        EXPECT_EQ(5.0, copied->getRepresentation<VolumeRAM>()->getAsDouble(size3_t{1, 2, 0}));
+
+        // Strided arrays can not be adopted, they are copied in C order
+        auto b = pybind11::cast<pybind11::array>(dict["b"]);
+        auto strided = pyutil::createVolume(b, false);
+        auto data = static_cast<const float*>(strided->getRepresentation<VolumeRAM>()->getData());
+        for (size_t i = 0; i < 24; ++i) {
+            EXPECT_EQ(static_cast<float>(2 * i), data[i]);
+        }
+        status = true;
+    });
+    EXPECT_TRUE(status);
+}
+
+TEST(Python3Scripts, ZeroCopyLayerTest) {
+    PythonScript s;
+    s.setSource(
+        "import numpy as np\n"
+        "a = np.asfortranarray(np.arange(12, dtype=np.uint16).reshape((4, 3)))\n");
+    bool status = false;
+    s.run([&](pybind11::dict dict) {
+        auto a = pybind11::cast<pybind11::array>(dict["a"]);
+        auto layer = pyutil::createLayer(a, false);
+        EXPECT_EQ(a.data(), layer->getRepresentation<LayerRAM>()->getData());
+
+        // Clones do not share memory with the array
+        std::unique_ptr<Layer> clone(layer->clone());
+        static_cast<std::uint16_t*>(a.mutable_data())[1] = 42;
+        EXPECT_EQ(42.0, layer->getRepresentation<LayerRAM>()->getAsDouble(size2_t{1, 0}));
+        EXPECT_EQ(3.0, clone->getRepresentation<LayerRAM>()->getAsDouble(size2_t{1, 0}));
+        status = true;
+    });
+    EXPECT_TRUE(status);
+}
+
 class DTypeTest : public ::testing::TestWithParam<std::string> {
 protected:
     virtual void SetUp() {}
@@ -273,6 +273,11 @@ void TFEditorView::updateHistogram() {
             } else if (!histCalculation_) {
                 histograms_.clear();
                 histCalculation_ = volume->calculateHistograms(2048);
+                histCalculation_->whenUpdated([this](const HistogramContainer& histograms, double) {
+                    updateHistogram(histograms);
+                    resetCachedContent();
+                    update();
+                });
                 histCalculation_->whenDone([this](const HistogramContainer& histograms) {
                     updateHistogram(histograms);
                     resetCachedContent();
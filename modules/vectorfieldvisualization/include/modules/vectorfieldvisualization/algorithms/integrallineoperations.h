@@ -32,6 +32,10 @@
 #include <modules/vectorfieldvisualization/vectorfieldvisualizationmoduledefine.h>
 #include <modules/vectorfieldvisualization/datastructures/integralline.h>
 #include <modules/vectorfieldvisualization/datastructures/integrallineset.h>
+#include <modules/vectorfieldvisualization/datastructures/packedintegrallineset.h>
+#include <inviwo/core/datastructures/geometry/mesh.h>
+
+#include <memory>
 
 namespace inviwo {
 
@@ -49,6 +53,25 @@ IVW_MODULE_VECTORFIELDVISUALIZATION_API IntegralLineSet tortuosity(const Integra
 
 IVW_MODULE_VECTORFIELDVISUALIZATION_API void tortuosity(IntegralLine& line, dmat4 toWorld);
 IVW_MODULE_VECTORFIELDVISUALIZATION_API void tortuosity(IntegralLineSet& lines);
+
+/**
+ * Create a line mesh from a packed integral line set. The position buffer of the set is used as the
+ * position buffer of the mesh without copying it, only the index buffers are created. Lines with
+ * less than two points are skipped.
+ *
+ * @param lines the lines to create a mesh of
+ * @param connectivity how the lines are represented in the mesh:
+ *   * ConnectivityType::None one index buffer with DrawType::Lines and two indices per segment
+ *   * ConnectivityType::Adjacency like None but with the neighboring points of each segment,
+ *     i.e. four indices per segment, the first and last points of each line are repeated
+ *   * ConnectivityType::Strip one line strip index buffer per line
+ *   * ConnectivityType::StripAdjacency one line strip index buffer per line where the first and
+ *     last indices are repeated, as created by the IntegralLineVectorToMesh processor
+ * @throw Exception for any other connectivity
+ */
+IVW_MODULE_VECTORFIELDVISUALIZATION_API std::shared_ptr<Mesh> toMesh(
+    const PackedIntegralLineSet& lines,
+    ConnectivityType connectivity = ConnectivityType::Adjacency);
 }  // namespace util
 
 }  // namespace inviwo
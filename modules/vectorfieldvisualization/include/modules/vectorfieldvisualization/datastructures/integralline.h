@@ -66,6 +66,12 @@ public:
 
     void reverse();
 
+    /**
+     * Remove all positions and meta data values, the meta data channels are kept. Allocated memory
+     * is retained to make it cheap to reuse the line when tracing many lines.
+     */
+    void clear();
+
     template <typename T>
     const std::vector<T>& getMetaData(const std::string& name) const;
 
@@ -0,0 +1,203 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2021 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#pragma once
+
+#include <modules/vectorfieldvisualization/vectorfieldvisualizationmoduledefine.h>
+#include <modules/vectorfieldvisualization/datastructures/integralline.h>
+#include <modules/vectorfieldvisualization/datastructures/integrallineset.h>
+#include <inviwo/core/datastructures/buffer/buffer.h>
+#include <inviwo/core/datastructures/datatraits.h>
+#include <inviwo/core/ports/datainport.h>
+#include <inviwo/core/ports/dataoutport.h>
+
+#include <tcb/span.hpp>
+
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace inviwo {
+
+/**
+ * \ingroup datastructures
+ * \brief A set of integral lines stored as a structure of arrays.
+ *
+ * All positions are stored in one contiguous buffer and the points of line `i` are the range
+ * `[getOffsets()[i], getOffsets()[i + 1])` of it. Each meta data channel is stored in one buffer
+ * with one value per point, in the same order as the positions. Compared to an IntegralLineSet this
+ * needs only a handful of allocations independent of the number of lines, and the position buffer
+ * can be used directly as the vertex buffer of a mesh, see util::toMesh.
+ *
+ * Positions are stored in single precision to be directly usable for rendering, use an
+ * IntegralLineSet if double precision positions are needed.
+ *
+ * Appending lines is thread safe, the accessors are not synchronized with appends and should only
+ * be used once all lines have been added.
+ */
+class IVW_MODULE_VECTORFIELDVISUALIZATION_API PackedIntegralLineSet {
+public:
+    using TerminationReason = IntegralLine::TerminationReason;
+
+    PackedIntegralLineSet(mat4 modelMatrix, mat4 worldMatrix = mat4(1));
+    /**
+     * Pack all lines of the given set, the line indices are kept.
+     */
+    explicit PackedIntegralLineSet(const IntegralLineSet& lines);
+    PackedIntegralLineSet(const PackedIntegralLineSet& rhs);
+    PackedIntegralLineSet(PackedIntegralLineSet&& rhs);
+    PackedIntegralLineSet& operator=(const PackedIntegralLineSet& that);
+    PackedIntegralLineSet& operator=(PackedIntegralLineSet&& that);
+    virtual ~PackedIntegralLineSet();
+
+    mat4 getModelMatrix() const;
+    mat4 getWorldMatrix() const;
+
+    /**
+     * The number of lines
+     */
+    size_t size() const;
+    bool empty() const;
+    /**
+     * The total number of points of all lines
+     */
+    size_t getNumberOfPoints() const;
+
+    void reserve(size_t lines, size_t points);
+
+    /**
+     * Append a copy of line with the given index. Meta data channels that do not exist in the set
+     * are added and filled with zeros for the points of the previous lines, and channels that the
+     * line does not have are filled with zeros for its points. Thread safe.
+     * @throw Exception if a meta data channel of the line has a different format than the
+     * corresponding channel of the set
+     */
+    void append(const IntegralLine& line, uint32_t index);
+    /**
+     * Append all lines of another packed set, keeping their indices. Thread safe.
+     * @throw Exception if a meta data channel has a different format than in this set
+     */
+    void append(const PackedIntegralLineSet& lines);
+
+    /**
+     * Offsets of the first point of each line into the position and meta data buffers. The
+     * vector has size() + 1 elements, the last one equals getNumberOfPoints().
+     */
+    const std::vector<uint32_t>& getOffsets() const;
+
+    util::span<const vec3> getPositions() const;
+    util::span<const vec3> getPositions(size_t line) const;
+    std::shared_ptr<const Buffer<vec3>> getPositionBuffer() const;
+
+    std::vector<std::string> getMetaDataKeys() const;
+    bool hasMetaData(const std::string& name) const;
+    /**
+     * @throw Exception if there is no channel called name
+     */
+    std::shared_ptr<const BufferBase> getMetaDataBuffer(const std::string& name) const;
+    const std::map<std::string, std::shared_ptr<BufferBase>>& getMetaDataBuffers() const;
+
+    /**
+     * The values of all points of the meta data channel name
+     * @throw Exception if there is no channel called name or if it is not of type T
+     */
+    template <typename T>
+    util::span<const T> getMetaData(const std::string& name) const;
+    /**
+     * The values of the points of one line of the meta data channel name
+     * @throw Exception if there is no channel called name or if it is not of type T
+     */
+    template <typename T>
+    util::span<const T> getMetaData(const std::string& name, size_t line) const;
+
+    uint32_t getIndex(size_t line) const;
+    TerminationReason getBackwardTerminationReason(size_t line) const;
+    TerminationReason getForwardTerminationReason(size_t line) const;
+
+    /**
+     * Unpack a single line including all meta data
+     */
+    IntegralLine getLine(size_t line) const;
+
+private:
+    void appendChannel(const std::string& name, const BufferBase& values, size_t offset);
+    void fillChannels(size_t points);
+
+    mat4 modelMatrix_;
+    mat4 worldMatrix_;
+
+    std::shared_ptr<Buffer<vec3>> positions_;
+    std::vector<uint32_t> offsets_;
+    std::vector<uint32_t> indices_;
+    std::vector<TerminationReason> backwardTerminationReasons_;
+    std::vector<TerminationReason> forwardTerminationReasons_;
+    std::map<std::string, std::shared_ptr<BufferBase>> metaData_;
+
+    mutable std::mutex mutex_;
+};
+
+template <typename T>
+util::span<const T> PackedIntegralLineSet::getMetaData(const std::string& name) const {
+    auto buffer = getMetaDataBuffer(name);
+    if (buffer->getDataFormat() != DataFormat<T>::get()) {
+        throw Exception("Incorrect dataformat for meta data " + name + " asking for " +
+                            DataFormat<T>::get()->getString() + " but is " +
+                            buffer->getDataFormat()->getString(),
+                        IVW_CONTEXT);
+    }
+    return static_cast<const Buffer<T>*>(buffer.get())->getRAMRepresentation()->getDataContainer();
+}
+
+template <typename T>
+util::span<const T> PackedIntegralLineSet::getMetaData(const std::string& name,
+                                                       size_t line) const {
+    return getMetaData<T>(name).subspan(offsets_[line], offsets_[line + 1] - offsets_[line]);
+}
+
+using PackedIntegralLineSetInport = DataInport<PackedIntegralLineSet>;
+using PackedIntegralLineSetOutport = DataOutport<PackedIntegralLineSet>;
+
+template <>
+struct DataTraits<PackedIntegralLineSet> {
+    static std::string classIdentifier() { return "org.inviwo.PackedIntegralLineSet"; }
+    static std::string dataName() { return "PackedIntegralLineSet"; }
+    static uvec3 colorCode() { return uvec3(255, 180, 0); }
+    static Document info(const PackedIntegralLineSet& data) {
+        std::ostringstream oss;
+        oss << "Packed Integral Line Set with " << data.size() << " lines and "
+            << data.getNumberOfPoints() << " points";
+        Document doc;
+        doc.append("p", oss.str());
+        return doc;
+    }
+};
+
+}  // namespace inviwo
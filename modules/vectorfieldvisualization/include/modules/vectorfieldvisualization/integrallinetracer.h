@@ -69,6 +69,13 @@ public:
 
     Result traceFrom(const SpatialVector& pIn) const;
 
+    /**
+     * Trace a line from pIn into the given line, which is cleared first. Reusing the same line for
+     * many seeds avoids allocating new positions and meta data buffers for each line.
+     * @return the index of the seed point within the line
+     */
+    size_t traceFrom(const SpatialVector& pIn, IntegralLine& line) const;
+
     void addMetaDataSampler(const std::string& name, std::shared_ptr<const Sampler> sampler);
 
     const DataHomogenouSpatialMatrixrix& getSeedTransformationMatrix() const;
@@ -116,9 +123,17 @@ IntegralLineTracer<SpatialSampler, TimeDependent>::IntegralLineTracer(
 template <typename SpatialSampler, bool TimeDependent>
 typename IntegralLineTracer<SpatialSampler, TimeDependent>::Result
 IntegralLineTracer<SpatialSampler, TimeDependent>::traceFrom(const SpatialVector& pIn) const {
-    const SpatialVector p = seedTransform(pIn);
     Result res;
-    IntegralLine& line = res.line;
+    res.seedIndex = traceFrom(pIn, res.line);
+    return res;
+}
+
+template <typename SpatialSampler, bool TimeDependent>
+size_t IntegralLineTracer<SpatialSampler, TimeDependent>::traceFrom(const SpatialVector& pIn,
+                                                                    IntegralLine& line) const {
+    const SpatialVector p = seedTransform(pIn);
+    size_t seedIndex = 0;
+    line.clear();
 
     const auto [stepsBWD, stepsFWD] = [dir = dir_, steps = steps_,
                                        &line]() -> std::pair<size_t, size_t> {
@@ -148,18 +163,18 @@ IntegralLineTracer<SpatialSampler, TimeDependent>::traceFrom(const SpatialVector
     }
 
     if (!addPoint(line, p)) {
-        return res;  // Zero velocity at seed point
+        return seedIndex;  // Zero velocity at seed point
     }
 
     line.setBackwardTerminationReason(integrate(stepsBWD, p, line, false));
 
     if (line.getPositions().size() > 1) {
         line.reverse();
-        res.seedIndex = line.getPositions().size() - 1;
+        seedIndex = line.getPositions().size() - 1;
     }
 
     line.setForwardTerminationReason(integrate(stepsFWD, p, line, true));
-    return res;
+    return seedIndex;
 }
 
 template <typename SpatialSampler, bool TimeDependent>
@@ -34,20 +34,55 @@
 #include <inviwo/core/properties/transferfunctionproperty.h>
 #include <inviwo/core/properties/minmaxproperty.h>
 #include <inviwo/core/ports/meshport.h>
-#include <inviwo/core/processors/processor.h>
+#include <inviwo/core/processors/poolprocessor.h>
 #include <inviwo/core/properties/optionproperty.h>
 #include <inviwo/core/properties/boolproperty.h>
 
 #include <modules/vectorfieldvisualization/ports/seedpointsport.h>
 #include <modules/vectorfieldvisualization/properties/pathlineproperties.h>
 #include <modules/vectorfieldvisualization/datastructures/integrallineset.h>
+#include <modules/vectorfieldvisualization/integrallinetracer.h>
 #include <inviwo/core/util/spatial4dsampler.h>
 #include <inviwo/core/ports/datainport.h>
 #include <inviwo/core/properties/stringproperty.h>
 
+#include <functional>
+
 namespace inviwo {
 
-class IVW_MODULE_VECTORFIELDVISUALIZATION_API PathLinesDeprecated : public Processor {
+class ThreadPool;
+
+namespace util {
+
+/**
+ * Trace path lines from all seed points in parallel. The lines are stored in seed point order with
+ * the seed point index as line index, independent of the number of threads used. Seed points
+ * giving lines with less than two points are skipped.
+ * @param tracer the tracer used for every seed point
+ * @param seeds the seed points, indexed consecutively over all sets
+ * @param seedTransform applied to every seed point before tracing
+ * @param startT the start time of every line
+ * @param modelMatrix the model matrix of the returned line set
+ * @param stop polled during tracing, tracing is aborted when it returns true
+ * @param progress called with the number of traced seed points and the total number of seed
+ *        points. Calls are serialized, never decrease and end with (total, total).
+ * @param pool the thread pool to trace on, uses the pool of the InviwoApplication if nullptr
+ * @return the traced lines or nullptr if stopped
+ */
+IVW_MODULE_VECTORFIELDVISUALIZATION_API std::shared_ptr<IntegralLineSet> tracePathLines(
+    const PathLine3DTracer& tracer,
+    const std::vector<std::shared_ptr<const SeedPoint3DVector>>& seeds, const mat4& seedTransform,
+    double startT, const mat4& modelMatrix, const std::function<bool()>& stop,
+    const std::function<void(size_t, size_t)>& progress, ThreadPool* pool = nullptr);
+
+}  // namespace util
+
+/**
+ * Traces path lines in a background job. The seed points are traced in parallel on the thread pool
+ * and the lines are stored in seed point order with the seed point index as line index, hence the
+ * result is the same for every run.
+ */
+class IVW_MODULE_VECTORFIELDVISUALIZATION_API PathLinesDeprecated : public PoolProcessor {
 public:
     enum class ColoringMethod { Velocity, Timestamp, ColorPort };
     PathLinesDeprecated();
@@ -39,7 +39,9 @@
 #include <inviwo/core/ports/imageport.h>
 #include <inviwo/core/util/utilities.h>
 #include <inviwo/core/util/foreach.h>
+#include <inviwo/core/util/parallel.h>
 #include <modules/vectorfieldvisualization/algorithms/integrallineoperations.h>
+#include <modules/vectorfieldvisualization/datastructures/packedintegrallineset.h>
 #include <modules/vectorfieldvisualization/integrallinetracer.h>
 #include <modules/vectorfieldvisualization/ports/seedpointsport.h>
 
@@ -61,6 +63,7 @@ private:
     DataInport<typename Tracer::Sampler, 0> annotationSamplers_;
 
     IntegralLineSetOutport lines_;
+    PackedIntegralLineSetOutport packedLines_;
 
     IntegralLineProperties properties_;
 
@@ -75,6 +78,7 @@ IntegralLineTracerProcessor<Tracer>::IntegralLineTracerProcessor()
     , seeds_("seeds")
     , annotationSamplers_("annotationSamplers")
     , lines_("lines")
+    , packedLines_("packedLines")
     , properties_("properties", "Properties")
 
     , metaData_("metaData", "Meta Data")
@@ -84,6 +88,10 @@ IntegralLineTracerProcessor<Tracer>::IntegralLineTracerProcessor()
     addPort(seeds_);
     addPort(annotationSamplers_);
     addPort(lines_);
+    addPort(packedLines_);
+
+    // The lines are only copied into an IntegralLineSet if needed, see process()
+    lines_.onConnect([this]() { invalidate(InvalidationLevel::InvalidOutput); });
 
     addProperty(properties_);
     addProperty(metaData_);
@@ -113,27 +121,63 @@ void IntegralLineTracerProcessor<Tracer>::process() {
         tracer.addMetaDataSampler(key, meta.second);
     }
 
-    std::mutex mutex;
+    const dmat4 toWorld{sampler->getModelMatrix()};
+    const bool curvature = calculateCurvature_;
+    const bool tortuosity = calculateTortuosity_;
+    // Copying the lines into the IntegralLineSet is only needed if someone uses it
+    const bool unpacked = lines_.isConnected();
+
+    // Every chunk of seeds is traced into a separate packed set reusing the same line for all
+    // seeds. The chunks are then appended in seed order, making the result independent of the
+    // scheduling.
+    struct Chunk {
+        PackedIntegralLineSet packed;
+        std::vector<IntegralLine> lines;
+    };
+    const Chunk empty{PackedIntegralLineSet{sampler->getModelMatrix(), sampler->getWorldMatrix()},
+                      {}};
+
+    auto packed = std::make_shared<PackedIntegralLineSet>(sampler->getModelMatrix(),
+                                                          sampler->getWorldMatrix());
     size_t startID = 0;
     for (const auto& seeds : seeds_) {
-        util::forEachParallel(*seeds, [&](const auto& p, size_t i) {
-            IntegralLine line = tracer.traceFrom(p);
-            auto size = line.getPositions().size();
-            if (size > 1) {
-                std::lock_guard<std::mutex> lock(mutex);
-                lines->push_back(std::move(line), startID + i);
-            }
-        });
+        auto traced = util::parallelReduce(
+            0, seeds->size(), empty,
+            [&](size_t begin, size_t end, Chunk chunk) {
+                IntegralLine scratch;
+                for (size_t i = begin; i < end; ++i) {
+                    // Copies of an IntegralLine share the meta data buffers, hence the scratch line
+                    // can only be reused if no copy is kept.
+                    IntegralLine unpackedLine;
+                    auto& line = unpacked ? unpackedLine : scratch;
+                    tracer.traceFrom((*seeds)[i], line);
+                    if (line.getPositions().size() <= 1) continue;
+                    if (curvature) util::curvature(line, toWorld);
+                    if (tortuosity) util::tortuosity(line, toWorld);
+
+                    const auto index = static_cast<uint32_t>(startID + i);
+                    chunk.packed.append(line, index);
+                    if (unpacked) {
+                        line.setIndex(index);
+                        chunk.lines.push_back(std::move(line));
+                    }
+                }
+                return chunk;
+            },
+            [](Chunk a, Chunk b) {
+                a.packed.append(b.packed);
+                std::move(b.lines.begin(), b.lines.end(), std::back_inserter(a.lines));
+                return a;
+            });
+
+        packed->append(traced.packed);
+        for (auto& line : traced.lines) {
+            lines->push_back(std::move(line), IntegralLineSet::SetIndex::No);
+        }
         startID += seeds->size();
     }
 
-    if (calculateCurvature_) {
-        util::curvature(*lines);
-    }
-    if (calculateTortuosity_) {
-        util::tortuosity(*lines);
-    }
-
+    packedLines_.setData(packed);
     lines_.setData(lines);
 }
 
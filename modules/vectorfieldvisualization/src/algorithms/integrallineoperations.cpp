@@ -43,8 +43,11 @@ IntegralLineSet curvature(const IntegralLineSet& lines) {
 }
 
 void curvature(IntegralLine& line, dmat4 toWorld) {
-    if (line.hasMetaData("curvature")) return;
     if (line.getPositions().size() <= 1) return;
+    if (line.hasMetaData("curvature") &&
+        line.getMetaData<double>("curvature").size() == line.getPositions().size()) {
+        return;
+    }
     auto positions = line.getPositions();  // note, this creates a copy, we modify it below
 
     std::transform(positions.begin(), positions.end(), positions.begin(), [&](dvec3 pos) {
@@ -52,8 +55,9 @@ void curvature(IntegralLine& line, dmat4 toWorld) {
         return dvec3(P) / P.w;
     });
 
-    auto md = line.createMetaData<double>("curvature");
-    auto& K = md->getEditableRAMRepresentation()->getDataContainer();
+    // the channel might exist but be empty if the line has been cleared for reuse
+    auto& K = line.getMetaData<double>("curvature", true);
+    K.clear();
     const auto& V = line.getMetaData<dvec3>("velocity");
 
     auto cur = positions.begin();
@@ -111,7 +115,10 @@ IntegralLineSet tortuosity(const IntegralLineSet& lines) {
 }
 
 void tortuosity(IntegralLine& line, dmat4 toWorld) {
-    if (line.hasMetaData("tortuosity")) return;
+    if (line.hasMetaData("tortuosity") &&
+        line.getMetaData<double>("tortuosity").size() == line.getPositions().size()) {
+        return;
+    }
     auto positions = line.getPositions();  // note, this creates a copy, we modify it below
     if (positions.size() <= 1) return;
     float dt = static_cast<float>(positions.size() - 1);
@@ -122,8 +129,8 @@ void tortuosity(IntegralLine& line, dmat4 toWorld) {
         return dvec3(P) / P.w;
     });
 
-    auto md = line.createMetaData<double>("tortuosity");
-    auto& K = md->getEditableRAMRepresentation()->getDataContainer();
+    auto& K = line.getMetaData<double>("tortuosity", true);
+    K.clear();
     double acuDist = 0;
 
     dvec3 start = positions.front();
@@ -146,5 +153,65 @@ void tortuosity(IntegralLineSet& lines) {
     }
 }
 
+std::shared_ptr<Mesh> toMesh(const PackedIntegralLineSet& lines, ConnectivityType connectivity) {
+    auto mesh = std::make_shared<Mesh>();
+    mesh->setModelMatrix(lines.getModelMatrix());
+    mesh->setWorldMatrix(lines.getWorldMatrix());
+    // The mesh shares the position buffer with the line set. The buffer is not modified and the
+    // mesh will be const in all connected ports, making the const cast ok in this case.
+    mesh->addBuffer(BufferType::PositionAttrib,
+                    std::const_pointer_cast<Buffer<vec3>>(lines.getPositionBuffer()));
+
+    const auto& offsets = lines.getOffsets();
+    size_t segments = 0;
+    for (size_t l = 0; l < lines.size(); ++l) {
+        const auto points = offsets[l + 1] - offsets[l];
+        if (points > 1) segments += points - 1;
+    }
+
+    switch (connectivity) {
+        case ConnectivityType::None:
+        case ConnectivityType::Adjacency: {
+            const bool adjacency = connectivity == ConnectivityType::Adjacency;
+            std::vector<uint32_t> indices;
+            indices.reserve(segments * (adjacency ? 4 : 2));
+            for (size_t l = 0; l < lines.size(); ++l) {
+                const auto begin = offsets[l];
+                const auto end = offsets[l + 1];
+                for (auto i = begin; i + 1 < end; ++i) {
+                    if (adjacency) indices.push_back(i == begin ? i : i - 1);
+                    indices.push_back(i);
+                    indices.push_back(i + 1);
+                    if (adjacency) indices.push_back(i + 2 == end ? i + 1 : i + 2);
+                }
+            }
+            mesh->addIndices(Mesh::MeshInfo(DrawType::Lines, connectivity),
+                             util::makeIndexBuffer(std::move(indices)));
+            break;
+        }
+        case ConnectivityType::Strip:
+        case ConnectivityType::StripAdjacency: {
+            const bool adjacency = connectivity == ConnectivityType::StripAdjacency;
+            for (size_t l = 0; l < lines.size(); ++l) {
+                const auto begin = offsets[l];
+                const auto end = offsets[l + 1];
+                if (end - begin < 2) continue;
+                std::vector<uint32_t> indices;
+                indices.reserve(end - begin + (adjacency ? 2 : 0));
+                if (adjacency) indices.push_back(begin);
+                for (auto i = begin; i < end; ++i) indices.push_back(i);
+                if (adjacency) indices.push_back(end - 1);
+                mesh->addIndices(Mesh::MeshInfo(DrawType::Lines, connectivity),
+                                 util::makeIndexBuffer(std::move(indices)));
+            }
+            break;
+        }
+        default:
+            throw Exception("Unsupported connectivity for integral lines",
+                            IVW_CONTEXT_CUSTOM("util::toMesh"));
+    }
+    return mesh;
+}
+
 }  // namespace util
 }  // namespace inviwo
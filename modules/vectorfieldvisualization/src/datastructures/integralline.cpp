@@ -66,6 +66,16 @@ void IntegralLine::reverse() {
     }
 }
 
+void IntegralLine::clear() {
+    positions_.clear();
+    for (auto& m : metaData_) {
+        m.second->getEditableRepresentation<BufferRAM>()->clear();
+    }
+    forwardTerminationReason_ = TerminationReason::Unknown;
+    backwardTerminationReason_ = TerminationReason::Unknown;
+    length_ = -1;
+}
+
 const std::map<std::string, std::shared_ptr<BufferBase>>& IntegralLine::getMetaDataBuffers() const {
     return metaData_;
 }
@@ -138,11 +148,11 @@ void IntegralLine::setForwardTerminationReason(TerminationReason terminationReas
 }
 
 IntegralLine::TerminationReason IntegralLine::getBackwardTerminationReason() const {
-    return forwardTerminationReason_;
+    return backwardTerminationReason_;
 }
 
 IntegralLine::TerminationReason IntegralLine::getForwardTerminationReason() const {
-    return backwardTerminationReason_;
+    return forwardTerminationReason_;
 }
 
 double IntegralLine::calcLength(std::vector<dvec3>::const_iterator start,
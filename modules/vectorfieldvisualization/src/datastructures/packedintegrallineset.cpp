@@ -0,0 +1,304 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2021 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#include <modules/vectorfieldvisualization/datastructures/packedintegrallineset.h>
+
+#include <algorithm>
+#include <iterator>
+#include <limits>
+
+namespace inviwo {
+
+namespace {
+
+std::shared_ptr<BufferBase> createEmptyBuffer(const BufferBase& prototype) {
+    return prototype.getRepresentation<BufferRAM>()->dispatch<std::shared_ptr<BufferBase>>(
+        [](auto brprecision) -> std::shared_ptr<BufferBase> {
+            using ValueType = util::PrecisionValueType<decltype(brprecision)>;
+            return std::make_shared<Buffer<ValueType>>();
+        });
+}
+
+void resizeBuffer(BufferBase& buffer, size_t size) {
+    buffer.getEditableRepresentation<BufferRAM>()->setSize(size);
+}
+
+}  // namespace
+
+PackedIntegralLineSet::PackedIntegralLineSet(mat4 modelMatrix, mat4 worldMatrix)
+    : modelMatrix_{modelMatrix}
+    , worldMatrix_{worldMatrix}
+    , positions_{std::make_shared<Buffer<vec3>>()}
+    , offsets_{0} {}
+
+PackedIntegralLineSet::PackedIntegralLineSet(const IntegralLineSet& lines)
+    : PackedIntegralLineSet(lines.getModelMatrix(), lines.getWorldMatrix()) {
+    size_t points = 0;
+    for (const auto& line : lines) {
+        points += line.getPositions().size();
+    }
+    reserve(lines.size(), points);
+    for (const auto& line : lines) {
+        append(line, line.getIndex());
+    }
+}
+
+PackedIntegralLineSet::PackedIntegralLineSet(const PackedIntegralLineSet& rhs)
+    : modelMatrix_{rhs.modelMatrix_}, worldMatrix_{rhs.worldMatrix_} {
+    std::scoped_lock lock{rhs.mutex_};
+    positions_ = std::shared_ptr<Buffer<vec3>>(rhs.positions_->clone());
+    offsets_ = rhs.offsets_;
+    indices_ = rhs.indices_;
+    backwardTerminationReasons_ = rhs.backwardTerminationReasons_;
+    forwardTerminationReasons_ = rhs.forwardTerminationReasons_;
+    for (const auto& [name, buffer] : rhs.metaData_) {
+        metaData_.emplace(name, std::shared_ptr<BufferBase>(buffer->clone()));
+    }
+}
+
+PackedIntegralLineSet::PackedIntegralLineSet(PackedIntegralLineSet&& rhs)
+    : PackedIntegralLineSet(rhs.modelMatrix_, rhs.worldMatrix_) {
+    *this = std::move(rhs);
+}
+
+PackedIntegralLineSet& PackedIntegralLineSet::operator=(const PackedIntegralLineSet& that) {
+    if (this != &that) {
+        PackedIntegralLineSet copy(that);
+        *this = std::move(copy);
+    }
+    return *this;
+}
+
+PackedIntegralLineSet& PackedIntegralLineSet::operator=(PackedIntegralLineSet&& that) {
+    if (this != &that) {
+        // swap to leave that as a valid (empty) set
+        std::scoped_lock lock{mutex_, that.mutex_};
+        std::swap(modelMatrix_, that.modelMatrix_);
+        std::swap(worldMatrix_, that.worldMatrix_);
+        std::swap(positions_, that.positions_);
+        std::swap(offsets_, that.offsets_);
+        std::swap(indices_, that.indices_);
+        std::swap(backwardTerminationReasons_, that.backwardTerminationReasons_);
+        std::swap(forwardTerminationReasons_, that.forwardTerminationReasons_);
+        std::swap(metaData_, that.metaData_);
+    }
+    return *this;
+}
+
+PackedIntegralLineSet::~PackedIntegralLineSet() = default;
+
+mat4 PackedIntegralLineSet::getModelMatrix() const { return modelMatrix_; }
+mat4 PackedIntegralLineSet::getWorldMatrix() const { return worldMatrix_; }
+
+size_t PackedIntegralLineSet::size() const { return indices_.size(); }
+bool PackedIntegralLineSet::empty() const { return indices_.empty(); }
+size_t PackedIntegralLineSet::getNumberOfPoints() const { return offsets_.back(); }
+
+void PackedIntegralLineSet::reserve(size_t lines, size_t points) {
+    std::scoped_lock lock{mutex_};
+    offsets_.reserve(lines + 1);
+    indices_.reserve(lines);
+    backwardTerminationReasons_.reserve(lines);
+    forwardTerminationReasons_.reserve(lines);
+    positions_->getEditableRAMRepresentation()->reserve(points);
+    for (auto& item : metaData_) {
+        item.second->getEditableRepresentation<BufferRAM>()->reserve(points);
+    }
+}
+
+void PackedIntegralLineSet::append(const IntegralLine& line, uint32_t index) {
+    const auto& positions = line.getPositions();
+
+    std::scoped_lock lock{mutex_};
+    const size_t offset = offsets_.back();
+    if (offset + positions.size() > std::numeric_limits<uint32_t>::max()) {
+        throw Exception("Too many points in packed integral line set", IVW_CONTEXT);
+    }
+    // Validate all channels before modifying anything to not leave the set half updated
+    for (const auto& [name, buffer] : line.getMetaDataBuffers()) {
+        if (buffer->getSize() > positions.size()) {
+            throw Exception("Meta data " + name + " has more values than the line has points",
+                            IVW_CONTEXT);
+        }
+        auto it = metaData_.find(name);
+        if (it != metaData_.end() && it->second->getDataFormat() != buffer->getDataFormat()) {
+            throw Exception("Incorrect dataformat for meta data " + name + " expected " +
+                                it->second->getDataFormat()->getString() + " but got " +
+                                buffer->getDataFormat()->getString(),
+                            IVW_CONTEXT);
+        }
+    }
+
+    auto& dst = positions_->getEditableRAMRepresentation()->getDataContainer();
+    std::transform(positions.begin(), positions.end(), std::back_inserter(dst),
+                   [](const dvec3& p) { return vec3{p}; });
+    for (const auto& [name, buffer] : line.getMetaDataBuffers()) {
+        appendChannel(name, *buffer, offset);
+    }
+    fillChannels(dst.size());
+
+    offsets_.push_back(static_cast<uint32_t>(dst.size()));
+    indices_.push_back(index);
+    backwardTerminationReasons_.push_back(line.getBackwardTerminationReason());
+    forwardTerminationReasons_.push_back(line.getForwardTerminationReason());
+}
+
+void PackedIntegralLineSet::append(const PackedIntegralLineSet& lines) {
+    if (&lines == this) {
+        const PackedIntegralLineSet copy(lines);
+        append(copy);
+        return;
+    }
+
+    std::scoped_lock lock{mutex_, lines.mutex_};
+    const size_t offset = offsets_.back();
+    if (offset + lines.offsets_.back() > std::numeric_limits<uint32_t>::max()) {
+        throw Exception("Too many points in packed integral line set", IVW_CONTEXT);
+    }
+    for (const auto& [name, buffer] : lines.metaData_) {
+        auto it = metaData_.find(name);
+        if (it != metaData_.end() && it->second->getDataFormat() != buffer->getDataFormat()) {
+            throw Exception("Incorrect dataformat for meta data " + name + " expected " +
+                                it->second->getDataFormat()->getString() + " but got " +
+                                buffer->getDataFormat()->getString(),
+                            IVW_CONTEXT);
+        }
+    }
+
+    positions_->getEditableRAMRepresentation()->append(
+        lines.positions_->getRAMRepresentation()->getDataContainer());
+    for (const auto& [name, buffer] : lines.metaData_) {
+        appendChannel(name, *buffer, offset);
+    }
+    fillChannels(offset + lines.offsets_.back());
+
+    std::transform(std::next(lines.offsets_.begin()), lines.offsets_.end(),
+                   std::back_inserter(offsets_),
+                   [offset](uint32_t o) { return static_cast<uint32_t>(offset + o); });
+    indices_.insert(indices_.end(), lines.indices_.begin(), lines.indices_.end());
+    backwardTerminationReasons_.insert(backwardTerminationReasons_.end(),
+                                       lines.backwardTerminationReasons_.begin(),
+                                       lines.backwardTerminationReasons_.end());
+    forwardTerminationReasons_.insert(forwardTerminationReasons_.end(),
+                                      lines.forwardTerminationReasons_.begin(),
+                                      lines.forwardTerminationReasons_.end());
+}
+
+void PackedIntegralLineSet::appendChannel(const std::string& name, const BufferBase& values,
+                                          size_t offset) {
+    auto it = metaData_.find(name);
+    if (it == metaData_.end()) {
+        it = metaData_.emplace(name, createEmptyBuffer(values)).first;
+    }
+    // Pad with zeros for points of previous lines that did not have this channel
+    resizeBuffer(*it->second, offset);
+    it->second->append(values);
+}
+
+void PackedIntegralLineSet::fillChannels(size_t points) {
+    for (auto& item : metaData_) {
+        if (item.second->getSize() < points) {
+            resizeBuffer(*item.second, points);
+        }
+    }
+}
+
+const std::vector<uint32_t>& PackedIntegralLineSet::getOffsets() const { return offsets_; }
+
+util::span<const vec3> PackedIntegralLineSet::getPositions() const {
+    return positions_->getRAMRepresentation()->getDataContainer();
+}
+
+util::span<const vec3> PackedIntegralLineSet::getPositions(size_t line) const {
+    return getPositions().subspan(offsets_[line], offsets_[line + 1] - offsets_[line]);
+}
+
+std::shared_ptr<const Buffer<vec3>> PackedIntegralLineSet::getPositionBuffer() const {
+    return positions_;
+}
+
+std::vector<std::string> PackedIntegralLineSet::getMetaDataKeys() const {
+    std::vector<std::string> keys;
+    for (const auto& item : metaData_) {
+        keys.push_back(item.first);
+    }
+    return keys;
+}
+
+bool PackedIntegralLineSet::hasMetaData(const std::string& name) const {
+    return metaData_.find(name) != metaData_.end();
+}
+
+std::shared_ptr<const BufferBase> PackedIntegralLineSet::getMetaDataBuffer(
+    const std::string& name) const {
+    auto it = metaData_.find(name);
+    if (it == metaData_.end()) {
+        throw Exception("No meta data with name: " + name, IVW_CONTEXT);
+    }
+    return it->second;
+}
+
+const std::map<std::string, std::shared_ptr<BufferBase>>&
+PackedIntegralLineSet::getMetaDataBuffers() const {
+    return metaData_;
+}
+
+uint32_t PackedIntegralLineSet::getIndex(size_t line) const { return indices_[line]; }
+
+auto PackedIntegralLineSet::getBackwardTerminationReason(size_t line) const -> TerminationReason {
+    return backwardTerminationReasons_[line];
+}
+
+auto PackedIntegralLineSet::getForwardTerminationReason(size_t line) const -> TerminationReason {
+    return forwardTerminationReasons_[line];
+}
+
+IntegralLine PackedIntegralLineSet::getLine(size_t line) const {
+    IntegralLine res;
+    const auto positions = getPositions(line);
+    res.getPositions().assign(positions.begin(), positions.end());
+
+    const auto begin = offsets_[line];
+    const auto end = offsets_[line + 1];
+    for (const auto& [name, buffer] : metaData_) {
+        buffer->getRepresentation<BufferRAM>()->dispatch<void>([&, &key = name](auto brprecision) {
+            using ValueType = util::PrecisionValueType<decltype(brprecision)>;
+            const auto& data = brprecision->getDataContainer();
+            res.getMetaData<ValueType>(key, true).assign(data.begin() + begin,
+                                                         data.begin() + end);
+        });
+    }
+
+    res.setIndex(indices_[line]);
+    res.setBackwardTerminationReason(backwardTerminationReasons_[line]);
+    res.setForwardTerminationReason(forwardTerminationReasons_[line]);
+    return res;
+}
+
+}  // namespace inviwo
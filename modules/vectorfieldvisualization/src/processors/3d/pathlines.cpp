@@ -35,13 +35,84 @@
 #include <modules/vectorfieldvisualization/algorithms/integrallineoperations.h>
 #include <inviwo/core/util/zip.h>
 #include <modules/vectorfieldvisualization/integrallinetracer.h>
+#include <inviwo/core/util/parallel.h>
 
-#ifdef IVW_USE_OPENMP
-#include <omp.h>
-#endif
+#include <atomic>
+#include <iterator>
+#include <mutex>
 
 namespace inviwo {
 
+std::shared_ptr<IntegralLineSet> util::tracePathLines(
+    const PathLine3DTracer& tracer,
+    const std::vector<std::shared_ptr<const SeedPoint3DVector>>& seeds, const mat4& seedTransform,
+    double startT, const mat4& modelMatrix, const std::function<bool()>& stop,
+    const std::function<void(size_t, size_t)>& progress, ThreadPool* pool) {
+
+    size_t total = 0;
+    for (const auto& seedSet : seeds) {
+        total += seedSet->size();
+    }
+    std::atomic<size_t> traced{0};
+    std::mutex progressMutex;
+    size_t reported = 0;
+    const dmat4 toWorld{modelMatrix};
+
+    auto lines = std::make_shared<IntegralLineSet>(modelMatrix);
+    size_t startID = 0;
+    for (const auto& seedSet : seeds) {
+        auto map = [&](size_t begin, size_t end, std::vector<IntegralLine> chunk) {
+            for (size_t j = begin; j < end; ++j) {
+                if (stop()) return chunk;
+                const vec4 P = seedTransform * vec4((*seedSet)[j], 1.0f);
+                IntegralLine line = tracer.traceFrom(dvec4(vec3(P), startT));
+                if (line.getPositions().size() > 1) {
+                    line.setIndex(static_cast<uint32_t>(startID + j));
+                    util::curvature(line, toWorld);
+                    util::tortuosity(line, toWorld);
+                    chunk.push_back(std::move(line));
+                }
+            }
+            const size_t done = traced += end - begin;
+            // Chunks finish in any order, only report when the count has moved forward
+            std::scoped_lock lock{progressMutex};
+            if (done > reported) {
+                reported = done;
+                progress(done, total);
+            }
+            return chunk;
+        };
+        auto reduce = [](std::vector<IntegralLine> a, std::vector<IntegralLine> b) {
+            std::move(b.begin(), b.end(), std::back_inserter(a));
+            return a;
+        };
+        auto chunks = pool ? util::parallelReduce(*pool, 0, seedSet->size(),
+                                                  std::vector<IntegralLine>{}, map, reduce)
+                           : util::parallelReduce(0, seedSet->size(),
+                                                  std::vector<IntegralLine>{}, map, reduce);
+        if (stop()) return nullptr;
+
+        for (auto& line : chunks) {
+            lines->push_back(std::move(line), IntegralLineSet::SetIndex::No);
+        }
+        startID += seedSet->size();
+    }
+    progress(total, total);
+    return lines;
+}
+
+namespace {
+
+struct PathLinesResult {
+    std::shared_ptr<IntegralLineSet> lines;
+    std::shared_ptr<BasicMesh> mesh;
+    float maxVelocity = 0.0f;
+    bool tooFewColors = false;
+    bool missingColors = false;
+};
+
+}  // namespace
+
 const ProcessorInfo PathLinesDeprecated::processorInfo_{
     "org.inviwo.PathLinesDeprecated",  // Class identifier
     "Path Lines (Deprecated)",         // Display name
@@ -53,7 +124,7 @@ const ProcessorInfo PathLinesDeprecated::processorInfo_{
 const ProcessorInfo PathLinesDeprecated::getProcessorInfo() const { return processorInfo_; }
 
 PathLinesDeprecated::PathLinesDeprecated()
-    : Processor()
+    : PoolProcessor(pool::Option::QueuedDispatch | pool::Option::DelayInvalidation)
     , sampler_("sampler")
     , seedPoints_("seedpoints")
     , colors_("colors")
@@ -132,120 +203,108 @@ void PathLinesDeprecated::process() {
 
     if (!sampler) return;
 
-    auto mesh = std::make_shared<BasicMesh>();
-    mesh->setModelMatrix(sampler->getModelMatrix());
-    mesh->setWorldMatrix(sampler->getWorldMatrix());
-
-    auto m =
+    auto tracer = std::make_shared<const PathLine3DTracer>(sampler, pathLineProperties_);
+    const auto seedTransform =
         pathLineProperties_.getSeedPointTransformationMatrix(sampler->getCoordinateTransformer());
 
-    float maxVelocity = 0;
-    PathLine3DTracer tracer(sampler, pathLineProperties_);
-
-    bool hasColors = colors_.hasData();
-
-    bool warnOnce = true;
-    bool warnOnce2 = true;
+    const auto calc = [tracer, seeds = seedPoints_.getVectorData(), seedTransform,
+                       startT = pathLineProperties_.getStartT(),
+                       modelMatrix = sampler->getModelMatrix(),
+                       worldMatrix = sampler->getWorldMatrix(),
+                       colors = colors_.hasData() ? colors_.getData() : nullptr, tf = tf_.get(),
+                       coloringMethod = coloringMethod_.get(),
+                       velocityScale = velocityScale_.get()](
+                          pool::Stop stop,
+                          pool::Progress progress) -> std::shared_ptr<const PathLinesResult> {
+        auto lines = util::tracePathLines(
+            *tracer, seeds, seedTransform, startT, modelMatrix, [&]() -> bool { return stop; },
+            [&](size_t i, size_t max) { progress(i, max); });
+        if (!lines) return nullptr;
+
+        auto result = std::make_shared<PathLinesResult>();
+        result->lines = lines;
+        result->mesh = std::make_shared<BasicMesh>();
+        result->mesh->setModelMatrix(modelMatrix);
+        result->mesh->setWorldMatrix(worldMatrix);
+
+        std::vector<BasicMesh::Vertex> vertices;
+        for (auto& line : *lines) {
+            if (stop) return nullptr;
 
-    auto lines = std::make_shared<IntegralLineSet>(sampler->getModelMatrix());
-    std::vector<BasicMesh::Vertex> vertices;
-    size_t startID = 0;
-    for (const auto& seeds : seedPoints_) {
-
-#ifdef IVW_USE_OPENMP
-#pragma omp parallel for
-#endif
-        for (long long j = 0; j < static_cast<long long>(seeds->size()); j++) {
-            const auto& p = (*seeds)[j];
-            vec4 P = m * vec4(p, 1.0f);
-            IntegralLine line = tracer.traceFrom(vec4(vec3(P), pathLineProperties_.getStartT()));
             auto size = line.getPositions().size();
-            if (size > 1) {
-#ifdef IVW_USE_OPENMP
-#pragma omp critical
-#endif
-                // lines->push_back(line, startID + j);
-                lines->push_back(line, lines->size());
-            };
-        }
-        startID += seeds->size();
-    }
-
-    for (auto& line : *lines) {
-        auto size = line.getPositions().size();
-        if (size <= 1) continue;
-
-        auto position = line.getPositions().begin();
-        auto velocity = line.getMetaData<dvec3>("velocity").begin();
-        auto timestamp = line.getMetaData<double>("timestamp").begin();
-
-        auto indexBuffer = mesh->addIndexBuffer(DrawType::Lines, ConnectivityType::StripAdjacency);
-        indexBuffer->add(0);
-
-        vec4 c{0};
-        if (hasColors) {
-            if (line.getIndex() >= colors_.getData()->size()) {
-                if (warnOnce2) {
-                    warnOnce2 = false;
-                    LogWarn("The vector of colors is smaller then the vector of seed points");
+            if (size <= 1) continue;
+
+            auto position = line.getPositions().begin();
+            auto velocity = line.getMetaData<dvec3>("velocity").begin();
+            auto timestamp = line.getMetaData<double>("timestamp").begin();
+
+            auto indexBuffer =
+                result->mesh->addIndexBuffer(DrawType::Lines, ConnectivityType::StripAdjacency);
+            indexBuffer->add(0);
+
+            vec4 c{0};
+            if (colors) {
+                if (line.getIndex() >= colors->size()) {
+                    result->tooFewColors = true;
+                } else {
+                    c = colors->at(line.getIndex());
                 }
-            } else {
-                c = colors_.getData()->at(line.getIndex());
             }
-        }
 
-        for (size_t ii = 0; ii < size; ii++) {
-            vec3 pos(*position);
-            vec3 v(*velocity);
-            float t = static_cast<float>(*timestamp);
-
-            float l = glm::length(v);
-            float d = glm::clamp(l / velocityScale_.get(), 0.0f, 1.0f);
-            maxVelocity = std::max(maxVelocity, l);
-
-            switch (coloringMethod_.get()) {
-                case ColoringMethod::Timestamp:
-                    c = tf_.get().sample(t);
-                    break;
-                case ColoringMethod::ColorPort:
-                    if (hasColors) {
+            for (size_t ii = 0; ii < size; ii++) {
+                vec3 pos(*position);
+                vec3 v(*velocity);
+                float t = static_cast<float>(*timestamp);
+
+                float l = glm::length(v);
+                float d = glm::clamp(l / velocityScale, 0.0f, 1.0f);
+                result->maxVelocity = std::max(result->maxVelocity, l);
+
+                switch (coloringMethod) {
+                    case ColoringMethod::Timestamp:
+                        c = tf.sample(t);
                         break;
-                    } else {
-                        if (warnOnce) {
-                            warnOnce = false;
-                            LogWarn(
-                                "No colors in the color port, using velocity for coloring "
-                                "instead ");
+                    case ColoringMethod::ColorPort:
+                        if (colors) {
+                            break;
+                        } else {
+                            result->missingColors = true;
+                            [[fallthrough]];
                         }
+                    default:
                         [[fallthrough]];
-                    }
-                default:
-                    [[fallthrough]];
-                case ColoringMethod::Velocity:
-                    c = tf_.get().sample(d);
-                    break;
-            }
+                    case ColoringMethod::Velocity:
+                        c = tf.sample(d);
+                        break;
+                }
 
-            indexBuffer->add(static_cast<std::uint32_t>(vertices.size()));
+                indexBuffer->add(static_cast<std::uint32_t>(vertices.size()));
 
-            vertices.push_back({pos, glm::normalize(v), pos, c});
+                vertices.push_back({pos, glm::normalize(v), pos, c});
 
-            position++;
-            velocity++;
-            timestamp++;
+                position++;
+                velocity++;
+                timestamp++;
+            }
+            indexBuffer->add(static_cast<std::uint32_t>(vertices.size() - 1));
         }
-        indexBuffer->add(static_cast<std::uint32_t>(vertices.size() - 1));
-    }
-
-    mesh->addVertices(vertices);
-
-    linesStripsMesh_.setData(mesh);
-
-    util::curvature(*lines);
-    util::tortuosity(*lines);
-
-    lines_.setData(lines);
-    maxVelocity_.set(toString(maxVelocity));
+        result->mesh->addVertices(vertices);
+        return result;
+    };
+
+    dispatchOne(calc, [this](std::shared_ptr<const PathLinesResult> result) {
+        if (!result) return;
+        if (result->tooFewColors) {
+            LogWarn("The vector of colors is smaller then the vector of seed points");
+        }
+        if (result->missingColors) {
+            LogWarn("No colors in the color port, using velocity for coloring instead ");
+        }
+        linesStripsMesh_.setData(result->mesh);
+        lines_.setData(result->lines);
+        maxVelocity_.set(toString(result->maxVelocity));
+        newResults();
+    });
 }
 
 void PathLinesDeprecated::deserialize(Deserializer& d) {
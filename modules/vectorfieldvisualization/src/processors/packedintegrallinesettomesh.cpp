@@ -0,0 +1,131 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2021 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#include <modules/vectorfieldvisualization/processors/packedintegrallinesettomesh.h>
+#include <modules/vectorfieldvisualization/algorithms/integrallineoperations.h>
+#include <inviwo/core/datastructures/tflookuptable.h>
+#include <inviwo/core/util/parallel.h>
+
+#include <algorithm>
+
+namespace inviwo {
+
+namespace {
+
+template <typename T>
+double magnitude(const T& value) {
+    if constexpr (util::rank<T>::value == 0) {
+        return static_cast<double>(value);
+    } else {
+        return glm::length(util::glm_convert<typename util::same_extent<T, double>::type>(value));
+    }
+}
+
+}  // namespace
+
+// The Class Identifier has to be globally unique. Use a reverse DNS naming scheme
+const ProcessorInfo PackedIntegralLineSetToMesh::processorInfo_{
+    "org.inviwo.PackedIntegralLineSetToMesh",  // Class identifier
+    "Packed Integral Line Set To Mesh",        // Display name
+    "Integral Lines",                          // Category
+    CodeState::Experimental,                   // Code state
+    Tags::CPU,                                 // Tags
+};
+const ProcessorInfo PackedIntegralLineSetToMesh::getProcessorInfo() const {
+    return processorInfo_;
+}
+
+PackedIntegralLineSetToMesh::PackedIntegralLineSetToMesh()
+    : Processor()
+    , lines_("lines")
+    , mesh_("mesh")
+    , connectivity_("connectivity", "Connectivity",
+                    {{"adjacency", "Segments with adjacency", ConnectivityType::Adjacency},
+                     {"segments", "Segments", ConnectivityType::None},
+                     {"stripAdjacency", "Strips with adjacency", ConnectivityType::StripAdjacency},
+                     {"strip", "Strips", ConnectivityType::Strip}},
+                    0)
+    , colorBy_("colorBy", "Color by", {{"constant", "constant color"}})
+    , color_("color", "Color", vec4(1.0f, 0.6f, 0.0f, 1.0f), vec4(0.0f), vec4(1.0f),
+             vec4(0.01f), InvalidationLevel::InvalidOutput, PropertySemantics::Color)
+    , tf_("transferFunction", "Transfer function") {
+
+    addPort(lines_);
+    addPort(mesh_);
+
+    addProperties(connectivity_, colorBy_, color_, tf_);
+    colorBy_.setSerializationMode(PropertySerializationMode::All);
+    tf_.visibilityDependsOn(colorBy_, [](const auto& p) { return p.get() != "constant"; });
+    color_.visibilityDependsOn(colorBy_, [](const auto& p) { return p.get() == "constant"; });
+
+    lines_.onChange([this]() { updateOptions(); });
+}
+
+void PackedIntegralLineSetToMesh::updateOptions() {
+    if (!lines_.hasData()) return;
+
+    std::vector<OptionPropertyStringOption> options = {{"constant", "constant color"}};
+    for (const auto& key : lines_.getData()->getMetaDataKeys()) {
+        options.emplace_back(key, key);
+    }
+    colorBy_.replaceOptions(options);
+}
+
+void PackedIntegralLineSetToMesh::process() {
+    auto lines = lines_.getData();
+    auto mesh = util::toMesh(*lines, connectivity_.get());
+
+    const size_t points = lines->getNumberOfPoints();
+    std::vector<vec4> colors(points, color_.get());
+
+    if (colorBy_.get() != "constant" && lines->hasMetaData(colorBy_.get())) {
+        std::vector<double> values(points);
+        lines->getMetaDataBuffer(colorBy_.get())
+            ->getRepresentation<BufferRAM>()
+            ->dispatch<void>([&](auto brprecision) {
+                const auto& data = brprecision->getDataContainer();
+                util::parallelFor(0, points, [&](size_t i) { values[i] = magnitude(data[i]); });
+            });
+
+        if (!values.empty()) {
+            const auto [minIt, maxIt] = std::minmax_element(values.begin(), values.end());
+            const double min = *minIt;
+            const double range = *maxIt - *minIt;
+            const TFLookupTable table(tf_.get());
+            util::parallelFor(0, points, [&](size_t i) {
+                colors[i] = table.sample(range > 0.0 ? (values[i] - min) / range : 0.0);
+            });
+        }
+    }
+
+    mesh->addBuffer(BufferType::ColorAttrib, util::makeBuffer(std::move(colors)));
+    mesh_.setData(mesh);
+}
+
+}  // namespace inviwo
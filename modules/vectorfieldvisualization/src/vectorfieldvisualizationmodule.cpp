@@ -46,6 +46,7 @@
 #include <modules/vectorfieldvisualization/processors/integrallinetracerprocessor.h>
 #include <modules/vectorfieldvisualization/processors/seedsfrommasksequence.h>
 #include <modules/vectorfieldvisualization/processors/discardshortlines.h>
+#include <modules/vectorfieldvisualization/processors/packedintegrallinesettomesh.h>
 
 #include <modules/base/processors/inputselector.h>
 #include <modules/vectorfieldvisualization/integrallinetracer.h>
@@ -86,6 +87,7 @@ VectorFieldVisualizationModule::VectorFieldVisualizationModule(InviwoApplication
     registerProcessor<PathLines3D>();
     registerProcessor<SeedsFromMaskSequence>();
     registerProcessor<DiscardShortLines>();
+    registerProcessor<PackedIntegralLineSetToMesh>();
 
     registerProcessor<SeedPointGenerator2D>();
     registerProcessor<LineSetSelector>();
@@ -95,6 +97,7 @@ VectorFieldVisualizationModule::VectorFieldVisualizationModule(InviwoApplication
     registerProperty<IntegralLineVectorToMesh::ColorByProperty>();
 
     registerDefaultsForDataType<IntegralLineSet>();
+    registerDefaultsForDataType<PackedIntegralLineSet>();
 }
 
 int VectorFieldVisualizationModule::getVersion() const { return 4; }
@@ -0,0 +1,94 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2021 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#include <warn/push>
+#include <warn/ignore/all>
+#include <gtest/gtest.h>
+#include <warn/pop>
+
+#include <modules/vectorfieldvisualization/algorithms/integrallineoperations.h>
+#include <modules/vectorfieldvisualization/datastructures/integralline.h>
+
+#include <cmath>
+#include <vector>
+
+namespace inviwo {
+
+namespace {
+
+// A helix, points and velocities as the IntegralLineTracer would add them
+void trace(IntegralLine& line, size_t points, double radius) {
+    for (size_t i = 0; i < points; ++i) {
+        const auto t = 0.3 * static_cast<double>(i);
+        line.getPositions().emplace_back(radius * std::cos(t), radius * std::sin(t), 0.1 * t);
+        line.getMetaData<dvec3>("velocity", true)
+            .emplace_back(-radius * std::sin(t), radius * std::cos(t), 0.1);
+    }
+    line.setForwardTerminationReason(IntegralLine::TerminationReason::Steps);
+}
+
+}  // namespace
+
+TEST(IntegralLine, clearAndReuse) {
+    IntegralLine line;
+    trace(line, 20, 1.0);
+    util::curvature(line, dmat4(1));
+    util::tortuosity(line, dmat4(1));
+    ASSERT_EQ(size_t{20}, line.getMetaData<double>("curvature").size());
+    const auto length = line.getLength();
+
+    // The channels are kept but emptied
+    line.clear();
+    EXPECT_TRUE(line.getPositions().empty());
+    EXPECT_TRUE(line.hasMetaData("velocity"));
+    EXPECT_TRUE(line.hasMetaData("curvature"));
+    EXPECT_TRUE(line.getMetaData<double>("curvature").empty());
+    EXPECT_TRUE(line.getMetaData<double>("tortuosity").empty());
+    EXPECT_EQ(IntegralLine::TerminationReason::Unknown, line.getForwardTerminationReason());
+
+    // A reused line gets the same values as a new one, even with fewer points than before, and
+    // the cached length of the old line is gone
+    trace(line, 12, 2.0);
+    util::curvature(line, dmat4(1));
+    util::tortuosity(line, dmat4(1));
+
+    IntegralLine fresh;
+    trace(fresh, 12, 2.0);
+    util::curvature(fresh, dmat4(1));
+    util::tortuosity(fresh, dmat4(1));
+
+    EXPECT_EQ(fresh.getPositions(), line.getPositions());
+    EXPECT_EQ(fresh.getMetaData<dvec3>("velocity"), line.getMetaData<dvec3>("velocity"));
+    EXPECT_EQ(fresh.getMetaData<double>("curvature"), line.getMetaData<double>("curvature"));
+    EXPECT_EQ(fresh.getMetaData<double>("tortuosity"), line.getMetaData<double>("tortuosity"));
+    EXPECT_EQ(fresh.getLength(), line.getLength());
+    EXPECT_NE(length, line.getLength());
+}
+
+}  // namespace inviwo
@@ -0,0 +1,213 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2021 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#include <warn/push>
+#include <warn/ignore/all>
+#include <gtest/gtest.h>
+#include <warn/pop>
+
+#include <modules/vectorfieldvisualization/algorithms/integrallineoperations.h>
+#include <modules/vectorfieldvisualization/datastructures/integralline.h>
+#include <modules/vectorfieldvisualization/datastructures/packedintegrallineset.h>
+#include <inviwo/core/datastructures/geometry/mesh.h>
+#include <inviwo/core/util/exception.h>
+
+#include <vector>
+
+namespace inviwo {
+
+namespace {
+
+using TerminationReason = IntegralLine::TerminationReason;
+
+// Positions are exactly representable in single precision
+IntegralLine createLine(size_t points, double x) {
+    IntegralLine line;
+    for (size_t i = 0; i < points; ++i) {
+        line.getPositions().emplace_back(x, static_cast<double>(i), 0.5 * static_cast<double>(i));
+    }
+    line.setBackwardTerminationReason(TerminationReason::StartPoint);
+    line.setForwardTerminationReason(TerminationReason::OutOfBounds);
+    return line;
+}
+
+template <typename T>
+std::vector<T> toVector(util::span<const T> values) {
+    return std::vector<T>(values.begin(), values.end());
+}
+
+std::vector<uint32_t> indices(const Mesh& mesh, size_t i) {
+    return mesh.getIndices(i)->getRAMRepresentation()->getDataContainer();
+}
+
+}  // namespace
+
+TEST(PackedIntegralLineSet, appendMissingMetaData) {
+    PackedIntegralLineSet set(mat4(1));
+
+    auto first = createLine(2, 0.0);
+    first.getMetaData<double>("speed", true) = {1.0, 2.0};
+    set.append(first, 7);
+
+    auto second = createLine(3, 1.0);
+    second.getMetaData<float>("time", true) = {3.0f, 4.0f, 5.0f};
+    set.append(second, 8);
+
+    ASSERT_EQ(size_t{2}, set.size());
+    EXPECT_EQ(std::vector<uint32_t>({0, 2, 5}), set.getOffsets());
+    EXPECT_EQ(std::vector<std::string>({"speed", "time"}), set.getMetaDataKeys());
+    // Channels a line does not have are zero for its points
+    EXPECT_EQ(std::vector<double>({1.0, 2.0, 0.0, 0.0, 0.0}),
+              toVector(set.getMetaData<double>("speed")));
+    EXPECT_EQ(std::vector<float>({0.0f, 0.0f, 3.0f, 4.0f, 5.0f}),
+              toVector(set.getMetaData<float>("time")));
+    EXPECT_EQ(std::vector<float>({3.0f, 4.0f, 5.0f}), toVector(set.getMetaData<float>("time", 1)));
+
+    EXPECT_THROW(set.getMetaData<float>("speed"), Exception);
+    EXPECT_THROW(set.getMetaData<double>("missing"), Exception);
+}
+
+TEST(PackedIntegralLineSet, appendMismatchedMetaData) {
+    PackedIntegralLineSet set(mat4(1));
+    auto first = createLine(2, 0.0);
+    first.getMetaData<double>("speed", true) = {1.0, 2.0};
+    set.append(first, 0);
+
+    // The set is left unchanged, also by channels that are valid
+    auto line = createLine(3, 1.0);
+    line.getMetaData<float>("speed", true) = {3.0f, 4.0f, 5.0f};
+    line.getMetaData<float>("time", true) = {3.0f, 4.0f, 5.0f};
+    EXPECT_THROW(set.append(line, 1), Exception);
+
+    auto tooLong = createLine(1, 1.0);
+    tooLong.getMetaData<double>("speed", true) = {3.0, 4.0};
+    EXPECT_THROW(set.append(tooLong, 1), Exception);
+
+    PackedIntegralLineSet other(mat4(1));
+    other.append(line, 1);
+    EXPECT_THROW(set.append(other), Exception);
+
+    EXPECT_EQ(size_t{1}, set.size());
+    EXPECT_EQ(size_t{2}, set.getNumberOfPoints());
+    EXPECT_EQ(std::vector<std::string>({"speed"}), set.getMetaDataKeys());
+    EXPECT_EQ(std::vector<double>({1.0, 2.0}), toVector(set.getMetaData<double>("speed")));
+}
+
+TEST(PackedIntegralLineSet, appendToItself) {
+    PackedIntegralLineSet set(mat4(1));
+    auto first = createLine(2, 0.0);
+    first.getMetaData<double>("speed", true) = {1.0, 2.0};
+    set.append(first, 3);
+    auto second = createLine(3, 1.0);
+    second.getMetaData<double>("speed", true) = {3.0, 4.0, 5.0};
+    set.append(second, 4);
+
+    const auto positions = toVector(set.getPositions());
+    set.append(set);
+
+    ASSERT_EQ(size_t{4}, set.size());
+    EXPECT_EQ(std::vector<uint32_t>({0, 2, 5, 7, 10}), set.getOffsets());
+    const auto appended = toVector(set.getPositions());
+    ASSERT_EQ(size_t{10}, appended.size());
+    EXPECT_EQ(positions, std::vector<vec3>(appended.begin(), appended.begin() + 5));
+    EXPECT_EQ(positions, std::vector<vec3>(appended.begin() + 5, appended.end()));
+    EXPECT_EQ(std::vector<double>({1.0, 2.0, 3.0, 4.0, 5.0, 1.0, 2.0, 3.0, 4.0, 5.0}),
+              toVector(set.getMetaData<double>("speed")));
+    EXPECT_EQ(uint32_t{3}, set.getIndex(2));
+    EXPECT_EQ(uint32_t{4}, set.getIndex(3));
+}
+
+TEST(PackedIntegralLineSet, getLineRoundTrip) {
+    std::vector<IntegralLine> lines;
+    for (size_t points : {0, 1, 2, 5}) {
+        auto line = createLine(points, static_cast<double>(points));
+        auto& speed = line.getMetaData<double>("speed", true);
+        auto& velocity = line.getMetaData<dvec3>("velocity", true);
+        for (size_t i = 0; i < points; ++i) {
+            speed.push_back(0.25 * static_cast<double>(i));
+            velocity.emplace_back(1.0, static_cast<double>(i), 2.0);
+        }
+        line.setIndex(static_cast<uint32_t>(10 + points));
+        line.setForwardTerminationReason(points < 2 ? TerminationReason::ZeroVelocity
+                                                    : TerminationReason::Steps);
+        lines.push_back(std::move(line));
+    }
+
+    PackedIntegralLineSet set(mat4(1));
+    for (const auto& line : lines) set.append(line, line.getIndex());
+
+    ASSERT_EQ(lines.size(), set.size());
+    for (size_t l = 0; l < lines.size(); ++l) {
+        const auto line = set.getLine(l);
+        EXPECT_EQ(lines[l].getPositions(), line.getPositions());
+        EXPECT_EQ(lines[l].getMetaData<double>("speed"), line.getMetaData<double>("speed"));
+        EXPECT_EQ(lines[l].getMetaData<dvec3>("velocity"), line.getMetaData<dvec3>("velocity"));
+        EXPECT_EQ(lines[l].getIndex(), line.getIndex());
+        EXPECT_EQ(lines[l].getBackwardTerminationReason(), line.getBackwardTerminationReason());
+        EXPECT_EQ(lines[l].getForwardTerminationReason(), line.getForwardTerminationReason());
+    }
+}
+
+TEST(PackedIntegralLineSet, toMesh) {
+    // Lines with 0, 1, 2 and 4 points, only the last two have segments
+    PackedIntegralLineSet set(mat4(1));
+    for (size_t points : {0, 1, 2, 4}) {
+        set.append(createLine(points, 0.0), static_cast<uint32_t>(points));
+    }
+    ASSERT_EQ(std::vector<uint32_t>({0, 0, 1, 3, 7}), set.getOffsets());
+
+    auto none = util::toMesh(set, ConnectivityType::None);
+    EXPECT_EQ(set.getPositionBuffer().get(), none->getBuffer(0));
+    ASSERT_EQ(size_t{1}, none->getNumberOfIndicies());
+    EXPECT_EQ(DrawType::Lines, none->getIndexMeshInfo(0).dt);
+    EXPECT_EQ(ConnectivityType::None, none->getIndexMeshInfo(0).ct);
+    EXPECT_EQ(std::vector<uint32_t>({1, 2, 3, 4, 4, 5, 5, 6}), indices(*none, 0));
+
+    auto adjacency = util::toMesh(set, ConnectivityType::Adjacency);
+    ASSERT_EQ(size_t{1}, adjacency->getNumberOfIndicies());
+    EXPECT_EQ(ConnectivityType::Adjacency, adjacency->getIndexMeshInfo(0).ct);
+    EXPECT_EQ(std::vector<uint32_t>({1, 1, 2, 2, 3, 3, 4, 5, 3, 4, 5, 6, 4, 5, 6, 6}),
+              indices(*adjacency, 0));
+
+    auto strip = util::toMesh(set, ConnectivityType::Strip);
+    ASSERT_EQ(size_t{2}, strip->getNumberOfIndicies());
+    EXPECT_EQ(ConnectivityType::Strip, strip->getIndexMeshInfo(0).ct);
+    EXPECT_EQ(std::vector<uint32_t>({1, 2}), indices(*strip, 0));
+    EXPECT_EQ(std::vector<uint32_t>({3, 4, 5, 6}), indices(*strip, 1));
+
+    auto stripAdjacency = util::toMesh(set, ConnectivityType::StripAdjacency);
+    ASSERT_EQ(size_t{2}, stripAdjacency->getNumberOfIndicies());
+    EXPECT_EQ(ConnectivityType::StripAdjacency, stripAdjacency->getIndexMeshInfo(1).ct);
+    EXPECT_EQ(std::vector<uint32_t>({1, 1, 2, 2}), indices(*stripAdjacency, 0));
+    EXPECT_EQ(std::vector<uint32_t>({3, 3, 4, 5, 6, 6}), indices(*stripAdjacency, 1));
+
+    EXPECT_THROW(util::toMesh(set, ConnectivityType::Loop), Exception);
+}
+
+}  // namespace inviwo
@@ -0,0 +1,145 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2021 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#include <warn/push>
+#include <warn/ignore/all>
+#include <gtest/gtest.h>
+#include <warn/pop>
+
+#include <modules/vectorfieldvisualization/processors/3d/pathlines.h>
+#include <modules/vectorfieldvisualization/properties/pathlineproperties.h>
+#include <inviwo/core/datastructures/volume/volume.h>
+#include <inviwo/core/util/threadpool.h>
+
+#include <utility>
+#include <vector>
+
+namespace inviwo {
+
+namespace {
+
+// Rotation around the center of the unit cube, slowly speeding up over time
+class RotatingSampler : public Spatial4DSampler<3, double> {
+public:
+    RotatingSampler() : Spatial4DSampler<3, double>(std::make_shared<Volume>(size3_t{8})) {}
+
+protected:
+    virtual dvec3 sampleDataSpace(const dvec4& pos) const override {
+        return (1.0 + pos.w) * dvec3{0.5 - pos.y, pos.x - 0.5, 0.1};
+    }
+    virtual bool withinBoundsDataSpace(const dvec4& pos) const override {
+        return glm::all(glm::greaterThanEqual(dvec3(pos), dvec3(0.0))) &&
+               glm::all(glm::lessThanEqual(dvec3(pos), dvec3(1.0)));
+    }
+};
+
+std::vector<std::shared_ptr<const SeedPoint3DVector>> seedPoints() {
+    auto inside = std::make_shared<SeedPoint3DVector>();
+    for (int i = 0; i < 10; ++i) {
+        for (int j = 0; j < 10; ++j) {
+            inside->emplace_back(0.05f + 0.1f * i, 0.05f + 0.1f * j, 0.2f);
+        }
+    }
+    // Seed points outside of the volume do not give any lines
+    auto mixed = std::make_shared<SeedPoint3DVector>();
+    for (int i = 0; i < 20; ++i) {
+        mixed->emplace_back(i % 3 == 0 ? 2.0f : 0.04f * i, 0.3f, 0.5f);
+    }
+    return {inside, mixed};
+}
+
+struct Traced {
+    std::shared_ptr<IntegralLineSet> lines;
+    std::vector<std::pair<size_t, size_t>> progress;
+};
+
+Traced trace(ThreadPool* pool) {
+    PathLineProperties properties("pathLineProperties", "Path Line Properties");
+    const PathLine3DTracer tracer{std::make_shared<RotatingSampler>(), properties};
+
+    Traced res;
+    res.lines = util::tracePathLines(
+        tracer, seedPoints(), mat4{1.0f}, 0.0, mat4{1.0f}, []() { return false; },
+        [&](size_t i, size_t max) { res.progress.emplace_back(i, max); }, pool);
+    return res;
+}
+
+}  // namespace
+
+TEST(PathLines, sameLinesForAnyPoolSize) {
+    ThreadPool single(0);
+    ThreadPool multiple(3);
+    const auto a = trace(&single);
+    const auto b = trace(&multiple);
+
+    ASSERT_TRUE(a.lines);
+    ASSERT_TRUE(b.lines);
+    ASSERT_EQ(a.lines->size(), b.lines->size());
+    EXPECT_EQ(100 + 13, a.lines->size());
+
+    for (size_t i = 0; i < a.lines->size(); ++i) {
+        const auto& la = a.lines->at(i);
+        const auto& lb = b.lines->at(i);
+        EXPECT_EQ(la.getIndex(), lb.getIndex());
+        EXPECT_EQ(la.getPositions(), lb.getPositions());
+        if (i > 0) {
+            EXPECT_LT(a.lines->at(i - 1).getIndex(), la.getIndex());
+        }
+        if (la.getIndex() >= 100) {
+            EXPECT_NE(0, (la.getIndex() - 100) % 3) << "seed point outside of the volume traced";
+        }
+    }
+    EXPECT_EQ(119, a.lines->at(a.lines->size() - 1).getIndex());
+}
+
+TEST(PathLines, progressNeverDecreases) {
+    ThreadPool pool(3);
+    const auto res = trace(&pool);
+
+    ASSERT_FALSE(res.progress.empty());
+    for (size_t i = 1; i < res.progress.size(); ++i) {
+        EXPECT_LE(res.progress[i - 1].first, res.progress[i].first);
+    }
+    for (const auto& [i, max] : res.progress) {
+        EXPECT_EQ(120, max);
+    }
+    EXPECT_EQ(120, res.progress.back().first);
+}
+
+TEST(PathLines, stop) {
+    PathLineProperties properties("pathLineProperties", "Path Line Properties");
+    const PathLine3DTracer tracer{std::make_shared<RotatingSampler>(), properties};
+    ThreadPool pool(3);
+
+    EXPECT_FALSE(util::tracePathLines(
+        tracer, seedPoints(), mat4{1.0f}, 0.0, mat4{1.0f}, []() { return true; },
+        [](size_t, size_t) {}, &pool));
+}
+
+}  // namespace inviwo
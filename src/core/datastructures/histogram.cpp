@@ -28,7 +28,10 @@
  *********************************************************************************/
 
 #include <inviwo/core/datastructures/histogram.h>
+#include <inviwo/core/util/exception.h>
+
 #include <algorithm>
+#include <cmath>
 #include <numeric>
 #include <functional>
 
@@ -102,6 +105,9 @@ double& NormalizedHistogram::operator[](size_t i) { return data_[i]; }
 
 const double& NormalizedHistogram::operator[](size_t i) const { return data_[i]; }
 
+HistogramContainer::HistogramContainer(std::vector<NormalizedHistogram> histograms)
+    : histograms_{std::move(histograms)} {}
+
 size_t HistogramContainer::size() const { return histograms_.size(); }
 
 bool HistogramContainer::empty() const { return histograms_.empty(); }
@@ -116,4 +122,109 @@ NormalizedHistogram& HistogramContainer::get(size_t i) { return histograms_[i];
 
 void HistogramContainer::clear() { histograms_.clear(); }
 
+PartialHistogram::PartialHistogram(dvec2 dataRange, size_t bins, const DataFormatBase* format)
+    : integral_{format->getNumericType() != NumericType::Float}
+    , channels_(format->getComponents()) {
+
+    const size_t componentSize = format->getSize() / format->getComponents();
+    if (integral_ && componentSize <= 2) {
+        const size_t values = size_t{1} << (8 * componentSize);
+        valueOffset_ = format->getNumericType() == NumericType::SignedInteger
+                           ? -static_cast<double>(values / 2)
+                           : 0.0;
+        for (auto& channel : channels_) {
+            channel.values.resize(values, 0);
+        }
+        rebin(dataRange, bins);
+    } else {
+        dataRange_ = dataRange;
+        bins_ = integral_ ? std::min(bins, static_cast<size_t>(dataRange.y - dataRange.x + 1))
+                          : bins;
+        for (auto& channel : channels_) {
+            channel.bins.resize(bins_, 0);
+        }
+    }
+}
+
+void PartialHistogram::merge(const PartialHistogram& other) {
+    if (channels_.size() != other.channels_.size() || bins_ != other.bins_ ||
+        dataRange_ != other.dataRange_ || hasValueCounts() != other.hasValueCounts()) {
+        throw Exception("Histograms with different layout can not be merged",
+                        IVW_CONTEXT_CUSTOM("PartialHistogram::merge"));
+    }
+
+    for (size_t c = 0; c < channels_.size(); ++c) {
+        auto& channel = channels_[c];
+        const auto& src = other.channels_[c];
+        std::transform(channel.bins.begin(), channel.bins.end(), src.bins.begin(),
+                       channel.bins.begin(), std::plus<>{});
+        std::transform(channel.values.begin(), channel.values.end(), src.values.begin(),
+                       channel.values.begin(), std::plus<>{});
+        channel.min = std::min(channel.min, src.min);
+        channel.max = std::max(channel.max, src.max);
+        channel.sum += src.sum;
+        channel.sum2 += src.sum2;
+    }
+    count_ += other.count_;
+}
+
+bool PartialHistogram::hasValueCounts() const {
+    return !channels_.empty() && !channels_.front().values.empty();
+}
+
+void PartialHistogram::rebin(dvec2 dataRange, size_t bins) {
+    if (!hasValueCounts()) {
+        throw Exception("Only histograms of 8 and 16 bit integer data can be rebinned",
+                        IVW_CONTEXT_CUSTOM("PartialHistogram::rebin"));
+    }
+    dataRange_ = dataRange;
+    bins_ = std::min(bins, static_cast<size_t>(dataRange.y - dataRange.x + 1));
+}
+
+dvec2 PartialHistogram::getDataRange() const { return dataRange_; }
+
+size_t PartialHistogram::getBins() const { return bins_; }
+
+size_t PartialHistogram::getCount() const { return count_; }
+
+HistogramContainer PartialHistogram::getHistograms() const {
+    const auto count = static_cast<double>(count_);
+    const double rangeScaleFactor = static_cast<double>(bins_ - 1) / (dataRange_.y - dataRange_.x);
+
+    std::vector<NormalizedHistogram> histograms;
+    for (const auto& channel : channels_) {
+        std::vector<double> bins(bins_, 0.0);
+        double min = channel.min;
+        double max = channel.max;
+        double sum = channel.sum;
+        double sum2 = channel.sum2;
+
+        if (hasValueCounts()) {
+            // bin the value counts and derive the statistics from them
+            for (size_t i = 0; i < channel.values.size(); ++i) {
+                if (channel.values[i] == 0) continue;
+                const auto n = static_cast<double>(channel.values[i]);
+                const double val = static_cast<double>(i) + valueOffset_;
+                min = std::min(min, val);
+                max = std::max(max, val);
+                sum += n * val;
+                sum2 += n * val * val;
+
+                const double ind = (val - dataRange_.x) * rangeScaleFactor;
+                if (ind >= 0.0 && ind < static_cast<double>(bins_)) {
+                    bins[static_cast<size_t>(ind)] += n;
+                }
+            }
+        } else {
+            std::transform(channel.bins.begin(), channel.bins.end(), bins.begin(),
+                           [](std::uint64_t n) { return static_cast<double>(n); });
+        }
+
+        const double mean = sum / count;
+        const double stddev = std::sqrt((count * sum2 - sum * sum) / (count * (count - 1.0)));
+        histograms.emplace_back(dataRange_, std::move(bins), min, max, mean, stddev);
+    }
+    return HistogramContainer{std::move(histograms)};
+}
+
 }  // namespace inviwo
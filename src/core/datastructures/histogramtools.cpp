@@ -30,9 +30,20 @@
 #include <inviwo/core/datastructures/histogramtools.h>
 #include <inviwo/core/datastructures/volume/volumeramprecision.h>
 #include <inviwo/core/common/inviwoapplication.h>
+#include <inviwo/core/util/parallel.h>
 
 namespace inviwo {
 
+namespace {
+
+// number of voxels processed as one unit of work
+constexpr size_t chunkSize = size_t{1} << 22;
+// volumes with at least this many chunks publish approximate histograms while calculating
+constexpr size_t progressiveChunks = 16;
+constexpr size_t progressiveRounds = 4;
+
+}  // namespace
+
 void HistogramCalculationState::whenDone(std::function<void(const HistogramContainer&)> callback) {
     if (auto container = container_.lock(); container && done) {
         callback(*container);
@@ -41,6 +52,11 @@ void HistogramCalculationState::whenDone(std::function<void(const HistogramConta
     }
 }
 
+void HistogramCalculationState::whenUpdated(
+    std::function<void(const HistogramContainer&, double)> callback) {
+    updateCallbackHandles_.push_back(updateCallbacks_.add(callback));
+}
+
 HistogramSupplier::HistogramSupplier() : histograms_{std::make_shared<HistogramContainer>()} {}
 
 HistogramSupplier::HistogramSupplier(const HistogramSupplier& rhs)
@@ -55,31 +71,82 @@ HistogramSupplier& HistogramSupplier::operator=(const HistogramSupplier& that) {
 
 std::shared_ptr<HistogramCalculationState> HistogramSupplier::startCalculation(
     std::shared_ptr<const VolumeRAM> volumeRam, dvec2 dataRange, size_t bins) const {
-    if (!calculation_ || calculation_->getBins() != bins ||
-        calculation_->getDataRange() != dataRange) {
-
-        histograms_ = std::make_shared<HistogramContainer>();
-        calculation_ = std::make_shared<HistogramCalculationState>(histograms_, bins, dataRange);
-
-        dispatchPool([weakState = std::weak_ptr<HistogramCalculationState>(calculation_),
-                      stop = calculation_->stop_, volumeRam, dataRange, bins]() {
-            auto histograms = volumeRam->dispatch<HistogramContainer>([&](auto vr) {
-                return HistogramContainer(dataRange, bins, vr->getDataTyped(),
-                                          vr->getDataTyped() + glm::compMul(vr->getDimensions()));
-            });
-            if (*stop) return;
-            dispatchFrontAndForget([hist = std::move(histograms), weakState]() {
-                if (auto s = weakState.lock()) {
-                    done(s, std::move(hist));
+    if (calculation_ && calculation_->getBins() == bins &&
+        calculation_->getDataRange() == dataRange) {
+        return calculation_;
+    }
+
+    auto previous = std::move(calculation_);
+    histograms_ = std::make_shared<HistogramContainer>();
+    calculation_ = std::make_shared<HistogramCalculationState>(histograms_, bins, dataRange);
+
+    // Integer data is counted per value, only the binning depends on the data range.
+    if (previous && previous->result_ && previous->result_->hasValueCounts()) {
+        auto result = std::make_shared<PartialHistogram>(*previous->result_);
+        result->rebin(dataRange, bins);
+        done(calculation_, result->getHistograms(), result);
+        return calculation_;
+    }
+
+    dispatchPool(ThreadPool::Priority::Low,
+                 [weakState = std::weak_ptr<HistogramCalculationState>(calculation_),
+                  stop = calculation_->stop_, volumeRam, dataRange, bins]() {
+        volumeRam->dispatch<void>([&](auto vr) {
+            const auto* data = vr->getDataTyped();
+            const size_t size = glm::compMul(vr->getDimensions());
+            const PartialHistogram empty(dataRange, bins, vr->getDataFormat());
+
+            // For large volumes, the chunks are processed in several rounds where each round
+            // covers every n:th chunk. The result of each round is thereby spread over the whole
+            // volume and the merged result gives a good approximation of the final histogram.
+            const size_t chunks = (size + chunkSize - 1) / chunkSize;
+            const size_t rounds = chunks >= progressiveChunks ? progressiveRounds : 1;
+
+            auto result = std::make_shared<PartialHistogram>(empty);
+            for (size_t round = 0; round < rounds; ++round) {
+                const size_t roundChunks = (chunks - round + rounds - 1) / rounds;
+                result->merge(util::parallelReduce(
+                    0, roundChunks, empty,
+                    [&](size_t begin, size_t end, PartialHistogram histogram) {
+                        for (size_t i = begin; i < end && !*stop; ++i) {
+                            const size_t first = (round + i * rounds) * chunkSize;
+                            histogram.add(data + first, data + std::min(size, first + chunkSize));
+                        }
+                        return histogram;
+                    },
+                    [](PartialHistogram a, const PartialHistogram& b) {
+                        a.merge(b);
+                        return a;
+                    }));
+                if (*stop) return;
+
+                if (round + 1 < rounds) {
+                    const double progress =
+                        static_cast<double>(result->getCount()) / static_cast<double>(size);
+                    dispatchFrontAndForget(
+                        [hist = result->getHistograms(), progress, weakState]() {
+                            if (auto s = weakState.lock()) {
+                                update(s, hist, progress);
+                            }
+                        });
                 }
-            });
+            }
+            dispatchFrontAndForget(
+                [hist = result->getHistograms(), result, weakState]() mutable {
+                    if (auto s = weakState.lock()) {
+                        done(s, std::move(hist), std::move(result));
+                    }
+                });
         });
-    }
+    });
     return calculation_;
 }
 
 void HistogramSupplier::done(std::shared_ptr<HistogramCalculationState> state,
-                             HistogramContainer histograms) {
+                             HistogramContainer histograms,
+                             std::shared_ptr<const PartialHistogram> result) {
+    state->progress_ = 1.0;
+    state->result_ = std::move(result);
     state->callbacks_.invoke(histograms);
     state->done = true;
     if (auto container = state->container_.lock()) {
@@ -87,4 +154,11 @@ void HistogramSupplier::done(std::shared_ptr<HistogramCalculationState> state,
     }
 }
 
+void HistogramSupplier::update(std::shared_ptr<HistogramCalculationState> state,
+                               const HistogramContainer& histograms, double progress) {
+    if (state->done) return;
+    state->progress_ = progress;
+    state->updateCallbacks_.invoke(histograms, progress);
+}
+
 }  // namespace inviwo
@@ -0,0 +1,74 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2021 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#include <inviwo/core/datastructures/tflookuptable.h>
+#include <inviwo/core/datastructures/transferfunction.h>
+#include <inviwo/core/datastructures/image/layer.h>
+#include <inviwo/core/datastructures/image/layerramprecision.h>
+#include <inviwo/core/util/assertion.h>
+
+#include <algorithm>
+
+namespace inviwo {
+
+TFLookupTable::TFLookupTable(const TransferFunction& tf, size_t size) {
+    if (size == 0 || size == tf.getTextureSize()) {
+        const auto ram = static_cast<const LayerRAMPrecision<vec4>*>(
+            tf.getData()->getRepresentation<LayerRAM>());
+        const auto data = ram->getDataTyped();
+        table_.assign(data, data + ram->getDimensions().x);
+    } else {
+        table_.resize(size);
+        tf.interpolateAndStoreMaskedColors(table_);
+    }
+    if (table_.empty()) table_.push_back(vec4(0.0f));
+    last_ = static_cast<double>(table_.size() - 1);
+}
+
+namespace {
+
+template <typename T>
+void sampleAll(const TFLookupTable& table, util::span<const T> positions,
+               util::span<vec4> colors) {
+    IVW_ASSERT(colors.size() >= positions.size(), "Not enough space for the colors");
+    std::transform(positions.begin(), positions.end(), colors.begin(),
+                   [&](T v) { return table.sample(v); });
+}
+
+}  // namespace
+
+void TFLookupTable::sample(util::span<const double> positions, util::span<vec4> colors) const {
+    sampleAll(*this, positions, colors);
+}
+
+void TFLookupTable::sample(util::span<const float> positions, util::span<vec4> colors) const {
+    sampleAll(*this, positions, colors);
+}
+
+}  // namespace inviwo
@@ -44,6 +44,7 @@
 #include <inviwo/core/util/filesystem.h>
 #include <inviwo/core/util/zip.h>
 
+#include <algorithm>
 #include <cmath>
 
 namespace inviwo {
@@ -138,6 +139,20 @@ vec4 TransferFunction::sample(double v) const { return interpolateColor(v); }
 
 vec4 TransferFunction::sample(float v) const { return interpolateColor(v); }
 
+void TransferFunction::interpolateAndStoreMaskedColors(util::span<vec4> data) const {
+    const auto size = data.size();
+    interpolateAndStoreColors(data.data(), size);
+
+    // Clamp before converting, the mask of absolute transfer functions is unbounded by default
+    const auto toIndex = [&](double mask) {
+        return static_cast<size_t>(std::clamp(mask * size, 0.0, static_cast<double>(size)));
+    };
+    const auto maskMin = toIndex(maskMin_);
+    const auto maskMax = toIndex(maskMax_);
+    for (size_t i = 0; i < maskMin; i++) data[i].a = 0.0;
+    for (size_t i = maskMax; i < size; i++) data[i].a = 0.0;
+}
+
 std::vector<FileExtension> TransferFunction::getSupportedExtensions() const {
     return {{"itf", "Inviwo Transfer Function"}, {"png", "Transfer Function Image"}};
 }
@@ -257,13 +272,8 @@ void TransferFunction::calcTransferValues() const {
     IVW_ASSERT(std::is_sorted(sorted_.begin(), sorted_.end(), comparePtr{}), "Should be sorted");
 
     // We assume the the points a sorted here.
-    auto dataArray = dataRepr_->getDataTyped();
-    const auto size = dataRepr_->getDimensions().x;
-
-    interpolateAndStoreColors(dataArray, size);
-
-    for (size_t i = 0; i < size_t(maskMin_ * size); i++) dataArray[i].a = 0.0;
-    for (size_t i = size_t(maskMax_ * size); i < size; i++) dataArray[i].a = 0.0;
+    interpolateAndStoreMaskedColors(
+        util::span<vec4>(dataRepr_->getDataTyped(), dataRepr_->getDimensions().x));
 
     data_->invalidateAllOther(dataRepr_.get());
 
@@ -0,0 +1,131 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2021 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#include <inviwo/core/datastructures/volume/volumebrickcache.h>
+#include <inviwo/core/datastructures/volume/volumeram.h>
+#include <inviwo/core/util/hashcombine.h>
+
+namespace inviwo {
+
+VolumeBrickCache::VolumeBrickCache(size_t memoryBudget)
+    : memoryBudget_{memoryBudget}, memoryUsage_{0} {}
+
+VolumeBrickCache::~VolumeBrickCache() = default;
+
+size_t VolumeBrickCache::KeyHash::operator()(const Key& key) const {
+    size_t seed = 0;
+    util::hash_combine(seed, key.owner);
+    util::hash_combine(seed, key.brick);
+    return seed;
+}
+
+std::shared_ptr<const VolumeRAM> VolumeBrickCache::get(size_t owner, size_t brick,
+                                                       const Loader& loader) {
+    const Key key{owner, brick};
+    {
+        std::scoped_lock lock{mutex_};
+        if (auto it = index_.find(key); it != index_.end()) {
+            entries_.splice(entries_.begin(), entries_, it->second);
+            return it->second->brick;
+        }
+    }
+
+    auto loaded = loader();
+    if (!loaded) return loaded;
+
+    std::scoped_lock lock{mutex_};
+    // Someone else might have loaded the same brick in the mean time, keep the first one.
+    if (auto it = index_.find(key); it != index_.end()) {
+        entries_.splice(entries_.begin(), entries_, it->second);
+        return it->second->brick;
+    }
+    const auto bytes = loaded->getNumberOfBytes();
+    entries_.push_front(Entry{key, loaded, bytes});
+    index_.emplace(key, entries_.begin());
+    memoryUsage_ += bytes;
+    evict();
+    return loaded;
+}
+
+void VolumeBrickCache::erase(size_t owner) {
+    std::scoped_lock lock{mutex_};
+    for (auto it = entries_.begin(); it != entries_.end();) {
+        if (it->key.owner == owner) {
+            memoryUsage_ -= it->bytes;
+            index_.erase(it->key);
+            it = entries_.erase(it);
+        } else {
+            ++it;
+        }
+    }
+}
+
+void VolumeBrickCache::clear() {
+    std::scoped_lock lock{mutex_};
+    entries_.clear();
+    index_.clear();
+    memoryUsage_ = 0;
+}
+
+void VolumeBrickCache::setMemoryBudget(size_t bytes) {
+    std::scoped_lock lock{mutex_};
+    memoryBudget_ = bytes;
+    evict();
+}
+
+size_t VolumeBrickCache::getMemoryBudget() const {
+    std::scoped_lock lock{mutex_};
+    return memoryBudget_;
+}
+
+size_t VolumeBrickCache::getMemoryUsage() const {
+    std::scoped_lock lock{mutex_};
+    return memoryUsage_;
+}
+
+size_t VolumeBrickCache::size() const {
+    std::scoped_lock lock{mutex_};
+    return entries_.size();
+}
+
+std::shared_ptr<VolumeBrickCache> VolumeBrickCache::getShared() {
+    static const auto cache = std::make_shared<VolumeBrickCache>();
+    return cache;
+}
+
+void VolumeBrickCache::evict() {
+    while (memoryUsage_ > memoryBudget_ && entries_.size() > 1) {
+        auto& last = entries_.back();
+        memoryUsage_ -= last.bytes;
+        index_.erase(last.key);
+        entries_.pop_back();
+    }
+}
+
+}  // namespace inviwo
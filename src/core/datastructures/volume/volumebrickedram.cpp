@@ -0,0 +1,237 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2021 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#include <inviwo/core/datastructures/volume/volumebrickedram.h>
+#include <inviwo/core/datastructures/volume/volumeramprecision.h>
+#include <inviwo/core/util/indexmapper.h>
+#include <inviwo/core/util/exception.h>
+#include <inviwo/core/util/parallel.h>
+
+#include <algorithm>
+#include <atomic>
+#include <vector>
+
+namespace inviwo {
+
+namespace {
+
+/**
+ * Copy the part of the `src` region, located at `srcOffset` with dimensions `srcDims`, that
+ * overlaps the `dst` region at `dstOffset` with dimensions `dstDims`. Offsets are given in the
+ * voxel coordinates of the whole volume.
+ */
+struct RegionCopyDispatcher {
+    using type = void;
+    template <typename Result, typename Format>
+    void operator()(const VolumeRAM* src, size3_t srcOffset, VolumeRAM* dst, size3_t dstOffset) {
+        using T = typename Format::type;
+        const auto srcDims = src->getDimensions();
+        const auto dstDims = dst->getDimensions();
+        const auto begin = glm::max(srcOffset, dstOffset);
+        const auto end = glm::min(srcOffset + srcDims, dstOffset + dstDims);
+        if (glm::any(glm::greaterThanEqual(begin, end))) return;
+
+        const auto srcData = static_cast<const T*>(src->getData());
+        auto dstData = static_cast<T*>(dst->getData());
+        const util::IndexMapper3D srcIm(srcDims);
+        const util::IndexMapper3D dstIm(dstDims);
+        const auto rowLength = end.x - begin.x;
+        for (size_t z = begin.z; z < end.z; ++z) {
+            for (size_t y = begin.y; y < end.y; ++y) {
+                const auto srcRow = srcData + srcIm(size3_t{begin.x, y, z} - srcOffset);
+                std::copy(srcRow, srcRow + rowLength,
+                          dstData + dstIm(size3_t{begin.x, y, z} - dstOffset));
+            }
+        }
+    }
+};
+
+void copyRegion(const VolumeRAM* src, size3_t srcOffset, VolumeRAM* dst, size3_t dstOffset) {
+    RegionCopyDispatcher disp;
+    dispatching::dispatch<void, dispatching::filter::All>(src->getDataFormatId(), disp, src,
+                                                          srcOffset, dst, dstOffset);
+}
+
+}  // namespace
+
+VolumeRAMBrickLoader::VolumeRAMBrickLoader(std::shared_ptr<const VolumeRAM> source)
+    : source_{std::move(source)} {}
+
+std::shared_ptr<VolumeRAM> VolumeRAMBrickLoader::loadBrick(const VolumeBrickedRAM& volume,
+                                                           size3_t brick) const {
+    auto res = createVolumeRAM(volume.getBrickExtent(brick), volume.getDataFormat(), nullptr,
+                               volume.getSwizzleMask(), volume.getInterpolation(),
+                               volume.getWrapping());
+    copyRegion(source_.get(), size3_t{0}, res.get(), volume.getBrickOffset(brick));
+    return res;
+}
+
+VolumeBrickedRAM::VolumeBrickedRAM(std::shared_ptr<const VolumeBrickLoader> loader,
+                                   size3_t dimensions, size3_t brickSize,
+                                   const DataFormatBase* format, const SwizzleMask& swizzleMask,
+                                   InterpolationType interpolation, const Wrapping3D& wrapping,
+                                   std::shared_ptr<VolumeBrickCache> cache)
+    : VolumeRepresentation(format)
+    , id_{newId()}
+    , loader_{std::move(loader)}
+    , cache_{cache ? std::move(cache) : VolumeBrickCache::getShared()}
+    , dimensions_{dimensions}
+    , brickSize_{glm::max(brickSize, size3_t{1})}
+    , swizzleMask_{swizzleMask}
+    , interpolation_{interpolation}
+    , wrapping_{wrapping} {}
+
+VolumeBrickedRAM::VolumeBrickedRAM(const VolumeBrickedRAM& rhs)
+    : VolumeRepresentation(rhs)
+    , id_{newId()}
+    , loader_{rhs.loader_}
+    , cache_{rhs.cache_}
+    , dimensions_{rhs.dimensions_}
+    , brickSize_{rhs.brickSize_}
+    , swizzleMask_{rhs.swizzleMask_}
+    , interpolation_{rhs.interpolation_}
+    , wrapping_{rhs.wrapping_} {}
+
+VolumeBrickedRAM& VolumeBrickedRAM::operator=(const VolumeBrickedRAM& that) {
+    if (this != &that) {
+        cache_->erase(id_);
+        VolumeRepresentation::operator=(that);
+        loader_ = that.loader_;
+        cache_ = that.cache_;
+        dimensions_ = that.dimensions_;
+        brickSize_ = that.brickSize_;
+        swizzleMask_ = that.swizzleMask_;
+        interpolation_ = that.interpolation_;
+        wrapping_ = that.wrapping_;
+    }
+    return *this;
+}
+
+VolumeBrickedRAM* VolumeBrickedRAM::clone() const { return new VolumeBrickedRAM(*this); }
+
+VolumeBrickedRAM::~VolumeBrickedRAM() { cache_->erase(id_); }
+
+std::type_index VolumeBrickedRAM::getTypeIndex() const {
+    return std::type_index(typeid(VolumeBrickedRAM));
+}
+
+void VolumeBrickedRAM::setDimensions(size3_t dimensions) {
+    cache_->erase(id_);
+    dimensions_ = dimensions;
+}
+
+const size3_t& VolumeBrickedRAM::getDimensions() const { return dimensions_; }
+
+void VolumeBrickedRAM::setSwizzleMask(const SwizzleMask& mask) { swizzleMask_ = mask; }
+
+SwizzleMask VolumeBrickedRAM::getSwizzleMask() const { return swizzleMask_; }
+
+void VolumeBrickedRAM::setInterpolation(InterpolationType interpolation) {
+    interpolation_ = interpolation;
+}
+
+InterpolationType VolumeBrickedRAM::getInterpolation() const { return interpolation_; }
+
+void VolumeBrickedRAM::setWrapping(const Wrapping3D& wrapping) { wrapping_ = wrapping; }
+
+Wrapping3D VolumeBrickedRAM::getWrapping() const { return wrapping_; }
+
+const size3_t& VolumeBrickedRAM::getBrickSize() const { return brickSize_; }
+
+size3_t VolumeBrickedRAM::getNumberOfBricks() const {
+    return (dimensions_ + brickSize_ - size3_t{1}) / brickSize_;
+}
+
+size3_t VolumeBrickedRAM::getBrickOffset(size3_t brick) const { return brick * brickSize_; }
+
+size3_t VolumeBrickedRAM::getBrickExtent(size3_t brick) const {
+    const auto offset = getBrickOffset(brick);
+    return glm::min(offset + brickSize_, dimensions_) - offset;
+}
+
+std::shared_ptr<const VolumeRAM> VolumeBrickedRAM::getBrick(size3_t brick) const {
+    if (glm::any(glm::greaterThanEqual(brick, getNumberOfBricks()))) {
+        throw Exception("Brick index out of range", IVW_CONTEXT);
+    }
+    const util::IndexMapper3D im(getNumberOfBricks());
+    return cache_->get(id_, im(brick), [&]() -> std::shared_ptr<const VolumeRAM> {
+        auto res = loader_->loadBrick(*this, brick);
+        if (!res || res->getDimensions() != getBrickExtent(brick) ||
+            res->getDataFormat() != getDataFormat()) {
+            throw Exception("Brick loader returned an invalid brick", IVW_CONTEXT);
+        }
+        return res;
+    });
+}
+
+std::shared_ptr<VolumeRAM> VolumeBrickedRAM::getRegion(size3_t offset, size3_t extent) const {
+    if (glm::any(glm::greaterThan(offset + extent, dimensions_))) {
+        throw Exception("Region outside of volume", IVW_CONTEXT);
+    }
+
+    auto res = createVolumeRAM(extent, getDataFormat(), nullptr, swizzleMask_, interpolation_,
+                               wrapping_);
+    if (glm::compMul(extent) == 0) return res;
+
+    const auto first = offset / brickSize_;
+    const auto last = (offset + extent - size3_t{1}) / brickSize_;
+    std::vector<size3_t> bricks;
+    for (size_t z = first.z; z <= last.z; ++z) {
+        for (size_t y = first.y; y <= last.y; ++y) {
+            for (size_t x = first.x; x <= last.x; ++x) {
+                bricks.emplace_back(x, y, z);
+            }
+        }
+    }
+
+    // The bricks cover disjoint parts of the region and can be loaded and copied concurrently
+    util::parallelFor(0, bricks.size(), [&](size_t i) {
+        const auto brick = getBrick(bricks[i]);
+        copyRegion(brick.get(), getBrickOffset(bricks[i]), res.get(), offset);
+    });
+    return res;
+}
+
+const std::shared_ptr<const VolumeBrickLoader>& VolumeBrickedRAM::getLoader() const {
+    return loader_;
+}
+
+void VolumeBrickedRAM::setLoader(std::shared_ptr<const VolumeBrickLoader> loader) {
+    cache_->erase(id_);
+    loader_ = std::move(loader);
+}
+
+const std::shared_ptr<VolumeBrickCache>& VolumeBrickedRAM::getCache() const { return cache_; }
+
+size_t VolumeBrickedRAM::newId() {
+    static std::atomic<size_t> id{0};
+    return id++;
+}
+
+}  // namespace inviwo
@@ -30,6 +30,8 @@
 #include <inviwo/core/datastructures/volume/volumeramconverter.h>
 #include <inviwo/core/datastructures/volume/volumeram.h>
 
+#include <algorithm>
+
 namespace inviwo {
 
 std::shared_ptr<VolumeRAM> VolumeDisk2RAMConverter::createFrom(
@@ -42,4 +44,42 @@ void VolumeDisk2RAMConverter::update(std::shared_ptr<const VolumeDisk> source,
     source->updateRepresentation(destination);
 }
 
+std::shared_ptr<VolumeRAM> VolumeBrickedRAM2RAMConverter::createFrom(
+    std::shared_ptr<const VolumeBrickedRAM> source) const {
+    return source->getRegion(size3_t{0}, source->getDimensions());
+}
+
+void VolumeBrickedRAM2RAMConverter::update(std::shared_ptr<const VolumeBrickedRAM> source,
+                                           std::shared_ptr<VolumeRAM> destination) const {
+    auto region = source->getRegion(size3_t{0}, source->getDimensions());
+    if (destination->getDimensions() != source->getDimensions()) {
+        destination->setDimensions(source->getDimensions());
+    }
+    std::copy_n(static_cast<const char*>(region->getData()), region->getNumberOfBytes(),
+                static_cast<char*>(destination->getData()));
+
+    destination->setSwizzleMask(source->getSwizzleMask());
+    destination->setInterpolation(source->getInterpolation());
+    destination->setWrapping(source->getWrapping());
+}
+
+std::shared_ptr<VolumeBrickedRAM> VolumeRAM2BrickedRAMConverter::createFrom(
+    std::shared_ptr<const VolumeRAM> source) const {
+    return std::make_shared<VolumeBrickedRAM>(
+        std::make_shared<VolumeRAMBrickLoader>(source), source->getDimensions(),
+        VolumeBrickedRAM::defaultBrickSize, source->getDataFormat(), source->getSwizzleMask(),
+        source->getInterpolation(), source->getWrapping());
+}
+
+void VolumeRAM2BrickedRAMConverter::update(std::shared_ptr<const VolumeRAM> source,
+                                           std::shared_ptr<VolumeBrickedRAM> destination) const {
+    destination->setLoader(std::make_shared<VolumeRAMBrickLoader>(source));
+    if (destination->getDimensions() != source->getDimensions()) {
+        destination->setDimensions(source->getDimensions());
+    }
+    destination->setSwizzleMask(source->getSwizzleMask());
+    destination->setInterpolation(source->getInterpolation());
+    destination->setWrapping(source->getWrapping());
+}
+
 }  // namespace inviwo
@@ -0,0 +1,134 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2021 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#include <inviwo/core/io/memorymappedfile.h>
+#include <inviwo/core/util/exception.h>
+#include <inviwo/core/util/stringconversion.h>
+
+#include <fmt/format.h>
+
+#ifdef WIN32
+#define NOMINMAX
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#else
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+namespace inviwo {
+
+namespace util {
+
+#ifdef WIN32
+
+MemoryMappedFile::MemoryMappedFile(const std::string& file, size_t offset, size_t bytes)
+    : mapping_{nullptr}, mappingSize_{0}, data_{nullptr}, size_{bytes} {
+
+    HANDLE handle = CreateFileW(util::toWstring(file).c_str(), GENERIC_READ, FILE_SHARE_READ,
+                                nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (handle == INVALID_HANDLE_VALUE) {
+        throw FileException(fmt::format("Could not open file: {}", file),
+                            IVW_CONTEXT_CUSTOM("MemoryMappedFile"));
+    }
+    LARGE_INTEGER fileSize;
+    if (!GetFileSizeEx(handle, &fileSize) ||
+        static_cast<unsigned long long>(fileSize.QuadPart) < offset + bytes) {
+        CloseHandle(handle);
+        throw FileException(fmt::format("File is smaller than the requested range: {}", file),
+                            IVW_CONTEXT_CUSTOM("MemoryMappedFile"));
+    }
+
+    HANDLE fileMapping = CreateFileMappingW(handle, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    CloseHandle(handle);
+    if (!fileMapping) {
+        throw FileException(fmt::format("Could not map file: {}", file),
+                            IVW_CONTEXT_CUSTOM("MemoryMappedFile"));
+    }
+
+    // The view has to start at a multiple of the allocation granularity
+    SYSTEM_INFO info;
+    GetSystemInfo(&info);
+    const size_t start = offset - offset % info.dwAllocationGranularity;
+    mappingSize_ = bytes + (offset - start);
+    mapping_ = MapViewOfFile(fileMapping, FILE_MAP_READ, static_cast<DWORD>(start >> 32),
+                             static_cast<DWORD>(start & 0xffffffff), mappingSize_);
+    // The view keeps a reference to the mapping object
+    CloseHandle(fileMapping);
+    if (!mapping_) {
+        throw FileException(fmt::format("Could not map file: {}", file),
+                            IVW_CONTEXT_CUSTOM("MemoryMappedFile"));
+    }
+    data_ = static_cast<char*>(mapping_) + (offset - start);
+}
+
+MemoryMappedFile::~MemoryMappedFile() { UnmapViewOfFile(mapping_); }
+
+#else
+
+MemoryMappedFile::MemoryMappedFile(const std::string& file, size_t offset, size_t bytes)
+    : mapping_{nullptr}, mappingSize_{0}, data_{nullptr}, size_{bytes} {
+
+    const int fd = ::open(file.c_str(), O_RDONLY);
+    if (fd == -1) {
+        throw FileException(fmt::format("Could not open file: {}", file),
+                            IVW_CONTEXT_CUSTOM("MemoryMappedFile"));
+    }
+    struct stat fileStat;
+    if (::fstat(fd, &fileStat) != 0 || static_cast<size_t>(fileStat.st_size) < offset + bytes) {
+        ::close(fd);
+        throw FileException(fmt::format("File is smaller than the requested range: {}", file),
+                            IVW_CONTEXT_CUSTOM("MemoryMappedFile"));
+    }
+
+    // The mapping has to start at a multiple of the page size
+    const auto pageSize = static_cast<size_t>(::sysconf(_SC_PAGESIZE));
+    const size_t start = offset - offset % pageSize;
+    mappingSize_ = bytes + (offset - start);
+    void* mapping =
+        ::mmap(nullptr, mappingSize_, PROT_READ, MAP_PRIVATE, fd, static_cast<off_t>(start));
+    // The mapping keeps a reference to the file
+    ::close(fd);
+    if (mapping == MAP_FAILED) {
+        throw FileException(fmt::format("Could not map file: {}", file),
+                            IVW_CONTEXT_CUSTOM("MemoryMappedFile"));
+    }
+    mapping_ = mapping;
+    data_ = static_cast<char*>(mapping_) + (offset - start);
+}
+
+MemoryMappedFile::~MemoryMappedFile() { ::munmap(mapping_, mappingSize_); }
+
+#endif
+
+}  // namespace util
+
+}  // namespace inviwo
@@ -0,0 +1,64 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2021 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#include <inviwo/core/io/rawvolumebrickloader.h>
+#include <inviwo/core/io/bytereaderutil.h>
+#include <inviwo/core/datastructures/volume/volumeramprecision.h>
+
+namespace inviwo {
+
+RawVolumeBrickLoader::RawVolumeBrickLoader(const std::string& rawFile, size_t offset,
+                                           bool littleEndian)
+    : rawFile_(rawFile), offset_(offset), littleEndian_(littleEndian) {}
+
+std::shared_ptr<VolumeRAM> RawVolumeBrickLoader::loadBrick(const VolumeBrickedRAM& volume,
+                                                           size3_t brick) const {
+    const auto extent = volume.getBrickExtent(brick);
+    auto res = createVolumeRAM(extent, volume.getDataFormat(), nullptr, volume.getSwizzleMask(),
+                               volume.getInterpolation(), volume.getWrapping());
+
+    const auto elementSize = volume.getDataFormat()->getSize();
+    const auto start =
+        util::brickedRawOffset(volume.getDimensions(), volume.getBrickSize(), brick);
+    util::readBytesIntoBuffer(rawFile_, offset_ + start * elementSize,
+                              glm::compMul(extent) * elementSize, littleEndian_, elementSize,
+                              res->getData());
+    return res;
+}
+
+size_t util::brickedRawOffset(size3_t dims, size3_t brickSize, size3_t brick) {
+    // All preceding layers of bricks in z and rows of bricks in y are complete, only the
+    // extent of the current layer and row can be clipped.
+    const auto offset = brick * brickSize;
+    const auto extent = glm::min(offset + brickSize, dims) - offset;
+    return offset.z * dims.x * dims.y + offset.y * dims.x * extent.z +
+           offset.x * extent.y * extent.z;
+}
+
+}  // namespace inviwo
@@ -28,13 +28,42 @@
  *********************************************************************************/
 
 #include <inviwo/core/io/rawvolumeramloader.h>
+#include <inviwo/core/io/memorymappedfile.h>
 
 #include <inviwo/core/datastructures/volume/volumeramprecision.h>
+#include <inviwo/core/util/exception.h>
+#include <inviwo/core/util/formatdispatching.h>
+#include <inviwo/core/util/logcentral.h>
 
 namespace inviwo {
 
-RawVolumeRAMLoader::RawVolumeRAMLoader(const std::string& rawFile, size_t offset, bool littleEndian)
-    : rawFile_(rawFile), offset_(offset), littleEndian_(littleEndian) {}
+namespace {
+
+/**
+ * Creates a VolumeRAM sharing the read only data of a memory mapped file. The data is copied into
+ * memory the first time the VolumeRAM is edited.
+ */
+struct MappedVolumeRAMCreationDispatcher {
+    using type = std::shared_ptr<VolumeRAM>;
+    template <typename Result, typename T>
+    std::shared_ptr<VolumeRAM> operator()(std::shared_ptr<const util::MemoryMappedFile> file,
+                                          const VolumeRepresentation& src) {
+        using F = typename T::type;
+        auto data = static_cast<const F*>(file->data());
+        return std::make_shared<VolumeRAMPrecision<F>>(data, std::move(file), src.getDimensions(),
+                                                       src.getSwizzleMask(),
+                                                       src.getInterpolation(), src.getWrapping());
+    }
+};
+
+}  // namespace
+
+RawVolumeRAMLoader::RawVolumeRAMLoader(const std::string& rawFile, size_t offset, bool littleEndian,
+                                       bool useMemoryMapping)
+    : rawFile_(rawFile)
+    , offset_(offset)
+    , littleEndian_(littleEndian)
+    , useMemoryMapping_(useMemoryMapping) {}
 
 RawVolumeRAMLoader* RawVolumeRAMLoader::clone() const { return new RawVolumeRAMLoader(*this); }
 
@@ -42,6 +71,13 @@ std::shared_ptr<VolumeRepresentation> RawVolumeRAMLoader::createRepresentation(
     const VolumeRepresentation& src) const {
 
     const auto size = glm::compMul(src.getDimensions()) * src.getDataFormat()->getSize();
+
+    if (auto file = map(src, size)) {
+        MappedVolumeRAMCreationDispatcher disp;
+        return dispatching::dispatch<std::shared_ptr<VolumeRAM>, dispatching::filter::All>(
+            src.getDataFormat()->getId(), disp, std::move(file), src);
+    }
+
     auto data = std::make_unique<char[]>(size);
     util::readBytesIntoBuffer(rawFile_, offset_, size, littleEndian_,
                               src.getDataFormat()->getSize(), data.get());
@@ -54,17 +90,48 @@ std::shared_ptr<VolumeRepresentation> RawVolumeRAMLoader::createRepresentation(
     return volumeRAM;
 }
 
+std::shared_ptr<const util::MemoryMappedFile> RawVolumeRAMLoader::map(
+    const VolumeRepresentation& src, size_t size) const {
+    const auto format = src.getDataFormat();
+    const auto componentSize = format->getSize() / format->getComponents();
+    // Only data in native byte order (little endian) can be used as is, the offset has to keep
+    // the values aligned.
+    if (!useMemoryMapping_ || size == 0 || (!littleEndian_ && componentSize > 1) ||
+        offset_ % componentSize != 0) {
+        return nullptr;
+    }
+
+    try {
+        return std::make_shared<const util::MemoryMappedFile>(rawFile_, offset_, size);
+    } catch (const FileException& e) {
+        LogWarnCustom("RawVolumeRAMLoader",
+                      e.getMessage() << ", reading the file into memory instead");
+        return nullptr;
+    }
+}
+
 void RawVolumeRAMLoader::updateRepresentation(std::shared_ptr<VolumeRepresentation> dest,
                                               const VolumeRepresentation& src) const {
     auto volumeDst = std::static_pointer_cast<VolumeRAM>(dest);
 
-    if (src.getDimensions() != volumeDst->getDimensions()) {
-        volumeDst->setDimensions(src.getDimensions());
-    }
-
-    const auto size = glm::compMul(src.getDimensions());
-    util::readBytesIntoBuffer(rawFile_, offset_, size * src.getDataFormat()->getSize(),
-                              littleEndian_, src.getDataFormat()->getSize(), volumeDst->getData());
+    const auto dims = src.getDimensions();
+    const auto size = glm::compMul(dims) * src.getDataFormat()->getSize();
+    auto file = map(src, size);
+    volumeDst->dispatch<void>([&](auto vrprecision) {
+        using ValueType = util::PrecisionValueType<decltype(vrprecision)>;
+        if (file) {
+            // Use the new mapping, writing into a mapped destination would copy every page
+            auto data = static_cast<const ValueType*>(file->data());
+            vrprecision->setSharedData(data, std::move(file), dims);
+        } else {
+            if (vrprecision->hasSharedData() || vrprecision->getDimensions() != dims) {
+                vrprecision->setData(new ValueType[glm::compMul(dims)], dims);
+            }
+            util::readBytesIntoBuffer(rawFile_, offset_, size, littleEndian_,
+                                      src.getDataFormat()->getSize(),
+                                      vrprecision->getDataTyped());
+        }
+    });
 
     volumeDst->setSwizzleMask(src.getSwizzleMask());
     volumeDst->setInterpolation(src.getInterpolation());
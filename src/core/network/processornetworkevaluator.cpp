@@ -35,14 +35,34 @@
 #include <inviwo/core/network/networkutils.h>
 #include <inviwo/core/network/networklock.h>
 #include <inviwo/core/util/clock.h>
+#include <inviwo/core/util/evaluationtrace.h>
+#include <inviwo/core/util/threadpool.h>
+#include <inviwo/core/common/inviwoapplication.h>
+
+#include <condition_variable>
+#include <deque>
+#include <iterator>
+#include <mutex>
+#include <unordered_map>
+#include <unordered_set>
 
 namespace inviwo {
 
 ProcessorNetworkEvaluator::ProcessorNetworkEvaluator(ProcessorNetwork* processorNetwork)
     : processorNetwork_(processorNetwork)
-    , processorsSorted_(util::topologicalSortFiltered(processorNetwork_))
+    , sortedDirty_(true)
     , evaulationQueued_(false)
-    , exceptionHandler_(StandardEvaluationErrorHandler()) {
+    , exceptionHandler_(StandardEvaluationErrorHandler())
+    , evaluationMode_(EvaluationMode::Sequential)
+    , trace_(std::make_shared<EvaluationTrace>()) {
+
+    order_.beginBatch();
+    processorNetwork_->forEachProcessor([&](Processor* p) { order_.addNode(p); });
+    for (const auto& connection : processorNetwork_->getConnections()) {
+        order_.addEdge(connection.getOutport()->getProcessor(),
+                       connection.getInport()->getProcessor());
+    }
+    order_.endBatch();
 
     processorNetwork_->addObserver(this);
 }
@@ -51,6 +71,12 @@ void ProcessorNetworkEvaluator::setExceptionHandler(EvaluationErrorHandler handl
     exceptionHandler_ = handler;
 }
 
+void ProcessorNetworkEvaluator::setEvaluationMode(EvaluationMode mode) { evaluationMode_ = mode; }
+
+EvaluationMode ProcessorNetworkEvaluator::getEvaluationMode() const { return evaluationMode_; }
+
+std::shared_ptr<EvaluationTrace> ProcessorNetworkEvaluator::getTrace() const { return trace_; }
+
 void ProcessorNetworkEvaluator::onProcessorNetworkEvaluateRequest() {
     // Direct request, thus we don't want to queue the evaluation anymore
     evaulationQueued_ = false;
@@ -100,85 +126,287 @@ void ProcessorNetworkEvaluator::evaluate() {
     notifyObserversProcessorNetworkEvaluationBegin();
 
     IVW_CPU_PROFILING_IF(500, "Evaluated Processor Network");
+    EvaluationTrace::Scope traceEvaluation(*trace_, TraceEventType::Evaluation);
 
-    for (auto processor : processorsSorted_) {
-        if (!processor->isValid()) {
-            if (processor->isReady()) {
-                try {
-                    // re-initialize resources (e.g., shaders) if necessary
-                    if (processor->getInvalidationLevel() >= InvalidationLevel::InvalidResources) {
-                        processor->initializeResources();
-                    }
-                } catch (...) {
-                    exceptionHandler_(processor, EvaluationType::InitResource, IVW_CONTEXT);
-                    continue;
-                }
+    if (sortedDirty_) updateSorted();
+
+    if (evaluationMode_ == EvaluationMode::Parallel &&
+        processorNetwork_->getApplication()->getPoolSize() > 0) {
+        evaluateParallel();
+    } else {
+        evaluateSequential();
+    }
+
+    notifyObserversProcessorNetworkEvaluationEnd();
+}
+
+void ProcessorNetworkEvaluator::updateSorted() {
+    order_.endBatch();
+    sortedDirty_ = false;
+
+    // Connections are not checked for cycles, use the traversal from the sinks that handles them
+    if (order_.hasCycle()) {
+        processorsSorted_ = util::topologicalSortFiltered(processorNetwork_);
+        return;
+    }
 
-                try {
-                    // call onChange for all invalid inports
-                    for (auto inport : processor->getInports()) {
-                        inport->callOnChangeIfChanged();
+    // All successors come after a processor in the order, hence going backwards we know for all
+    // successors whether they lead to a sink when we reach a processor.
+    const auto order = order_.getOrder();
+    std::unordered_set<const Processor*> needed;
+    for (auto it = order.rbegin(); it != order.rend(); ++it) {
+        auto processor = *it;
+        const auto leadsToSink = [&]() {
+            if (processor->isSink()) return true;
+            for (auto outport : processor->getOutports()) {
+                for (auto inport : outport->getConnectedInports()) {
+                    auto successor = inport->getProcessor();
+                    if (needed.count(successor) != 0 &&
+                        successor->isConnectionActive(inport, outport)) {
+                        return true;
                     }
-                } catch (...) {
-                    exceptionHandler_(processor, EvaluationType::PortOnChange, IVW_CONTEXT);
-                    continue;
                 }
+            }
+            return false;
+        };
+        if (leadsToSink()) needed.insert(processor);
+    }
 
-                processor->notifyObserversAboutToProcess(processor);
+    processorsSorted_.clear();
+    util::copy_if(order, std::back_inserter(processorsSorted_),
+                  [&](Processor* p) { return needed.count(p) != 0; });
+}
 
-                try {
-                    IVW_CPU_PROFILING_IF(500, "Processed " << processor->getIdentifier());
-                    // do the actual processing
-                    processor->process();
+bool ProcessorNetworkEvaluator::prepareProcess(Processor* processor) {
+    if (processor->isValid()) return false;
 
-                    // Set processor as valid only if we still are ready.
-                    // Callbacks might have made our inports invalid, if so abort
-                    // the evaluation by not setting the processor valid.
-                    if (processor->isReady()) processor->setValid();
+    if (!processor->isReady()) {
+        try {
+            processor->doIfNotReady();
+        } catch (...) {
+            exceptionHandler_(processor, EvaluationType::NotReady, IVW_CONTEXT);
+        }
+        return false;
+    }
 
-                } catch (...) {
-                    exceptionHandler_(processor, EvaluationType::Process, IVW_CONTEXT);
-                }
+    try {
+        // re-initialize resources (e.g., shaders) if necessary
+        if (processor->getInvalidationLevel() >= InvalidationLevel::InvalidResources) {
+            EvaluationTrace::Scope trace(*trace_, TraceEventType::InitializeResources,
+                                         processor->getIdentifier());
+            processor->initializeResources();
+        }
+    } catch (...) {
+        exceptionHandler_(processor, EvaluationType::InitResource, IVW_CONTEXT);
+        return false;
+    }
 
-                processor->notifyObserversFinishedProcess(processor);
+    try {
+        // call onChange for all invalid inports
+        EvaluationTrace::Scope trace(*trace_, TraceEventType::InportOnChange,
+                                     processor->getIdentifier());
+        for (auto inport : processor->getInports()) {
+            inport->callOnChangeIfChanged();
+        }
+    } catch (...) {
+        exceptionHandler_(processor, EvaluationType::PortOnChange, IVW_CONTEXT);
+        return false;
+    }
+
+    processor->notifyObserversAboutToProcess(processor);
+    return true;
+}
+
+void ProcessorNetworkEvaluator::finishProcess(Processor* processor, std::exception_ptr error) {
+    try {
+        if (error) std::rethrow_exception(error);
+
+        // Set processor as valid only if we still are ready.
+        // Callbacks might have made our inports invalid, if so abort
+        // the evaluation by not setting the processor valid.
+        if (processor->isReady()) processor->setValid();
+
+    } catch (...) {
+        exceptionHandler_(processor, EvaluationType::Process, IVW_CONTEXT);
+    }
 
-            } else {
-                try {
-                    processor->doIfNotReady();
-                } catch (...) {
-                    exceptionHandler_(processor, EvaluationType::NotReady, IVW_CONTEXT);
+    processor->notifyObserversFinishedProcess(processor);
+}
+
+void ProcessorNetworkEvaluator::evaluateSequential() {
+    for (auto processor : processorsSorted_) {
+        if (!prepareProcess(processor)) continue;
+
+        std::exception_ptr error;
+        try {
+            IVW_CPU_PROFILING_IF(500, "Processed " << processor->getIdentifier());
+            EvaluationTrace::Scope trace(*trace_, TraceEventType::Process,
+                                         processor->getIdentifier());
+            // do the actual processing
+            processor->process();
+        } catch (...) {
+            error = std::current_exception();
+        }
+        finishProcess(processor, error);
+    }
+}
+
+namespace {
+
+bool isConcurrent(const Processor* processor) {
+    const auto& tags = processor->getProcessorInfo().tags.tags_;
+    return util::contains(tags, Tag::Concurrent) && !util::contains(tags, Tag::GL);
+}
+
+}  // namespace
+
+void ProcessorNetworkEvaluator::evaluateParallel() {
+    const auto& processors = processorsSorted_;
+    const size_t size = processors.size();
+
+    // Build the dependency graph from the port connections, the topological order guarantees
+    // that all predecessors of a processor are found before it.
+    std::unordered_map<const Processor*, size_t> indices;
+    for (size_t i = 0; i < size; ++i) indices[processors[i]] = i;
+
+    std::vector<size_t> remaining(size, 0);
+    std::vector<std::vector<size_t>> successors(size);
+    for (size_t i = 0; i < size; ++i) {
+        std::vector<size_t> predecessors;
+        for (auto inport : processors[i]->getInports()) {
+            for (auto outport : inport->getConnectedOutports()) {
+                auto it = indices.find(outport->getProcessor());
+                if (it != indices.end() && !util::contains(predecessors, it->second)) {
+                    predecessors.push_back(it->second);
                 }
             }
         }
+        remaining[i] = predecessors.size();
+        for (auto p : predecessors) successors[p].push_back(i);
     }
 
-    notifyObserversProcessorNetworkEvaluationEnd();
-}
+    std::deque<size_t> ready;
+    for (size_t i = 0; i < size; ++i) {
+        if (remaining[i] == 0) ready.push_back(i);
+    }
 
-void ProcessorNetworkEvaluator::onProcessorSinkChanged(Processor*) {
-    processorsSorted_ = util::topologicalSortFiltered(processorNetwork_);
+    // Processors finished on the pool, handed back to the main thread
+    std::mutex mutex;
+    std::condition_variable condition;
+    std::vector<std::pair<size_t, std::exception_ptr>> finished;
+    size_t running = 0;
+    size_t done = 0;
+
+    const auto complete = [&](size_t i) {
+        ++done;
+        for (auto s : successors[i]) {
+            if (--remaining[s] == 0) ready.push_back(s);
+        }
+    };
+    const auto collect = [&](bool wait) {
+        std::vector<std::pair<size_t, std::exception_ptr>> results;
+        {
+            std::unique_lock<std::mutex> lock{mutex};
+            if (wait) condition.wait(lock, [&]() { return !finished.empty(); });
+            std::swap(results, finished);
+        }
+        for (auto& [i, error] : results) {
+            --running;
+            finishProcess(processors[i], error);
+            complete(i);
+        }
+    };
+
+    // Never leave while jobs referring to the local state are still running
+    util::OnScopeExit waitForJobs{[&]() {
+        std::unique_lock<std::mutex> lock{mutex};
+        condition.wait(lock, [&]() { return finished.size() == running; });
+    }};
+
+    auto& pool = processorNetwork_->getApplication()->getThreadPool();
+    while (done < size) {
+        if (running > 0) collect(false);
+
+        if (ready.empty()) {
+            collect(true);
+            continue;
+        }
+
+        const auto i = ready.front();
+        ready.pop_front();
+        auto processor = processors[i];
+
+        if (!prepareProcess(processor)) {
+            complete(i);
+        } else if (isConcurrent(processor)) {
+            ++running;
+            pool.enqueueRaw(
+                [processor, i, &trace = *trace_, &mutex, &condition, &finished]() {
+                    std::exception_ptr error;
+                    try {
+                        IVW_CPU_PROFILING_IF(500, "Processed " << processor->getIdentifier());
+                        EvaluationTrace::Scope scope(trace, TraceEventType::Process,
+                                                     processor->getIdentifier());
+                        processor->process();
+                    } catch (...) {
+                        error = std::current_exception();
+                    }
+                    {
+                        std::scoped_lock lock{mutex};
+                        finished.emplace_back(i, error);
+                    }
+                    condition.notify_all();
+                },
+                ThreadPool::Priority::High);
+        } else {
+            std::exception_ptr error;
+            try {
+                IVW_CPU_PROFILING_IF(500, "Processed " << processor->getIdentifier());
+                EvaluationTrace::Scope trace(*trace_, TraceEventType::Process,
+                                             processor->getIdentifier());
+                processor->process();
+            } catch (...) {
+                error = std::current_exception();
+            }
+            finishProcess(processor, error);
+            complete(i);
+        }
+    }
 }
 
+void ProcessorNetworkEvaluator::onProcessorSinkChanged(Processor*) { sortedDirty_ = true; }
+
 void ProcessorNetworkEvaluator::onProcessorActiveConnectionsChanged(Processor*) {
-    processorsSorted_ = util::topologicalSortFiltered(processorNetwork_);
+    sortedDirty_ = true;
 }
 
 void ProcessorNetworkEvaluator::onProcessorNetworkDidAddProcessor(Processor* p) {
     p->ProcessorObservable::addObserver(this);
-    processorsSorted_ = util::topologicalSortFiltered(processorNetwork_);
+    order_.addNode(p);
+    sortedDirty_ = true;
 }
 
 void ProcessorNetworkEvaluator::onProcessorNetworkDidRemoveProcessor(Processor* p) {
     p->ProcessorObservable::removeObserver(this);
-    processorsSorted_ = util::topologicalSortFiltered(processorNetwork_);
+    order_.removeNode(p);
+    sortedDirty_ = true;
 }
 
-void ProcessorNetworkEvaluator::onProcessorNetworkDidAddConnection(const PortConnection&) {
-    processorsSorted_ = util::topologicalSortFiltered(processorNetwork_);
+void ProcessorNetworkEvaluator::onProcessorNetworkDidAddConnection(
+    const PortConnection& connection) {
+    // Connections of a deserialized network are added in arbitrary order, sort them all at once
+    // before the next evaluation instead.
+    if (processorNetwork_->isDeserializing()) order_.beginBatch();
+    order_.addEdge(connection.getOutport()->getProcessor(),
+                   connection.getInport()->getProcessor());
+    sortedDirty_ = true;
 }
 
-void ProcessorNetworkEvaluator::onProcessorNetworkDidRemoveConnection(const PortConnection&) {
-    processorsSorted_ = util::topologicalSortFiltered(processorNetwork_);
+void ProcessorNetworkEvaluator::onProcessorNetworkDidRemoveConnection(
+    const PortConnection& connection) {
+    order_.removeEdge(connection.getOutport()->getProcessor(),
+                      connection.getInport()->getProcessor());
+    sortedDirty_ = true;
 }
 
 }  // namespace inviwo
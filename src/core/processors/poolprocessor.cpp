@@ -29,6 +29,8 @@
 
 #include <inviwo/core/processors/poolprocessor.h>
 #include <inviwo/core/network/processornetwork.h>
+#include <inviwo/core/network/processornetworkevaluator.h>
+#include <inviwo/core/util/evaluationtrace.h>
 #include <inviwo/core/common/inviwoapplication.h>
 
 namespace inviwo {
@@ -106,8 +108,18 @@ void PoolProcessor::submit(Submission& job) {
     job.setupProgress();
     states_.push_back(job.state);
     notifyObserversStartBackgroundWork(this, job.tasks.size());
+
+    auto app = getNetwork()->getApplication();
+    auto evaluator = app->getProcessorNetworkEvaluator();
+    auto trace = evaluator ? evaluator->getTrace() : nullptr;
     for (auto& task : job.tasks) {
-        getNetwork()->getApplication()->getThreadPool().enqueueRaw(std::move(task));
+        if (trace && trace->isEnabled()) {
+            task = [trace, id = getIdentifier(), task = std::move(task)]() {
+                EvaluationTrace::Scope scope(*trace, TraceEventType::BackgroundJob, id);
+                task();
+            };
+        }
+        app->getThreadPool().enqueueRaw(std::move(task), ThreadPool::Priority::High);
     }
 }
 
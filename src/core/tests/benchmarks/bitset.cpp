@@ -0,0 +1,162 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2021 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#include <inviwo/core/datastructures/bitset.h>
+
+#include <benchmark/benchmark.h>
+
+#include <random>
+#include <vector>
+
+namespace {
+
+using namespace inviwo;
+
+constexpr uint32_t universe = 1 << 24;
+
+/**
+ * Random indices in [0, universe) where each index is included with the given density
+ */
+std::vector<uint32_t> makeIndices(double density, unsigned int seed) {
+    std::mt19937 gen{seed};
+    std::geometric_distribution<uint32_t> gap{density};
+    std::vector<uint32_t> indices;
+    for (uint32_t i = gap(gen); i < universe; i += 1 + gap(gen)) indices.push_back(i);
+    return indices;
+}
+
+BitSet makeBitSet(double density, unsigned int seed) {
+    const auto indices = makeIndices(density, seed);
+    return BitSet(util::span<const uint32_t>(indices));
+}
+
+double density(benchmark::State& state) { return 1.0 / static_cast<double>(state.range(0)); }
+
+void Add(benchmark::State& state) {
+    const auto indices = makeIndices(density(state), 1);
+    for (auto _ : state) {
+        BitSet b;
+        b.add(util::span<const uint32_t>(indices));
+        benchmark::DoNotOptimize(b.cardinality());
+    }
+    state.SetItemsProcessed(state.iterations() * indices.size());
+}
+
+void AddSingle(benchmark::State& state) {
+    const auto indices = makeIndices(density(state), 1);
+    for (auto _ : state) {
+        BitSet b;
+        for (auto i : indices) b.add(i);
+        benchmark::DoNotOptimize(b.cardinality());
+    }
+    state.SetItemsProcessed(state.iterations() * indices.size());
+}
+
+void Contains(benchmark::State& state) {
+    const auto b = makeBitSet(density(state), 1);
+    const auto queries = makeIndices(density(state), 2);
+    for (auto _ : state) {
+        size_t count = 0;
+        for (auto i : queries) count += b.contains(i) ? 1 : 0;
+        benchmark::DoNotOptimize(count);
+    }
+    state.SetItemsProcessed(state.iterations() * queries.size());
+}
+
+void Iterate(benchmark::State& state) {
+    const auto b = makeBitSet(density(state), 1);
+    for (auto _ : state) {
+        uint64_t sum = 0;
+        for (auto i : b) sum += i;
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(state.iterations() * b.cardinality());
+}
+
+void Union(benchmark::State& state) {
+    const auto a = makeBitSet(density(state), 1);
+    const auto b = makeBitSet(density(state), 2);
+    for (auto _ : state) {
+        auto c = a | b;
+        benchmark::DoNotOptimize(c.cardinality());
+    }
+}
+
+void Intersection(benchmark::State& state) {
+    const auto a = makeBitSet(density(state), 1);
+    const auto b = makeBitSet(density(state), 2);
+    for (auto _ : state) {
+        auto c = a & b;
+        benchmark::DoNotOptimize(c.cardinality());
+    }
+}
+
+void AndCardinality(benchmark::State& state) {
+    const auto a = makeBitSet(density(state), 1);
+    const auto b = makeBitSet(density(state), 2);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(a.andCardinality(b));
+    }
+}
+
+void FastUnion(benchmark::State& state) {
+    std::vector<BitSet> sets;
+    for (unsigned int i = 0; i < 16; ++i) {
+        sets.push_back(makeBitSet(density(state), i + 1));
+    }
+    std::vector<const BitSet*> ptrs;
+    for (auto& s : sets) ptrs.push_back(&s);
+
+    for (auto _ : state) {
+        auto c = BitSet::fastUnion(ptrs);
+        benchmark::DoNotOptimize(c.cardinality());
+    }
+}
+
+void densityArgs(benchmark::internal::Benchmark* b) {
+    // One in every 2, 64, and 4096 indices is set
+    b->Arg(2)->Arg(64)->Arg(4096)->ArgName("sparsity")->Unit(benchmark::kMicrosecond);
+}
+
+}  // namespace
+
+BENCHMARK(Add)->Apply(densityArgs);
+BENCHMARK(AddSingle)->Apply(densityArgs);
+BENCHMARK(Contains)->Apply(densityArgs);
+BENCHMARK(Iterate)->Apply(densityArgs);
+BENCHMARK(Union)->Apply(densityArgs);
+BENCHMARK(Intersection)->Apply(densityArgs);
+BENCHMARK(AndCardinality)->Apply(densityArgs);
+BENCHMARK(FastUnion)->Apply(densityArgs);
+
+int main(int argc, char** argv) {
+    benchmark::Initialize(&argc, argv);
+    benchmark::RunSpecifiedBenchmarks();
+    return 0;
+}
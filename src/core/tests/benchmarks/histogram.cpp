@@ -0,0 +1,129 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2021 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#include <inviwo/core/datastructures/histogram.h>
+
+#include <benchmark/benchmark.h>
+
+#include <random>
+#include <vector>
+
+namespace {
+
+using namespace inviwo;
+
+constexpr size_t nValues = 1 << 22;
+
+template <typename T>
+std::vector<T> makeValues() {
+    std::mt19937 gen{1};
+    std::vector<T> values(nValues);
+    if constexpr (std::is_floating_point_v<T>) {
+        std::normal_distribution<T> dist{T{0}, T{1}};
+        for (auto& v : values) v = dist(gen);
+    } else {
+        std::uniform_int_distribution<int> dist{std::numeric_limits<T>::lowest(),
+                                                std::numeric_limits<T>::max()};
+        for (auto& v : values) v = static_cast<T>(dist(gen));
+    }
+    return values;
+}
+
+template <typename T>
+dvec2 dataRange() {
+    if constexpr (std::is_floating_point_v<T>) {
+        return dvec2{-4.0, 4.0};
+    } else {
+        return dvec2{std::numeric_limits<T>::lowest(), std::numeric_limits<T>::max()};
+    }
+}
+
+template <typename T>
+void Container(benchmark::State& state) {
+    const auto values = makeValues<T>();
+    const auto bins = static_cast<size_t>(state.range(0));
+
+    for (auto _ : state) {
+        HistogramContainer histograms(dataRange<T>(), bins, values.begin(), values.end());
+        benchmark::DoNotOptimize(histograms[0].getData().data());
+    }
+    state.SetItemsProcessed(state.iterations() * nValues);
+}
+
+template <typename T>
+void PartialMerge(benchmark::State& state) {
+    const auto values = makeValues<T>();
+    const auto parts = static_cast<size_t>(state.range(0));
+    const size_t partSize = nValues / parts;
+
+    for (auto _ : state) {
+        PartialHistogram total(dataRange<T>(), 256, DataFormat<T>::get());
+        for (size_t i = 0; i < parts; ++i) {
+            PartialHistogram part(dataRange<T>(), 256, DataFormat<T>::get());
+            part.add(values.begin() + i * partSize, values.begin() + (i + 1) * partSize);
+            total.merge(part);
+        }
+        benchmark::DoNotOptimize(total.getCount());
+    }
+    state.SetItemsProcessed(state.iterations() * nValues);
+}
+
+void Rebin(benchmark::State& state) {
+    const auto values = makeValues<std::uint16_t>();
+    PartialHistogram histogram(dataRange<std::uint16_t>(), 2048, DataUInt16::get());
+    histogram.add(values.begin(), values.end());
+
+    size_t bins = 256;
+    for (auto _ : state) {
+        histogram.rebin(dvec2{1000.0, 60000.0}, bins);
+        auto histograms = histogram.getHistograms();
+        benchmark::DoNotOptimize(histograms[0].getData().data());
+        bins = bins == 256 ? 512 : 256;
+    }
+}
+
+}  // namespace
+
+BENCHMARK_TEMPLATE(Container, float)->Arg(256)->Arg(2048)->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(Container, double)->Arg(256)->Arg(2048)->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(Container, std::uint8_t)->Arg(256)->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(Container, std::uint16_t)->Arg(256)->Arg(2048)->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(PartialMerge, float)->Arg(1)->Arg(16)->Arg(256)->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(PartialMerge, std::uint16_t)
+    ->Arg(1)
+    ->Arg(16)
+    ->Arg(256)
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK(Rebin)->Unit(benchmark::kMicrosecond);
+
+int main(int argc, char** argv) {
+    benchmark::Initialize(&argc, argv);
+    benchmark::RunSpecifiedBenchmarks();
+    return 0;
+}
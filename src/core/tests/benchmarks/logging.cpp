@@ -0,0 +1,134 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2021 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#include <inviwo/core/util/logcentral.h>
+
+#include <benchmark/benchmark.h>
+
+#include <chrono>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+using namespace inviwo;
+
+/**
+ * A logger that takes a given time per message, standing in for the console and file loggers
+ */
+class SlowLogger : public Logger {
+public:
+    explicit SlowLogger(std::chrono::nanoseconds delay) : delay_{delay} {}
+    virtual void log(std::string_view, LogLevel, LogAudience, std::string_view, std::string_view,
+                     int, std::string_view msg) override {
+        bytes += msg.size();
+        // Spin rather than sleep, sleeping is far too coarse for a microsecond
+        const auto end = std::chrono::steady_clock::now() + delay_;
+        while (std::chrono::steady_clock::now() < end) {
+        }
+    }
+    size_t bytes = 0;
+
+private:
+    std::chrono::nanoseconds delay_;
+};
+
+constexpr size_t messagesPerThread = 10000;
+
+/**
+ * Log messagesPerThread messages from each of a number of threads. Without flush only the time the
+ * logging threads are blocked is measured, with flush the time until all messages have reached
+ * the logger is included.
+ */
+template <bool async, bool format>
+void logThroughput(benchmark::State& state) {
+    const auto nThreads = static_cast<size_t>(state.range(0));
+    const auto delay = std::chrono::nanoseconds{state.range(1)};
+    const bool flush = state.range(2) != 0;
+
+    LogCentral lc;
+    auto logger = std::make_shared<SlowLogger>(delay);
+    lc.registerLogger(logger);
+    lc.setAsynchronous(async);
+
+    for (auto _ : state) {
+        std::vector<std::thread> threads;
+        for (size_t t = 0; t < nThreads; ++t) {
+            threads.emplace_back([&lc, t]() {
+                for (size_t i = 0; i < messagesPerThread; ++i) {
+                    if constexpr (format) {
+                        lc.logFormat("benchmark", LogLevel::Info, LogAudience::Developer,
+                                     __FILE__, __FUNCTION__, __LINE__, "Thread {} message {}", t,
+                                     i);
+                    } else {
+                        lc.log("benchmark", LogLevel::Info, LogAudience::Developer, __FILE__,
+                               __FUNCTION__, __LINE__,
+                               "Thread " + std::to_string(t) + " message " + std::to_string(i));
+                    }
+                }
+            });
+        }
+        for (auto& thread : threads) thread.join();
+        if (flush) lc.flush();
+    }
+
+    lc.setAsynchronous(false);
+    benchmark::DoNotOptimize(logger->bytes);
+    state.SetItemsProcessed(state.iterations() * nThreads * messagesPerThread);
+}
+
+void SyncLog(benchmark::State& state) { logThroughput<false, false>(state); }
+void AsyncLog(benchmark::State& state) { logThroughput<true, false>(state); }
+void SyncLogFormat(benchmark::State& state) { logThroughput<false, true>(state); }
+void AsyncLogFormat(benchmark::State& state) { logThroughput<true, true>(state); }
+
+void logArgs(benchmark::internal::Benchmark* b) {
+    b->ArgNames({"threads", "loggerNs", "flush"});
+    for (int threads : {1, 2, 4, 8}) {
+        for (int delay : {0, 1000}) {
+            for (int flush : {0, 1}) b->Args({threads, delay, flush});
+        }
+    }
+    b->UseRealTime()->Unit(benchmark::kMillisecond);
+}
+
+}  // namespace
+
+BENCHMARK(SyncLog)->Apply(logArgs);
+BENCHMARK(AsyncLog)->Apply(logArgs);
+BENCHMARK(SyncLogFormat)->Apply(logArgs);
+BENCHMARK(AsyncLogFormat)->Apply(logArgs);
+
+int main(int argc, char** argv) {
+    benchmark::Initialize(&argc, argv);
+    benchmark::RunSpecifiedBenchmarks();
+    return 0;
+}
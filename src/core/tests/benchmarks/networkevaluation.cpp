@@ -0,0 +1,201 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2021 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#include <inviwo/core/common/inviwoapplication.h>
+#include <inviwo/core/common/coremodulesharedlibrary.h>
+#include <inviwo/core/network/processornetwork.h>
+#include <inviwo/core/network/processornetworkevaluator.h>
+#include <inviwo/core/network/networklock.h>
+#include <inviwo/core/processors/processor.h>
+#include <inviwo/core/ports/datainport.h>
+#include <inviwo/core/ports/dataoutport.h>
+#include <inviwo/core/util/logcentral.h>
+
+#include <benchmark/benchmark.h>
+
+#include <cmath>
+
+namespace {
+
+using namespace inviwo;
+
+double work(size_t iterations) {
+    double sum = 0.0;
+    for (size_t i = 0; i < iterations; ++i) {
+        sum += std::sqrt(static_cast<double>(i));
+    }
+    return sum;
+}
+
+/**
+ * A processor that spends some time in process and passes on a value, the inport accepts any
+ * number of connections
+ */
+class WorkProcessor : public Processor {
+public:
+    WorkProcessor(const std::string& id, size_t workSize, bool hasInport, bool hasOutport)
+        : Processor(id, id), workSize_{workSize} {
+        if (hasInport) addPort(inport_);
+        if (hasOutport) addPort(outport_);
+    }
+    virtual const ProcessorInfo getProcessorInfo() const override { return processorInfo_; }
+
+    virtual void process() override {
+        auto res = work(workSize_);
+        if (inport_.hasData()) res += *inport_.getData();
+        if (outport_.getProcessor()) outport_.setData(std::make_shared<double>(res));
+        benchmark::DoNotOptimize(res);
+    }
+
+    static const ProcessorInfo processorInfo_;
+
+    DataInport<double, 0> inport_{"in"};
+    DataOutport<double> outport_{"out"};
+
+private:
+    size_t workSize_;
+};
+
+const ProcessorInfo WorkProcessor::processorInfo_{
+    "org.inviwo.WorkProcessor",  // Class identifier
+    "Work Processor",            // Display name
+    "Benchmark",                 // Category
+    CodeState::Stable,           // Code state
+    Tags::CPU | Tag::Concurrent  // Tags
+};
+
+/**
+ * Evaluate a network of independent branches source -> filter -> sink
+ */
+void evaluateBranches(benchmark::State& state, EvaluationMode mode) {
+    const auto branches = static_cast<size_t>(state.range(0));
+    const auto workSize = static_cast<size_t>(state.range(1));
+
+    auto app = InviwoApplication::getPtr();
+    ProcessorNetwork network{app};
+    ProcessorNetworkEvaluator evaluator{&network};
+    evaluator.setEvaluationMode(mode);
+
+    std::vector<Processor*> sources;
+    {
+        NetworkLock lock(&network);
+        for (size_t i = 0; i < branches; ++i) {
+            const auto id = std::to_string(i);
+            auto source = static_cast<WorkProcessor*>(network.addProcessor(
+                std::make_unique<WorkProcessor>("source" + id, workSize, false, true)));
+            auto filter = static_cast<WorkProcessor*>(network.addProcessor(
+                std::make_unique<WorkProcessor>("filter" + id, workSize, true, true)));
+            auto sink = static_cast<WorkProcessor*>(network.addProcessor(
+                std::make_unique<WorkProcessor>("sink" + id, workSize, true, false)));
+            network.addConnection(&source->outport_, &filter->inport_);
+            network.addConnection(&filter->outport_, &sink->inport_);
+            sources.push_back(source);
+        }
+    }
+
+    for (auto _ : state) {
+        NetworkLock lock(&network);
+        for (auto source : sources) source->invalidate(InvalidationLevel::InvalidOutput);
+    }
+    state.SetItemsProcessed(state.iterations() * branches * 3);
+}
+
+void Sequential(benchmark::State& state) { evaluateBranches(state, EvaluationMode::Sequential); }
+void Parallel(benchmark::State& state) { evaluateBranches(state, EvaluationMode::Parallel); }
+
+void branchArgs(benchmark::internal::Benchmark* b) {
+    for (int64_t branches : {1, 2, 4, 8}) {
+        for (int64_t workSize : {100, 10000, 1000000}) {
+            b->Args({branches, workSize});
+        }
+    }
+    b->ArgNames({"branches", "work"})->UseRealTime()->Unit(benchmark::kMicrosecond);
+}
+
+/**
+ * Build a layered network of processors, where each processor is connected to two processors
+ * of the previous layer, and evaluate it once. The connections are added from the sinks up, the
+ * worst case for keeping the processors sorted.
+ */
+void Build(benchmark::State& state) {
+    const auto size = static_cast<size_t>(state.range(0));
+    const size_t width = 16;
+    const size_t layers = size / width;
+
+    auto app = InviwoApplication::getPtr();
+    for (auto _ : state) {
+        ProcessorNetwork network{app};
+        ProcessorNetworkEvaluator evaluator{&network};
+        {
+            NetworkLock lock(&network);
+            std::vector<WorkProcessor*> processors;
+            for (size_t i = 0; i < layers * width; ++i) {
+                const auto layer = i / width;
+                processors.push_back(static_cast<WorkProcessor*>(
+                    network.addProcessor(std::make_unique<WorkProcessor>(
+                        "p" + std::to_string(i), 0, layer != 0, layer + 1 != layers))));
+            }
+            for (size_t layer = layers - 1; layer > 0; --layer) {
+                for (size_t j = 0; j < width; ++j) {
+                    auto dst = processors[layer * width + j];
+                    auto src1 = processors[(layer - 1) * width + j];
+                    auto src2 = processors[(layer - 1) * width + (j + 1) % width];
+                    network.addConnection(&src1->outport_, &dst->inport_);
+                    network.addConnection(&src2->outport_, &dst->inport_);
+                }
+            }
+        }
+        state.PauseTiming();
+        network.clear();
+        state.ResumeTiming();
+    }
+    state.SetItemsProcessed(state.iterations() * layers * width);
+}
+
+}  // namespace
+
+BENCHMARK(Sequential)->Apply(branchArgs);
+BENCHMARK(Parallel)->Apply(branchArgs);
+BENCHMARK(Build)->Arg(256)->Arg(1024)->Arg(4096)->ArgName("processors")->Unit(
+    benchmark::kMillisecond);
+
+int main(int argc, char** argv) {
+    LogCentral::init();
+    InviwoApplication app(argc, argv, "Inviwo-Benchmark-NetworkEvaluation");
+    {
+        std::vector<std::unique_ptr<InviwoModuleFactoryObject>> modules;
+        modules.emplace_back(createInviwoCore());
+        app.registerModules(std::move(modules));
+    }
+    app.processFront();
+
+    benchmark::Initialize(&argc, argv);
+    benchmark::RunSpecifiedBenchmarks();
+    return 0;
+}
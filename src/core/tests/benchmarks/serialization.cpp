@@ -0,0 +1,135 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2021 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#include <inviwo/core/io/serialization/serialization.h>
+#include <inviwo/core/util/filesystem.h>
+
+#include <benchmark/benchmark.h>
+
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace {
+
+using namespace inviwo;
+
+struct Item : public Serializable {
+    std::string name;
+    int id = 0;
+    dvec3 position{0.0};
+    vec4 color{0.0f};
+    bool enabled = true;
+
+    virtual void serialize(Serializer& s) const override {
+        s.serialize("name", name);
+        s.serialize("id", id);
+        s.serialize("position", position);
+        s.serialize("color", color);
+        s.serialize("enabled", enabled);
+    }
+    virtual void deserialize(Deserializer& d) override {
+        d.deserialize("name", name);
+        d.deserialize("id", id);
+        d.deserialize("position", position);
+        d.deserialize("color", color);
+        d.deserialize("enabled", enabled);
+    }
+};
+
+std::vector<Item> makeItems(size_t count) {
+    std::mt19937 gen{1};
+    std::uniform_real_distribution<double> dist{-1.0, 1.0};
+    std::vector<Item> items(count);
+    for (size_t i = 0; i < count; ++i) {
+        items[i].name = "item" + std::to_string(i);
+        items[i].id = static_cast<int>(i);
+        items[i].position = dvec3{dist(gen), dist(gen), dist(gen)};
+        items[i].color = vec4{dist(gen), dist(gen), dist(gen), 1.0};
+    }
+    return items;
+}
+
+std::string serialize(const std::string& refPath, const std::vector<Item>& items) {
+    Serializer serializer(refPath);
+    serializer.serialize("Items", items, "Item");
+    std::stringstream ss;
+    serializer.writeFile(ss);
+    return ss.str();
+}
+
+void Serialize(benchmark::State& state) {
+    const auto refPath = filesystem::findBasePath();
+    const auto items = makeItems(static_cast<size_t>(state.range(0)));
+    for (auto _ : state) {
+        auto str = serialize(refPath, items);
+        benchmark::DoNotOptimize(str.data());
+    }
+    state.SetItemsProcessed(state.iterations() * items.size());
+}
+
+void Deserialize(benchmark::State& state) {
+    const auto refPath = filesystem::findBasePath();
+    const auto str = serialize(refPath, makeItems(static_cast<size_t>(state.range(0))));
+    for (auto _ : state) {
+        std::stringstream ss{str};
+        Deserializer deserializer(ss, refPath);
+        std::vector<Item> items;
+        deserializer.deserialize("Items", items, "Item");
+        benchmark::DoNotOptimize(items.data());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+    state.SetBytesProcessed(state.iterations() * str.size());
+}
+
+void RoundTrip(benchmark::State& state) {
+    const auto refPath = filesystem::findBasePath();
+    const auto items = makeItems(static_cast<size_t>(state.range(0)));
+    for (auto _ : state) {
+        std::stringstream ss{serialize(refPath, items)};
+        Deserializer deserializer(ss, refPath);
+        std::vector<Item> result;
+        deserializer.deserialize("Items", result, "Item");
+        benchmark::DoNotOptimize(result.data());
+    }
+    state.SetItemsProcessed(state.iterations() * items.size());
+}
+
+}  // namespace
+
+BENCHMARK(Serialize)->RangeMultiplier(10)->Range(10, 10000)->Unit(benchmark::kMicrosecond);
+BENCHMARK(Deserialize)->RangeMultiplier(10)->Range(10, 10000)->Unit(benchmark::kMicrosecond);
+BENCHMARK(RoundTrip)->RangeMultiplier(10)->Range(10, 10000)->Unit(benchmark::kMicrosecond);
+
+int main(int argc, char** argv) {
+    benchmark::Initialize(&argc, argv);
+    benchmark::RunSpecifiedBenchmarks();
+    return 0;
+}
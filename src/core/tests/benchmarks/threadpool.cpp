@@ -0,0 +1,219 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2021 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#include <inviwo/core/util/threadpool.h>
+
+#include <benchmark/benchmark.h>
+
+#include <queue>
+#include <numeric>
+#include <cmath>
+
+namespace {
+
+using namespace inviwo;
+
+/**
+ * The previous single queue thread pool, one mutex and a std::queue of std::function. Kept here to
+ * compare against.
+ */
+class LockedQueuePool {
+public:
+    LockedQueuePool(size_t threads) {
+        for (size_t i = 0; i < threads; ++i) {
+            workers_.emplace_back([this]() {
+                for (;;) {
+                    std::function<void()> task;
+                    {
+                        std::unique_lock<std::mutex> lock(mutex_);
+                        condition_.wait(lock, [this] { return stop_ || !tasks_.empty(); });
+                        if (stop_ && tasks_.empty()) return;
+                        task = std::move(tasks_.front());
+                        tasks_.pop();
+                    }
+                    task();
+                }
+            });
+        }
+    }
+    ~LockedQueuePool() {
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            stop_ = true;
+        }
+        condition_.notify_all();
+        for (auto& worker : workers_) worker.join();
+    }
+
+    template <class F>
+    auto enqueue(F&& f) -> std::future<std::invoke_result_t<F>> {
+        using return_type = std::invoke_result_t<F>;
+        auto task = std::make_shared<std::packaged_task<return_type()>>(std::forward<F>(f));
+        std::future<return_type> res = task->get_future();
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            tasks_.emplace([task]() { (*task)(); });
+        }
+        condition_.notify_one();
+        return res;
+    }
+
+private:
+    std::vector<std::thread> workers_;
+    std::queue<std::function<void()>> tasks_;
+    std::mutex mutex_;
+    std::condition_variable condition_;
+    bool stop_ = false;
+};
+
+double work(size_t iterations) {
+    double sum = 0.0;
+    for (size_t i = 0; i < iterations; ++i) {
+        sum += std::sqrt(static_cast<double>(i));
+    }
+    return sum;
+}
+
+constexpr size_t nTasks = 4096;
+
+template <typename Pool>
+void enqueueFromOutside(benchmark::State& state) {
+    const auto threads = static_cast<size_t>(state.range(0));
+    const auto taskSize = static_cast<size_t>(state.range(1));
+    Pool pool(threads);
+    std::vector<std::future<double>> futures;
+    futures.reserve(nTasks);
+
+    for (auto _ : state) {
+        futures.clear();
+        for (size_t i = 0; i < nTasks; ++i) {
+            futures.push_back(pool.enqueue([taskSize]() { return work(taskSize); }));
+        }
+        double sum = 0.0;
+        for (auto& f : futures) sum += f.get();
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(state.iterations() * nTasks);
+}
+
+template <typename Pool>
+void enqueueNested(benchmark::State& state) {
+    const auto threads = static_cast<size_t>(state.range(0));
+    const auto taskSize = static_cast<size_t>(state.range(1));
+    constexpr size_t nOuter = 16;
+    Pool pool(threads);
+
+    for (auto _ : state) {
+        std::vector<std::future<std::vector<std::future<double>>>> outer;
+        for (size_t j = 0; j < nOuter; ++j) {
+            outer.push_back(pool.enqueue([&pool, taskSize]() {
+                std::vector<std::future<double>> inner;
+                inner.reserve(nTasks / nOuter);
+                for (size_t i = 0; i < nTasks / nOuter; ++i) {
+                    inner.push_back(pool.enqueue([taskSize]() { return work(taskSize); }));
+                }
+                return inner;
+            }));
+        }
+        double sum = 0.0;
+        for (auto& o : outer) {
+            for (auto& f : o.get()) sum += f.get();
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(state.iterations() * nTasks);
+}
+
+void ThreadPoolOutside(benchmark::State& state) { enqueueFromOutside<ThreadPool>(state); }
+void LockedQueueOutside(benchmark::State& state) { enqueueFromOutside<LockedQueuePool>(state); }
+void ThreadPoolNested(benchmark::State& state) { enqueueNested<ThreadPool>(state); }
+void LockedQueueNested(benchmark::State& state) { enqueueNested<LockedQueuePool>(state); }
+
+template <typename Pool>
+void enqueueLatency(benchmark::State& state) {
+    const auto threads = static_cast<size_t>(state.range(0));
+    Pool pool(threads);
+
+    // Round trip of a single trivial task through an idle pool
+    for (auto _ : state) {
+        auto res = pool.enqueue([]() { return 1; }).get();
+        benchmark::DoNotOptimize(res);
+    }
+}
+
+void ThreadPoolLatency(benchmark::State& state) { enqueueLatency<ThreadPool>(state); }
+void LockedQueueLatency(benchmark::State& state) { enqueueLatency<LockedQueuePool>(state); }
+
+void ThreadPoolPriority(benchmark::State& state) {
+    const auto threads = static_cast<size_t>(state.range(0));
+    ThreadPool pool(threads);
+
+    // Measure the latency of a high priority task while the pool is busy with background work
+    for (auto _ : state) {
+        state.PauseTiming();
+        std::vector<std::future<double>> background;
+        for (size_t i = 0; i < nTasks; ++i) {
+            background.push_back(
+                pool.enqueue(ThreadPool::Priority::Low, []() { return work(10000); }));
+        }
+        state.ResumeTiming();
+
+        auto res = pool.enqueue(ThreadPool::Priority::High, []() { return work(10); }).get();
+        benchmark::DoNotOptimize(res);
+
+        state.PauseTiming();
+        for (auto& f : background) f.wait();
+        state.ResumeTiming();
+    }
+}
+
+void taskArgs(benchmark::internal::Benchmark* b) {
+    for (int64_t threads : {1, 2, 4, 8}) {
+        for (int64_t taskSize : {1, 100, 10000}) {
+            b->Args({threads, taskSize});
+        }
+    }
+    b->ArgNames({"threads", "work"})->UseRealTime()->Unit(benchmark::kMicrosecond);
+}
+
+}  // namespace
+
+BENCHMARK(ThreadPoolOutside)->Apply(taskArgs);
+BENCHMARK(LockedQueueOutside)->Apply(taskArgs);
+BENCHMARK(ThreadPoolNested)->Apply(taskArgs);
+BENCHMARK(LockedQueueNested)->Apply(taskArgs);
+BENCHMARK(ThreadPoolLatency)->Arg(1)->Arg(4)->UseRealTime()->Unit(benchmark::kMicrosecond);
+BENCHMARK(LockedQueueLatency)->Arg(1)->Arg(4)->UseRealTime()->Unit(benchmark::kMicrosecond);
+BENCHMARK(ThreadPoolPriority)->Arg(2)->Arg(4)->Arg(8)->UseRealTime()->Unit(benchmark::kMicrosecond);
+
+int main(int argc, char** argv) {
+    benchmark::Initialize(&argc, argv);
+    benchmark::RunSpecifiedBenchmarks();
+    return 0;
+}
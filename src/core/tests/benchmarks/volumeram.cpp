@@ -0,0 +1,159 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2021 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#include <inviwo/core/common/inviwoapplication.h>
+#include <inviwo/core/datastructures/volume/volume.h>
+#include <inviwo/core/datastructures/volume/volumeramprecision.h>
+#include <inviwo/core/util/formatdispatching.h>
+#include <inviwo/core/util/indexmapper.h>
+#include <inviwo/core/util/logcentral.h>
+#include <inviwo/core/util/volumeramutils.h>
+
+#include <benchmark/benchmark.h>
+
+#include <random>
+
+namespace {
+
+using namespace inviwo;
+
+template <typename T>
+std::shared_ptr<VolumeRAMPrecision<T>> makeVolume(size_t size) {
+    auto ram = std::make_shared<VolumeRAMPrecision<T>>(size3_t{size});
+    auto data = ram->getDataTyped();
+    std::mt19937 gen{1};
+    std::uniform_real_distribution<double> dist{0.0, 100.0};
+    for (size_t i = 0; i < size * size * size; ++i) {
+        data[i] = util::glm_convert<T>(dvec4{dist(gen), dist(gen), dist(gen), dist(gen)});
+    }
+    return ram;
+}
+
+// Sum of all voxels through the virtual per voxel access
+template <typename T>
+void GetAsDVec4(benchmark::State& state) {
+    const auto size = static_cast<size_t>(state.range(0));
+    const auto ram = makeVolume<T>(size);
+    const VolumeRAM& base = *ram;
+
+    for (auto _ : state) {
+        dvec4 sum{0.0};
+        for (size_t z = 0; z < size; ++z) {
+            for (size_t y = 0; y < size; ++y) {
+                for (size_t x = 0; x < size; ++x) {
+                    sum += base.getAsDVec4(size3_t{x, y, z});
+                }
+            }
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(state.iterations() * size * size * size);
+}
+
+// Sum of all voxels after dispatching on the data format once
+template <typename T>
+void Dispatch(benchmark::State& state) {
+    const auto size = static_cast<size_t>(state.range(0));
+    const auto ram = makeVolume<T>(size);
+    const VolumeRAM& base = *ram;
+
+    for (auto _ : state) {
+        const auto sum = base.dispatch<dvec4>([](auto vrprecision) {
+            const auto data = vrprecision->getDataTyped();
+            const auto count = glm::compMul(vrprecision->getDimensions());
+            dvec4 res{0.0};
+            for (size_t i = 0; i < count; ++i) {
+                res += util::glm_convert<dvec4>(data[i]);
+            }
+            return res;
+        });
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(state.iterations() * size * size * size);
+}
+
+template <typename T>
+void ForEachVoxel(benchmark::State& state) {
+    const auto size = static_cast<size_t>(state.range(0));
+    const auto ram = makeVolume<T>(size);
+    const auto data = ram->getDataTyped();
+    const util::IndexMapper3D index(ram->getDimensions());
+    std::vector<double> result(size * size * size);
+
+    for (auto _ : state) {
+        util::forEachVoxel(*ram, [&](const size3_t& pos) {
+            const auto i = index(pos);
+            result[i] = util::glm_convert<dvec4>(data[i]).x;
+        });
+        benchmark::DoNotOptimize(result.data());
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * size * size * size);
+}
+
+template <typename T>
+void ForEachVoxelParallel(benchmark::State& state) {
+    const auto size = static_cast<size_t>(state.range(0));
+    const auto ram = makeVolume<T>(size);
+    const auto data = ram->getDataTyped();
+    const util::IndexMapper3D index(ram->getDimensions());
+    std::vector<double> result(size * size * size);
+
+    for (auto _ : state) {
+        util::forEachVoxelParallel(*ram, [&](const size3_t& pos) {
+            const auto i = index(pos);
+            result[i] = util::glm_convert<dvec4>(data[i]).x;
+        });
+        benchmark::DoNotOptimize(result.data());
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * size * size * size);
+}
+
+void volumeArgs(benchmark::internal::Benchmark* b) {
+    b->RangeMultiplier(4)->Range(16, 256)->Unit(benchmark::kMillisecond);
+}
+
+}  // namespace
+
+BENCHMARK_TEMPLATE(GetAsDVec4, float)->Apply(volumeArgs);
+BENCHMARK_TEMPLATE(GetAsDVec4, glm::u8vec4)->Apply(volumeArgs);
+BENCHMARK_TEMPLATE(Dispatch, float)->Apply(volumeArgs);
+BENCHMARK_TEMPLATE(Dispatch, glm::u8vec4)->Apply(volumeArgs);
+BENCHMARK_TEMPLATE(ForEachVoxel, float)->Apply(volumeArgs);
+BENCHMARK_TEMPLATE(ForEachVoxelParallel, float)->Apply(volumeArgs)->UseRealTime();
+
+int main(int argc, char** argv) {
+    LogCentral::init();
+    InviwoApplication app(argc, argv, "Inviwo-Benchmark-VolumeRAM");
+
+    benchmark::Initialize(&argc, argv);
+    benchmark::RunSpecifiedBenchmarks();
+    return 0;
+}
@@ -0,0 +1,157 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2021 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#include <inviwo/core/datastructures/volume/volume.h>
+#include <inviwo/core/datastructures/volume/volumeramprecision.h>
+#include <inviwo/core/util/volumesampler.h>
+#include <inviwo/core/util/interpolation.h>
+
+#include <benchmark/benchmark.h>
+
+#include <random>
+#include <vector>
+
+namespace {
+
+using namespace inviwo;
+
+/**
+ * The previous VolumeDoubleSampler<3> implementation using one virtual VolumeRAM::getAsDVec3 call
+ * per voxel. Kept here to compare against.
+ */
+class VirtualVolumeSampler {
+public:
+    VirtualVolumeSampler(const Volume& volume)
+        : ram_{volume.getRepresentation<VolumeRAM>()}, dims_{volume.getDimensions()} {}
+
+    dvec3 sample(const dvec3& pos) const {
+        if (glm::any(glm::lessThan(pos, dvec3(0.0))) ||
+            glm::any(glm::greaterThan(pos, dvec3(1.0)))) {
+            return dvec3(0.0);
+        }
+        const dvec3 samplePos = pos * dvec3(dims_ - size3_t(1));
+        const size3_t indexPos = size3_t(samplePos);
+        const dvec3 interpolants = samplePos - dvec3(indexPos);
+
+        dvec3 samples[8];
+        samples[0] = getVoxel(indexPos);
+        samples[1] = getVoxel(indexPos + size3_t(1, 0, 0));
+        samples[2] = getVoxel(indexPos + size3_t(0, 1, 0));
+        samples[3] = getVoxel(indexPos + size3_t(1, 1, 0));
+        samples[4] = getVoxel(indexPos + size3_t(0, 0, 1));
+        samples[5] = getVoxel(indexPos + size3_t(1, 0, 1));
+        samples[6] = getVoxel(indexPos + size3_t(0, 1, 1));
+        samples[7] = getVoxel(indexPos + size3_t(1, 1, 1));
+
+        return Interpolation<dvec3>::trilinear(samples, interpolants);
+    }
+
+private:
+    dvec3 getVoxel(const size3_t& pos) const {
+        const auto p = glm::clamp(pos, size3_t(0), dims_ - size3_t(1));
+        return ram_->getAsDVec3(p);
+    }
+
+    const VolumeRAM* ram_;
+    size3_t dims_;
+};
+
+std::shared_ptr<Volume> makeVolume(size_t size) {
+    auto ram = std::make_shared<VolumeRAMPrecision<vec3>>(size3_t{size});
+    auto data = ram->getDataTyped();
+    std::mt19937 gen{1};
+    std::uniform_real_distribution<float> dist{-1.0f, 1.0f};
+    for (size_t i = 0; i < size * size * size; ++i) {
+        data[i] = vec3{dist(gen), dist(gen), dist(gen)};
+    }
+    return std::make_shared<Volume>(ram);
+}
+
+std::vector<dvec3> makePositions(size_t count) {
+    std::mt19937 gen{2};
+    std::uniform_real_distribution<double> dist{0.0, 1.0};
+    std::vector<dvec3> positions(count);
+    for (auto& p : positions) p = dvec3{dist(gen), dist(gen), dist(gen)};
+    return positions;
+}
+
+constexpr size_t nSamples = 1 << 16;
+
+void VirtualSampler(benchmark::State& state) {
+    const auto volume = makeVolume(static_cast<size_t>(state.range(0)));
+    const auto positions = makePositions(nSamples);
+    VirtualVolumeSampler sampler(*volume);
+
+    for (auto _ : state) {
+        dvec3 sum{0.0};
+        for (const auto& p : positions) sum += sampler.sample(p);
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(state.iterations() * nSamples);
+}
+
+void DispatchedSampler(benchmark::State& state) {
+    const auto volume = makeVolume(static_cast<size_t>(state.range(0)));
+    const auto positions = makePositions(nSamples);
+    const VolumeDoubleSampler<3> sampler(*volume);
+    const SpatialSampler<3, 3, double>& base = sampler;
+
+    for (auto _ : state) {
+        dvec3 sum{0.0};
+        for (const auto& p : positions) sum += base.sample(p);
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(state.iterations() * nSamples);
+}
+
+void BatchSampler(benchmark::State& state) {
+    const auto volume = makeVolume(static_cast<size_t>(state.range(0)));
+    const auto positions = makePositions(nSamples);
+    const VolumeDoubleSampler<3> sampler(*volume);
+    std::vector<dvec3> result(nSamples);
+
+    for (auto _ : state) {
+        sampler.sample(positions, result);
+        benchmark::DoNotOptimize(result.data());
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * nSamples);
+}
+
+}  // namespace
+
+BENCHMARK(VirtualSampler)->RangeMultiplier(4)->Range(16, 256);
+BENCHMARK(DispatchedSampler)->RangeMultiplier(4)->Range(16, 256);
+BENCHMARK(BatchSampler)->RangeMultiplier(4)->Range(16, 256);
+
+int main(int argc, char** argv) {
+    benchmark::Initialize(&argc, argv);
+    benchmark::RunSpecifiedBenchmarks();
+    return 0;
+}
@@ -0,0 +1,138 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2021 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#include <warn/push>
+#include <warn/ignore/all>
+#include <gtest/gtest.h>
+#include <warn/pop>
+
+#include <inviwo/core/util/dynamictopologicalorder.h>
+
+#include <algorithm>
+#include <numeric>
+#include <random>
+#include <set>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace inviwo {
+
+namespace {
+
+bool isTopological(const util::DynamicTopologicalOrder<int>& order,
+                   const std::multiset<std::pair<int, int>>& edges) {
+    const auto nodes = order.getOrder();
+    std::unordered_map<int, size_t> pos;
+    for (size_t i = 0; i < nodes.size(); ++i) pos[nodes[i]] = i;
+    return std::all_of(edges.begin(), edges.end(),
+                       [&](const auto& e) { return pos.at(e.first) < pos.at(e.second); });
+}
+
+}  // namespace
+
+TEST(DynamicTopologicalOrder, Reorder) {
+    util::DynamicTopologicalOrder<int> order;
+    for (int i = 0; i < 5; ++i) order.addNode(i);
+    EXPECT_EQ(std::vector<int>({0, 1, 2, 3, 4}), order.getOrder());
+
+    order.addEdge(4, 0);
+    order.addEdge(3, 4);
+    EXPECT_EQ(std::vector<int>({3, 1, 2, 4, 0}), order.getOrder());
+    EXPECT_FALSE(order.hasCycle());
+
+    order.removeNode(2);
+    EXPECT_EQ(std::vector<int>({3, 1, 4, 0}), order.getOrder());
+    EXPECT_FALSE(order.hasNode(2));
+    EXPECT_EQ(4u, order.size());
+}
+
+TEST(DynamicTopologicalOrder, Cycle) {
+    util::DynamicTopologicalOrder<int> order;
+    order.addEdge(0, 1);
+    order.addEdge(1, 2);
+    order.addEdge(2, 0);
+    EXPECT_TRUE(order.hasCycle());
+
+    // duplicated edges have to be removed twice
+    order.addEdge(2, 0);
+    order.removeEdge(2, 0);
+    EXPECT_TRUE(order.hasCycle());
+    order.removeEdge(2, 0);
+    EXPECT_FALSE(order.hasCycle());
+    EXPECT_EQ(std::vector<int>({0, 1, 2}), order.getOrder());
+
+    order.addEdge(1, 1);
+    EXPECT_TRUE(order.hasCycle());
+    order.removeNode(1);
+    EXPECT_FALSE(order.hasCycle());
+}
+
+TEST(DynamicTopologicalOrder, Random) {
+    std::mt19937 gen;
+    gen.seed(1);
+
+    for (bool batch : {false, true}) {
+        SCOPED_TRACE(batch ? "Batch" : "Incremental");
+        util::DynamicTopologicalOrder<int> order;
+        std::multiset<std::pair<int, int>> edges;
+
+        // a random dag where edges go from lower to higher values, added in random order
+        const int nodes = 200;
+        std::vector<int> perm(nodes);
+        std::iota(perm.begin(), perm.end(), 0);
+        std::shuffle(perm.begin(), perm.end(), gen);
+        for (auto i : perm) order.addNode(i);
+
+        std::uniform_int_distribution<int> dist(0, nodes - 1);
+        if (batch) order.beginBatch();
+        for (int i = 0; i < 1000; ++i) {
+            auto a = dist(gen);
+            auto b = dist(gen);
+            if (a == b) continue;
+            if (a > b) std::swap(a, b);
+            order.addEdge(a, b);
+            edges.emplace(a, b);
+            if (!batch) ASSERT_TRUE(isTopological(order, edges));
+        }
+        if (batch) order.endBatch();
+        EXPECT_FALSE(order.hasCycle());
+        EXPECT_TRUE(isTopological(order, edges));
+
+        for (int i = 0; i < 100; ++i) {
+            auto it = std::next(edges.begin(), std::uniform_int_distribution<size_t>(
+                                                   0, edges.size() - 1)(gen));
+            order.removeEdge(it->first, it->second);
+            edges.erase(it);
+        }
+        EXPECT_TRUE(isTopological(order, edges));
+    }
+}
+
+}  // namespace inviwo
@@ -0,0 +1,144 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2021 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#include <warn/push>
+#include <warn/ignore/all>
+#include <gtest/gtest.h>
+#include <warn/pop>
+
+#include <inviwo/core/util/evaluationtrace.h>
+
+#include <sstream>
+#include <string>
+#include <thread>
+
+namespace inviwo {
+
+namespace {
+
+TraceEvent makeEvent(const std::string& name) {
+    return {TraceEventType::Process, name, EvaluationTrace::clock::now(),
+            std::chrono::milliseconds{1}, 0, 0, 0};
+}
+
+}  // namespace
+
+TEST(EvaluationTrace, RingBuffer) {
+    EvaluationTrace trace(3);
+    for (auto name : {"a", "b", "c", "d", "e"}) trace.record(makeEvent(name));
+
+    EXPECT_EQ(3u, trace.size());
+    auto events = trace.getEvents();
+    ASSERT_EQ(3u, events.size());
+    EXPECT_EQ("c", events[0].name);
+    EXPECT_EQ("d", events[1].name);
+    EXPECT_EQ("e", events[2].name);
+
+    trace.setCapacity(2);
+    events = trace.getEvents();
+    ASSERT_EQ(2u, events.size());
+    EXPECT_EQ("d", events[0].name);
+    EXPECT_EQ("e", events[1].name);
+
+    trace.record(makeEvent("f"));
+    events = trace.getEvents();
+    ASSERT_EQ(2u, events.size());
+    EXPECT_EQ("e", events[0].name);
+    EXPECT_EQ("f", events[1].name);
+
+    trace.clear();
+    EXPECT_EQ(0u, trace.size());
+}
+
+TEST(EvaluationTrace, Scope) {
+    EvaluationTrace trace;
+    { EvaluationTrace::Scope scope(trace, TraceEventType::Process, "disabled"); }
+    EXPECT_EQ(0u, trace.size());
+
+    trace.setEnabled(true);
+    {
+        EvaluationTrace::Scope scope(trace, TraceEventType::Process, "enabled");
+        EvaluationTrace::countConversion(16);
+        EvaluationTrace::countConversion(0);
+    }
+    {
+        EvaluationTrace::Scope scope(trace, TraceEventType::Evaluation);
+        // Conversions of other threads only count for evaluations
+        std::thread{[]() { EvaluationTrace::countConversion(8); }}.join();
+    }
+
+    const auto events = trace.getEvents();
+    ASSERT_EQ(2u, events.size());
+    EXPECT_EQ("enabled", events[0].name);
+    EXPECT_EQ(TraceEventType::Process, events[0].type);
+    EXPECT_EQ(2u, events[0].conversions);
+    EXPECT_EQ(16u, events[0].bytes);
+    EXPECT_EQ(EvaluationTrace::getThreadId(), events[0].thread);
+
+    EXPECT_EQ(TraceEventType::Evaluation, events[1].type);
+    EXPECT_EQ(1u, events[1].conversions);
+    EXPECT_EQ(8u, events[1].bytes);
+}
+
+TEST(EvaluationTrace, ChromeTrace) {
+    EvaluationTrace trace;
+    trace.record(makeEvent("a \"quoted\" name"));
+    trace.record({TraceEventType::Evaluation, "", EvaluationTrace::clock::now(),
+                  std::chrono::microseconds{5}, 1, 2, 3});
+    // Hours after the epoch, the timestamp still needs microsecond resolution
+    const std::chrono::microseconds farOffset{12345678901};
+    trace.record({TraceEventType::Process, "far", EvaluationTrace::clock::now() + farOffset,
+                  std::chrono::microseconds{1}, 0, 0, 0});
+
+    std::stringstream ss;
+    trace.writeChromeTrace(ss);
+    const auto json = ss.str();
+
+    EXPECT_EQ(0u, json.find("{\"traceEvents\":["));
+    EXPECT_NE(std::string::npos, json.find("\"name\":\"a \\\"quoted\\\" name\""));
+    EXPECT_NE(std::string::npos, json.find("\"name\":\"Evaluation\",\"cat\":\"Evaluation\""));
+    EXPECT_NE(std::string::npos, json.find("\"dur\":5.000,"));
+    EXPECT_NE(std::string::npos, json.find("\"args\":{\"conversions\":2,\"bytes\":3}"));
+
+    const auto far = json.find("\"name\":\"far\"");
+    ASSERT_NE(std::string::npos, far);
+    const auto tsBegin = json.find("\"ts\":", far) + 5;
+    const auto ts = json.substr(tsBegin, json.find(',', tsBegin) - tsBegin);
+    EXPECT_EQ(std::string::npos, ts.find_first_of("eE")) << ts;
+    ASSERT_NE(std::string::npos, ts.find('.')) << ts;
+    EXPECT_EQ(3u, ts.size() - ts.find('.') - 1) << ts;
+    EXPECT_GE(std::stod(ts), static_cast<double>(farOffset.count()));
+    EXPECT_LT(std::stod(ts), static_cast<double>(farOffset.count()) + 60.0e6);
+
+    // The flags of the stream are restored
+    ss << 0.5;
+    EXPECT_EQ("0.5", ss.str().substr(json.size()));
+}
+
+}  // namespace inviwo
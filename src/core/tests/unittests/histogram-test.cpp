@@ -0,0 +1,123 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2021 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#include <warn/push>
+#include <warn/ignore/all>
+#include <gtest/gtest.h>
+#include <warn/pop>
+
+#include <inviwo/core/datastructures/histogram.h>
+#include <inviwo/core/util/exception.h>
+
+#include <vector>
+#include <numeric>
+
+namespace inviwo {
+
+TEST(histogram, floatBins) {
+    const std::vector<float> data{0.0f, 0.1f, 0.5f, 0.9f, 1.0f, 2.0f, -1.0f};
+    const HistogramContainer hist(dvec2{0.0, 1.0}, 3, data.begin(), data.end());
+
+    ASSERT_EQ(1, hist.size());
+    EXPECT_EQ(-1.0, hist[0].stats_.min);
+    EXPECT_EQ(2.0, hist[0].stats_.max);
+    EXPECT_EQ(2.0, hist[0].getMaximumBinValue());
+
+    // values outside of the data range are not binned
+    const std::vector<double> expected{1.0, 1.0, 0.5};
+    EXPECT_EQ(expected, hist[0].getData());
+}
+
+TEST(histogram, integerValueCounts) {
+    std::vector<glm::u8vec2> data(1000);
+    for (size_t i = 0; i < data.size(); ++i) {
+        data[i] = glm::u8vec2(static_cast<glm::u8>(i % 256), static_cast<glm::u8>(i % 7));
+    }
+
+    PartialHistogram partial(dvec2{0.0, 255.0}, 4096, DataFormat<glm::u8vec2>::get());
+    EXPECT_TRUE(partial.hasValueCounts());
+    EXPECT_EQ(256, partial.getBins()) << "bins should be limited to the integer data range";
+
+    partial.add(data.begin(), data.end());
+    const auto hist = partial.getHistograms();
+    ASSERT_EQ(2, hist.size());
+
+    const double mean = std::accumulate(data.begin(), data.end(), 0.0,
+                                        [](double sum, auto v) { return sum + v.x; }) /
+                        static_cast<double>(data.size());
+    EXPECT_DOUBLE_EQ(mean, hist[0].stats_.mean);
+    EXPECT_EQ(0.0, hist[1].stats_.min);
+    EXPECT_EQ(6.0, hist[1].stats_.max);
+    EXPECT_EQ(143.0, hist[1].getMaximumBinValue());
+}
+
+TEST(histogram, mergeMatchesSinglePass) {
+    std::vector<short> data(10000);
+    for (size_t i = 0; i < data.size(); ++i) {
+        data[i] = static_cast<short>((static_cast<int>(i) * 7919) % 4001 - 2000);
+    }
+    const dvec2 range{-2000.0, 2000.0};
+    const HistogramContainer expected(range, 100, data.begin(), data.end());
+
+    // 32 bit integers are binned directly instead of being counted per value
+    const std::vector<int> ints(data.begin(), data.end());
+    const HistogramContainer binned(range, 100, ints.begin(), ints.end());
+    EXPECT_EQ(expected[0].getData(), binned[0].getData());
+
+    PartialHistogram first(range, 100, DataFormat<short>::get());
+    PartialHistogram second(range, 100, DataFormat<short>::get());
+    first.add(data.begin(), data.begin() + 3000);
+    second.add(data.begin() + 3000, data.end());
+    first.merge(second);
+    EXPECT_EQ(data.size(), first.getCount());
+
+    const auto merged = first.getHistograms();
+    EXPECT_EQ(expected[0].getData(), merged[0].getData());
+    EXPECT_DOUBLE_EQ(expected[0].stats_.mean, merged[0].stats_.mean);
+    EXPECT_DOUBLE_EQ(expected[0].stats_.standardDeviation, merged[0].stats_.standardDeviation);
+}
+
+TEST(histogram, rebin) {
+    std::vector<unsigned short> data(5000);
+    for (size_t i = 0; i < data.size(); ++i) {
+        data[i] = static_cast<unsigned short>((i * 31) % 1000);
+    }
+    PartialHistogram partial(dvec2{0.0, 999.0}, 50, DataFormat<unsigned short>::get());
+    partial.add(data.begin(), data.end());
+
+    partial.rebin(dvec2{100.0, 500.0}, 20);
+    const HistogramContainer expected(dvec2{100.0, 500.0}, 20, data.begin(), data.end());
+    EXPECT_EQ(expected[0].getData(), partial.getHistograms()[0].getData());
+
+    PartialHistogram floats(dvec2{0.0, 1.0}, 10, DataFormat<float>::get());
+    EXPECT_FALSE(floats.hasValueCounts());
+    EXPECT_THROW(floats.rebin(dvec2{0.0, 2.0}, 10), Exception);
+}
+
+}  // namespace inviwo
@@ -0,0 +1,362 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2021 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#include <warn/push>
+#include <warn/ignore/all>
+#include <gtest/gtest.h>
+#include <warn/pop>
+
+#include <inviwo/core/util/logcentral.h>
+#include <inviwo/core/util/mpscqueue.h>
+#include <inviwo/core/util/asyncdeliveryqueue.h>
+
+#include <atomic>
+#include <chrono>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace inviwo {
+
+namespace {
+
+class RecordingLogger : public Logger {
+public:
+    virtual void log(std::string_view, LogLevel, LogAudience, std::string_view, std::string_view,
+                     int, std::string_view msg) override {
+        messages.emplace_back(msg);
+    }
+    std::vector<std::string> messages;
+};
+
+// Counts the messages, can be called from several threads at once
+class CountingLogger : public Logger {
+public:
+    virtual void log(std::string_view, LogLevel, LogAudience, std::string_view, std::string_view,
+                     int, std::string_view) override {
+        count.fetch_add(1);
+    }
+    std::atomic<size_t> count{0};
+};
+
+// Blocks the logging thread in the first message until released
+class BlockingLogger : public RecordingLogger {
+public:
+    virtual void log(std::string_view source, LogLevel level, LogAudience audience,
+                     std::string_view file, std::string_view function, int line,
+                     std::string_view msg) override {
+        released.wait();
+        RecordingLogger::log(source, level, audience, file, function, line, msg);
+    }
+    std::promise<void> release;
+    std::shared_future<void> released{release.get_future().share()};
+};
+
+// Blocks the producer the first time it is moved, i.e. when it is moved into the queue after it
+// has been counted but before it is linked
+struct HeldElement {
+    HeldElement(int aId, std::promise<void>* aMoving = nullptr,
+                std::shared_future<void> aRelease = {})
+        : id{aId}, moving{aMoving}, release{std::move(aRelease)} {}
+    HeldElement(HeldElement&& rhs) : id{rhs.id} {
+        if (auto m = std::exchange(rhs.moving, nullptr)) {
+            m->set_value();
+            rhs.release.wait();
+        }
+    }
+    HeldElement& operator=(HeldElement&&) = default;
+
+    int id;
+    std::promise<void>* moving = nullptr;
+    std::shared_future<void> release;
+};
+
+// Blocks the messages from source "block" until released, like a logger showing a modal dialog
+class SourceBlockingLogger : public BlockingLogger {
+public:
+    virtual void log(std::string_view source, LogLevel level, LogAudience audience,
+                     std::string_view file, std::string_view function, int line,
+                     std::string_view msg) override {
+        if (source == "block") {
+            blocking.set_value();
+            released.wait();
+        }
+        RecordingLogger::log(source, level, audience, file, function, line, msg);
+    }
+    std::promise<void> blocking;
+};
+
+constexpr size_t nThreads = 4;
+constexpr size_t nMessages = 1000;
+
+}  // namespace
+
+TEST(MPSCQueue, orderPerProducer) {
+    util::MPSCQueue<size_t> queue;
+    std::vector<std::thread> producers;
+    for (size_t t = 0; t < nThreads; ++t) {
+        producers.emplace_back([&queue, t]() {
+            for (size_t i = 0; i < nMessages; ++i) queue.push(t * nMessages + i);
+        });
+    }
+
+    std::vector<size_t> next(nThreads, 0);
+    size_t popped = 0;
+    while (popped < nThreads * nMessages) {
+        if (auto value = queue.pop()) {
+            const auto t = *value / nMessages;
+            EXPECT_EQ(next[t]++, *value % nMessages);
+            ++popped;
+        }
+    }
+    for (auto& producer : producers) producer.join();
+    EXPECT_TRUE(queue.empty());
+}
+
+TEST(AsyncDeliveryQueue, flushWaitsForCountedElements) {
+    std::mutex mutex;
+    std::vector<int> delivered;
+    util::AsyncDeliveryQueue<HeldElement> queue(
+        [&](HeldElement& element) {
+            std::scoped_lock lock{mutex};
+            delivered.push_back(element.id);
+        },
+        "Test Delivery Thread");
+
+    std::promise<void> moving;
+    std::promise<void> release;
+    std::thread held([&]() { queue.push(HeldElement{1, &moving, release.get_future().share()}); });
+    moving.get_future().wait();
+
+    std::thread releaser([&]() {
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+        release.set_value();
+    });
+    queue.push(HeldElement{2});
+    queue.flush();
+    {
+        // The held element was counted first, hence the flush also waits for it
+        std::scoped_lock lock{mutex};
+        EXPECT_EQ((std::vector<int>{2, 1}), delivered);
+    }
+    held.join();
+    releaser.join();
+}
+
+TEST(AsyncDeliveryQueue, flushWhileProducing) {
+    // Every delivered 0 pushes a new 0 until done, so the queue never runs empty
+    std::atomic<bool> done{false};
+    std::atomic<int> flushed{0};
+    util::AsyncDeliveryQueue<int>* self = nullptr;
+    util::AsyncDeliveryQueue<int> queue(
+        [&](int& element) {
+            if (element == 1) flushed.fetch_add(1);
+            if (element == 0 && !done.load()) self->push(0);
+        },
+        "Test Delivery Thread");
+    self = &queue;
+
+    queue.push(0);
+    for (int i = 1; i <= 100; ++i) {
+        queue.push(1);
+        queue.flush();
+        EXPECT_EQ(i, flushed.load());
+    }
+    done.store(true);
+}
+
+TEST(AsyncDeliveryQueue, pushAfterStop) {
+    std::vector<int> delivered;
+    util::AsyncDeliveryQueue<int> queue([&](int& element) { delivered.push_back(element); },
+                                        "Test Delivery Thread");
+    queue.push(1);
+    queue.stop();
+    EXPECT_EQ((std::vector<int>{1}), delivered);
+
+    // Without a background thread the element is delivered on the pushing thread
+    queue.push(2);
+    EXPECT_EQ((std::vector<int>{1, 2}), delivered);
+    queue.flush();
+}
+
+TEST(LogCentral, formatAndVerbosity) {
+    LogCentral lc;
+    auto logger = std::make_shared<RecordingLogger>();
+    lc.registerLogger(logger);
+
+    lc.logFormat("test", LogLevel::Info, LogAudience::User, "", "", 0, "{} of {}", 1, "two");
+    lc.setVerbosity(LogVerbosity::Warn);
+    lc.logFormat("test", LogLevel::Info, LogAudience::User, "", "", 0, "{}", 3);
+
+    ASSERT_EQ(1u, logger->messages.size());
+    EXPECT_EQ("1 of two", logger->messages[0]);
+}
+
+TEST(LogCentral, blockingLoggerDoesNotBlockOtherThreads) {
+    LogCentral lc;
+    auto logger = std::make_shared<SourceBlockingLogger>();
+    lc.registerLogger(logger);
+
+    auto blocking = logger->blocking.get_future();
+    std::thread blocked(
+        [&]() { lc.log("block", LogLevel::Info, LogAudience::User, "", "", 0, "second"); });
+    blocking.wait();
+
+    // Returns while the other thread is still inside the logger
+    lc.log("test", LogLevel::Info, LogAudience::User, "", "", 0, "first");
+    logger->release.set_value();
+    blocked.join();
+
+    EXPECT_EQ((std::vector<std::string>{"first", "second"}), logger->messages);
+}
+
+TEST(LogCentral, asynchronousFromManyThreads) {
+    LogCentral lc;
+    auto logger = std::make_shared<RecordingLogger>();
+    lc.registerLogger(logger);
+    lc.setAsynchronous(true);
+    EXPECT_TRUE(lc.isAsynchronous());
+
+    std::vector<std::thread> threads;
+    for (size_t t = 0; t < nThreads; ++t) {
+        threads.emplace_back([&lc, t]() {
+            for (size_t i = 0; i < nMessages; ++i) {
+                lc.logFormat("test", LogLevel::Info, LogAudience::User, "", "", 0, "{} {}", t, i);
+            }
+        });
+    }
+    for (auto& thread : threads) thread.join();
+    lc.flush();
+
+    ASSERT_EQ(nThreads * nMessages, logger->messages.size());
+    std::vector<size_t> next(nThreads, 0);
+    for (const auto& msg : logger->messages) {
+        const auto space = msg.find(' ');
+        const auto t = std::stoul(msg.substr(0, space));
+        EXPECT_EQ(next[t]++, std::stoul(msg.substr(space + 1)));
+    }
+
+    // Turning asynchronous mode off delivers the queued messages
+    lc.log("test", LogLevel::Info, LogAudience::User, "", "", 0, "last");
+    lc.setAsynchronous(false);
+    EXPECT_FALSE(lc.isAsynchronous());
+    EXPECT_EQ("last", logger->messages.back());
+}
+
+TEST(LogCentral, toggleAsynchronousWhileLogging) {
+    LogCentral lc;
+    auto logger = std::make_shared<CountingLogger>();
+    lc.registerLogger(logger);
+
+    std::atomic<bool> done{false};
+    std::vector<std::thread> togglers;
+    for (size_t t = 0; t < 2; ++t) {
+        togglers.emplace_back([&lc, &done, t]() {
+            for (bool on = t == 0; !done.load(); on = !on) lc.setAsynchronous(on);
+        });
+    }
+    std::vector<std::thread> threads;
+    for (size_t t = 0; t < nThreads; ++t) {
+        threads.emplace_back([&lc]() {
+            for (size_t i = 0; i < nMessages; ++i) {
+                lc.logFormat("test", LogLevel::Info, LogAudience::User, "", "", 0, "{}", i);
+            }
+        });
+    }
+    for (auto& thread : threads) thread.join();
+    done.store(true);
+    for (auto& thread : togglers) thread.join();
+
+    // Every message is delivered exactly once, whichever mode it was logged in
+    lc.setAsynchronous(false);
+    EXPECT_EQ(nThreads * nMessages, logger->count.load());
+}
+
+TEST(LogCentral, asynchronousCopiesStringArguments) {
+    LogCentral lc;
+    auto logger = std::make_shared<BlockingLogger>();
+    lc.registerLogger(logger);
+    lc.setAsynchronous(true);
+
+    // The logging thread is held in the first message, the second is formatted after the
+    // strings it refers to are gone
+    lc.log("test", LogLevel::Info, LogAudience::User, "", "", 0, "first");
+    {
+        auto str = std::make_unique<std::string>("a string long enough to live on the heap");
+        const std::string_view view{*str};
+        const char* chars = str->c_str();
+        lc.logFormat("test", LogLevel::Info, LogAudience::User, "", "", 0, "{}|{}", view, chars);
+        str->assign(str->size(), 'x');
+    }
+    logger->release.set_value();
+    lc.flush();
+
+    ASSERT_EQ(2u, logger->messages.size());
+    EXPECT_EQ(
+        "a string long enough to live on the heap|a string long enough to live on the heap",
+        logger->messages[1]);
+}
+
+TEST(LogCentral, invalidFormat) {
+    LogCentral lc;
+    auto logger = std::make_shared<RecordingLogger>();
+    lc.registerLogger(logger);
+
+    EXPECT_NO_THROW(lc.logFormat("test", LogLevel::Info, LogAudience::User, "", "", 0, "{} {}", 1));
+    lc.setAsynchronous(true);
+    EXPECT_NO_THROW(lc.logFormat("test", LogLevel::Info, LogAudience::User, "", "", 0, "{} {}", 1));
+    lc.flush();
+
+    ASSERT_EQ(2u, logger->messages.size());
+    EXPECT_EQ(0u, logger->messages[0].find("Invalid log format: "));
+    EXPECT_EQ(logger->messages[0], logger->messages[1]);
+}
+
+TEST(LogCentral, rateLimit) {
+    LogCentral lc;
+    auto logger = std::make_shared<RecordingLogger>();
+    lc.registerLogger(logger);
+    lc.setRateLimit(2, std::chrono::milliseconds{10});
+
+    for (int i = 0; i < 5; ++i) lc.log("test", LogLevel::Warn, LogAudience::User, "", "", 0, "a");
+    lc.log("test", LogLevel::Warn, LogAudience::User, "", "", 0, "b");
+    ASSERT_EQ(3u, logger->messages.size());
+
+    std::this_thread::sleep_for(std::chrono::milliseconds{20});
+    lc.log("test", LogLevel::Warn, LogAudience::User, "", "", 0, "a");
+    ASSERT_EQ(5u, logger->messages.size());
+    EXPECT_EQ("3 repeats of the following message were suppressed", logger->messages[3]);
+    EXPECT_EQ("a", logger->messages[4]);
+}
+
+}  // namespace inviwo
@@ -0,0 +1,189 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2021 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#include <warn/push>
+#include <warn/ignore/all>
+#include <gtest/gtest.h>
+#include <warn/pop>
+
+#include <inviwo/core/io/memorymappedfile.h>
+#include <inviwo/core/io/bytereaderutil.h>
+#include <inviwo/core/io/rawvolumeramloader.h>
+#include <inviwo/core/datastructures/volume/volumedisk.h>
+#include <inviwo/core/datastructures/volume/volumeramprecision.h>
+#include <inviwo/core/io/tempfilehandle.h>
+#include <inviwo/core/util/exception.h>
+#include <inviwo/core/util/filesystem.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <numeric>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace inviwo {
+
+namespace {
+
+std::vector<std::uint16_t> writeRaw(const std::string& file, size_t offset, size_t count) {
+    std::vector<std::uint16_t> values(count);
+    std::iota(values.begin(), values.end(), std::uint16_t{0});
+    auto out = filesystem::ofstream(file, std::ios::out | std::ios::binary);
+    const std::vector<char> header(offset, 'h');
+    out.write(header.data(), offset);
+    out.write(reinterpret_cast<const char*>(values.data()), count * sizeof(std::uint16_t));
+    return values;
+}
+
+std::vector<std::uint16_t> readRaw(const std::string& file, size_t offset, size_t count) {
+    std::vector<std::uint16_t> onDisk(count);
+    util::readBytesIntoBuffer(file, offset, count * sizeof(std::uint16_t), true,
+                              sizeof(std::uint16_t), onDisk.data());
+    return onDisk;
+}
+
+}  // namespace
+
+TEST(MemoryMappedFile, readOnly) {
+    util::TempFileHandle tmp("inviwo", ".raw");
+    const size_t offset = 6;
+    const auto values = writeRaw(tmp.getFileName(), offset, 10000);
+    const size_t bytes = values.size() * sizeof(std::uint16_t);
+
+    const util::MemoryMappedFile file(tmp.getFileName(), offset, bytes);
+    ASSERT_EQ(bytes, file.size());
+    auto data = static_cast<const std::uint16_t*>(file.data());
+    EXPECT_TRUE(std::equal(values.begin(), values.end(), data));
+
+    EXPECT_THROW(util::MemoryMappedFile(tmp.getFileName(), offset, bytes + 1), FileException);
+}
+
+TEST(RawVolumeRAMLoader, copiesMappedDataOnEdit) {
+    util::TempFileHandle tmp("inviwo", ".raw");
+    const size_t offset = 6;
+    const size3_t dims{10, 20, 30};
+    const auto values = writeRaw(tmp.getFileName(), offset, glm::compMul(dims));
+
+    const RawVolumeRAMLoader loader(tmp.getFileName(), offset, true);
+    const VolumeDisk disk(dims, DataUInt16::get());
+    auto volumeRAM = std::dynamic_pointer_cast<VolumeRAMPrecision<std::uint16_t>>(
+        loader.createRepresentation(disk));
+    ASSERT_TRUE(volumeRAM);
+    ASSERT_TRUE(volumeRAM->hasSharedData());
+
+    const auto& constRAM = *volumeRAM;
+    EXPECT_TRUE(std::equal(values.begin(), values.end(), constRAM.getDataTyped()));
+
+    // copies share the mapped data until they are edited
+    std::unique_ptr<VolumeRAMPrecision<std::uint16_t>> copy{volumeRAM->clone()};
+    EXPECT_TRUE(copy->hasSharedData());
+    EXPECT_EQ(constRAM.getDataTyped(), std::as_const(*copy).getDataTyped());
+
+    volumeRAM->setFromDouble(size3_t{0, 0, 0}, 42.0);
+    EXPECT_FALSE(volumeRAM->hasSharedData());
+    EXPECT_EQ(42, constRAM.getDataTyped()[0]);
+    EXPECT_TRUE(std::equal(values.begin() + 1, values.end(), constRAM.getDataTyped() + 1));
+
+    EXPECT_TRUE(copy->hasSharedData());
+    EXPECT_EQ(0, std::as_const(*copy).getDataTyped()[0]);
+    copy->getDataTyped()[1] = 43;
+    EXPECT_FALSE(copy->hasSharedData());
+    EXPECT_EQ(43, std::as_const(*copy).getDataTyped()[1]);
+
+    EXPECT_EQ(values, readRaw(tmp.getFileName(), offset, values.size()));
+
+    // updating maps the file again instead of writing into the edited data
+    loader.updateRepresentation(volumeRAM, disk);
+    EXPECT_TRUE(volumeRAM->hasSharedData());
+    EXPECT_TRUE(std::equal(values.begin(), values.end(), constRAM.getDataTyped()));
+}
+
+TEST(RawVolumeRAMLoader, parallelEditsOfMappedData) {
+    util::TempFileHandle tmp("inviwo", ".raw");
+    const size_t offset = 6;
+    const size3_t dims{16, 16, 64};
+    const auto values = writeRaw(tmp.getFileName(), offset, glm::compMul(dims));
+
+    const RawVolumeRAMLoader loader(tmp.getFileName(), offset, true);
+    const VolumeDisk disk(dims, DataUInt16::get());
+    auto volumeRAM = std::dynamic_pointer_cast<VolumeRAMPrecision<std::uint16_t>>(
+        loader.createRepresentation(disk));
+    ASSERT_TRUE(volumeRAM);
+    ASSERT_TRUE(volumeRAM->hasSharedData());
+
+    // Read through the mapped data while the other threads copy it on their first write
+    const auto mapped = std::as_const(*volumeRAM).getDataTyped();
+
+    // Every thread writes its own slices, all writes have to end up in the same copy
+    const size_t nThreads = 8;
+    std::vector<std::thread> threads;
+    for (size_t t = 0; t < nThreads; ++t) {
+        threads.emplace_back([&, t]() {
+            for (size_t z = t; z < dims.z; z += nThreads) {
+                for (size_t y = 0; y < dims.y; ++y) {
+                    for (size_t x = 0; x < dims.x; ++x) {
+                        volumeRAM->setFromDouble(size3_t{x, y, z}, static_cast<double>(z));
+                    }
+                }
+            }
+        });
+    }
+    EXPECT_TRUE(std::equal(values.begin(), values.end(), mapped));
+    for (auto& thread : threads) thread.join();
+
+    EXPECT_FALSE(volumeRAM->hasSharedData());
+    EXPECT_TRUE(std::equal(values.begin(), values.end(), mapped));
+    const auto edited = std::as_const(*volumeRAM).getDataTyped();
+    for (size_t i = 0; i < values.size(); ++i) {
+        ASSERT_EQ(i / (dims.x * dims.y), edited[i]) << "voxel " << i;
+    }
+}
+
+TEST(RawVolumeRAMLoader, readsWithoutMapping) {
+    util::TempFileHandle tmp("inviwo", ".raw");
+    const size_t offset = 6;
+    const size3_t dims{10, 20, 30};
+    const auto values = writeRaw(tmp.getFileName(), offset, glm::compMul(dims));
+
+    const RawVolumeRAMLoader loader(tmp.getFileName(), offset, true, false);
+    const VolumeDisk disk(dims, DataUInt16::get());
+    auto volumeRAM = std::dynamic_pointer_cast<VolumeRAMPrecision<std::uint16_t>>(
+        loader.createRepresentation(disk));
+    ASSERT_TRUE(volumeRAM);
+    EXPECT_FALSE(volumeRAM->hasSharedData());
+    EXPECT_TRUE(std::equal(values.begin(), values.end(), volumeRAM->getDataTyped()));
+
+    volumeRAM->getDataTyped()[0] = 42;
+    loader.updateRepresentation(volumeRAM, disk);
+    EXPECT_TRUE(std::equal(values.begin(), values.end(), volumeRAM->getDataTyped()));
+}
+
+}  // namespace inviwo
@@ -38,20 +38,30 @@
 #include <inviwo/core/network/processornetwork.h>
 #include <inviwo/core/network/processornetworkevaluator.h>
 #include <inviwo/core/network/networklock.h>
+#include <inviwo/core/util/evaluationtrace.h>
 
 #include <inviwo/core/ports/datainport.h>
 #include <inviwo/core/ports/dataoutport.h>
 
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
 #include <functional>
+#include <mutex>
+#include <thread>
 
 namespace inviwo {
 
 namespace {
 
 struct TestProcessor : Processor {
-    TestProcessor(const std::string& id) : Processor(id, id) {}
+    TestProcessor(const std::string& id, Tags tags = Tags::CPU)
+        : Processor(id, id), tags_{std::move(tags)} {}
 
-    virtual const ProcessorInfo getProcessorInfo() const override { return processorInfo_; }
+    virtual const ProcessorInfo getProcessorInfo() const override {
+        return {processorInfo_.classIdentifier, processorInfo_.displayName,
+                processorInfo_.category, processorInfo_.codeState, tags_};
+    }
 
     static const ProcessorInfo processorInfo_;
 
@@ -68,6 +78,7 @@ struct TestProcessor : Processor {
     std::function<void(TestProcessor&)> onInitializeResources;
     std::function<void(TestProcessor&)> onProcess;
     std::function<void(TestProcessor&)> onDoIfNotReady;
+    Tags tags_;
 };
 
 // The Class Identifier has to be globally unique. Use a reverse DNS naming scheme
@@ -256,4 +267,279 @@ TEST(NetworkEvaluator, Error) {
     }
 }
 
+namespace {
+
+const Tags concurrentTags = Tags::CPU | Tag::Concurrent;
+
+TestProcessor* addProcessor(ProcessorNetwork& network, const std::string& id, Tags tags,
+                            size_t inports, bool outport) {
+    auto p = std::make_unique<TestProcessor>(id, std::move(tags));
+    for (size_t i = 0; i < inports; ++i) {
+        p->addPort(std::make_unique<DataInport<int>>("in" + std::to_string(i)));
+    }
+    if (outport) p->addPort(std::make_unique<DataOutport<int>>("out"));
+    return static_cast<TestProcessor*>(network.addProcessor(std::move(p)));
+}
+
+void setOutput(TestProcessor& p) {
+    for (auto outport : p.getOutports()) {
+        static_cast<DataOutport<int>*>(outport)->setData(std::make_shared<int>(0));
+    }
+}
+
+/**
+ * Make sure the pool has at least `size` threads while in scope
+ */
+struct PoolSizeGuard {
+    PoolSizeGuard(size_t size) : app{InviwoApplication::getPtr()}, oldSize{app->getPoolSize()} {
+        if (oldSize < size) app->resizePool(size);
+    }
+    ~PoolSizeGuard() {
+        if (app->getPoolSize() != oldSize) app->resizePool(oldSize);
+    }
+    InviwoApplication* app;
+    size_t oldSize;
+};
+
+}  // namespace
+
+TEST(NetworkEvaluator, ParallelOrder) {
+    PoolSizeGuard poolSize{2};
+    ProcessorNetwork network{InviwoApplication::getPtr()};
+    ProcessorNetworkEvaluator evaluator{&network};
+    evaluator.setEvaluationMode(EvaluationMode::Parallel);
+
+    std::mutex mutex;
+    std::vector<std::string> order;
+    std::vector<std::unique_ptr<Instrument>> instruments;
+
+    // a -> b1 -> c
+    //   -> b2 ->
+    TestProcessor *a, *b1, *b2, *c;
+    {
+        NetworkLock lock(&network);
+        a = addProcessor(network, "a", concurrentTags, 0, true);
+        b1 = addProcessor(network, "b1", concurrentTags, 1, true);
+        b2 = addProcessor(network, "b2", concurrentTags, 1, true);
+        c = addProcessor(network, "c", Tags::CPU, 2, false);
+
+        for (auto p : {a, b1, b2, c}) {
+            instruments.push_back(std::make_unique<Instrument>(*p));
+            p->onProcess = [&, func = p->onProcess](TestProcessor& self) {
+                func(self);
+                setOutput(self);
+                std::scoped_lock orderLock{mutex};
+                order.push_back(self.getIdentifier());
+            };
+        }
+
+        network.addConnection(a->getOutports()[0], b1->getInports()[0]);
+        network.addConnection(a->getOutports()[0], b2->getInports()[0]);
+        network.addConnection(b1->getOutports()[0], c->getInports()[0]);
+        network.addConnection(b2->getOutports()[0], c->getInports()[1]);
+    }
+
+    for (auto& i : instruments) i->checkAndReset(1, 1, 0);
+    ASSERT_EQ(4u, order.size());
+    EXPECT_EQ("a", order.front());
+    EXPECT_EQ("c", order.back());
+    EXPECT_TRUE(a->isValid() && b1->isValid() && b2->isValid() && c->isValid());
+
+    {
+        SCOPED_TRACE("Invalid branch");
+        order.clear();
+        b2->invalidate(InvalidationLevel::InvalidOutput);
+        instruments[0]->checkAndReset(0, 0, 0);
+        instruments[1]->checkAndReset(0, 0, 0);
+        instruments[2]->checkAndReset(0, 1, 0);
+        instruments[3]->checkAndReset(0, 1, 0);
+        EXPECT_EQ(std::vector<std::string>({"b2", "c"}), order);
+    }
+}
+
+TEST(NetworkEvaluator, ParallelBranchesRunConcurrently) {
+    PoolSizeGuard poolSize{2};
+    ProcessorNetwork network{InviwoApplication::getPtr()};
+    ProcessorNetworkEvaluator evaluator{&network};
+    evaluator.setEvaluationMode(EvaluationMode::Parallel);
+
+    // Two independent processors that each wait for the other to start, this can only succeed if
+    // they are processed at the same time.
+    std::mutex mutex;
+    std::condition_variable cv;
+    int started = 0;
+    int metEachOther = 0;
+    const auto rendezvous = [&](TestProcessor&) {
+        std::unique_lock lock{mutex};
+        ++started;
+        cv.notify_all();
+        if (cv.wait_for(lock, std::chrono::seconds(10), [&]() { return started >= 2; })) {
+            ++metEachOther;
+        }
+    };
+
+    {
+        NetworkLock lock(&network);
+        addProcessor(network, "a", concurrentTags, 0, false)->onProcess = rendezvous;
+        addProcessor(network, "b", concurrentTags, 0, false)->onProcess = rendezvous;
+    }
+
+    EXPECT_EQ(2, started);
+    EXPECT_EQ(2, metEachOther);
+}
+
+TEST(NetworkEvaluator, ParallelKeepsGLOnMainThread) {
+    PoolSizeGuard poolSize{2};
+    ProcessorNetwork network{InviwoApplication::getPtr()};
+    ProcessorNetworkEvaluator evaluator{&network};
+    evaluator.setEvaluationMode(EvaluationMode::Parallel);
+
+    const auto mainThread = std::this_thread::get_id();
+    std::thread::id glThread;
+    std::thread::id concurrentThread;
+    {
+        NetworkLock lock(&network);
+        addProcessor(network, "gl", Tags::GL | Tag::Concurrent, 0, false)->onProcess =
+            [&](TestProcessor&) { glThread = std::this_thread::get_id(); };
+        addProcessor(network, "cpu", concurrentTags, 0, false)->onProcess =
+            [&](TestProcessor&) { concurrentThread = std::this_thread::get_id(); };
+    }
+
+    EXPECT_EQ(mainThread, glThread);
+    EXPECT_NE(std::thread::id{}, concurrentThread);
+    EXPECT_NE(mainThread, concurrentThread);
+}
+
+TEST(NetworkEvaluator, ParallelError) {
+    PoolSizeGuard poolSize{2};
+    ProcessorNetwork network{InviwoApplication::getPtr()};
+    ProcessorNetworkEvaluator evaluator{&network};
+    evaluator.setEvaluationMode(EvaluationMode::Parallel);
+
+    unsigned int throwCount = 0;
+    EvaluationType type = EvaluationType::NotReady;
+    evaluator.setExceptionHandler([&](Processor*, EvaluationType t, ExceptionContext) {
+        ++throwCount;
+        type = t;
+    });
+
+    auto a = addProcessor(network, "a", concurrentTags, 0, true);
+    auto b = addProcessor(network, "b", concurrentTags, 1, false);
+    Instrument ai(*a);
+    Instrument bi(*b);
+    a->onProcess = [func = a->onProcess](TestProcessor& p) {
+        func(p);
+        setOutput(p);
+        throw Exception("Error", IVW_CONTEXT_CUSTOM("TestProcessor"));
+    };
+    bi.reset();
+
+    network.addConnection(a->getOutports()[0], b->getInports()[0]);
+    EXPECT_EQ(1u, throwCount);
+    EXPECT_EQ(EvaluationType::Process, type);
+    ai.checkAndReset(1, 1, 0);
+    bi.checkAndReset(0, 0, 1);
+    EXPECT_FALSE(a->isValid());
+}
+
+TEST(NetworkEvaluator, OrderAfterChanges) {
+    ProcessorNetwork network{InviwoApplication::getPtr()};
+    ProcessorNetworkEvaluator evaluator{&network};
+
+    std::vector<std::string> order;
+
+    // Added in reverse, the order has to be fixed by the connections
+    // a -> b -> c -> d
+    TestProcessor *a, *b, *c, *d;
+    {
+        NetworkLock lock(&network);
+        d = addProcessor(network, "d", Tags::CPU, 1, false);
+        c = addProcessor(network, "c", Tags::CPU, 1, true);
+        b = addProcessor(network, "b", Tags::CPU, 1, true);
+        a = addProcessor(network, "a", Tags::CPU, 0, true);
+        for (auto p : {a, b, c, d}) {
+            p->onProcess = [&](TestProcessor& self) {
+                setOutput(self);
+                order.push_back(self.getIdentifier());
+            };
+        }
+        network.addConnection(c->getOutports()[0], d->getInports()[0]);
+        network.addConnection(a->getOutports()[0], b->getInports()[0]);
+        network.addConnection(b->getOutports()[0], c->getInports()[0]);
+    }
+    EXPECT_EQ(std::vector<std::string>({"a", "b", "c", "d"}), order);
+
+    {
+        SCOPED_TRACE("Unconnected processors are not evaluated");
+        order.clear();
+        network.removeConnection(c->getOutports()[0], d->getInports()[0]);
+        a->invalidate(InvalidationLevel::InvalidOutput);
+        EXPECT_TRUE(order.empty());
+    }
+    {
+        SCOPED_TRACE("Reconnect");
+        order.clear();
+        network.addConnection(c->getOutports()[0], d->getInports()[0]);
+        EXPECT_EQ(std::vector<std::string>({"a", "b", "c", "d"}), order);
+    }
+    {
+        SCOPED_TRACE("Remove processor");
+        network.removeAndDeleteProcessor(b);
+        auto e = addProcessor(network, "e", Tags::CPU, 1, true);
+        e->onProcess = a->onProcess;
+        order.clear();
+        {
+            NetworkLock lock(&network);
+            network.addConnection(e->getOutports()[0], c->getInports()[0]);
+            network.addConnection(a->getOutports()[0], e->getInports()[0]);
+        }
+        EXPECT_EQ(std::vector<std::string>({"e", "c", "d"}), order);
+    }
+}
+
+TEST(NetworkEvaluator, Trace) {
+    ProcessorNetwork network{InviwoApplication::getPtr()};
+    ProcessorNetworkEvaluator evaluator{&network};
+    auto trace = evaluator.getTrace();
+    trace->setEnabled(true);
+
+    TestProcessor *a, *b;
+    {
+        NetworkLock lock(&network);
+        a = addProcessor(network, "a", Tags::CPU, 0, true);
+        b = addProcessor(network, "b", Tags::CPU, 1, false);
+        a->onProcess = [](TestProcessor& self) { setOutput(self); };
+        network.addConnection(a->getOutports()[0], b->getInports()[0]);
+    }
+
+    const auto events = trace->getEvents();
+    const auto count = [&](TraceEventType type, const std::string& name) {
+        return std::count_if(events.begin(), events.end(), [&](const TraceEvent& e) {
+            return e.type == type && e.name == name;
+        });
+    };
+    for (auto name : {"a", "b"}) {
+        SCOPED_TRACE(name);
+        EXPECT_EQ(1, count(TraceEventType::InitializeResources, name));
+        EXPECT_EQ(1, count(TraceEventType::InportOnChange, name));
+        EXPECT_EQ(1, count(TraceEventType::Process, name));
+    }
+
+    // The evaluation is recorded after the processors and spans all of them
+    const auto evaluation = std::find_if(events.begin(), events.end(), [](const TraceEvent& e) {
+        return e.type == TraceEventType::Evaluation;
+    });
+    ASSERT_NE(events.end(), evaluation);
+    EXPECT_EQ(6, std::distance(events.begin(), evaluation));
+    for (auto it = events.begin(); it != evaluation; ++it) {
+        EXPECT_LE(evaluation->start, it->start);
+        EXPECT_LE(it->start + it->duration, evaluation->start + evaluation->duration);
+    }
+
+    trace->setEnabled(false);
+    trace->clear();
+    a->invalidate(InvalidationLevel::InvalidOutput);
+    EXPECT_EQ(0u, trace->size());
+}
+
 }  // namespace inviwo
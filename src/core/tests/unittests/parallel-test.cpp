@@ -0,0 +1,140 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2021 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#include <warn/push>
+#include <warn/ignore/all>
+#include <gtest/gtest.h>
+#include <warn/pop>
+
+#include <inviwo/core/util/parallel.h>
+#include <inviwo/core/util/threadpool.h>
+
+#include <vector>
+#include <numeric>
+#include <stdexcept>
+#include <atomic>
+#include <future>
+#include <string>
+
+namespace inviwo {
+
+TEST(parallel, forEachIndex) {
+    ThreadPool pool(3);
+    std::vector<int> data(10000, 0);
+    util::parallelFor(pool, 0, data.size(), [&](size_t i) { data[i] += static_cast<int>(i); });
+
+    for (size_t i = 0; i < data.size(); ++i) {
+        EXPECT_EQ(static_cast<int>(i), data[i]);
+    }
+}
+
+TEST(parallel, chunks) {
+    ThreadPool pool(3);
+    std::atomic<size_t> count{0};
+    std::atomic<size_t> chunks{0};
+    util::parallelFor(
+        pool, 10, 1010,
+        [&](size_t begin, size_t end) {
+            EXPECT_LE(end - begin, size_t{7});
+            count += end - begin;
+            ++chunks;
+        },
+        7);
+    EXPECT_EQ(size_t{1000}, count);
+    EXPECT_EQ(size_t{143}, chunks);
+}
+
+TEST(parallel, emptyRange) {
+    ThreadPool pool(2);
+    bool called = false;
+    util::parallelFor(pool, 5, 5, [&](size_t) { called = true; });
+    EXPECT_FALSE(called);
+    EXPECT_EQ(3, util::parallelReduce(
+                     pool, 5, 5, 3, [](size_t, size_t, int init) { return init + 1; },
+                     [](int a, int b) { return a + b; }));
+}
+
+TEST(parallel, reduce) {
+    ThreadPool pool(3);
+    std::vector<double> data(100000);
+    std::iota(data.begin(), data.end(), 0.0);
+
+    const auto sum = util::parallelReduce(
+        pool, 0, data.size(), 0.0,
+        [&](size_t begin, size_t end, double init) {
+            return std::accumulate(data.begin() + begin, data.begin() + end, init);
+        },
+        std::plus<>{});
+    EXPECT_EQ(std::accumulate(data.begin(), data.end(), 0.0), sum);
+}
+
+TEST(parallel, reduceIsOrdered) {
+    ThreadPool pool(3);
+    const auto str = util::parallelReduce(
+        pool, 0, 26, std::string{},
+        [](size_t begin, size_t end, std::string init) {
+            for (size_t i = begin; i < end; ++i) init.push_back(static_cast<char>('a' + i));
+            return init;
+        },
+        [](std::string a, const std::string& b) { return a + b; }, 3);
+    EXPECT_EQ("abcdefghijklmnopqrstuvwxyz", str);
+}
+
+TEST(parallel, exception) {
+    ThreadPool pool(3);
+    EXPECT_THROW(util::parallelFor(
+                     pool, 0, 1000,
+                     [](size_t i) {
+                         if (i == 500) throw std::runtime_error("fail");
+                     },
+                     10),
+                 std::runtime_error);
+}
+
+TEST(parallel, nestedInSaturatedPool) {
+    ThreadPool pool(2);
+    // More outer tasks than workers, each waiting for a nested parallelFor.
+    std::vector<std::future<size_t>> futures;
+    for (size_t job = 0; job < 8; ++job) {
+        futures.push_back(pool.enqueue([&pool]() {
+            std::vector<size_t> data(1000, 1);
+            return util::parallelReduce(
+                pool, 0, data.size(), size_t{0},
+                [&](size_t begin, size_t end, size_t init) {
+                    return std::accumulate(data.begin() + begin, data.begin() + end, init);
+                },
+                std::plus<>{}, 10);
+        }));
+    }
+    for (auto& f : futures) {
+        EXPECT_EQ(size_t{1000}, f.get());
+    }
+}
+
+}  // namespace inviwo
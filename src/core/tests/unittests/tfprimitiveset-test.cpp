@@ -32,10 +32,12 @@
 #include <gtest/gtest.h>
 #include <warn/pop>
 
+#include <inviwo/core/datastructures/tflookuptable.h>
 #include <inviwo/core/datastructures/tfprimitiveset.h>
 #include <inviwo/core/datastructures/transferfunction.h>
 
 #include <iostream>
+#include <vector>
 
 namespace inviwo {
 
@@ -81,4 +83,48 @@ TEST(TFSampling, linear) {
     EXPECT_EQ(color2, tf.sample(1.0));
 }
 
+TEST(TFLookupTable, sameAsSample) {
+    vec4 color1{0.0f, 1.0f, 0.0f, 0.5f};
+    vec4 color2{1.0f, 0.0f, 0.5f, 1.0f};
+    vec4 color3{0.2f, 0.3f, 1.0f, 0.0f};
+    TransferFunction tf{{{0.25, color1}, {0.5, color2}, {0.75, color3}}};
+
+    const TFLookupTable defaultTable(tf);
+    EXPECT_EQ(tf.getTextureSize(), defaultTable.size());
+
+    const TFLookupTable table(tf, 4097);
+    EXPECT_EQ(4097, table.size());
+    for (double v : {-0.5, 0.0, 0.1, 0.25, 0.3, 0.5, 0.6, 0.75, 0.9, 1.0, 1.5}) {
+        const vec4 expected = tf.sample(v);
+        for (int i = 0; i < 4; ++i) {
+            EXPECT_NEAR(expected[i], table.sample(v)[i], 1e-6f) << "v = " << v;
+            EXPECT_NEAR(expected[i], defaultTable.sample(v)[i], 1e-2f) << "v = " << v;
+        }
+    }
+}
+
+TEST(TFLookupTable, mask) {
+    vec4 color{1.0f, 0.0f, 0.5f, 1.0f};
+    TransferFunction tf{{{0.0, color}, {1.0, color}}};
+    tf.setMaskMin(0.25);
+    tf.setMaskMax(0.75);
+
+    const TFLookupTable table(tf, 100);
+    EXPECT_EQ(0.0f, table.sample(0.1).a);
+    EXPECT_EQ(color, table.sample(0.5));
+    EXPECT_EQ(0.0f, table.sample(0.9).a);
+}
+
+TEST(TFLookupTable, batch) {
+    TransferFunction tf{{{0.0, vec4{0.0f}}, {1.0, vec4{1.0f}}}};
+    const TFLookupTable table(tf);
+
+    const std::vector<double> positions{-1.0, 0.0, 0.123, 0.5, 0.987, 1.0, 2.0};
+    std::vector<vec4> colors(positions.size());
+    table.sample(positions, colors);
+    for (size_t i = 0; i < positions.size(); ++i) {
+        EXPECT_EQ(table.sample(positions[i]), colors[i]);
+    }
+}
+
 }  // namespace inviwo
@@ -0,0 +1,239 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2021 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#include <warn/push>
+#include <warn/ignore/all>
+#include <gtest/gtest.h>
+#include <warn/pop>
+
+#include <inviwo/core/util/threadpool.h>
+
+#include <atomic>
+#include <chrono>
+#include <future>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace inviwo {
+
+namespace {
+
+using namespace std::chrono_literals;
+
+// Keeps workers busy until opened
+class Gate {
+public:
+    Gate() : future_{promise_.get_future().share()} {}
+    void open() { promise_.set_value(); }
+    void wait() const { future_.wait(); }
+
+private:
+    std::promise<void> promise_;
+    std::shared_future<void> future_;
+};
+
+// Blocks all workers of the pool, returns when they all are blocked
+std::vector<std::future<void>> block(ThreadPool& pool, const Gate& gate) {
+    std::atomic<size_t> blocked{0};
+    std::vector<std::future<void>> res;
+    for (size_t i = 0; i < pool.getSize(); ++i) {
+        res.push_back(pool.enqueue(ThreadPool::Priority::High, [&blocked, &gate]() {
+            ++blocked;
+            gate.wait();
+        }));
+    }
+    while (blocked < pool.getSize()) std::this_thread::yield();
+    return res;
+}
+
+class Recorder {
+public:
+    auto add(std::string name) {
+        return [this, name = std::move(name)]() {
+            std::scoped_lock lock{mutex_};
+            order_.push_back(name);
+        };
+    }
+    std::vector<std::string> order() {
+        std::scoped_lock lock{mutex_};
+        return order_;
+    }
+
+private:
+    std::mutex mutex_;
+    std::vector<std::string> order_;
+};
+
+}  // namespace
+
+TEST(ThreadPool, noThreadsRunsInline) {
+    ThreadPool pool(0);
+    const auto id = std::this_thread::get_id();
+    EXPECT_EQ(id, pool.enqueue([]() { return std::this_thread::get_id(); }).get());
+}
+
+TEST(ThreadPool, enqueueAtEachPriority) {
+    ThreadPool pool(2);
+    auto high = pool.enqueue(ThreadPool::Priority::High, [](int i) { return i; }, 1);
+    auto normal = pool.enqueue(ThreadPool::Priority::Normal, [](int i) { return i; }, 2);
+    auto low = pool.enqueue(ThreadPool::Priority::Low, [](int i) { return i; }, 3);
+    auto fallback = pool.enqueue([](int i) { return i; }, 4);
+
+    EXPECT_EQ(1, high.get());
+    EXPECT_EQ(2, normal.get());
+    EXPECT_EQ(3, low.get());
+    EXPECT_EQ(4, fallback.get());
+}
+
+TEST(ThreadPool, exceptionsReachTheFuture) {
+    ThreadPool pool(1);
+    auto res = pool.enqueue([]() -> int { throw std::runtime_error("error"); });
+    EXPECT_THROW(res.get(), std::runtime_error);
+    EXPECT_EQ(1, pool.enqueue([]() { return 1; }).get());
+}
+
+TEST(ThreadPool, laneOrdering) {
+    ThreadPool pool(1);
+    Gate gate;
+    auto blocked = block(pool, gate);
+
+    Recorder recorder;
+    pool.enqueueRaw(recorder.add("low1"), ThreadPool::Priority::Low);
+    pool.enqueueRaw(recorder.add("normal1"), ThreadPool::Priority::Normal);
+    pool.enqueueRaw(recorder.add("high1"), ThreadPool::Priority::High);
+    pool.enqueueRaw(recorder.add("low2"), ThreadPool::Priority::Low);
+    pool.enqueueRaw(recorder.add("normal2"), ThreadPool::Priority::Normal);
+    pool.enqueueRaw(recorder.add("high2"), ThreadPool::Priority::High);
+    EXPECT_EQ(size_t{6}, pool.getQueueSize());
+
+    gate.open();
+    pool.enqueue(ThreadPool::Priority::Low, []() {}).wait();
+
+    const std::vector<std::string> expected{"high1",   "high2", "normal1",
+                                            "normal2", "low1",  "low2"};
+    EXPECT_EQ(expected, recorder.order());
+}
+
+TEST(ThreadPool, nestedTasksRunNewestFirst) {
+    ThreadPool pool(1);
+    Recorder recorder;
+    pool.enqueue([&]() {
+            pool.enqueueRaw(recorder.add("first"));
+            pool.enqueueRaw(recorder.add("second"));
+            pool.enqueueRaw(recorder.add("high"), ThreadPool::Priority::High);
+        })
+        .wait();
+    pool.enqueue(ThreadPool::Priority::Low, []() {}).wait();
+
+    const std::vector<std::string> expected{"high", "second", "first"};
+    EXPECT_EQ(expected, recorder.order());
+}
+
+TEST(ThreadPool, blockedWorkerDoesNotStarveItsTasks) {
+    // A task waiting for the tasks it enqueued, without running them itself, only finishes if
+    // the other workers steal them.
+    ThreadPool pool(3);
+    constexpr size_t tasks = 100;
+    std::atomic<size_t> done{0};
+
+    auto outer = pool.enqueue([&]() {
+        std::vector<std::future<void>> inner;
+        for (size_t i = 0; i < tasks; ++i) {
+            inner.push_back(pool.enqueue(ThreadPool::Priority::Low, [&]() { ++done; }));
+        }
+        for (auto& f : inner) {
+            if (f.wait_for(10s) != std::future_status::ready) return false;
+        }
+        return true;
+    });
+
+    EXPECT_TRUE(outer.get());
+    EXPECT_EQ(tasks, done.load());
+}
+
+TEST(ThreadPool, lowPriorityRunsWhenHighIsDone) {
+    ThreadPool pool(2);
+    std::atomic<size_t> high{0};
+    auto low = pool.enqueue(ThreadPool::Priority::Low, [&]() { return high.load(); });
+
+    std::vector<std::future<void>> highs;
+    for (size_t i = 0; i < 1000; ++i) {
+        highs.push_back(pool.enqueue(ThreadPool::Priority::High, [&]() { ++high; }));
+    }
+
+    ASSERT_EQ(std::future_status::ready, low.wait_for(10s));
+    for (auto& f : highs) f.get();
+    EXPECT_EQ(size_t{1000}, high.load());
+}
+
+TEST(ThreadPool, destructorDrainsQueuedTasks) {
+    constexpr size_t tasks = 300;
+    std::atomic<size_t> done{0};
+    std::vector<std::future<size_t>> results;
+    Gate gate;
+    std::thread opener;
+    {
+        ThreadPool pool(2);
+        auto blocked = block(pool, gate);
+        for (size_t i = 0; i < tasks; ++i) {
+            const auto priority = static_cast<ThreadPool::Priority>(i % ThreadPool::numPriorities);
+            results.push_back(pool.enqueue(priority, [&done, i]() {
+                ++done;
+                return i;
+            }));
+        }
+        // Open the gate while the pool is being destroyed
+        opener = std::thread([&gate]() {
+            std::this_thread::sleep_for(50ms);
+            gate.open();
+        });
+    }
+    opener.join();
+
+    EXPECT_EQ(tasks, done.load());
+    for (size_t i = 0; i < tasks; ++i) {
+        EXPECT_EQ(i, results[i].get());
+    }
+}
+
+TEST(ThreadPool, shrinkRunsQueuedTasks) {
+    ThreadPool pool(3);
+    std::atomic<size_t> done{0};
+    for (size_t i = 0; i < 100; ++i) {
+        pool.enqueueRaw([&done]() { ++done; }, ThreadPool::Priority::Low);
+    }
+    while (pool.trySetSize(0) != 0) std::this_thread::yield();
+    EXPECT_EQ(size_t{100}, done.load());
+    EXPECT_EQ(size_t{0}, pool.getQueueSize());
+}
+
+}  // namespace inviwo
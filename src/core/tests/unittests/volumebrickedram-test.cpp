@@ -0,0 +1,166 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2021 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#include <warn/push>
+#include <warn/ignore/all>
+#include <gtest/gtest.h>
+#include <warn/pop>
+
+#include <inviwo/core/datastructures/volume/volumebrickedram.h>
+#include <inviwo/core/datastructures/volume/volumebrickcache.h>
+#include <inviwo/core/datastructures/volume/volumeramprecision.h>
+#include <inviwo/core/io/rawvolumebrickloader.h>
+#include <inviwo/core/io/tempfilehandle.h>
+#include <inviwo/core/util/filesystem.h>
+#include <inviwo/core/util/indexmapper.h>
+
+#include <cstdint>
+#include <cstring>
+#include <numeric>
+
+namespace inviwo {
+
+namespace {
+
+std::shared_ptr<VolumeRAMPrecision<std::uint16_t>> createSource(size3_t dims) {
+    auto vol = std::make_shared<VolumeRAMPrecision<std::uint16_t>>(dims);
+    auto data = vol->getDataTyped();
+    std::iota(data, data + glm::compMul(dims), std::uint16_t{0});
+    return vol;
+}
+
+}  // namespace
+
+TEST(VolumeBrickedRAM, bricks) {
+    const size3_t dims{10, 7, 5};
+    auto source = createSource(dims);
+    VolumeBrickedRAM bricked(std::make_shared<VolumeRAMBrickLoader>(source), dims, size3_t{4},
+                             DataUInt16::get(), swizzlemasks::rgba, InterpolationType::Linear,
+                             wrapping3d::clampAll, std::make_shared<VolumeBrickCache>());
+
+    EXPECT_EQ(size3_t(3, 2, 2), bricked.getNumberOfBricks());
+    EXPECT_EQ(size3_t(8, 4, 4), bricked.getBrickOffset(size3_t{2, 1, 1}));
+    EXPECT_EQ(size3_t(2, 3, 1), bricked.getBrickExtent(size3_t{2, 1, 1}));
+
+    auto brick = bricked.getBrick(size3_t{2, 1, 1});
+    ASSERT_EQ(size3_t(2, 3, 1), brick->getDimensions());
+    EXPECT_EQ(source->getAsDouble(size3_t{9, 6, 4}), brick->getAsDouble(size3_t{1, 2, 0}));
+}
+
+TEST(VolumeBrickedRAM, region) {
+    const size3_t dims{10, 7, 5};
+    auto source = createSource(dims);
+    auto cache = std::make_shared<VolumeBrickCache>();
+    VolumeBrickedRAM bricked(std::make_shared<VolumeRAMBrickLoader>(source), dims, size3_t{4},
+                             DataUInt16::get(), swizzlemasks::rgba, InterpolationType::Linear,
+                             wrapping3d::clampAll, cache);
+
+    const size3_t offset{3, 1, 2};
+    const size3_t extent{2, 5, 1};
+    auto region = bricked.getRegion(offset, extent);
+    ASSERT_EQ(extent, region->getDimensions());
+    util::IndexMapper3D im(extent);
+    for (size_t i = 0; i < glm::compMul(extent); ++i) {
+        const auto pos = im(i);
+        EXPECT_EQ(source->getAsDouble(offset + pos), region->getAsDouble(pos));
+    }
+    // Only the bricks overlapping the region are loaded
+    EXPECT_EQ(4u, cache->size());
+
+    auto full = bricked.getRegion(size3_t{0}, dims);
+    EXPECT_EQ(0, std::memcmp(source->getData(), full->getData(), source->getNumberOfBytes()));
+
+    EXPECT_THROW(bricked.getRegion(size3_t{9, 0, 0}, size3_t{2, 1, 1}), Exception);
+}
+
+TEST(VolumeBrickCache, evictsLeastRecentlyUsed) {
+    const size3_t dims{8, 8, 8};
+    auto source = createSource(dims);
+    const size_t brickBytes = 4 * 4 * 4 * sizeof(std::uint16_t);
+    auto cache = std::make_shared<VolumeBrickCache>(2 * brickBytes);
+    VolumeBrickedRAM bricked(std::make_shared<VolumeRAMBrickLoader>(source), dims, size3_t{4},
+                             DataUInt16::get(), swizzlemasks::rgba, InterpolationType::Linear,
+                             wrapping3d::clampAll, cache);
+
+    auto first = bricked.getBrick(size3_t{0, 0, 0});
+    auto second = bricked.getBrick(size3_t{1, 0, 0});
+    EXPECT_EQ(first, bricked.getBrick(size3_t{0, 0, 0}));
+    bricked.getBrick(size3_t{0, 1, 0});
+
+    EXPECT_EQ(2u, cache->size());
+    EXPECT_EQ(2 * brickBytes, cache->getMemoryUsage());
+    // The most recently used brick is still cached while (1,0,0) has been evicted
+    EXPECT_EQ(first, bricked.getBrick(size3_t{0, 0, 0}));
+    EXPECT_NE(second, bricked.getBrick(size3_t{1, 0, 0}));
+
+    cache->setMemoryBudget(brickBytes);
+    EXPECT_EQ(1u, cache->size());
+
+    cache->setMemoryBudget(VolumeBrickCache::defaultMemoryBudget);
+    {
+        std::unique_ptr<VolumeBrickedRAM> copy(bricked.clone());
+        copy->getBrick(size3_t{1, 1, 1});
+        EXPECT_EQ(2u, cache->size());
+    }
+    // Destroying a volume drops its bricks
+    EXPECT_EQ(1u, cache->size());
+
+    cache->clear();
+    EXPECT_EQ(0u, cache->size());
+    EXPECT_EQ(0u, cache->getMemoryUsage());
+}
+
+TEST(RawVolumeBrickLoader, readBrickedFile) {
+    const size3_t dims{10, 7, 5};
+    const size3_t brickSize{4, 4, 4};
+    auto source = createSource(dims);
+    VolumeBrickedRAM fromRAM(std::make_shared<VolumeRAMBrickLoader>(source), dims, brickSize,
+                             DataUInt16::get());
+
+    util::TempFileHandle tmp("inviwo", ".raw");
+    {
+        auto out = filesystem::ofstream(tmp.getFileName(), std::ios::out | std::ios::binary);
+        util::IndexMapper3D bim(fromRAM.getNumberOfBricks());
+        for (size_t i = 0; i < glm::compMul(fromRAM.getNumberOfBricks()); ++i) {
+            const auto brick = bim(i);
+            ASSERT_EQ(util::brickedRawOffset(dims, brickSize, brick) * sizeof(std::uint16_t),
+                      static_cast<size_t>(out.tellp()));
+            auto data = fromRAM.getBrick(brick);
+            out.write(static_cast<const char*>(data->getData()), data->getNumberOfBytes());
+        }
+        ASSERT_EQ(source->getNumberOfBytes(), static_cast<size_t>(out.tellp()));
+    }
+
+    VolumeBrickedRAM fromFile(std::make_shared<RawVolumeBrickLoader>(tmp.getFileName(), 0, true),
+                              dims, brickSize, DataUInt16::get());
+    auto full = fromFile.getRegion(size3_t{0}, dims);
+    EXPECT_EQ(0, std::memcmp(source->getData(), full->getData(), source->getNumberOfBytes()));
+}
+
+}  // namespace inviwo
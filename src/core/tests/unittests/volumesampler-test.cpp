@@ -0,0 +1,189 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2021 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#include <warn/push>
+#include <warn/ignore/all>
+#include <gtest/gtest.h>
+#include <warn/pop>
+
+#include <inviwo/core/datastructures/volume/volume.h>
+#include <inviwo/core/datastructures/volume/volumeramprecision.h>
+#include <inviwo/core/util/interpolation.h>
+#include <inviwo/core/util/volumesampler.h>
+
+#include <cstdint>
+#include <type_traits>
+#include <vector>
+
+namespace inviwo {
+
+namespace {
+
+template <unsigned int DataDims>
+Vector<DataDims, double> getVoxel(const VolumeRAM& ram, const size3_t& pos) {
+    const auto p = glm::clamp(pos, size3_t(0), ram.getDimensions() - size3_t(1));
+    if constexpr (DataDims == 1) {
+        return ram.getAsDouble(p);
+    } else if constexpr (DataDims == 2) {
+        return ram.getAsDVec2(p);
+    } else if constexpr (DataDims == 3) {
+        return ram.getAsDVec3(p);
+    } else {
+        return ram.getAsDVec4(p);
+    }
+}
+
+// Trilinear sampling through the virtual VolumeRAM accessors, as the sampler used to do it
+template <unsigned int DataDims>
+Vector<DataDims, double> referenceSample(const VolumeRAM& ram, const dvec3& pos) {
+    if (glm::any(glm::lessThan(pos, dvec3(0.0))) || glm::any(glm::greaterThan(pos, dvec3(1.0)))) {
+        return Vector<DataDims, double>(0.0);
+    }
+    const dvec3 samplePos = pos * dvec3(ram.getDimensions() - size3_t(1));
+    const size3_t indexPos = size3_t(samplePos);
+    const dvec3 interpolants = samplePos - dvec3(indexPos);
+
+    const Vector<DataDims, double> samples[8] = {
+        getVoxel<DataDims>(ram, indexPos),
+        getVoxel<DataDims>(ram, indexPos + size3_t(1, 0, 0)),
+        getVoxel<DataDims>(ram, indexPos + size3_t(0, 1, 0)),
+        getVoxel<DataDims>(ram, indexPos + size3_t(1, 1, 0)),
+        getVoxel<DataDims>(ram, indexPos + size3_t(0, 0, 1)),
+        getVoxel<DataDims>(ram, indexPos + size3_t(1, 0, 1)),
+        getVoxel<DataDims>(ram, indexPos + size3_t(0, 1, 1)),
+        getVoxel<DataDims>(ram, indexPos + size3_t(1, 1, 1))};
+
+    return Interpolation<Vector<DataDims, double>>::trilinear(samples, interpolants);
+}
+
+// Positions at 0 and 1, at and between the voxels, and outside of [0,1] along each axis
+std::vector<dvec3> makePositions(const size3_t& dims) {
+    std::vector<double> coords[3];
+    for (size_t axis = 0; axis < 3; ++axis) {
+        auto& c = coords[axis];
+        c = {-0.25, 0.0, 1.0, 1.25};
+        for (size_t i = 0; i < dims[axis]; ++i) {
+            c.push_back((i + 0.5) / dims[axis]);
+            if (dims[axis] > 1) c.push_back(static_cast<double>(i) / (dims[axis] - 1));
+        }
+    }
+    std::vector<dvec3> positions;
+    for (auto z : coords[2]) {
+        for (auto y : coords[1]) {
+            for (auto x : coords[0]) positions.emplace_back(x, y, z);
+        }
+    }
+    return positions;
+}
+
+template <unsigned int DataDims>
+void expectNear(const Vector<DataDims, double>& expected, const Vector<DataDims, double>& actual,
+                size_t index) {
+    for (size_t i = 0; i < DataDims; ++i) {
+        EXPECT_NEAR(glmcomp(expected, i), glmcomp(actual, i), 1e-12)
+            << "component " << i << " of position " << index;
+    }
+}
+
+template <unsigned int DataDims>
+void checkSampler(std::shared_ptr<Volume> volume) {
+    using R = Vector<DataDims, double>;
+    // A non-trivial model matrix, to separate model space from data space
+    volume->setBasis(mat3(vec3(2.0f, 0.0f, 0.0f), vec3(0.0f, 4.0f, 0.0f), vec3(0.0f, 0.0f, 8.0f)));
+    volume->setOffset(vec3(-1.0f, -2.0f, -4.0f));
+
+    const auto& ram = *volume->getRepresentation<VolumeRAM>();
+    const auto positions = makePositions(volume->getDimensions());
+    std::vector<R> expected;
+    for (const auto& pos : positions) expected.push_back(referenceSample<DataDims>(ram, pos));
+
+    VolumeDoubleSampler<DataDims> sampler(volume);
+    std::vector<R> batch(positions.size());
+    sampler.sample(positions, batch);
+    std::vector<R> dataSpaceBatch(positions.size());
+    sampler.sampleDataSpace(positions, dataSpaceBatch);
+    for (size_t i = 0; i < positions.size(); ++i) {
+        expectNear<DataDims>(expected[i], sampler.sampleDataSpace(positions[i]), i);
+        expectNear<DataDims>(expected[i], batch[i], i);
+        expectNear<DataDims>(expected[i], dataSpaceBatch[i], i);
+    }
+
+    // Sample in model space, the reference is taken at the same positions mapped to data space
+    const auto& transformer = volume->getCoordinateTransformer();
+    const dmat4 toModel{transformer.getMatrix(CoordinateSpace::Data, CoordinateSpace::Model)};
+    const dmat4 toData{transformer.getMatrix(CoordinateSpace::Model, CoordinateSpace::Data)};
+    std::vector<dvec3> modelPositions;
+    std::vector<R> modelExpected;
+    for (const auto& pos : positions) {
+        const auto m = toModel * dvec4(pos, 1.0);
+        modelPositions.push_back(dvec3(m) / m.w);
+        const auto d = toData * dvec4(modelPositions.back(), 1.0);
+        modelExpected.push_back(referenceSample<DataDims>(ram, dvec3(d) / d.w));
+    }
+    VolumeDoubleSampler<DataDims> modelSampler(volume, CoordinateSpace::Model);
+    std::vector<R> modelBatch(modelPositions.size());
+    modelSampler.sample(modelPositions, modelBatch);
+    for (size_t i = 0; i < modelPositions.size(); ++i) {
+        expectNear<DataDims>(modelExpected[i], modelSampler.sample(modelPositions[i]), i);
+        expectNear<DataDims>(modelExpected[i], modelBatch[i], i);
+    }
+}
+
+template <typename T>
+std::shared_ptr<Volume> makeVolume(const size3_t& dims) {
+    auto ram = std::make_shared<VolumeRAMPrecision<T>>(dims);
+    auto data = ram->getDataTyped();
+    for (size_t i = 0; i < glm::compMul(dims); ++i) {
+        if constexpr (std::is_same_v<T, std::uint8_t>) {
+            data[i] = static_cast<std::uint8_t>((i * 37) % 256);
+        } else {
+            data[i] = T(0.5f * i, -1.0f * i, 1.0f / (i + 1));
+        }
+    }
+    return std::make_shared<Volume>(ram);
+}
+
+}  // namespace
+
+TEST(VolumeSampler, uint8Scalar) {
+    checkSampler<1>(makeVolume<std::uint8_t>(size3_t{4, 3, 5}));
+    checkSampler<4>(makeVolume<std::uint8_t>(size3_t{4, 3, 5}));
+}
+
+TEST(VolumeSampler, floatVec3) {
+    checkSampler<3>(makeVolume<vec3>(size3_t{3, 4, 2}));
+    checkSampler<4>(makeVolume<vec3>(size3_t{3, 4, 2}));
+}
+
+TEST(VolumeSampler, singleSlice) {
+    checkSampler<1>(makeVolume<std::uint8_t>(size3_t{5, 1, 3}));
+    checkSampler<3>(makeVolume<vec3>(size3_t{3, 4, 1}));
+}
+
+}  // namespace inviwo
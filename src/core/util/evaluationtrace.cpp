@@ -0,0 +1,226 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2021 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#include <inviwo/core/util/evaluationtrace.h>
+#include <inviwo/core/util/exception.h>
+#include <inviwo/core/util/filesystem.h>
+
+#include <algorithm>
+#include <fstream>
+#include <iomanip>
+#include <ostream>
+#include <sstream>
+
+namespace inviwo {
+
+namespace {
+
+// Conversions on the current thread, used for the events of processors and background jobs
+thread_local size_t threadConversions = 0;
+thread_local size_t threadBytes = 0;
+// Conversions on all threads, used for the events of whole evaluations
+std::atomic<size_t> totalConversions{0};
+std::atomic<size_t> totalBytes{0};
+
+std::atomic<size_t> threadCount{0};
+
+void writeString(std::ostream& os, std::string_view str) {
+    os << '"';
+    for (const char c : str) {
+        switch (c) {
+            case '"':
+                os << "\\\"";
+                break;
+            case '\\':
+                os << "\\\\";
+                break;
+            case '\n':
+                os << "\\n";
+                break;
+            case '\t':
+                os << "\\t";
+                break;
+            default:
+                if (static_cast<unsigned char>(c) < 0x20) {
+                    os << "\\u" << std::hex << std::setw(4) << std::setfill('0')
+                       << static_cast<int>(c) << std::dec << std::setfill(' ');
+                } else {
+                    os << c;
+                }
+        }
+    }
+    os << '"';
+}
+
+}  // namespace
+
+EvaluationTrace::EvaluationTrace(size_t capacity)
+    : enabled_{false}
+    , epoch_{clock::now()}
+    , events_{}
+    , capacity_{std::max(capacity, size_t{1})}
+    , next_{0} {}
+
+void EvaluationTrace::setEnabled(bool enabled) { enabled_ = enabled; }
+
+bool EvaluationTrace::isEnabled() const { return enabled_; }
+
+void EvaluationTrace::setCapacity(size_t capacity) {
+    capacity = std::max(capacity, size_t{1});
+    auto events = getEvents();
+    if (events.size() > capacity) {
+        events.erase(events.begin(), events.end() - capacity);
+    }
+
+    std::scoped_lock lock{mutex_};
+    events_ = std::move(events);
+    capacity_ = capacity;
+    next_ = 0;
+}
+
+size_t EvaluationTrace::getCapacity() const {
+    std::scoped_lock lock{mutex_};
+    return capacity_;
+}
+
+void EvaluationTrace::record(TraceEvent event) {
+    std::scoped_lock lock{mutex_};
+    if (events_.size() < capacity_) {
+        events_.push_back(std::move(event));
+    } else {
+        events_[next_] = std::move(event);
+        next_ = (next_ + 1) % capacity_;
+    }
+}
+
+std::vector<TraceEvent> EvaluationTrace::getEvents() const {
+    std::scoped_lock lock{mutex_};
+    std::vector<TraceEvent> events;
+    events.reserve(events_.size());
+    events.insert(events.end(), events_.begin() + next_, events_.end());
+    events.insert(events.end(), events_.begin(), events_.begin() + next_);
+    return events;
+}
+
+size_t EvaluationTrace::size() const {
+    std::scoped_lock lock{mutex_};
+    return events_.size();
+}
+
+void EvaluationTrace::clear() {
+    std::scoped_lock lock{mutex_};
+    events_.clear();
+    next_ = 0;
+}
+
+void EvaluationTrace::writeChromeTrace(std::ostream& os) const {
+    using us = std::chrono::duration<double, std::micro>;
+
+    const auto events = getEvents();
+    // Fixed notation, the default precision would round timestamps far from the epoch
+    const auto flags = os.flags();
+    const auto precision = os.precision();
+    os << std::fixed << std::setprecision(3);
+
+    os << "{\"traceEvents\":[";
+    for (size_t i = 0; i < events.size(); ++i) {
+        const auto& e = events[i];
+        if (i != 0) os << ",";
+        os << "\n{\"name\":";
+        if (e.name.empty()) {
+            std::ostringstream type;
+            type << e.type;
+            writeString(os, type.str());
+        } else {
+            writeString(os, e.name);
+        }
+        os << ",\"cat\":\"" << e.type << "\",\"ph\":\"X\",\"ts\":" << us(e.start - epoch_).count()
+           << ",\"dur\":" << us(e.duration).count() << ",\"pid\":0,\"tid\":" << e.thread
+           << ",\"args\":{\"conversions\":" << e.conversions << ",\"bytes\":" << e.bytes << "}}";
+    }
+    os << "\n],\"displayTimeUnit\":\"ms\"}\n";
+
+    os.flags(flags);
+    os.precision(precision);
+}
+
+void EvaluationTrace::writeChromeTrace(std::string_view filename) const {
+    auto file = filesystem::ofstream(std::string{filename});
+    if (!file) {
+        throw FileException("Could not open file \"" + std::string{filename} + "\" for writing",
+                            IVW_CONTEXT);
+    }
+    writeChromeTrace(file);
+}
+
+EvaluationTrace::Scope::Scope(EvaluationTrace& trace, TraceEventType type, std::string_view name)
+    : trace_{trace.isEnabled() ? &trace : nullptr}
+    , type_{type}
+    , name_{}
+    , start_{}
+    , conversions_{0}
+    , bytes_{0} {
+    if (!trace_) return;
+
+    name_ = name;
+    if (type_ == TraceEventType::Evaluation) {
+        conversions_ = totalConversions;
+        bytes_ = totalBytes;
+    } else {
+        conversions_ = threadConversions;
+        bytes_ = threadBytes;
+    }
+    start_ = clock::now();
+}
+
+EvaluationTrace::Scope::~Scope() {
+    if (!trace_) return;
+
+    const auto end = clock::now();
+    const bool all = type_ == TraceEventType::Evaluation;
+    const size_t conversions = (all ? totalConversions.load() : threadConversions) - conversions_;
+    const size_t bytes = (all ? totalBytes.load() : threadBytes) - bytes_;
+
+    trace_->record(
+        {type_, std::move(name_), start_, end - start_, getThreadId(), conversions, bytes});
+}
+
+void EvaluationTrace::countConversion(size_t bytes) {
+    ++threadConversions;
+    threadBytes += bytes;
+    totalConversions.fetch_add(1, std::memory_order_relaxed);
+    totalBytes.fetch_add(bytes, std::memory_order_relaxed);
+}
+
+size_t EvaluationTrace::getThreadId() {
+    thread_local const size_t id = threadCount++;
+    return id;
+}
+
+}  // namespace inviwo
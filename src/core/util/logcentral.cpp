@@ -34,6 +34,7 @@
 #include <inviwo/core/common/inviwoapplication.h>
 #include <inviwo/core/processors/processor.h>
 #include <inviwo/core/network/processornetwork.h>
+#include <inviwo/core/util/asyncdeliveryqueue.h>
 
 namespace inviwo {
 
@@ -85,18 +86,43 @@ void Logger::logAssertion(std::string_view file, std::string_view function, int
     log("Assertion failed", LogLevel::Error, LogAudience::Developer, file, function, line, msg);
 }
 
+/**
+ * The queue and logging thread of the asynchronous mode
+ */
+class LogCentral::AsyncQueue : public util::AsyncDeliveryQueue<Message> {
+public:
+    explicit AsyncQueue(LogCentral* logCentral)
+        : util::AsyncDeliveryQueue<Message>{
+              [logCentral](Message& message) {
+                  if (message.format) message.msg = message.format();
+                  logCentral->deliver(message.kind, nullptr, message.source, message.level,
+                                      message.audience, message.file, message.function,
+                                      message.line, message.msg);
+              },
+              "Inviwo Logging Thread"} {}
+};
+
 LogCentral::LogCentral() : logVerbosity_(LogVerbosity::Info), logStacktrace_(false) {}
 
+LogCentral::~LogCentral() {
+    setAsynchronous(false);
+    asyncQueues_.clear();
+}
+
 void LogCentral::setVerbosity(LogVerbosity verbosity) { logVerbosity_ = verbosity; }
 
 LogVerbosity LogCentral::getVerbosity() { return logVerbosity_; }
 
-void LogCentral::registerLogger(std::weak_ptr<Logger> logger) { loggers_.push_back(logger); }
+void LogCentral::registerLogger(std::weak_ptr<Logger> logger) {
+    std::scoped_lock lock{loggersMutex_};
+    loggers_.push_back(logger);
+}
 
 void LogCentral::log(std::string_view source, LogLevel level, LogAudience audience,
                      std::string_view file, std::string_view function, int line,
                      std::string_view msg) {
-    if (logStacktrace_ && level == LogLevel::Error && audience == LogAudience::Developer) {
+    std::string msgWithStacktrace;
+    if (needsStacktrace(level, audience)) {
         std::stringstream ss;
         ss << msg;
 
@@ -108,21 +134,91 @@ void LogCentral::log(std::string_view source, LogLevel level, LogAudience audien
         // append an extra line break to easier separate several stack traces in a row
         ss << '\n';
 
-        msg = ss.str();
+        msgWithStacktrace = ss.str();
+        msg = msgWithStacktrace;
     }
 
     if (level >= logVerbosity_) {
-        // use remove if here to remove expired weak pointers while calling the loggers.
-        util::erase_remove_if(loggers_, [&](const std::weak_ptr<Logger>& logger) {
-            if (auto l = logger.lock()) {
-                l->log(source, level, audience, file, function, line, msg);
-                return false;
-            } else {
-                return true;
-            }
-        });
+        if (auto queue = asyncQueue()) {
+            enqueue(queue, Message{MessageKind::Log, std::string(source), level, audience,
+                                   std::string(file), std::string(function), line,
+                                   std::string(msg), {}});
+        } else {
+            deliver(MessageKind::Log, nullptr, source, level, audience, file, function, line, msg);
+        }
+    }
+
+    breakOnMessage(level);
+}
+
+void LogCentral::logProcessor(Processor* processor, LogLevel level, LogAudience audience,
+                              std::string_view msg, std::string_view file,
+                              std::string_view function, int line) {
+    if (level >= logVerbosity_) {
+        if (auto queue = asyncQueue()) {
+            enqueue(queue, Message{MessageKind::Log, "Processor " + processor->getIdentifier(),
+                                   level, audience, std::string(file), std::string(function),
+                                   line, std::string(msg), {}});
+        } else {
+            deliver(MessageKind::Processor, processor, processor->getIdentifier(), level,
+                    audience, file, function, line, msg);
+        }
     }
+}
 
+void LogCentral::logNetwork(LogLevel level, LogAudience audience, std::string_view msg,
+                            std::string_view file, std::string_view function, int line) {
+    if (level >= logVerbosity_) {
+        if (auto queue = asyncQueue()) {
+            enqueue(queue, Message{MessageKind::Network, "ProcessorNetwork", level, audience,
+                                   std::string(file), std::string(function), line,
+                                   std::string(msg), {}});
+        } else {
+            deliver(MessageKind::Network, nullptr, "ProcessorNetwork", level, audience, file,
+                    function, line, msg);
+        }
+    }
+}
+
+void LogCentral::logAssertion(std::string_view file, std::string_view function, int line,
+                              std::string_view msg) {
+    // Keep the order of any queued messages
+    flush();
+
+    for (const auto& logger : liveLoggers()) {
+        logger->logAssertion(file, function, line, msg);
+    }
+}
+
+void LogCentral::setAsynchronous(bool asynchronous) {
+    std::scoped_lock lock{asyncMutex_};
+    if (asynchronous) {
+        if (asyncQueue_.load()) return;
+        asyncQueues_.push_back(std::make_unique<AsyncQueue>(this));
+        asyncQueue_.store(asyncQueues_.back().get(), std::memory_order_release);
+    } else if (auto queue = asyncQueue_.exchange(nullptr)) {
+        // Delivers the queued messages. Producers that loaded the queue before the exchange
+        // deliver their messages themselves once it is stopped.
+        queue->stop();
+    }
+}
+
+bool LogCentral::isAsynchronous() const { return asyncQueue() != nullptr; }
+
+void LogCentral::flush() {
+    if (auto queue = asyncQueue()) queue->flush();
+}
+
+void LogCentral::setRateLimit(size_t maxRepeats, std::chrono::milliseconds window) {
+    std::scoped_lock lock{repeatsMutex_};
+    maxRepeats_ = maxRepeats;
+    rateWindow_ = window;
+    repeats_.clear();
+}
+
+size_t LogCentral::getRateLimit() const { return maxRepeats_; }
+
+void LogCentral::breakOnMessage(LogLevel level) const {
     switch (breakLevel_) {
         case MessageBreakLevel::Off:
             break;
@@ -140,47 +236,92 @@ void LogCentral::log(std::string_view source, LogLevel level, LogAudience audien
     }
 }
 
-void LogCentral::logProcessor(Processor* processor, LogLevel level, LogAudience audience,
-                              std::string_view msg, std::string_view file,
-                              std::string_view function, int line) {
-    if (level >= logVerbosity_) {
-        // use remove if here to remove expired weak pointers while calling the loggers.
-        util::erase_remove_if(loggers_, [&](const std::weak_ptr<Logger>& logger) {
-            if (auto l = logger.lock()) {
-                l->logProcessor(processor, level, audience, msg, file, function, line);
-                return false;
-            } else {
-                return true;
-            }
-        });
+std::string LogCentral::formatMessage(std::string_view format, fmt::format_args args) {
+    try {
+        return fmt::vformat(format, args);
+    } catch (const std::exception& e) {
+        return "Invalid log format: " + std::string(e.what());
     }
 }
 
-void LogCentral::logNetwork(LogLevel level, LogAudience audience, std::string_view msg,
-                            std::string_view file, std::string_view function, int line) {
-    if (level >= logVerbosity_) {
-        // use remove if here to remove expired weak pointers while calling the loggers.
-        util::erase_remove_if(loggers_, [&](const std::weak_ptr<Logger>& logger) {
-            if (auto l = logger.lock()) {
-                l->logNetwork(level, audience, msg, file, function, line);
-                return false;
-            } else {
-                return true;
+void LogCentral::enqueue(AsyncQueue* queue, Message message) { queue->push(std::move(message)); }
+
+void LogCentral::deliver(MessageKind kind, Processor* processor, std::string_view source,
+                         LogLevel level, LogAudience audience, std::string_view file,
+                         std::string_view function, int line, std::string_view msg) {
+    if (maxRepeats_ != 0) {
+        using clock = std::chrono::steady_clock;
+        const auto now = clock::now();
+
+        std::string key;
+        key.reserve(source.size() + msg.size() + 2);
+        key.append(source).append(1, static_cast<char>('0' + static_cast<int>(level)));
+        key.append(1, '\n').append(msg);
+
+        size_t suppressed = 0;
+        {
+            std::scoped_lock lock{repeatsMutex_};
+            // Drop old entries so that the map does not grow without bound
+            if (repeats_.size() > 4096) {
+                util::map_erase_remove_if(repeats_, [&](const auto& item) {
+                    return now - item.second.start > rateWindow_;
+                });
+            }
+
+            auto& repeats = repeats_.try_emplace(std::move(key), Repeats{now, 0, 0}).first->second;
+            if (now - repeats.start > rateWindow_) {
+                suppressed = repeats.suppressed;
+                repeats = Repeats{now, 0, 0};
+            }
+            if (++repeats.count > maxRepeats_) {
+                ++repeats.suppressed;
+                return;
             }
-        });
+        }
+        if (suppressed != 0) {
+            fanOut(kind, processor, source, level, audience, file, function, line,
+                   fmt::format("{} repeats of the following message were suppressed", suppressed));
+        }
     }
+
+    fanOut(kind, processor, source, level, audience, file, function, line, msg);
 }
 
-void LogCentral::logAssertion(std::string_view file, std::string_view function, int line,
-                              std::string_view msg) {
+std::vector<std::shared_ptr<Logger>> LogCentral::liveLoggers() {
+    std::vector<std::shared_ptr<Logger>> live;
+    std::scoped_lock lock{loggersMutex_};
+    live.reserve(loggers_.size());
+    // Remove expired weak pointers while collecting the live loggers
     util::erase_remove_if(loggers_, [&](const std::weak_ptr<Logger>& logger) {
         if (auto l = logger.lock()) {
-            l->logAssertion(file, function, line, msg);
+            live.push_back(std::move(l));
             return false;
         } else {
             return true;
         }
     });
+    return live;
+}
+
+void LogCentral::fanOut(MessageKind kind, Processor* processor, std::string_view source,
+                        LogLevel level, LogAudience audience, std::string_view file,
+                        std::string_view function, int line, std::string_view msg) {
+    // The loggers are called without holding any lock, a logger may block, e.g. by showing a
+    // dialog, or log itself without stalling other threads.
+    for (const auto& l : liveLoggers()) {
+        switch (kind) {
+            case MessageKind::Processor:
+                l->logProcessor(processor, level, audience, msg, file, function, line);
+                break;
+            case MessageKind::Network:
+                l->logNetwork(level, audience, msg, file, function, line);
+                break;
+            case MessageKind::Log:
+            default:
+                l->log(source, level, audience, file, function, line, msg);
+                break;
+        }
+    }
 }
 
 void LogCentral::setLogStacktrace(const bool& logStacktrace) { logStacktrace_ = logStacktrace; }
@@ -0,0 +1,117 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2021 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#include <inviwo/core/util/parallel.h>
+#include <inviwo/core/util/threadpool.h>
+#include <inviwo/core/common/inviwoapplication.h>
+
+namespace inviwo {
+
+namespace util {
+
+namespace detail {
+
+ForkJoinJob::ForkJoinJob(size_t chunks, Body body, void* data)
+    : chunks_{chunks}
+    , body_{body}
+    , data_{data}
+    , next_{0}
+    , done_{0}
+    , failed_{false}
+    , mutex_{}
+    , condition_{}
+    , exception_{} {}
+
+void ForkJoinJob::work() {
+    for (size_t chunk = next_++; chunk < chunks_; chunk = next_++) {
+        if (!failed_) {
+            try {
+                body_(data_, chunk);
+            } catch (...) {
+                std::scoped_lock lock{mutex_};
+                if (!exception_) exception_ = std::current_exception();
+                failed_ = true;
+            }
+        }
+        if (++done_ == chunks_) {
+            {
+                std::scoped_lock lock{mutex_};
+            }
+            condition_.notify_all();
+        }
+    }
+}
+
+void ForkJoinJob::wait() {
+    std::unique_lock<std::mutex> lock{mutex_};
+    condition_.wait(lock, [this]() { return done_ == chunks_; });
+    if (exception_) std::rethrow_exception(exception_);
+}
+
+void forkJoin(ThreadPool& pool, size_t chunks, ForkJoinJob::Body body, void* data) {
+    const auto helpers = std::min(chunks, pool.getSize() + 1) - 1;
+    if (helpers == 0) {
+        for (size_t chunk = 0; chunk < chunks; ++chunk) body(data, chunk);
+        return;
+    }
+
+    // The helpers might not start until after we are done, they only keep the shared state alive
+    // and will never touch data unless they manage to claim a chunk.
+    auto job = std::make_shared<ForkJoinJob>(chunks, body, data);
+    for (size_t i = 0; i < helpers; ++i) {
+        // Some thread is already waiting for these, hence use high priority.
+        pool.enqueueTask([job]() { job->work(); }, ThreadPool::Priority::High);
+    }
+    job->work();
+    job->wait();
+}
+
+void forkJoin(size_t chunks, ForkJoinJob::Body body, void* data) {
+    if (InviwoApplication::isInitialized()) {
+        forkJoin(InviwoApplication::getPtr()->getThreadPool(), chunks, body, data);
+    } else {
+        for (size_t chunk = 0; chunk < chunks; ++chunk) body(data, chunk);
+    }
+}
+
+size_t forkJoinConcurrency(ThreadPool* pool) {
+    if (pool) {
+        return pool->getSize() + 1;
+    } else if (InviwoApplication::isInitialized()) {
+        return InviwoApplication::getPtr()->getPoolSize() + 1;
+    } else {
+        return 1;
+    }
+}
+
+}  // namespace detail
+
+}  // namespace util
+
+}  // namespace inviwo
@@ -41,6 +41,7 @@ SystemSettings::SystemSettings(InviwoApplication* app)
                              {"developerMode", "Developer Mode", UsageMode::Development}},
                             1)
     , poolSize_("poolSize", "Pool Size", defaultPoolSize(), 0, 32)
+    , parallelEvaluation_("parallelEvaluation", "Parallel Network Evaluation", false)
     , enablePortInspectors_("enablePortInspectors", "Enable port inspectors", true)
     , portInspectorSize_("portInspectorSize", "Port inspector size", 128, 1, 1024)
 #if __APPLE__
@@ -59,16 +60,19 @@ SystemSettings::SystemSettings(InviwoApplication* app)
                       {MessageBreakLevel::Off, MessageBreakLevel::Error, MessageBreakLevel::Warn,
                        MessageBreakLevel::Info},
                       0}
+    , asynchronousLogging_{"asynchronousLogging", "Asynchronous Logging", false}
+    , logRateLimit_{"logRateLimit", "Max Repeated Log Messages per Second", 0, 0, 1000}
     , breakOnException_{"breakOnException", "Break on Exception", false}
     , stackTraceInException_{"stackTraceInException", "Create Stack Trace for Exceptions", false}
     , redirectCout_{"redirectCout", "Redirect cout to LogCentral", false}
     , redirectCerr_{"redirectCerr", "Redirect cerr to LogCentral", false} {
 
-    addProperties(workspaceAuthor_, applicationUsageMode_, poolSize_, enablePortInspectors_,
-                  portInspectorSize_, enableTouchProperty_, enableGesturesProperty_,
-                  enablePickingProperty_, enableSoundProperty_, logStackTraceProperty_,
-                  runtimeModuleReloading_, enableResourceManager_, breakOnMessage_,
-                  breakOnException_, stackTraceInException_, redirectCout_, redirectCerr_);
+    addProperties(workspaceAuthor_, applicationUsageMode_, poolSize_, parallelEvaluation_,
+                  enablePortInspectors_, portInspectorSize_, enableTouchProperty_,
+                  enableGesturesProperty_, enablePickingProperty_, enableSoundProperty_,
+                  logStackTraceProperty_, runtimeModuleReloading_, enableResourceManager_,
+                  breakOnMessage_, asynchronousLogging_, logRateLimit_, breakOnException_,
+                  stackTraceInException_, redirectCout_, redirectCerr_);
 
     logStackTraceProperty_.onChange(
         [this]() { LogCentral::getPtr()->setLogStacktrace(logStackTraceProperty_.get()); });
@@ -81,6 +85,11 @@ SystemSettings::SystemSettings(InviwoApplication* app)
     breakOnMessage_.onChange(
         [this]() { LogCentral::getPtr()->setMessageBreakLevel(breakOnMessage_.get()); });
 
+    asynchronousLogging_.onChange(
+        [this]() { LogCentral::getPtr()->setAsynchronous(asynchronousLogging_.get()); });
+
+    logRateLimit_.onChange([this]() { LogCentral::getPtr()->setRateLimit(logRateLimit_.get()); });
+
     redirectCout_.onChange([&]() {
         if (redirectCout_ && !cout_) {
             cout_ = std::make_unique<LogStream>(std::cout, "cout", LogLevel::Info,
@@ -102,7 +111,12 @@ SystemSettings::SystemSettings(InviwoApplication* app)
     load();
 }
 
-SystemSettings::~SystemSettings() = default;
+SystemSettings::~SystemSettings() {
+    // Deliver queued messages while the loggers are still around
+    if (asynchronousLogging_ && LogCentral::isInitialized()) {
+        LogCentral::getPtr()->setAsynchronous(false);
+    }
+}
 
 size_t SystemSettings::defaultPoolSize() { return std::thread::hardware_concurrency() / 2; }
 
@@ -32,20 +32,31 @@
 #include <inviwo/core/util/stdextensions.h>
 #include <inviwo/core/util/threadutil.h>
 
+#include <algorithm>
+
 namespace inviwo {
 
+namespace {
+// The worker running on this thread, if any. Stored as void* since ThreadPool::Worker is private.
+thread_local void* threadWorker = nullptr;
+}  // namespace
+
 // the constructor just launches some amount of workers
 ThreadPool::ThreadPool(size_t threads, std::function<void()> onThreadStart,
                        std::function<void()> onThreadStop)
     : onThreadStart_{std::move(onThreadStart)}, onThreadStop_{std::move(onThreadStop)} {
+    std::unique_lock<std::shared_mutex> lock(workersMutex_);
     while (workers.size() < threads) {
         workers.push_back(std::make_unique<Worker>(*this));
     }
 }
 
 size_t ThreadPool::trySetSize(size_t size) {
-    while (workers.size() < size) {
-        workers.push_back(std::make_unique<Worker>(*this));
+    if (workers.size() < size) {
+        std::unique_lock<std::shared_mutex> lock(workersMutex_);
+        while (workers.size() < size) {
+            workers.push_back(std::make_unique<Worker>(*this));
+        }
     }
 
     if (workers.size() > size) {
@@ -60,8 +71,9 @@ size_t ThreadPool::trySetSize(size_t size) {
             if (active <= size) break;
         }
 
-        condition.notify_all();
+        wakeAll();
 
+        std::unique_lock<std::shared_mutex> lock(workersMutex_);
         util::erase_remove_if(
             workers, [](std::unique_ptr<Worker>& worker) { return worker->state == State::Done; });
     }
@@ -70,40 +82,44 @@ size_t ThreadPool::trySetSize(size_t size) {
 
 size_t ThreadPool::getSize() const { return workers.size(); }
 
-size_t ThreadPool::getQueueSize() {
-    std::unique_lock<std::mutex> lock(queue_mutex);
-    return tasks.size();
-}
+size_t ThreadPool::getQueueSize() { return pending_.load(); }
 
 ThreadPool::~ThreadPool() {
-    for (auto& worker : workers) worker->state = State::Abort;
-    condition.notify_all();
-    workers.clear();  // this will join all threads.
+    // Let the workers run all queued tasks before stopping
+    for (auto& worker : workers) worker->state = State::Stop;
+    wakeAll();
+    // Join all threads before destroying any worker since they might still be stealing.
+    for (auto& worker : workers) worker->thread.join();
+    workers.clear();
 }
 
-ThreadPool::Worker::~Worker() { thread.join(); }
+ThreadPool::Worker::~Worker() {
+    if (thread.joinable()) thread.join();
+}
 
-ThreadPool::Worker::Worker(ThreadPool& pool)
-    : state{State::Free}, thread{[this, &pool]() {
+ThreadPool::Worker::Worker(ThreadPool& aPool)
+    : pool{aPool}, local{}, state{State::Free}, thread{[this]() {
+        threadWorker = this;
         pool.onThreadStart_();
-        util::OnScopeExit cleanup{[&pool]() { pool.onThreadStop_(); }};
+        util::OnScopeExit cleanup{[this]() {
+            pool.onThreadStop_();
+            threadWorker = nullptr;
+        }};
 
         for (;;) {
-            std::function<void()> task;
-            state = State::Free;
-            {
-                std::unique_lock<std::mutex> lock(pool.queue_mutex);
-                pool.condition.wait(lock, [this, &pool] {
-                    return state == State::Abort || state == State::Stop || !pool.tasks.empty();
-                });
-                if (state == State::Abort || (state == State::Stop && pool.tasks.empty())) break;
-                task = std::move(pool.tasks.front());
-                pool.tasks.pop();
-            }
-            state = State::Working;
-            try {
-                task();
-            } catch (...) {  // Make sure we don't leak any exceptions.
+            if (auto task = pool.take(*this)) {
+                auto expected = State::Free;
+                state.compare_exchange_strong(expected, State::Working);
+                try {
+                    task();
+                } catch (...) {  // Make sure we don't leak any exceptions.
+                }
+                expected = State::Working;
+                state.compare_exchange_strong(expected, State::Free);
+            } else if (state == State::Stop) {
+                break;  // No more tasks for us
+            } else {
+                pool.sleep(*this);
             }
         }
         state = State::Done;
@@ -112,14 +128,112 @@ ThreadPool::Worker::Worker(ThreadPool& pool)
     util::setThreadDescription(thread, "Inviwo Worker Thread");
 }
 
-void ThreadPool::enqueueRaw(std::function<void()> task) {
-    if (workers.empty()) {
+void ThreadPool::enqueueRaw(std::function<void()> task, Priority priority) {
+    push(Task{std::move(task)}, priority);
+}
+
+void ThreadPool::enqueueTask(Task task, Priority priority) { push(std::move(task), priority); }
+
+ThreadPool::Worker* ThreadPool::currentWorker() const {
+    auto worker = static_cast<Worker*>(threadWorker);
+    return worker && &worker->pool == this ? worker : nullptr;
+}
+
+void ThreadPool::push(Task task, Priority priority) {
+    const auto lane = static_cast<size_t>(priority);
+    if (auto worker = currentWorker()) {
+        worker->local[lane].push(std::move(task), pending_);
+    } else if (workers.empty()) {
         task();  // No worker threads, just run the task.
+        return;
     } else {
-        std::unique_lock<std::mutex> lock(queue_mutex);
-        tasks.emplace(std::move(task));
+        injection_[lane].push(std::move(task), pending_);
     }
-    condition.notify_one();
+
+    // Only touch the sleep mutex if someone is actually sleeping. pending_ and sleeping_ are both
+    // sequentially consistent, hence either we see the sleeper here, or the sleeper sees the new
+    // task before going to sleep.
+    if (sleeping_.load() > 0) {
+        {
+            std::scoped_lock lock{sleepMutex_};
+        }
+        condition_.notify_one();
+    }
+}
+
+ThreadPool::Task ThreadPool::take(Worker& worker) {
+    if (pending_.load() == 0) return {};
+
+    for (size_t lane = 0; lane < numPriorities; ++lane) {
+        if (auto task = worker.local[lane].popBack(pending_)) return task;
+        if (auto task = injection_[lane].popFront(pending_)) return task;
+        if (auto task = steal(worker, lane)) return task;
+    }
+    return {};
+}
+
+ThreadPool::Task ThreadPool::steal(Worker& thief, size_t lane) {
+    std::shared_lock<std::shared_mutex> lock(workersMutex_);
+    const auto nWorkers = workers.size();
+    if (nWorkers < 2) return {};
+
+    // Start looking at the worker after the thief to spread out the stealing
+    auto it = std::find_if(workers.begin(), workers.end(),
+                           [&](const auto& worker) { return worker.get() == &thief; });
+    const size_t start = it == workers.end() ? 0 : std::distance(workers.begin(), it) + 1;
+
+    for (size_t i = 0; i < nWorkers; ++i) {
+        auto& victim = *workers[(start + i) % nWorkers];
+        if (&victim == &thief || victim.local[lane].empty()) continue;
+        if (auto task = victim.local[lane].popFront(pending_)) return task;
+    }
+    return {};
+}
+
+void ThreadPool::sleep(Worker& worker) {
+    std::unique_lock<std::mutex> lock{sleepMutex_};
+    ++sleeping_;
+    condition_.wait(lock, [&]() {
+        return worker.state.load() == State::Stop || pending_.load() > 0;
+    });
+    --sleeping_;
+}
+
+void ThreadPool::wakeAll() {
+    // Lock to make sure no worker is in between checking its state and going to sleep.
+    {
+        std::scoped_lock lock{sleepMutex_};
+    }
+    condition_.notify_all();
+}
+
+void ThreadPool::Queue::push(Task task, std::atomic<size_t>& pending) {
+    std::scoped_lock lock{mutex_};
+    tasks_.push_back(std::move(task));
+    ++size_;
+    ++pending;
+}
+
+ThreadPool::Task ThreadPool::Queue::popFront(std::atomic<size_t>& pending) {
+    if (empty()) return {};
+    std::scoped_lock lock{mutex_};
+    if (tasks_.empty()) return {};
+    auto task = std::move(tasks_.front());
+    tasks_.pop_front();
+    --size_;
+    --pending;
+    return task;
+}
+
+ThreadPool::Task ThreadPool::Queue::popBack(std::atomic<size_t>& pending) {
+    if (empty()) return {};
+    std::scoped_lock lock{mutex_};
+    if (tasks_.empty()) return {};
+    auto task = std::move(tasks_.back());
+    tasks_.pop_back();
+    --size_;
+    --pending;
+    return task;
 }
 
 }  // namespace inviwo
@@ -0,0 +1,162 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2021 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#include <warn/push>
+#include <warn/ignore/all>
+#include <gtest/gtest.h>
+#include <warn/pop>
+
+#include <inviwo/qt/editor/undohistory.h>
+
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace inviwo {
+
+namespace {
+
+// States share a long header and footer, like serialized workspaces, and differ in between.
+// Some are shorter than, equal to, or a prefix of their keyframe.
+std::vector<std::shared_ptr<const std::string>> createStates(size_t count) {
+    const std::string header(1000, 'h');
+    const std::string footer(1000, 'f');
+    std::vector<std::shared_ptr<const std::string>> states;
+    for (size_t i = 0; i < count; ++i) {
+        std::string state;
+        switch (i % 5) {
+            case 0:
+                state = header + std::to_string(i) + footer;
+                break;
+            case 1:
+                state = header + std::string(i, 'x') + footer;
+                break;
+            case 2:
+                state = header;
+                break;
+            case 3:
+                state = *states[i - 1];
+                break;
+            default:
+                state = std::to_string(i) + footer;
+                break;
+        }
+        states.push_back(std::make_shared<const std::string>(std::move(state)));
+    }
+    return states;
+}
+
+void expectStates(const UndoHistory& history,
+                  const std::vector<std::shared_ptr<const std::string>>& states) {
+    ASSERT_EQ(states.size(), history.size());
+    for (size_t i = 0; i < states.size(); ++i) {
+        EXPECT_EQ(*states[i], *history.get(i)) << "state " << i;
+    }
+}
+
+}  // namespace
+
+TEST(UndoHistory, roundTripAcrossKeyframes) {
+    UndoHistory history;
+    const auto states = createStates(2 * UndoHistory::keyframeInterval + 5);
+    for (const auto& state : states) EXPECT_EQ(0u, history.push(state));
+
+    // Uncompressed or partially compressed
+    expectStates(history, states);
+
+    history.waitForCompression();
+    expectStates(history, states);
+    EXPECT_LT(history.getMemoryUsage(), states.size() * states.front()->size());
+}
+
+TEST(UndoHistory, pushTruncatesRedoStates) {
+    UndoHistory history;
+    auto states = createStates(UndoHistory::keyframeInterval + 8);
+    for (const auto& state : states) history.push(state);
+    history.waitForCompression();
+
+    // Undo into the first keyframe group and push a new state, the redo states are gone
+    history.truncate(10);
+    states.resize(10);
+    states.push_back(std::make_shared<const std::string>("new state"));
+    history.push(states.back());
+    expectStates(history, states);
+    history.waitForCompression();
+    expectStates(history, states);
+
+    // Truncating past the last keyframe makes the next state a new keyframe
+    for (const auto& state : createStates(UndoHistory::keyframeInterval + 4)) {
+        states.push_back(state);
+        history.push(state);
+    }
+    history.truncate(UndoHistory::keyframeInterval + 2);
+    states.resize(UndoHistory::keyframeInterval + 2);
+    for (const auto& state : createStates(6)) {
+        states.push_back(state);
+        history.push(state);
+    }
+    history.waitForCompression();
+    expectStates(history, states);
+
+    history.clear();
+    EXPECT_EQ(0u, history.size());
+    EXPECT_EQ(0u, history.getMemoryUsage());
+}
+
+TEST(UndoHistory, budgetDropsWholeKeyframeGroups) {
+    UndoHistory history;
+    history.setMemoryBudget(0);
+    const auto states = createStates(2 * UndoHistory::keyframeInterval + 3);
+
+    // The last keyframe group is always kept, older groups are dropped when a new keyframe is
+    // pushed
+    size_t dropped = 0;
+    for (size_t i = 0; i < states.size(); ++i) {
+        const auto n = history.push(states[i]);
+        if (i != 0 && i % UndoHistory::keyframeInterval == 0) {
+            EXPECT_EQ(UndoHistory::keyframeInterval, n) << "push " << i;
+        } else {
+            EXPECT_EQ(0u, n) << "push " << i;
+        }
+        dropped += n;
+    }
+    EXPECT_EQ(2 * UndoHistory::keyframeInterval, dropped);
+
+    history.waitForCompression();
+    expectStates(history, std::vector<std::shared_ptr<const std::string>>(
+                              states.begin() + dropped, states.end()));
+
+    // With room for everything nothing is dropped
+    history.setMemoryBudget(UndoHistory::defaultMemoryBudget);
+    for (size_t i = 0; i < UndoHistory::keyframeInterval; ++i) {
+        EXPECT_EQ(0u, history.push(states[i]));
+    }
+}
+
+}  // namespace inviwo
@@ -0,0 +1,207 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2021 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#include <inviwo/qt/editor/undohistory.h>
+
+#include <algorithm>
+
+namespace inviwo {
+
+UndoHistory::UndoHistory()
+    : quit_{false}, worker_{[this]() {
+        for (;;) {
+            Job job;
+            {
+                std::unique_lock<std::mutex> lock(mutex_);
+                working_ = false;
+                if (jobs_.empty()) idle_.notify_all();
+                while (!quit_ && jobs_.empty()) {
+                    condition_.wait(lock);
+                }
+                if (quit_) return;
+                job = std::move(jobs_.front());
+                jobs_.pop_front();
+                working_ = true;
+            }
+
+            auto [data, prefix, suffix] = compress(*job.state, job.keyframe.get());
+
+            std::unique_lock<std::mutex> lock(mutex_);
+            if (job.id < first_ || job.id >= first_ + entries_.size()) continue;
+            auto& entry = entries_[job.id - first_];
+            if (entry.serial != job.serial) continue;
+            memory_ -= entry.memory();
+            entry.data = std::move(data);
+            entry.prefix = prefix;
+            entry.suffix = suffix;
+            entry.state.reset();
+            memory_ += entry.memory();
+        }
+    }} {}
+
+UndoHistory::~UndoHistory() {
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        quit_ = true;
+    }
+    condition_.notify_one();
+    worker_.join();
+}
+
+size_t UndoHistory::size() const {
+    std::unique_lock<std::mutex> lock(mutex_);
+    return entries_.size();
+}
+
+size_t UndoHistory::push(std::shared_ptr<const std::string> state) {
+    size_t dropped = 0;
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        const auto id = first_ + entries_.size();
+        const bool isKeyframe = !keyframe_ || id - keyframeId_ >= keyframeInterval;
+        if (isKeyframe) {
+            keyframe_ = state;
+            keyframeId_ = id;
+        }
+
+        Entry entry;
+        entry.serial = ++serial_;
+        entry.keyframe = keyframeId_;
+        entry.state = state;
+        memory_ += entry.memory();
+        entries_.push_back(std::move(entry));
+        jobs_.push_back(Job{id, serial_, state, isKeyframe ? nullptr : keyframe_});
+
+        dropped = trim();
+    }
+    condition_.notify_one();
+    return dropped;
+}
+
+std::shared_ptr<const std::string> UndoHistory::get(size_t i) const {
+    std::shared_ptr<const std::string> keyframeState;
+    QByteArray keyframeData;
+    Entry entry;
+    bool isKeyframe = false;
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        entry = entries_.at(i);
+        if (entry.state) return entry.state;
+
+        isKeyframe = entry.keyframe == first_ + i;
+        if (!isKeyframe) {
+            const auto& keyframe = entries_[entry.keyframe - first_];
+            keyframeState = keyframe.state;
+            keyframeData = keyframe.data;
+        }
+    }
+
+    const auto unpacked = qUncompress(entry.data);
+    if (isKeyframe) {
+        return std::make_shared<const std::string>(unpacked.constData(), unpacked.size());
+    }
+
+    if (!keyframeState) {
+        const auto keyframe = qUncompress(keyframeData);
+        keyframeState = std::make_shared<const std::string>(keyframe.constData(), keyframe.size());
+    }
+    std::string state;
+    state.reserve(entry.prefix + static_cast<size_t>(unpacked.size()) + entry.suffix);
+    state.append(*keyframeState, 0, entry.prefix);
+    state.append(unpacked.constData(), unpacked.size());
+    state.append(*keyframeState, keyframeState->size() - entry.suffix, entry.suffix);
+    return std::make_shared<const std::string>(std::move(state));
+}
+
+void UndoHistory::truncate(size_t i) {
+    std::unique_lock<std::mutex> lock(mutex_);
+    while (entries_.size() > i) {
+        memory_ -= entries_.back().memory();
+        entries_.pop_back();
+    }
+    if (keyframe_ && keyframeId_ >= first_ + entries_.size()) keyframe_.reset();
+}
+
+void UndoHistory::clear() { truncate(0); }
+
+void UndoHistory::setMemoryBudget(size_t bytes) {
+    std::unique_lock<std::mutex> lock(mutex_);
+    budget_ = bytes;
+}
+
+size_t UndoHistory::getMemoryBudget() const {
+    std::unique_lock<std::mutex> lock(mutex_);
+    return budget_;
+}
+
+size_t UndoHistory::getMemoryUsage() const {
+    std::unique_lock<std::mutex> lock(mutex_);
+    return memory_;
+}
+
+void UndoHistory::waitForCompression() const {
+    std::unique_lock<std::mutex> lock(mutex_);
+    idle_.wait(lock, [this]() { return quit_ || (jobs_.empty() && !working_); });
+}
+
+std::tuple<QByteArray, size_t, size_t> UndoHistory::compress(const std::string& state,
+                                                             const std::string* keyframe) {
+    size_t prefix = 0;
+    size_t suffix = 0;
+    if (keyframe) {
+        const auto maxLength = std::min(state.size(), keyframe->size());
+        prefix = static_cast<size_t>(
+            std::mismatch(state.begin(), state.begin() + maxLength, keyframe->begin()).first -
+            state.begin());
+        suffix = static_cast<size_t>(
+            std::mismatch(state.rbegin(), state.rbegin() + (maxLength - prefix), keyframe->rbegin())
+                .first -
+            state.rbegin());
+    }
+    const auto data = qCompress(reinterpret_cast<const uchar*>(state.data() + prefix),
+                                static_cast<int>(state.size() - prefix - suffix));
+    return {data, prefix, suffix};
+}
+
+// Drop the oldest keyframe and its deltas while over budget, the last keyframe is always kept
+size_t UndoHistory::trim() {
+    size_t dropped = 0;
+    while (memory_ > budget_ && entries_.front().keyframe != entries_.back().keyframe) {
+        const auto keyframe = entries_.front().keyframe;
+        while (entries_.front().keyframe == keyframe) {
+            memory_ -= entries_.front().memory();
+            entries_.pop_front();
+            ++first_;
+            ++dropped;
+        }
+    }
+    return dropped;
+}
+
+}  // namespace inviwo
@@ -31,6 +31,7 @@
 #include <inviwo/core/network/processornetwork.h>
 #include <inviwo/qt/editor/inviwomainwindow.h>
 #include <inviwo/qt/editor/undomanager.h>
+#include <inviwo/qt/editor/undohistory.h>
 #include <inviwo/core/util/raiiutils.h>
 #include <inviwo/core/util/filesystem.h>
 #include <inviwo/qt/applicationbase/inviwoapplicationqt.h>
@@ -124,6 +125,7 @@ UndoManager::UndoManager(InviwoMainWindow* mainWindow)
     : mainWindow_(mainWindow)
     , manager_{mainWindow_->getInviwoApplication()->getWorkspaceManager()}
     , refPath_{filesystem::findBasePath()}
+    , history_{std::make_unique<UndoHistory>()}
     , autoSaver_{std::make_unique<AutoSaver>()} {
 
     mainWindow_->getInviwoApplicationQt()->setUndoTrigger([this]() { pushStateIfDirty(); });
@@ -172,12 +174,12 @@ void UndoManager::pushState() {
     auto str = std::make_shared<const std::string>(std::move(stream).str());
 
     dirty_ = false;
-    if (head_ >= 0 && *str == *undoBuffer_[head_]) return;  // No Change
+    if (head_ >= 0 && current_ && *str == *current_) return;  // No Change
 
     ++head_;
-    auto offset = std::min(std::distance(undoBuffer_.begin(), undoBuffer_.end()), head_);
-    undoBuffer_.erase(undoBuffer_.begin() + offset, undoBuffer_.end());
-    undoBuffer_.push_back(str);
+    history_->truncate(static_cast<size_t>(head_));
+    head_ -= static_cast<DiffType>(history_->push(str));
+    current_ = str;
 
     autoSaver_->save(str);
 
@@ -187,9 +189,10 @@ void UndoManager::undoState() {
     if (head_ > 0) {
         util::KeepTrueWhileInScope restore(&isRestoring);
         --head_;
+        current_ = history_->get(static_cast<size_t>(head_));
 
         std::stringstream stream;
-        stream << *undoBuffer_[head_];
+        stream << *current_;
         manager_->load(stream, refPath_);
 
         dirty_ = false;
@@ -197,13 +200,14 @@ void UndoManager::undoState() {
     }
 }
 void UndoManager::redoState() {
-    if (head_ >= -1 && head_ < static_cast<DiffType>(undoBuffer_.size()) - 1) {
+    if (head_ >= -1 && head_ < static_cast<DiffType>(history_->size()) - 1) {
 
         util::KeepTrueWhileInScope restore(&isRestoring);
         ++head_;
+        current_ = history_->get(static_cast<size_t>(head_));
 
         std::stringstream stream;
-        stream << *undoBuffer_[head_];
+        stream << *current_;
         manager_->load(stream, refPath_);
 
         dirty_ = false;
@@ -213,9 +217,16 @@ void UndoManager::redoState() {
 
 void UndoManager::clear() {
     head_ = -1;
-    undoBuffer_.clear();
+    history_->clear();
+    current_.reset();
 }
 
+void UndoManager::setMemoryBudget(size_t bytes) { history_->setMemoryBudget(bytes); }
+
+size_t UndoManager::getMemoryBudget() const { return history_->getMemoryBudget(); }
+
+size_t UndoManager::getMemoryUsage() const { return history_->getMemoryUsage(); }
+
 QAction* UndoManager::getUndoAction() const { return undoAction_; }
 
 QAction* UndoManager::getRedoAction() const { return redoAction_; }
@@ -239,7 +250,7 @@ void UndoManager::restore() {
 
 void UndoManager::updateActions() {
     undoAction_->setEnabled(head_ > 0);
-    redoAction_->setEnabled(head_ >= -1 && head_ < static_cast<DiffType>(undoBuffer_.size()) - 1);
+    redoAction_->setEnabled(head_ >= -1 && head_ < static_cast<DiffType>(history_->size()) - 1);
 }
 
 void UndoManager::onProcessorNetworkChange() { dirty_ = true; }
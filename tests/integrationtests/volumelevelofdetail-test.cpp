@@ -0,0 +1,112 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2021 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+
+#include <inviwo/core/common/inviwoapplication.h>
+#include <inviwo/core/network/processornetwork.h>
+#include <inviwo/core/ports/volumeport.h>
+#include <inviwo/core/processors/processor.h>
+#include <inviwo/core/properties/optionproperty.h>
+#include <inviwo/core/properties/ordinalproperty.h>
+#include <modules/base/algorithm/volume/volumegeneration.h>
+#include <modules/base/processors/volumelevelofdetail.h>
+
+#include <warn/push>
+#include <warn/ignore/all>
+#include <gtest/gtest.h>
+#include <warn/pop>
+
+#include <memory>
+#include <thread>
+
+namespace inviwo {
+
+namespace {
+
+struct VolumeTestSource : Processor {
+    VolumeTestSource() : Processor("source", "Source") { addPort(outport); }
+
+    virtual const ProcessorInfo getProcessorInfo() const override { return processorInfo_; }
+    static const ProcessorInfo processorInfo_;
+
+    virtual void process() override {}
+
+    VolumeOutport outport{"outport"};
+};
+
+const ProcessorInfo VolumeTestSource::processorInfo_{
+    "org.inviwo.VolumeTestSource",  // Class identifier
+    "Volume Test Source",           // Display name
+    "Testing",                      // Category
+    CodeState::Stable,              // Code state
+    Tags::CPU,                      // Tags
+};
+
+}  // namespace
+
+TEST(VolumeLevelOfDetail, SwitchLevelWhileComputing) {
+    auto app = InviwoApplication::getPtr();
+    ProcessorNetwork network{app};
+
+    auto sourcePtr = std::make_unique<VolumeTestSource>();
+    auto source = sourcePtr.get();
+    network.addProcessor(std::move(sourcePtr));
+    auto lodPtr = std::make_unique<VolumeLevelOfDetail>();
+    auto lod = lodPtr.get();
+    network.addProcessor(std::move(lodPtr));
+    network.addConnection(&source->outport, lod->getInports()[0]);
+
+    std::shared_ptr<const Volume> volume = util::makeSphericalVolume(size3_t{32});
+    source->outport.setData(volume);
+
+    auto selection = dynamic_cast<BaseOptionProperty*>(lod->getPropertyByIdentifier("selection"));
+    auto level = dynamic_cast<IntSizeTProperty*>(lod->getPropertyByIdentifier("level"));
+    ASSERT_TRUE(selection);
+    ASSERT_TRUE(level);
+    selection->setSelectedIndex(0);
+
+    // Start computing level 2, its result is only delivered when the main thread processes it
+    level->set(2);
+    lod->process();
+    EXPECT_TRUE(lod->hasJobs());
+
+    // Level 0 already exists, the job for level 2 must not overwrite it when it finishes
+    level->set(0);
+    lod->process();
+    while (lod->hasJobs()) {
+        app->processFront();
+        std::this_thread::yield();
+    }
+
+    auto outport = dynamic_cast<VolumeOutport*>(lod->getOutports()[0]);
+    ASSERT_TRUE(outport);
+    EXPECT_EQ(volume, outport->getData());
+}
+
+}  // namespace inviwo